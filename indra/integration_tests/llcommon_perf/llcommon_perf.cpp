@@ -0,0 +1,414 @@
+/**
+ * @file llcommon_perf.cpp
+ * @brief Timing loops for llcommon, run by hand rather than by the build
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+#include "linden_common.h"
+
+#include "llerrorcontrol.h"
+#include "llfile.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "llstringtable.h"
+#include "lltimer.h"
+#include "lluuid.h"
+
+// system libraries
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tllcommon_perf [options] [benchmark...]\n"
+"\n"
+"Times llcommon code paths the unit tests only check for correctness.\n"
+"Runs every benchmark unless some are named.\n"
+"\n"
+" -h, --help\n"
+"        Print this help and the benchmarks\n"
+"\n";
+
+namespace
+{
+    // Times body() run count times, in nanoseconds per run
+    template <typename FUNC>
+    F64 time_ns(S32 count, FUNC&& body)
+    {
+        LLTimer timer;
+        for (S32 i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return timer.getElapsedTimeF64() * 1e9 / count;
+    }
+
+    //-------------------------------------------------------------------------
+    // interned: lookups of names shaped like event pump names
+    //-------------------------------------------------------------------------
+    void interned_lookups()
+    {
+        typedef std::unordered_map<LLInternedString, S32,
+                                   LLInternedString::Hash, LLInternedString::Equal> interned_map_t;
+
+        const S32 NAMES = 200;
+        const S32 LOOKUPS = 1000000;
+        std::vector<std::string> names;
+        std::vector<LLInternedString> interned;
+        std::map<std::string, S32> string_map;
+        interned_map_t interned_map;
+        LLSD sd;
+        for (S32 i = 0; i < NAMES; ++i)
+        {
+            names.push_back(llformat("LLEventPump-%s-%d", (i % 2) ? "mainloop" : "Coro", i));
+            interned.emplace_back(names.back());
+            string_map[names[i]] = i;
+            interned_map[interned.back()] = i;
+            sd[names[i]] = i;
+        }
+
+        S64 sum = 0;
+        F64 string_map_ns = time_ns(LOOKUPS, [&](S32 i) { sum += string_map.find(names[i % NAMES])->second; });
+        F64 string_find_ns = time_ns(LOOKUPS, [&](S32 i) { sum += interned_map.find(std::string_view(names[i % NAMES]))->second; });
+        F64 interned_find_ns = time_ns(LOOKUPS, [&](S32 i) { sum += interned_map.find(interned[i % NAMES])->second; });
+        F64 llsd_string_ns = time_ns(LOOKUPS, [&](S32 i) { sum += sd[names[i % NAMES]].asInteger(); });
+        F64 llsd_interned_ns = time_ns(LOOKUPS, [&](S32 i) { sum += sd[interned[i % NAMES]].asInteger(); });
+
+        std::cout << "Lookup of " << NAMES << " names, ns per lookup:"
+                  << "\n  std::map<std::string>:           " << string_map_ns
+                  << "\n  interned map, by std::string:    " << string_find_ns
+                  << "\n  interned map, by interned:       " << interned_find_ns
+                  << "\n  LLSD map, by std::string:        " << llsd_string_ns
+                  << "\n  LLSD map, by interned:           " << llsd_interned_ns
+                  << "\n  (checksum " << sum << ")" << std::endl;
+    }
+
+    //-------------------------------------------------------------------------
+    // llsd: map-heavy LLSD workloads, by std::string and by interned keys
+    //-------------------------------------------------------------------------
+
+    // The item fields, in the order LLInventoryItem::fromLLSD() sees them
+    const char* const ITEM_KEYS[] = { "item_id", "parent_id", "name", "desc", "type",
+                                      "inv_type", "flags", "created_at", "asset_id" };
+    const char* const PERMISSIONS_KEYS[] = { "creator_id", "owner_id", "last_owner_id", "group_id",
+                                             "base_mask", "owner_mask", "group_mask",
+                                             "everyone_mask", "next_owner_mask", "is_owner_group" };
+    const char* const SALE_INFO_KEYS[] = { "sale_type", "sale_price" };
+
+    // What a region's seed capability hands back, in part
+    const char* const CAPABILITY_NAMES[] = {
+        "AgentPreferences", "AgentProfile", "AgentState", "AttachmentResources", "AvatarPickerSearch",
+        "AvatarRenderInfo", "ChatSessionRequest", "CopyInventoryFromNotecard", "CreateInventoryCategory",
+        "DispatchRegionInfo", "EnvironmentSettings", "EstateAccess", "EstateChangeInfo", "EventQueueGet",
+        "ExtEnvironment", "FetchLib2", "FetchLibDescendents2", "FetchInventory2",
+        "FetchInventoryDescendents2", "IncrementCOFVersion", "InterestList", "GetDisplayNames",
+        "GetExperiences", "GetMesh", "GetMesh2", "GetMetadata", "GetObjectCost", "GetObjectPhysicsData",
+        "GetTexture", "GroupAPIv1", "GroupMemberData", "HomeLocation", "LandResources", "LSLSyntax",
+        "MapLayer", "MeshUploadFlag", "ModifyMaterialParams", "ModifyRegion", "NewFileAgentInventory",
+        "ObjectAnimation", "ObjectMedia", "ObjectMediaNavigate", "ParcelPropertiesUpdate",
+        "ParcelVoiceInfoRequest", "ProvisionVoiceAccountRequest", "ReadOfflineMsgs", "RegionObjects",
+        "RemoteParcelRequest", "RenderMaterials", "RequestTextureDownload", "ResourceCostSelected",
+        "SearchStatRequest", "SendPostcard", "SendUserReport", "ServerReleaseNotes", "SetDisplayName",
+        "SimConsoleAsync", "SimulatorFeatures", "TextureStats", "UntrustedSimulatorMessage",
+        "UpdateAgentInformation", "UpdateAgentLanguage", "UpdateAvatarAppearance",
+        "UpdateNotecardAgentInventory", "UpdateScriptAgent", "UpdateScriptTask",
+        "UpdateSettingsAgentInventory", "UploadBakedTexture", "UserInfo", "ViewerAsset",
+        "ViewerBenefits", "ViewerMetrics", "ViewerStats" };
+
+    LLSD make_item(S32 i)
+    {
+        LLSD item;
+        item["item_id"] = LLUUID::generateNewID();
+        item["parent_id"] = LLUUID::generateNewID();
+        item["name"] = llformat("Object %d", i);
+        item["desc"] = llformat("(No Description) %d", i);
+        item["type"] = i % 20;
+        item["inv_type"] = i % 18;
+        item["flags"] = i * 7;
+        item["created_at"] = 1700000000 + i;
+        item["asset_id"] = LLUUID::generateNewID();
+        LLSD& permissions = item["permissions"];
+        for (const char* key : PERMISSIONS_KEYS)
+        {
+            permissions[key] = (i % 3) ? LLSD(i) : LLSD(LLUUID::generateNewID());
+        }
+        LLSD& sale_info = item["sale_info"];
+        sale_info["sale_type"] = i % 4;
+        sale_info["sale_price"] = 10 + i % 100;
+        return item;
+    }
+
+    // Reads every field as an import does, by KEY_T keys
+    template <typename KEY_T>
+    S64 read_item(const LLSD& item, const std::vector<KEY_T>& item_keys,
+                  const KEY_T& permissions_key, const std::vector<KEY_T>& permissions_keys,
+                  const KEY_T& sale_info_key, const std::vector<KEY_T>& sale_info_keys)
+    {
+        S64 sum = 0;
+        for (const KEY_T& key : item_keys)
+        {
+            sum += item[key].size() + item[key].asInteger();
+        }
+        const LLSD& permissions = item[permissions_key];
+        for (const KEY_T& key : permissions_keys)
+        {
+            sum += permissions[key].asInteger();
+        }
+        const LLSD& sale_info = item[sale_info_key];
+        for (const KEY_T& key : sale_info_keys)
+        {
+            sum += sale_info[key].asInteger();
+        }
+        return sum;
+    }
+
+    template <typename KEY_T>
+    std::vector<KEY_T> make_keys(const char* const* begin, const char* const* end)
+    {
+        std::vector<KEY_T> keys;
+        for (const char* const* key = begin; key != end; ++key)
+        {
+            keys.emplace_back(*key);
+        }
+        return keys;
+    }
+
+    void llsd_maps()
+    {
+        // inventory import: an AIS style array of items, as XML
+        const S32 ITEMS = 20000;
+        LLSD items(LLSD::emptyArray());
+        for (S32 i = 0; i < ITEMS; ++i)
+        {
+            items.append(make_item(i));
+        }
+        std::ostringstream xml;
+        LLSDSerialize::toXML(items, xml);
+
+        LLSD parsed;
+        LLTimer timer;
+        std::istringstream in(xml.str());
+        LLSDSerialize::fromXML(parsed, in);
+        F64 parse_ms = timer.getElapsedTimeF64() * 1000.0;
+
+        std::vector<std::string> string_item_keys(make_keys<std::string>(std::begin(ITEM_KEYS), std::end(ITEM_KEYS)));
+        std::vector<std::string> string_permissions_keys(make_keys<std::string>(std::begin(PERMISSIONS_KEYS), std::end(PERMISSIONS_KEYS)));
+        std::vector<std::string> string_sale_info_keys(make_keys<std::string>(std::begin(SALE_INFO_KEYS), std::end(SALE_INFO_KEYS)));
+        std::vector<LLInternedString> interned_item_keys(make_keys<LLInternedString>(std::begin(ITEM_KEYS), std::end(ITEM_KEYS)));
+        std::vector<LLInternedString> interned_permissions_keys(make_keys<LLInternedString>(std::begin(PERMISSIONS_KEYS), std::end(PERMISSIONS_KEYS)));
+        std::vector<LLInternedString> interned_sale_info_keys(make_keys<LLInternedString>(std::begin(SALE_INFO_KEYS), std::end(SALE_INFO_KEYS)));
+        const std::string string_permissions("permissions"), string_sale_info("sale_info");
+        const LLInternedString interned_permissions("permissions"), interned_sale_info("sale_info");
+
+        S64 string_sum = 0, interned_sum = 0;
+        F64 item_string_ns = time_ns(ITEMS, [&](S32 i)
+        {
+            string_sum += read_item(parsed[i], string_item_keys, string_permissions, string_permissions_keys,
+                                    string_sale_info, string_sale_info_keys);
+        });
+        F64 item_interned_ns = time_ns(ITEMS, [&](S32 i)
+        {
+            interned_sum += read_item(parsed[i], interned_item_keys, interned_permissions, interned_permissions_keys,
+                                      interned_sale_info, interned_sale_info_keys);
+        });
+
+        std::cout << "Inventory import of " << ITEMS << " items:"
+                  << "\n  XML parse, ms:                   " << parse_ms
+                  << "\n  field reads by std::string, ns per item: " << item_string_ns
+                  << "\n  field reads by interned, ns per item:    " << item_interned_ns
+                  << (string_sum == interned_sum ? "" : "\n  MISMATCH between key types") << std::endl;
+
+        // capability parsing: a seed capability response, then a lookup of
+        // every capability the viewer asked for
+        const S32 REGIONS = 2000;
+        LLSD caps;
+        for (const char* name : CAPABILITY_NAMES)
+        {
+            caps[name] = llformat("https://simhost-0123456789abcdef.agni.lindenlab.com:12043/cap/%s",
+                                  LLUUID::generateNewID().asString().c_str());
+        }
+        std::ostringstream caps_xml;
+        LLSDSerialize::toXML(caps, caps_xml);
+        const std::string caps_text(caps_xml.str());
+
+        std::vector<std::string> string_names(make_keys<std::string>(std::begin(CAPABILITY_NAMES), std::end(CAPABILITY_NAMES)));
+        std::vector<LLInternedString> interned_names(make_keys<LLInternedString>(std::begin(CAPABILITY_NAMES), std::end(CAPABILITY_NAMES)));
+
+        F64 caps_parse_ns = time_ns(REGIONS, [&](S32)
+        {
+            std::istringstream caps_in(caps_text);
+            LLSDSerialize::fromXML(parsed, caps_in);
+        });
+        string_sum = interned_sum = 0;
+        const S32 LOOKUPS = REGIONS * (S32)string_names.size();
+        F64 caps_string_ns = time_ns(LOOKUPS, [&](S32 i)
+        {
+            string_sum += parsed[string_names[i % string_names.size()]].asStringRef().size();
+        });
+        F64 caps_interned_ns = time_ns(LOOKUPS, [&](S32 i)
+        {
+            interned_sum += parsed[interned_names[i % interned_names.size()]].asStringRef().size();
+        });
+
+        std::cout << "Capability parsing of " << string_names.size() << " capabilities:"
+                  << "\n  XML parse, us per region:        " << caps_parse_ns / 1000.0
+                  << "\n  lookup by std::string, ns:       " << caps_string_ns
+                  << "\n  lookup by interned, ns:          " << caps_interned_ns
+                  << (string_sum == interned_sum ? "" : "\n  MISMATCH between key types") << std::endl;
+    }
+
+    //-------------------------------------------------------------------------
+    // logging: a chatty subsystem logging to a file from 8 threads
+    //-------------------------------------------------------------------------
+    void logging()
+    {
+        const U32 THREADS = 8;
+        const U32 COUNT = 5000;
+        const std::string file_name("llcommon_perf.log");
+        LLError::initForApplication(".", ".", false);
+        LLError::setDefaultLevel(LLError::LEVEL_INFO);
+
+        auto run = [&](bool async, U32& lines)
+        {
+            LLFile::remove(file_name);
+            LLError::logToFile(file_name);
+            LLError::setAsyncLogging(async);
+
+            std::atomic<U32> ready(0);
+            LLTimer timer;
+            std::vector<std::thread> threads;
+            for (U32 t = 0; t < THREADS; ++t)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    ++ready;
+                    while (ready < THREADS)
+                    {
+                        std::this_thread::yield();
+                    }
+                    for (U32 i = 0; i < COUNT; ++i)
+                    {
+                        LL_INFOS("AsyncBench") << "thread " << t << " message " << i << LL_ENDL;
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+            const F64 ns = timer.getElapsedTimeF64() * 1.e9 / (THREADS * COUNT);
+
+            LLError::setAsyncLogging(false);
+            LLError::logToFile("");
+            std::ifstream in(file_name.c_str());
+            std::string line;
+            for (lines = 0; std::getline(in, line); ++lines)
+            {
+            }
+            in.close();
+            LLFile::remove(file_name);
+            return ns;
+        };
+
+        U32 sync_lines = 0;
+        U32 async_lines = 0;
+        const U64 dropped = LLError::getAsyncLogDropped();
+        const F64 sync_ns = run(false, sync_lines);
+        const F64 async_ns = run(true, async_lines);
+        const U64 async_dropped = LLError::getAsyncLogDropped() - dropped;
+
+        std::cout << THREADS << " threads x " << COUNT << " LL_INFOS to a file, ns per call:"
+                  << "\n  sync:                            " << sync_ns << " (" << sync_lines << " lines)"
+                  << "\n  async:                           " << async_ns << " (" << async_lines << " lines, "
+                  << async_dropped << " dropped)" << std::endl;
+    }
+
+    struct Benchmark
+    {
+        const char* mName;
+        const char* mDescription;
+        void (*mRun)();
+    };
+
+    const Benchmark BENCHMARKS[] = {
+        { "interned", "Interned string lookups against std::string lookups", interned_lookups },
+        { "llsd", "LLSD inventory import and capability parsing, by std::string and interned keys", llsd_maps },
+        { "logging", "LL_INFOS to a file from 8 threads, with and without async logging", logging },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<const Benchmark*> selected;
+
+    // Analyze command line arguments
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << "benchmarks:\n";
+            for (const Benchmark& benchmark : BENCHMARKS)
+            {
+                std::cout << "  " << benchmark.mName << "\n        " << benchmark.mDescription << "\n";
+            }
+            std::cout << std::endl;
+            return 0;
+        }
+
+        const Benchmark* found = NULL;
+        for (const Benchmark& benchmark : BENCHMARKS)
+        {
+            if (!strcmp(argv[arg], benchmark.mName))
+            {
+                found = &benchmark;
+            }
+        }
+        if (!found)
+        {
+            std::cout << "Unknown benchmark " << argv[arg] << std::endl;
+            std::cout << USAGE << std::endl;
+            return 1;
+        }
+        selected.push_back(found);
+    }
+
+    if (selected.empty())
+    {
+        for (const Benchmark& benchmark : BENCHMARKS)
+        {
+            selected.push_back(&benchmark);
+        }
+    }
+
+    for (const Benchmark* benchmark : selected)
+    {
+        std::cout << "[" << benchmark->mName << "]" << std::endl;
+        benchmark->mRun();
+    }
+    return 0;
+}
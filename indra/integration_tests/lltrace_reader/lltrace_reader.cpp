@@ -0,0 +1,130 @@
+/**
+ * @file lltrace_reader.cpp
+ * @brief Turns frame stats captures into CSV files and percentile summaries
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+#include "linden_common.h"
+
+#include "lltracecapture.h"
+
+// system libraries
+#include <fstream>
+#include <iostream>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tlltrace_reader [options] <capture>\n"
+"\n"
+"Reads a frame stats capture, as the viewer writes with FSTraceCapture.\n"
+"\n"
+" -h, --help\n"
+"        Print this help\n"
+" -c, --csv <file>\n"
+"        Write a row per frame, with a column per stat, to <file>.\n"
+" -s, --summary <file>\n"
+"        Write a row per stat with its mean, min, 50th, 95th and 99th percentiles\n"
+"        and max over the frames it has a value in, to <file>.\n"
+"        Default is a summary on standard out.\n"
+"\n"
+"Counts are summed over the frame, samples and events are averaged and timers\n"
+"are the total time in the frame, in milliseconds.\n"
+"\n";
+
+int main(int argc, char** argv)
+{
+    std::string capture_name;
+    std::string csv_name;
+    std::string summary_name;
+
+    // Analyze command line arguments
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << std::endl;
+            return 0;
+        }
+        else if ((!strcmp(argv[arg], "--csv") || !strcmp(argv[arg], "-c")) && arg < argc-1)
+        {
+            csv_name = argv[++arg];
+        }
+        else if ((!strcmp(argv[arg], "--summary") || !strcmp(argv[arg], "-s")) && arg < argc-1)
+        {
+            summary_name = argv[++arg];
+        }
+        else if (argv[arg][0] != '-' && capture_name.empty())
+        {
+            capture_name = argv[arg];
+        }
+        else
+        {
+            std::cout << "Unknown argument " << argv[arg] << std::endl;
+            std::cout << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    if (capture_name.empty())
+    {
+        std::cout << USAGE << std::endl;
+        return 1;
+    }
+
+    LLTrace::TraceCaptureReader reader;
+    if (!reader.load(capture_name))
+    {
+        std::cerr << capture_name << " is not a frame stats capture" << std::endl;
+        return 1;
+    }
+    std::cerr << capture_name << ": " << reader.getFrames().size() << " frames, "
+              << reader.getStats().size() << " stats"
+              << (reader.isTruncated() ? " (truncated)" : "") << std::endl;
+
+    if (!csv_name.empty())
+    {
+        std::ofstream csv(csv_name.c_str());
+        if (!csv.is_open())
+        {
+            std::cerr << "Can't write " << csv_name << std::endl;
+            return 1;
+        }
+        reader.writeCSV(csv);
+    }
+
+    if (!summary_name.empty())
+    {
+        std::ofstream summary(summary_name.c_str());
+        if (!summary.is_open())
+        {
+            std::cerr << "Can't write " << summary_name << std::endl;
+            return 1;
+        }
+        reader.writeSummary(summary);
+    }
+    else if (csv_name.empty())
+    {
+        reader.writeSummary(std::cout);
+    }
+
+    return 0;
+}
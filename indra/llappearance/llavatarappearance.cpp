@@ -1350,6 +1350,32 @@ LLPolyMesh* LLAvatarAppearance::getUpperBodyMesh()
     return mMeshLOD[MESH_ID_UPPER_BODY]->mMeshParts[0]->getMesh();
 }
 
+// <FS> Shared morphed meshes
+//-----------------------------------------------------------------------------
+// LLAvatarAppearance::beginApplyVisualParams()
+//-----------------------------------------------------------------------------
+void LLAvatarAppearance::beginApplyVisualParams()
+{
+    // Morph targets queue their deltas, so that the meshes can look for the
+    // whole result in the shared cache before running any of them
+    for (polymesh_map_t::value_type& mesh_pair : mPolyMeshes)
+    {
+        mesh_pair.second->deferMorphs();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LLAvatarAppearance::finishApplyVisualParams()
+//-----------------------------------------------------------------------------
+void LLAvatarAppearance::finishApplyVisualParams()
+{
+    for (polymesh_map_t::value_type& mesh_pair : mPolyMeshes)
+    {
+        mesh_pair.second->applyPendingMorphs();
+    }
+}
+// </FS>
+
 
 
 // virtual
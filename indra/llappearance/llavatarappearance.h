@@ -99,6 +99,10 @@ public:
     /*virtual*/ S32             getCollisionVolumeID(std::string &name);
     /*virtual*/ LLPolyMesh*     getHeadMesh();
     /*virtual*/ LLPolyMesh*     getUpperBodyMesh();
+    // <FS> Shared morphed meshes
+    /*virtual*/ void            beginApplyVisualParams();
+    /*virtual*/ void            finishApplyVisualParams();
+    // </FS>
 
 /**                    Inherited
  **                                                                            **
@@ -758,6 +758,10 @@ LLPolyMesh::LLPolyMesh(LLPolyMeshSharedData *shared_data, LLPolyMesh *reference_
     mReferenceMesh = reference_mesh;
     mAvatarp = NULL;
     mVertexData = NULL;
+    // <FS> Shared morphed meshes
+    mVertexDataBytes = 0;
+    mDeferMorphs = false;
+    // </FS>
 
     mCurVertexCount = 0;
     mFaceIndexCount = 0;
@@ -793,6 +797,7 @@ LLPolyMesh::LLPolyMesh(LLPolyMeshSharedData *shared_data, LLPolyMesh *reference_
 
         //use 16 byte aligned vertex data to make LLPolyMesh SSE friendly
         mVertexData = (F32*) ll_aligned_malloc_16(nfloats*4);
+        mVertexDataBytes = nfloats*4; // <FS/> Shared morphed meshes
         S32 offset = 0;
         mCoords             =   (LLVector4a*)(mVertexData + offset); offset += 4*nverts;
         mNormals            =   (LLVector4a*)(mVertexData + offset); offset += 4*nverts;
@@ -865,6 +870,7 @@ void LLPolyMesh::freeAllMeshes()
         // delete each item in the global lists
         for_each(sGlobalSharedMeshList.begin(), sGlobalSharedMeshList.end(), DeletePairedPointer());
         sGlobalSharedMeshList.clear();
+        getMorphCache().clear(); // <FS/> Shared morphed meshes: keyed by the shared data
 }
 
 LLPolyMeshSharedData *LLPolyMesh::getSharedData() const
@@ -872,6 +878,144 @@ LLPolyMeshSharedData *LLPolyMesh::getSharedData() const
         return mSharedData;
 }
 
+// <FS> Shared morphed meshes
+// Copying a mesh's coords out of the cache costs about as much as morphing a
+// couple of times its vertices, and a hit still redoes the normals of every
+// queued morph. Smaller batches, such as the few physics morphs that change
+// every frame, are applied directly and not cached.
+static const U32 MIN_CACHED_MORPH_VERTEX_FACTOR = 2;
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::getMorphCache()
+//-----------------------------------------------------------------------------
+// static
+LLPolyMorphCache& LLPolyMesh::getMorphCache()
+{
+        static LLPolyMorphCache sMorphCache;
+        return sMorphCache;
+}
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::noteMorph()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::noteMorph(S32 id, F32 weight, U64 mask_hash)
+{
+        // Targets stay once they have touched the mesh, even at weight 0: the
+        // normals of their vertices have been renormalized since
+        auto it = std::lower_bound(mMorphState.begin(), mMorphState.end(), id,
+                                   [](const LLPolyMorphCache::Target& target, S32 id) { return target.mID < id; });
+        if (it == mMorphState.end() || it->mID != id)
+        {
+                it = mMorphState.insert(it, LLPolyMorphCache::Target());
+                it->mID = id;
+        }
+        it->mWeight = weight;
+        it->mMaskHash = mask_hash;
+}
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::getCachedMorphBytes()
+//-----------------------------------------------------------------------------
+size_t LLPolyMesh::getCachedMorphBytes() const
+{
+        // padded to an even number of vertices, as in the constructor
+        size_t nverts = mSharedData->mNumVertices;
+        nverts += nverts % 2;
+        return nverts * (sizeof(LLVector4a) * 2 + sizeof(LLVector2));
+}
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::copyToMorphCache()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::copyToMorphCache(F32* data) const
+{
+        size_t nverts = mSharedData->mNumVertices;
+        nverts += nverts % 2;
+        U8* out = (U8*)data;
+        LLVector4a::memcpyNonAliased16((F32*)out, (const F32*)mCoords, nverts * sizeof(LLVector4a));
+        out += nverts * sizeof(LLVector4a);
+        LLVector4a::memcpyNonAliased16((F32*)out, (const F32*)mClothingWeights, nverts * sizeof(LLVector4a));
+        out += nverts * sizeof(LLVector4a);
+        LLVector4a::memcpyNonAliased16((F32*)out, (const F32*)mTexCoords, nverts * sizeof(LLVector2));
+}
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::copyFromMorphCache()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::copyFromMorphCache(const F32* data)
+{
+        size_t nverts = mSharedData->mNumVertices;
+        nverts += nverts % 2;
+        const U8* in = (const U8*)data;
+        LLVector4a::memcpyNonAliased16((F32*)mCoords, (const F32*)in, nverts * sizeof(LLVector4a));
+        in += nverts * sizeof(LLVector4a);
+        LLVector4a::memcpyNonAliased16((F32*)mClothingWeights, (const F32*)in, nverts * sizeof(LLVector4a));
+        in += nverts * sizeof(LLVector4a);
+        LLVector4a::memcpyNonAliased16((F32*)mTexCoords, (const F32*)in, nverts * sizeof(LLVector2));
+}
+
+//-----------------------------------------------------------------------------
+// LLPolyMesh::applyPendingMorphs()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::applyPendingMorphs()
+{
+        mDeferMorphs = false;
+        if (mPendingMorphs.empty())
+        {
+                return;
+        }
+
+        LL_PROFILE_ZONE_SCOPED;
+
+        U32 morph_vertices = 0;
+        for (const auto& pending : mPendingMorphs)
+        {
+                morph_vertices += pending.first->getNumMorphVertices();
+        }
+
+        LLPolyMorphCache& cache = getMorphCache();
+        const bool use_cache = cache.getMaxBytes() > 0
+                && morph_vertices >= MIN_CACHED_MORPH_VERTEX_FACTOR * getNumVertices();
+
+        LLPolyMorphCache::Key key;
+        if (use_cache)
+        {
+                // The morph state determines the coords and texture coords:
+                // they are plain sums of the deltas. The normals and binormals
+                // are renormalized after each morph, so they depend on the
+                // order the morphs were applied in; this mesh always runs its
+                // own queue over them.
+                key.mMesh = mSharedData;
+                key.mTargets = mMorphState;
+                LLPolyMorphCache::vertices_ptr_t vertices = cache.get(key);
+                if (vertices.notNull())
+                {
+                        llassert(vertices->getBytes() == getCachedMorphBytes());
+                        copyFromMorphCache(vertices->getData());
+                        for (const auto& pending : mPendingMorphs)
+                        {
+                                pending.first->applyDelta(pending.second, true);
+                        }
+                        mPendingMorphs.clear();
+                        return;
+                }
+        }
+
+        for (const auto& pending : mPendingMorphs)
+        {
+                pending.first->applyDelta(pending.second);
+        }
+        mPendingMorphs.clear();
+
+        if (use_cache)
+        {
+                LLPolyMorphCache::vertices_ptr_t vertices = new LLPolyMorphCache::Vertices(getCachedMorphBytes());
+                copyToMorphCache(vertices->getData());
+                cache.put(key, vertices);
+        }
+}
+// </FS>
+
 
 //--------------------------------------------------------------------
 // LLPolyMesh::dumpDiagInfo()
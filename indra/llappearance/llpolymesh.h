@@ -35,6 +35,7 @@
 #include "v2math.h"
 #include "llquaternion.h"
 #include "llpolymorph.h"
+#include "llpolymorphblend.h" // <FS/> Shared morphed meshes
 #include "lljoint.h"
 
 class LLSkinJoint;
@@ -318,6 +319,31 @@ public:
 
     bool    isLOD() { return mSharedData && mSharedData->isLOD(); }
 
+    // <FS> Shared morphed meshes
+    // Between deferMorphs() and applyPendingMorphs(), morph targets queue
+    // their deltas instead of applying them. applyPendingMorphs() then copies
+    // the coords and texture coords from the shared cache if another mesh has
+    // reached the same morph state, or applies the queue and stores them
+    // there. Either way the mesh computes its own normals and binormals.
+    void    deferMorphs() { mDeferMorphs = (mVertexData != NULL); }
+    bool    isDeferringMorphs() const { return mDeferMorphs; }
+    void    deferMorph(LLPolyMorphTarget* target, F32 delta_weight) { mPendingMorphs.emplace_back(target, delta_weight); }
+    void    applyPendingMorphs();
+
+    // Records the state of a morph target that has touched the vertices
+    void    noteMorph(S32 id, F32 weight, U64 mask_hash);
+
+    static LLPolyMorphCache& getMorphCache();
+
+private:
+    // The parts of the vertex data that the morph cache keeps
+    size_t  getCachedMorphBytes() const;
+    void    copyToMorphCache(F32* data) const;
+    void    copyFromMorphCache(const F32* data);
+
+public:
+    // </FS>
+
     void setAvatar(LLAvatarAppearance* avatarp) { mAvatarp = avatarp; }
     LLAvatarAppearance* getAvatar() { return mAvatarp; }
 
@@ -356,6 +382,14 @@ protected:
 
     LLPolyMesh              *mReferenceMesh;
 
+    // <FS> Shared morphed meshes
+    size_t                  mVertexDataBytes;
+    bool                    mDeferMorphs;
+    std::vector<std::pair<LLPolyMorphTarget*, F32> > mPendingMorphs;
+    // every morph target applied so far, sorted by id
+    std::vector<LLPolyMorphCache::Target> mMorphState;
+    // </FS>
+
     // global mesh list
     typedef std::map<std::string, LLPolyMeshSharedData*> LLPolyMeshSharedDataTable;
     static LLPolyMeshSharedDataTable sGlobalSharedMeshList;
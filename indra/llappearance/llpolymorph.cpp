@@ -36,6 +36,9 @@
 #include "llendianswizzle.h"
 #include "llpolymesh.h"
 #include "llfasttimer.h"
+#include "llpolymorphblend.h" // <FS/> Shared morphed meshes
+
+#include <boost/functional/hash.hpp> // <FS/> Shared morphed meshes
 
 //#include "../tools/imdebug/imdebug.h"
 
@@ -57,6 +60,7 @@ LLPolyMorphData::LLPolyMorphData(const std::string& morph_name)
     mNormals = NULL;
     mBinormals = NULL;
     mTexCoords = NULL;
+    mBlendBinormals = NULL; // <FS/> Shared morphed meshes
 
     mMesh = NULL;
 }
@@ -71,7 +75,8 @@ LLPolyMorphData::LLPolyMorphData(const LLPolyMorphData &rhs) :
     mCoords(NULL),
     mNormals(NULL),
     mBinormals(NULL),
-    mTexCoords(NULL)
+    mTexCoords(NULL),
+    mBlendBinormals(NULL) // <FS/> Shared morphed meshes
 {
     const S32 numVertices = mNumIndices;
 
@@ -221,6 +226,14 @@ bool LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
 //-----------------------------------------------------------------------------
 void LLPolyMorphData::freeData()
 {
+    // <FS> Shared morphed meshes
+    if (mBlendBinormals != NULL && mBlendBinormals != mBinormals)
+    {
+        ll_aligned_free_16(mBlendBinormals);
+    }
+    mBlendBinormals = NULL;
+    // </FS>
+
     if (mCoords != NULL)
     {
         ll_aligned_free_16(mCoords);
@@ -252,6 +265,31 @@ void LLPolyMorphData::freeData()
     }
 }
 
+// <FS> Shared morphed meshes
+//-----------------------------------------------------------------------------
+// getBlendBinormals()
+//-----------------------------------------------------------------------------
+const LLVector4a* LLPolyMorphData::getBlendBinormals()
+{
+    if (!mBlendBinormals)
+    {
+        // Built on first use rather than on load, as the physics morphs
+        // cloned from loaded ones rewrite their binormals afterwards
+        if (LLPolyMorphBlend::hasDegenerateBinormals(mBinormals, mNumIndices))
+        {
+            mBlendBinormals = static_cast<LLVector4a*>(ll_aligned_malloc_16(sizeof(LLVector4a) * mNumIndices));
+            LLVector4a::memcpyNonAliased16((F32*)mBlendBinormals, (F32*)mBinormals, sizeof(LLVector4a) * mNumIndices);
+            LLPolyMorphBlend::sanitizeBinormals(mBlendBinormals, mNumIndices);
+        }
+        else
+        {
+            mBlendBinormals = mBinormals;
+        }
+    }
+    return mBlendBinormals;
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // LLPolyMorphTargetInfo()
 //-----------------------------------------------------------------------------
@@ -570,75 +608,87 @@ void LLPolyMorphTarget::apply( ESex avatar_sex )
     if (delta_weight != 0.f)
     {
         llassert(!mMesh->isLOD());
-        LLVector4a *coords = mMesh->getWritableCoords();
-
-        LLVector4a *scaled_normals = mMesh->getScaledNormals();
-        LLVector4a *normals = mMesh->getWritableNormals();
-
-        LLVector4a *scaled_binormals = mMesh->getScaledBinormals();
-        LLVector4a *binormals = mMesh->getWritableBinormals();
-
-        LLVector4a *clothing_weights = mMesh->getWritableClothingWeights();
-        LLVector2 *tex_coords = mMesh->getWritableTexCoords();
-
-        F32 *maskWeightArray = (mVertMask) ? mVertMask->getMorphMaskWeights() : NULL;
-
-        for(U32 vert_index_morph = 0; vert_index_morph < mMorphData->mNumIndices; vert_index_morph++)
+        // <FS> Shared morphed meshes: the vertex loop moved to
+        // LLPolyMorphBlend::blend(), which the mesh may run later
+        //LLVector4a *coords = mMesh->getWritableCoords();
+
+        //LLVector4a *scaled_normals = mMesh->getScaledNormals();
+        //LLVector4a *normals = mMesh->getWritableNormals();
+
+        //LLVector4a *scaled_binormals = mMesh->getScaledBinormals();
+        //LLVector4a *binormals = mMesh->getWritableBinormals();
+
+        //LLVector4a *clothing_weights = mMesh->getWritableClothingWeights();
+        //LLVector2 *tex_coords = mMesh->getWritableTexCoords();
+
+        //F32 *maskWeightArray = (mVertMask) ? mVertMask->getMorphMaskWeights() : NULL;
+
+        //for(U32 vert_index_morph = 0; vert_index_morph < mMorphData->mNumIndices; vert_index_morph++)
+        //{
+        //    S32 vert_index_mesh = mMorphData->mVertexIndices[vert_index_morph];
+
+        //    F32 maskWeight = 1.f;
+        //    if (maskWeightArray)
+        //    {
+        //        maskWeight = maskWeightArray[vert_index_morph];
+        //    }
+
+
+        //    LLVector4a pos = mMorphData->mCoords[vert_index_morph];
+        //    pos.mul(delta_weight*maskWeight);
+        //    coords[vert_index_mesh].add(pos);
+
+        //    if (getInfo()->mIsClothingMorph && clothing_weights)
+        //    {
+        //        LLVector4a clothing_offset = mMorphData->mCoords[vert_index_morph];
+        //        clothing_offset.mul(delta_weight * maskWeight);
+        //        LLVector4a* clothing_weight = &clothing_weights[vert_index_mesh];
+        //        clothing_weight->add(clothing_offset);
+        //        clothing_weight->getF32ptr()[VW] = maskWeight;
+        //    }
+
+        //    // calculate new normals based on half angles
+        //    LLVector4a norm = mMorphData->mNormals[vert_index_morph];
+        //    norm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
+        //    scaled_normals[vert_index_mesh].add(norm);
+        //    norm = scaled_normals[vert_index_mesh];
+
+        //    // guard against degenerate input data before we create NaNs below!
+        //    //
+        //    norm.normalize3fast();
+        //    normals[vert_index_mesh] = norm;
+
+        //    // calculate new binormals
+        //    LLVector4a binorm = mMorphData->mBinormals[vert_index_morph];
+
+        //    // guard against degenerate input data before we create NaNs below!
+        //    //
+        //    if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+        //    {
+        //        binorm.set(1,0,0,1);
+        //    }
+
+        //    binorm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
+        //    scaled_binormals[vert_index_mesh].add(binorm);
+        //    LLVector4a tangent;
+        //    tangent.setCross3(scaled_binormals[vert_index_mesh], norm);
+        //    LLVector4a& normalized_binormal = binormals[vert_index_mesh];
+
+        //    normalized_binormal.setCross3(norm, tangent);
+        //    normalized_binormal.normalize3fast();
+
+        //    tex_coords[vert_index_mesh] += mMorphData->mTexCoords[vert_index_morph] * delta_weight * maskWeight;
+        //}
+        mMesh->noteMorph(getID(), mLastWeight, mVertMask ? mVertMask->getWeightsHash() : 0);
+        if (mMesh->isDeferringMorphs())
         {
-            S32 vert_index_mesh = mMorphData->mVertexIndices[vert_index_morph];
-
-            F32 maskWeight = 1.f;
-            if (maskWeightArray)
-            {
-                maskWeight = maskWeightArray[vert_index_morph];
-            }
-
-
-            LLVector4a pos = mMorphData->mCoords[vert_index_morph];
-            pos.mul(delta_weight*maskWeight);
-            coords[vert_index_mesh].add(pos);
-
-            if (getInfo()->mIsClothingMorph && clothing_weights)
-            {
-                LLVector4a clothing_offset = mMorphData->mCoords[vert_index_morph];
-                clothing_offset.mul(delta_weight * maskWeight);
-                LLVector4a* clothing_weight = &clothing_weights[vert_index_mesh];
-                clothing_weight->add(clothing_offset);
-                clothing_weight->getF32ptr()[VW] = maskWeight;
-            }
-
-            // calculate new normals based on half angles
-            LLVector4a norm = mMorphData->mNormals[vert_index_morph];
-            norm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
-            scaled_normals[vert_index_mesh].add(norm);
-            norm = scaled_normals[vert_index_mesh];
-
-            // guard against degenerate input data before we create NaNs below!
-            //
-            norm.normalize3fast();
-            normals[vert_index_mesh] = norm;
-
-            // calculate new binormals
-            LLVector4a binorm = mMorphData->mBinormals[vert_index_morph];
-
-            // guard against degenerate input data before we create NaNs below!
-            //
-            if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
-            {
-                binorm.set(1,0,0,1);
-            }
-
-            binorm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
-            scaled_binormals[vert_index_mesh].add(binorm);
-            LLVector4a tangent;
-            tangent.setCross3(scaled_binormals[vert_index_mesh], norm);
-            LLVector4a& normalized_binormal = binormals[vert_index_mesh];
-
-            normalized_binormal.setCross3(norm, tangent);
-            normalized_binormal.normalize3fast();
-
-            tex_coords[vert_index_mesh] += mMorphData->mTexCoords[vert_index_morph] * delta_weight * maskWeight;
+            mMesh->deferMorph(this, delta_weight);
         }
+        else
+        {
+            applyDelta(delta_weight);
+        }
+        // </FS>
 
         // now apply volume changes
         for(LLPolyVolumeMorph& volume_morph : mVolumeMorphs)
@@ -728,9 +778,46 @@ void    LLPolyMorphTarget::applyMask(const U8 *maskTextureData, S32 width, S32 h
 
     mVertMask->generateMask(maskTextureData, width, height, num_components, invert, clothing_weights);
 
+    mMesh->noteMorph(getID(), 0.f, mVertMask->getWeightsHash()); // <FS/> Shared morphed meshes
+
     apply(mLastSex);
 }
 
+// <FS> Shared morphed meshes
+//-----------------------------------------------------------------------------
+// applyDelta()
+//-----------------------------------------------------------------------------
+void LLPolyMorphTarget::applyDelta(F32 delta_weight, bool normals_only)
+{
+    LLPolyMorphVertices vertices;
+    vertices.mCoords = mMesh->getWritableCoords();
+    vertices.mScaledNormals = mMesh->getScaledNormals();
+    vertices.mNormals = mMesh->getWritableNormals();
+    vertices.mScaledBinormals = mMesh->getScaledBinormals();
+    vertices.mBinormals = mMesh->getWritableBinormals();
+    vertices.mClothingWeights = getInfo()->mIsClothingMorph ? mMesh->getWritableClothingWeights() : NULL;
+    vertices.mTexCoords = mMesh->getWritableTexCoords();
+
+    LLPolyMorphDeltas deltas;
+    deltas.mNumIndices = mMorphData->mNumIndices;
+    deltas.mVertexIndices = mMorphData->mVertexIndices;
+    deltas.mCoords = mMorphData->mCoords;
+    deltas.mNormals = mMorphData->mNormals;
+    deltas.mBinormals = mMorphData->getBlendBinormals();
+    deltas.mTexCoords = mMorphData->mTexCoords;
+
+    const F32* mask_weights = mVertMask ? mVertMask->getMorphMaskWeights() : NULL;
+    if (normals_only)
+    {
+        LLPolyMorphBlend::blendNormals(deltas, vertices, delta_weight, mask_weights);
+    }
+    else
+    {
+        LLPolyMorphBlend::blend(deltas, vertices, delta_weight, mask_weights);
+    }
+}
+// </FS>
+
 void LLPolyMorphTarget::applyVolumeChanges(F32 delta_weight)
 {
     // now apply volume changes
@@ -751,7 +838,8 @@ void LLPolyMorphTarget::applyVolumeChanges(F32 delta_weight)
 LLPolyVertexMask::LLPolyVertexMask(LLPolyMorphData* morph_data)
     : mWeights(new F32[morph_data->mNumIndices]),
     mMorphData(morph_data),
-    mWeightsGenerated(false)
+    mWeightsGenerated(false),
+    mWeightsHash(0) // <FS/> Shared morphed meshes
 {
     llassert(mMorphData != NULL);
     llassert(mMorphData->mNumIndices > 0);
@@ -763,7 +851,8 @@ LLPolyVertexMask::LLPolyVertexMask(LLPolyMorphData* morph_data)
 LLPolyVertexMask::LLPolyVertexMask(const LLPolyVertexMask& pOther)
     : mWeights(new F32[pOther.mMorphData->mNumIndices]),
     mMorphData(pOther.mMorphData),
-    mWeightsGenerated(pOther.mWeightsGenerated)
+    mWeightsGenerated(pOther.mWeightsGenerated),
+    mWeightsHash(pOther.mWeightsHash) // <FS/> Shared morphed meshes
 {
     llassert(mMorphData != NULL);
     llassert(mMorphData->mNumIndices > 0);
@@ -830,6 +919,7 @@ void LLPolyVertexMask::generateMask(const U8 *maskTextureData, S32 width, S32 he
         }
     }
     mWeightsGenerated = true;
+    mWeightsHash = boost::hash_range(mWeights, mWeights + mMorphData->mNumIndices); // <FS/> Shared morphed meshes
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +52,12 @@ public:
     bool            loadBinary(LLFILE* fp, LLPolyMeshSharedData *mesh);
     const std::string& getName() { return mName; }
 
+    // <FS> Shared morphed meshes
+    // mBinormals with the degenerate ones LLPolyMorphBlend::blend() cannot
+    // take replaced, built on first use. The same array if there are none.
+    const LLVector4a*   getBlendBinormals();
+    // </FS>
+
 public:
     std::string         mName;
 
@@ -71,6 +77,8 @@ public:
 
 private:
     void freeData();
+
+    LLVector4a*         mBlendBinormals; // <FS/> Shared morphed meshes
 } LL_ALIGN_POSTFIX(16);
 
 
@@ -87,11 +95,16 @@ public:
     void generateMask(const U8 *maskData, S32 width, S32 height, S32 num_components, bool invert, LLVector4a *clothing_weights);
     F32* getMorphMaskWeights();
 
+    // <FS> Shared morphed meshes
+    // Identifies the generated weights; 0 before generateMask()
+    U64 getWeightsHash() const { return mWeightsGenerated ? mWeightsHash : 0; }
+    // </FS>
 
 protected:
     F32*        mWeights;
     LLPolyMorphData *mMorphData;
     bool            mWeightsGenerated;
+    U64             mWeightsHash; // <FS/> Shared morphed meshes
 
 };
 
@@ -175,6 +188,15 @@ public:
 
     void    applyVolumeChanges(F32 delta_weight); // SL-315 - for resetSkeleton()
 
+    // <FS> Shared morphed meshes
+    // Adds delta_weight of the morph to the mesh vertices. apply() calls it
+    // right away, or LLPolyMesh::applyPendingMorphs() once the mesh is done
+    // deferring morphs. normals_only updates just the normals and binormals,
+    // for a mesh whose other vertex data came from the morph cache.
+    void    applyDelta(F32 delta_weight, bool normals_only = false);
+    U32     getNumMorphVertices() const { return mMorphData ? mMorphData->mNumIndices : 0; }
+    // </FS>
+
 protected:
     LLPolyMorphTarget(const LLPolyMorphTarget& pOther);
 
@@ -0,0 +1,288 @@
+/**
+ * @file llpolymorphblend.cpp
+ * @brief Morph target blending kernel and the shared cache of morphed meshes.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmath.h"
+#include "llmemory.h"
+#include "llpolymorphblend.h"
+
+#include <boost/functional/hash.hpp>
+
+// Rough per entry cost of the hash map node, the LRU list node and the key
+static const size_t ENTRY_OVERHEAD_BYTES = 128;
+
+namespace
+{
+    // The mask and the clothing weights are fixed for a whole morph, so each
+    // combination gets its own loop. Without POSITIONS only the normals and
+    // binormals are updated, with exactly the same arithmetic.
+    template<bool MASKED, bool CLOTHING, bool POSITIONS>
+    void blend_vertices(const LLPolyMorphDeltas& deltas, const LLPolyMorphVertices& vertices,
+                        F32 delta_weight, const F32* mask_weights)
+    {
+        LLVector4a* __restrict coords = vertices.mCoords;
+        LLVector4a* __restrict scaled_normals = vertices.mScaledNormals;
+        LLVector4a* __restrict normals = vertices.mNormals;
+        LLVector4a* __restrict scaled_binormals = vertices.mScaledBinormals;
+        LLVector4a* __restrict binormals = vertices.mBinormals;
+        LLVector4a* __restrict clothing_weights = vertices.mClothingWeights;
+        LLVector2* __restrict tex_coords = vertices.mTexCoords;
+
+        LLVector4a weight;
+        weight.splat(delta_weight);
+        LLVector4a soft_weight;
+        soft_weight.splat(delta_weight * LLPolyMorphBlend::NORMAL_SOFTEN_FACTOR);
+
+        for (U32 i = 0; i < deltas.mNumIndices; ++i)
+        {
+            const U32 v = deltas.mVertexIndices[i];
+
+            F32 mask_weight = 1.f;
+            if (MASKED)
+            {
+                mask_weight = mask_weights[i];
+                weight.splat(delta_weight * mask_weight);
+                soft_weight.splat(delta_weight * mask_weight * LLPolyMorphBlend::NORMAL_SOFTEN_FACTOR);
+            }
+
+            if (POSITIONS)
+            {
+                LLVector4a pos;
+                pos.setMul(deltas.mCoords[i], weight);
+                coords[v].add(pos);
+
+                if (CLOTHING)
+                {
+                    clothing_weights[v].add(pos);
+                    clothing_weights[v].getF32ptr()[VW] = mask_weight;
+                }
+            }
+
+            // calculate new normals based on half angles
+            LLVector4a norm;
+            norm.setMul(deltas.mNormals[i], soft_weight);
+            scaled_normals[v].add(norm);
+            norm = scaled_normals[v];
+            norm.normalize3fast();
+            normals[v] = norm;
+
+            // calculate new binormals
+            LLVector4a binorm;
+            binorm.setMul(deltas.mBinormals[i], soft_weight);
+            scaled_binormals[v].add(binorm);
+            LLVector4a tangent;
+            tangent.setCross3(scaled_binormals[v], norm);
+            binormals[v].setCross3(norm, tangent);
+            binormals[v].normalize3fast();
+
+            if (POSITIONS)
+            {
+                tex_coords[v] += deltas.mTexCoords[i] * delta_weight * mask_weight;
+            }
+        }
+    }
+
+    bool is_degenerate(const LLVector4a& binormal)
+    {
+        return !binormal.isFinite3() || binormal.dot3(binormal).getF32() <= F_APPROXIMATELY_ZERO;
+    }
+}
+
+void LLPolyMorphBlend::blend(const LLPolyMorphDeltas& deltas, const LLPolyMorphVertices& vertices,
+                             F32 delta_weight, const F32* mask_weights)
+{
+    if (mask_weights)
+    {
+        if (vertices.mClothingWeights)
+        {
+            blend_vertices<true, true, true>(deltas, vertices, delta_weight, mask_weights);
+        }
+        else
+        {
+            blend_vertices<true, false, true>(deltas, vertices, delta_weight, mask_weights);
+        }
+    }
+    else if (vertices.mClothingWeights)
+    {
+        blend_vertices<false, true, true>(deltas, vertices, delta_weight, NULL);
+    }
+    else
+    {
+        blend_vertices<false, false, true>(deltas, vertices, delta_weight, NULL);
+    }
+}
+
+void LLPolyMorphBlend::blendNormals(const LLPolyMorphDeltas& deltas, const LLPolyMorphVertices& vertices,
+                                    F32 delta_weight, const F32* mask_weights)
+{
+    if (mask_weights)
+    {
+        blend_vertices<true, false, false>(deltas, vertices, delta_weight, mask_weights);
+    }
+    else
+    {
+        blend_vertices<false, false, false>(deltas, vertices, delta_weight, NULL);
+    }
+}
+
+U32 LLPolyMorphBlend::sanitizeBinormals(LLVector4a* binormals, U32 count)
+{
+    U32 replaced = 0;
+    for (U32 i = 0; i < count; ++i)
+    {
+        if (is_degenerate(binormals[i]))
+        {
+            binormals[i].set(1, 0, 0, 1);
+            ++replaced;
+        }
+    }
+    return replaced;
+}
+
+bool LLPolyMorphBlend::hasDegenerateBinormals(const LLVector4a* binormals, U32 count)
+{
+    for (U32 i = 0; i < count; ++i)
+    {
+        if (is_degenerate(binormals[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+LLPolyMorphCache::Vertices::Vertices(size_t bytes)
+    : mData((F32*)ll_aligned_malloc_16(bytes)),
+      mBytes(bytes)
+{
+}
+
+LLPolyMorphCache::Vertices::Vertices(const F32* data, size_t bytes)
+    : mData((F32*)ll_aligned_malloc_16(bytes)),
+      mBytes(bytes)
+{
+    LLVector4a::memcpyNonAliased16(mData, data, bytes);
+}
+
+LLPolyMorphCache::Vertices::~Vertices()
+{
+    ll_aligned_free_16(mData);
+}
+
+size_t LLPolyMorphCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<const void*>()(key.mMesh);
+    for (const Target& target : key.mTargets)
+    {
+        boost::hash_combine(hash, target.mID);
+        boost::hash_combine(hash, target.mWeight);
+        boost::hash_combine(hash, target.mMaskHash);
+    }
+    return hash;
+}
+
+LLPolyMorphCache::LLPolyMorphCache(size_t max_bytes)
+    : mMaxBytes(max_bytes),
+      mBytes(0),
+      mHits(0),
+      mMisses(0)
+{
+}
+
+LLPolyMorphCache::vertices_ptr_t LLPolyMorphCache::get(const Key& key)
+{
+    auto it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        ++mMisses;
+        return NULL;
+    }
+    ++mHits;
+
+    Entry& entry = it->second;
+    mLRU.splice(mLRU.begin(), mLRU, entry.mLRU);
+    return entry.mVertices;
+}
+
+void LLPolyMorphCache::put(const Key& key, const F32* data, size_t bytes)
+{
+    if (mMaxBytes)
+    {
+        put(key, new Vertices(data, bytes));
+    }
+}
+
+void LLPolyMorphCache::put(const Key& key, const vertices_ptr_t& vertices)
+{
+    if (!mMaxBytes)
+    {
+        return;
+    }
+    const size_t bytes = vertices->getBytes();
+
+    auto it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        mBytes -= it->second.mBytes;
+        mLRU.erase(it->second.mLRU);
+        mEntries.erase(it);
+    }
+
+    Entry entry;
+    entry.mVertices = vertices;
+    entry.mBytes = bytes + key.mTargets.size() * sizeof(Target) * 2 + ENTRY_OVERHEAD_BYTES;
+
+    mLRU.push_front(key);
+    entry.mLRU = mLRU.begin();
+    mBytes += entry.mBytes;
+    mEntries.emplace(key, std::move(entry));
+    evict();
+}
+
+void LLPolyMorphCache::setMaxBytes(size_t max_bytes)
+{
+    mMaxBytes = max_bytes;
+    evict();
+}
+
+void LLPolyMorphCache::clear()
+{
+    mEntries.clear();
+    mLRU.clear();
+    mBytes = 0;
+}
+
+void LLPolyMorphCache::evict()
+{
+    while (mBytes > mMaxBytes && !mLRU.empty())
+    {
+        auto it = mEntries.find(mLRU.back());
+        mBytes -= it->second.mBytes;
+        mEntries.erase(it);
+        mLRU.pop_back();
+    }
+}
@@ -0,0 +1,197 @@
+/**
+ * @file llpolymorphblend.h
+ * @brief Morph target blending kernel and the shared cache of morphed meshes.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPOLYMORPHBLEND_H
+#define LL_LLPOLYMORPHBLEND_H
+
+#include "llpointer.h"
+#include "llrefcount.h"
+#include "llvector4a.h"
+#include "v2math.h"
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// The vertex arrays of an LLPolyMesh that morph targets write to
+struct LLPolyMorphVertices
+{
+    LLVector4a* mCoords;
+    LLVector4a* mScaledNormals;
+    LLVector4a* mNormals;
+    LLVector4a* mScaledBinormals;
+    LLVector4a* mBinormals;
+    LLVector4a* mClothingWeights;   // NULL if the morph must not touch them
+    LLVector2*  mTexCoords;
+};
+
+// The per vertex deltas of one morph target, as in LLPolyMorphData
+struct LLPolyMorphDeltas
+{
+    U32                 mNumIndices;
+    const U32*          mVertexIndices;
+    const LLVector4a*   mCoords;
+    const LLVector4a*   mNormals;
+    const LLVector4a*   mBinormals;     // see sanitizeBinormals()
+    const LLVector2*    mTexCoords;
+};
+
+namespace LLPolyMorphBlend
+{
+    // How much of a morph's normal and binormal deltas is applied
+    constexpr F32 NORMAL_SOFTEN_FACTOR = 0.65f;
+
+    // Adds delta_weight times the deltas to the vertices and renormalizes the
+    // normals and binormals of the vertices touched. mask_weights, if not
+    // NULL, scales each morph vertex further. This is the loop of
+    // LLPolyMorphTarget::apply() with the per vertex branches taken out: the
+    // binormals must have been through sanitizeBinormals().
+    void blend(const LLPolyMorphDeltas& deltas, const LLPolyMorphVertices& vertices,
+               F32 delta_weight, const F32* mask_weights);
+
+    // The normal and binormal half of blend(): leaves the coords, clothing
+    // weights and texture coords alone, and gives the normals and binormals
+    // blend() would have, bit for bit.
+    void blendNormals(const LLPolyMorphDeltas& deltas, const LLPolyMorphVertices& vertices,
+                      F32 delta_weight, const F32* mask_weights);
+
+    // Replaces the binormals blend() would otherwise turn into NaNs, the
+    // non-finite and zero length ones, by (1, 0, 0, 1), as apply() always
+    // did for each vertex on the fly. Returns the number replaced.
+    U32 sanitizeBinormals(LLVector4a* binormals, U32 count);
+    bool hasDegenerateBinormals(const LLVector4a* binormals, U32 count);
+}
+
+//-----------------------------------------------------------------------------
+// class LLPolyMorphCache
+//
+// Avatars wearing the same shape end up with the same morphed system meshes,
+// yet each one used to run every morph target over its own copy. The cache
+// keeps the coords, clothing weights and texture coords of fully morphed
+// meshes, keyed by the mesh and the state of every morph target applied to it
+// so far, so that the next avatar reaching that state copies them instead.
+// Normals and binormals are not cached: they are renormalized after every
+// morph, so they depend on the order the morphs were applied in, and each
+// mesh recomputes its own with LLPolyMorphBlend::blendNormals(). Entries are
+// reference counted, and the least recently used are dropped once the cache
+// holds more than getMaxBytes().
+//
+// Main thread only, like the morphs themselves.
+//-----------------------------------------------------------------------------
+class LLPolyMorphCache
+{
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+
+    // A morph target that has touched the mesh, with the weight it is
+    // applied at and the hash of its vertex mask, 0 if none
+    struct Target
+    {
+        S32 mID;
+        F32 mWeight;
+        U64 mMaskHash;
+
+        bool operator==(const Target& rhs) const
+        {
+            return mID == rhs.mID && mWeight == rhs.mWeight && mMaskHash == rhs.mMaskHash;
+        }
+    };
+
+    struct Key
+    {
+        const void* mMesh;              // the shared mesh data
+        std::vector<Target> mTargets;   // sorted by id
+
+        bool operator==(const Key& rhs) const
+        {
+            return mMesh == rhs.mMesh && mTargets == rhs.mTargets;
+        }
+    };
+
+    // A copy of (part of) a mesh's vertex data block
+    class Vertices : public LLRefCount
+    {
+    public:
+        Vertices(size_t bytes);
+        Vertices(const F32* data, size_t bytes);
+
+        F32* getData()              { return mData; }
+        const F32* getData() const  { return mData; }
+        size_t getBytes() const     { return mBytes; }
+
+    protected:
+        ~Vertices();
+
+    private:
+        F32* mData;
+        size_t mBytes;
+    };
+    typedef LLPointer<Vertices> vertices_ptr_t;
+
+    LLPolyMorphCache(size_t max_bytes = DEFAULT_MAX_BYTES);
+
+    // The vertex data stored for key, or NULL
+    vertices_ptr_t get(const Key& key);
+
+    // Remember a copy of data for key, replacing any previous entry
+    void put(const Key& key, const F32* data, size_t bytes);
+    void put(const Key& key, const vertices_ptr_t& vertices);
+
+    // Evicts least recently used entries until the cache fits; 0 disables
+    // the cache
+    void setMaxBytes(size_t max_bytes);
+    void clear();
+
+    size_t getMaxBytes() const      { return mMaxBytes; }
+    size_t getBytes() const         { return mBytes; }
+    size_t getNumEntries() const    { return mEntries.size(); }
+    U64 getHits() const             { return mHits; }
+    U64 getMisses() const           { return mMisses; }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        vertices_ptr_t mVertices;
+        size_t mBytes;
+        std::list<Key>::iterator mLRU;
+    };
+
+    void evict();
+
+    std::unordered_map<Key, Entry, KeyHash> mEntries;
+    std::list<Key> mLRU;                // most recently used first
+    size_t mMaxBytes;
+    size_t mBytes;
+    U64 mHits;
+    U64 mMisses;
+};
+
+#endif // LL_LLPOLYMORPHBLEND_H
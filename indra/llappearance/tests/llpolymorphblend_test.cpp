@@ -0,0 +1,564 @@
+/**
+ * @file llpolymorphblend_test.cpp
+ * @brief LLPolyMorphBlend and LLPolyMorphCache test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+
+#include "llmath.h"
+#include "../llpolymorphblend.h"
+
+#include <memory>
+#include <random>
+
+namespace tut
+{
+    // A morph target as LLPolyMorphData loads it
+    struct Morph
+    {
+        std::vector<U32> mIndices;
+        std::vector<LLVector4a> mCoords;
+        std::vector<LLVector4a> mNormals;
+        std::vector<LLVector4a> mBinormals;
+        std::vector<LLVector4a> mBlendBinormals;
+        std::vector<LLVector2> mTexCoords;
+        std::vector<F32> mMask;
+        bool mClothing = false;
+
+        LLPolyMorphDeltas deltas() const
+        {
+            LLPolyMorphDeltas deltas;
+            deltas.mNumIndices = (U32)mIndices.size();
+            deltas.mVertexIndices = mIndices.data();
+            deltas.mCoords = mCoords.data();
+            deltas.mNormals = mNormals.data();
+            deltas.mBinormals = mBlendBinormals.data();
+            deltas.mTexCoords = mTexCoords.data();
+            return deltas;
+        }
+    };
+
+    // The vertex block of an LLPolyMesh, laid out the same way
+    struct Mesh
+    {
+        U32 mNumVertices;
+        size_t mBytes;
+        F32* mData;
+        LLPolyMorphVertices mVertices;
+        std::vector<LLPolyMorphCache::Target> mState;
+
+        Mesh(U32 num_vertices)
+            : mNumVertices(num_vertices)
+        {
+            U32 nverts = num_vertices + num_vertices % 2;
+            mBytes = nverts * (4 + 4 + 4 + 2 + 4 + 4 + 4) * sizeof(F32);
+            mData = (F32*)ll_aligned_malloc_16(mBytes);
+            memset(mData, 0, mBytes);
+            size_t offset = 0;
+            mVertices.mCoords = (LLVector4a*)(mData + offset); offset += 4 * nverts;
+            mVertices.mNormals = (LLVector4a*)(mData + offset); offset += 4 * nverts;
+            mVertices.mClothingWeights = (LLVector4a*)(mData + offset); offset += 4 * nverts;
+            mVertices.mTexCoords = (LLVector2*)(mData + offset); offset += 2 * nverts;
+            mVertices.mScaledNormals = (LLVector4a*)(mData + offset); offset += 4 * nverts;
+            mVertices.mBinormals = (LLVector4a*)(mData + offset); offset += 4 * nverts;
+            mVertices.mScaledBinormals = (LLVector4a*)(mData + offset);
+        }
+
+        ~Mesh()
+        {
+            ll_aligned_free_16(mData);
+        }
+
+        void copyFrom(const Mesh& other)
+        {
+            memcpy(mData, other.mData, mBytes);
+            mState = other.mState;
+        }
+
+        // LLPolyMesh::getCachedMorphBytes() and friends: the coords, the
+        // clothing weights and the texture coords
+        size_t cachedBytes() const
+        {
+            U32 nverts = mNumVertices + mNumVertices % 2;
+            return nverts * (4 + 4 + 2) * sizeof(F32);
+        }
+
+        void copyToCache(F32* data) const
+        {
+            U32 nverts = mNumVertices + mNumVertices % 2;
+            memcpy(data, mVertices.mCoords, nverts * sizeof(LLVector4a));
+            memcpy(data + 4 * nverts, mVertices.mClothingWeights, nverts * sizeof(LLVector4a));
+            memcpy(data + 8 * nverts, mVertices.mTexCoords, nverts * sizeof(LLVector2));
+        }
+
+        void copyFromCache(const F32* data)
+        {
+            U32 nverts = mNumVertices + mNumVertices % 2;
+            memcpy(mVertices.mCoords, data, nverts * sizeof(LLVector4a));
+            memcpy(mVertices.mClothingWeights, data + 4 * nverts, nverts * sizeof(LLVector4a));
+            memcpy(mVertices.mTexCoords, data + 8 * nverts, nverts * sizeof(LLVector2));
+        }
+
+        LLPolyMorphVertices verticesFor(const Morph& morph) const
+        {
+            LLPolyMorphVertices vertices = mVertices;
+            if (!morph.mClothing)
+            {
+                vertices.mClothingWeights = NULL;
+            }
+            return vertices;
+        }
+    };
+
+    struct polymorphblend_test
+    {
+        std::mt19937 mRandom{0x3012f};
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        LLVector4a vrand(F32 scale)
+        {
+            LLVector4a v;
+            v.set(frand(-scale, scale), frand(-scale, scale), frand(-scale, scale), 0.f);
+            return v;
+        }
+
+        void initMesh(Mesh& mesh)
+        {
+            std::mt19937 random(0xba5e);
+            for (U32 i = 0; i < mesh.mNumVertices; ++i)
+            {
+                F32 x = (F32)(random() % 1000) / 1000.f - 0.5f;
+                LLVector4a normal;
+                normal.set(x, 1.f, 0.25f, 0.f);
+                normal.normalize3fast();
+                mesh.mVertices.mCoords[i].set(x, (F32)i / mesh.mNumVertices, 0.1f, 1.f);
+                mesh.mVertices.mNormals[i] = normal;
+                mesh.mVertices.mScaledNormals[i] = normal;
+                mesh.mVertices.mBinormals[i] = normal;
+                mesh.mVertices.mScaledBinormals[i] = normal;
+                mesh.mVertices.mClothingWeights[i].clear();
+                mesh.mVertices.mTexCoords[i].set(x, 0.5f);
+            }
+        }
+
+        Morph makeMorph(U32 mesh_vertices, U32 num_indices, bool degenerate)
+        {
+            Morph morph;
+            U32 v = mRandom() % (mesh_vertices - num_indices);
+            for (U32 i = 0; i < num_indices; ++i)
+            {
+                morph.mIndices.push_back(v);
+                v += 1 + (mRandom() % 4 == 0 ? 1 : 0);
+                if (v >= mesh_vertices)
+                {
+                    break;
+                }
+            }
+            for (size_t i = 0; i < morph.mIndices.size(); ++i)
+            {
+                morph.mCoords.push_back(vrand(0.05f));
+                morph.mNormals.push_back(vrand(0.5f));
+                morph.mBinormals.push_back(vrand(0.5f));
+                morph.mTexCoords.push_back(LLVector2(frand(-0.01f, 0.01f), frand(-0.01f, 0.01f)));
+                if (degenerate && i % 7 == 0)
+                {
+                    morph.mBinormals.back().clear();
+                }
+            }
+            morph.mBlendBinormals = morph.mBinormals;
+            LLPolyMorphBlend::sanitizeBinormals(morph.mBlendBinormals.data(), (U32)morph.mBlendBinormals.size());
+            return morph;
+        }
+
+        // The vertex loop of LLPolyMorphTarget::apply() as it was
+        static void applyReference(const Morph& morph, const LLPolyMorphVertices& mesh, F32 delta_weight, bool clothing)
+        {
+            const F32* maskWeightArray = morph.mMask.empty() ? NULL : morph.mMask.data();
+            for (U32 vert_index_morph = 0; vert_index_morph < morph.mIndices.size(); vert_index_morph++)
+            {
+                S32 vert_index_mesh = morph.mIndices[vert_index_morph];
+
+                F32 maskWeight = 1.f;
+                if (maskWeightArray)
+                {
+                    maskWeight = maskWeightArray[vert_index_morph];
+                }
+
+                LLVector4a pos = morph.mCoords[vert_index_morph];
+                pos.mul(delta_weight*maskWeight);
+                mesh.mCoords[vert_index_mesh].add(pos);
+
+                if (clothing)
+                {
+                    LLVector4a clothing_offset = morph.mCoords[vert_index_morph];
+                    clothing_offset.mul(delta_weight * maskWeight);
+                    LLVector4a* clothing_weight = &mesh.mClothingWeights[vert_index_mesh];
+                    clothing_weight->add(clothing_offset);
+                    clothing_weight->getF32ptr()[VW] = maskWeight;
+                }
+
+                LLVector4a norm = morph.mNormals[vert_index_morph];
+                norm.mul(delta_weight*maskWeight*LLPolyMorphBlend::NORMAL_SOFTEN_FACTOR);
+                mesh.mScaledNormals[vert_index_mesh].add(norm);
+                norm = mesh.mScaledNormals[vert_index_mesh];
+                norm.normalize3fast();
+                mesh.mNormals[vert_index_mesh] = norm;
+
+                LLVector4a binorm = morph.mBinormals[vert_index_morph];
+                if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+                {
+                    binorm.set(1,0,0,1);
+                }
+
+                binorm.mul(delta_weight*maskWeight*LLPolyMorphBlend::NORMAL_SOFTEN_FACTOR);
+                mesh.mScaledBinormals[vert_index_mesh].add(binorm);
+                LLVector4a tangent;
+                tangent.setCross3(mesh.mScaledBinormals[vert_index_mesh], norm);
+                LLVector4a& normalized_binormal = mesh.mBinormals[vert_index_mesh];
+
+                normalized_binormal.setCross3(norm, tangent);
+                normalized_binormal.normalize3fast();
+
+                mesh.mTexCoords[vert_index_mesh] += morph.mTexCoords[vert_index_morph] * delta_weight * maskWeight;
+            }
+        }
+
+        // LLPolyMesh::noteMorph()
+        static void noteMorph(Mesh& mesh, S32 id, F32 weight)
+        {
+            auto it = std::lower_bound(mesh.mState.begin(), mesh.mState.end(), id,
+                                       [](const LLPolyMorphCache::Target& target, S32 id) { return target.mID < id; });
+            if (it == mesh.mState.end() || it->mID != id)
+            {
+                it = mesh.mState.insert(it, LLPolyMorphCache::Target());
+                it->mID = id;
+            }
+            it->mWeight = weight;
+            it->mMaskHash = 0;
+        }
+
+        static bool sameVertices(const Mesh& a, const Mesh& b, F32 tolerance)
+        {
+            for (size_t i = 0; i < a.mBytes / sizeof(F32); ++i)
+            {
+                if (fabsf(a.mData[i] - b.mData[i]) > tolerance)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+    typedef test_group<polymorphblend_test> polymorphblend_test_t;
+    typedef polymorphblend_test_t::object polymorphblend_test_object_t;
+    tut::polymorphblend_test_t tut_polymorphblend_test("LLPolyMorphBlend");
+
+    template<> template<>
+    void polymorphblend_test_object_t::test<1>()
+    {
+        set_test_name("blend matches the apply() loop");
+
+        const U32 VERTICES = 1000;
+        Mesh reference(VERTICES);
+        Mesh blended(VERTICES);
+        initMesh(reference);
+        initMesh(blended);
+
+        std::vector<Morph> morphs;
+        for (U32 i = 0; i < 12; ++i)
+        {
+            morphs.push_back(makeMorph(VERTICES, 50 + mRandom() % 300, i % 3 == 0));
+            morphs.back().mClothing = (i % 4 == 1);
+            if (i % 5 == 1)
+            {
+                for (size_t k = 0; k < morphs.back().mIndices.size(); ++k)
+                {
+                    morphs.back().mMask.push_back(frand(0.f, 1.f));
+                }
+            }
+        }
+        ensure("degenerate binormals found", LLPolyMorphBlend::hasDegenerateBinormals(morphs[0].mBinormals.data(), (U32)morphs[0].mBinormals.size()));
+        ensure("sanitized", !LLPolyMorphBlend::hasDegenerateBinormals(morphs[0].mBlendBinormals.data(), (U32)morphs[0].mBlendBinormals.size()));
+
+        for (U32 round = 0; round < 3; ++round)
+        {
+            for (const Morph& morph : morphs)
+            {
+                const F32 delta = frand(-1.f, 1.f);
+                applyReference(morph, reference.mVertices, delta, morph.mClothing);
+                LLPolyMorphBlend::blend(morph.deltas(), blended.verticesFor(morph), delta,
+                                        morph.mMask.empty() ? NULL : morph.mMask.data());
+            }
+        }
+        ensure("same vertices", sameVertices(reference, blended, 0.f));
+    }
+
+    template<> template<>
+    void polymorphblend_test_object_t::test<2>()
+    {
+        set_test_name("cache entries and eviction");
+
+        const U32 VERTICES = 100;
+        Mesh mesh(VERTICES);
+        initMesh(mesh);
+
+        LLPolyMorphCache cache;
+        LLPolyMorphCache::Key key;
+        key.mMesh = &mesh;
+        key.mTargets.push_back({ 1, 0.5f, 0 });
+        ensure("empty", cache.get(key).isNull());
+        ensure_equals("miss", cache.getMisses(), (U64)1);
+
+        cache.put(key, mesh.mData, mesh.mBytes);
+        LLPolyMorphCache::vertices_ptr_t vertices = cache.get(key);
+        ensure("hit", vertices.notNull());
+        ensure_equals("hits", cache.getHits(), (U64)1);
+        ensure_equals("size", vertices->getBytes(), mesh.mBytes);
+        ensure("copied", memcmp(vertices->getData(), mesh.mData, mesh.mBytes) == 0);
+        ensure("accounted", cache.getBytes() > mesh.mBytes);
+
+        LLPolyMorphCache::Key other = key;
+        other.mTargets[0].mWeight = 0.25f;
+        ensure("weight is part of the key", cache.get(other).isNull());
+        other = key;
+        other.mTargets[0].mMaskHash = 7;
+        ensure("mask is part of the key", cache.get(other).isNull());
+        other = key;
+        other.mTargets.push_back({ 2, 0.f, 0 });
+        ensure("targets at 0 are part of the key", cache.get(other).isNull());
+
+        // room for two entries
+        cache.setMaxBytes(cache.getBytes() * 2 + cache.getBytes() / 2);
+        cache.put(other, mesh.mData, mesh.mBytes);
+        ensure("key still there", cache.get(key).notNull());
+        LLPolyMorphCache::Key third = key;
+        third.mTargets[0].mID = 3;
+        cache.put(third, mesh.mData, mesh.mBytes);
+        ensure_equals("entries", cache.getNumEntries(), (size_t)2);
+        ensure("least recently used dropped", cache.get(other).isNull());
+        ensure("recently used kept", cache.get(key).notNull());
+
+        // an entry handed out outlives its eviction
+        cache.setMaxBytes(0);
+        ensure_equals("disabled", cache.getNumEntries(), (size_t)0);
+        ensure("still readable", memcmp(vertices->getData(), mesh.mData, mesh.mBytes) == 0);
+        cache.put(key, mesh.mData, mesh.mBytes);
+        ensure_equals("nothing stored when disabled", cache.getNumEntries(), (size_t)0);
+    }
+
+    template<> template<>
+    void polymorphblend_test_object_t::test<3>()
+    {
+        set_test_name("morph many avatars");
+
+        // An upper body sized mesh with its morph targets, and avatars
+        // arriving with one of a handful of shapes: the system defaults, or
+        // one of the shapes a crowd tends to share
+        const U32 VERTICES = 3000;
+        const U32 MORPHS = 120;
+        const U32 SHAPES = 8;
+        const U32 AVATARS = 100;
+
+        std::vector<Morph> morphs;
+        for (U32 i = 0; i < MORPHS; ++i)
+        {
+            morphs.push_back(makeMorph(VERTICES, 100 + mRandom() % 700, i % 10 == 0));
+            morphs.back().mClothing = (i % 8 == 0);
+        }
+
+        std::vector<std::vector<F32> > shapes(SHAPES);
+        for (std::vector<F32>& weights : shapes)
+        {
+            for (U32 i = 0; i < MORPHS; ++i)
+            {
+                weights.push_back(mRandom() % 3 ? frand(-1.f, 1.f) : 0.f);
+            }
+        }
+        std::vector<U32> avatar_shapes;
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            avatar_shapes.push_back(mRandom() % SHAPES);
+        }
+
+        // the meshes are set up when the avatars are made
+        Mesh base(VERTICES);
+        initMesh(base);
+        std::vector<std::unique_ptr<Mesh> > reference;
+        std::vector<std::unique_ptr<Mesh> > blended;
+        std::vector<std::unique_ptr<Mesh> > cached;
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            for (auto* meshes : { &reference, &blended, &cached })
+            {
+                meshes->emplace_back(new Mesh(VERTICES));
+                meshes->back()->copyFrom(base);
+            }
+        }
+
+        // the loop as it was
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            Mesh& mesh = *reference[a];
+            const std::vector<F32>& weights = shapes[avatar_shapes[a]];
+            for (U32 i = 0; i < MORPHS; ++i)
+            {
+                if (weights[i] != 0.f)
+                {
+                    applyReference(morphs[i], mesh.mVertices, weights[i], morphs[i].mClothing);
+                }
+            }
+        }
+
+        // the kernel alone
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            Mesh& mesh = *blended[a];
+            const std::vector<F32>& weights = shapes[avatar_shapes[a]];
+            for (U32 i = 0; i < MORPHS; ++i)
+            {
+                if (weights[i] != 0.f)
+                {
+                    LLPolyMorphBlend::blend(morphs[i].deltas(), mesh.verticesFor(morphs[i]), weights[i], NULL);
+                }
+            }
+        }
+
+        // the kernel behind the cache, as LLPolyMesh::applyPendingMorphs()
+        LLPolyMorphCache cache;
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            Mesh& mesh = *cached[a];
+            const std::vector<F32>& weights = shapes[avatar_shapes[a]];
+            for (U32 i = 0; i < MORPHS; ++i)
+            {
+                if (weights[i] != 0.f)
+                {
+                    noteMorph(mesh, i, weights[i]);
+                }
+            }
+            LLPolyMorphCache::Key key;
+            key.mMesh = &base;
+            key.mTargets = mesh.mState;
+            LLPolyMorphCache::vertices_ptr_t vertices = cache.get(key);
+            if (vertices.notNull())
+            {
+                mesh.copyFromCache(vertices->getData());
+                for (U32 i = 0; i < MORPHS; ++i)
+                {
+                    if (weights[i] != 0.f)
+                    {
+                        LLPolyMorphBlend::blendNormals(morphs[i].deltas(), mesh.verticesFor(morphs[i]), weights[i], NULL);
+                    }
+                }
+                continue;
+            }
+            for (U32 i = 0; i < MORPHS; ++i)
+            {
+                if (weights[i] != 0.f)
+                {
+                    LLPolyMorphBlend::blend(morphs[i].deltas(), mesh.verticesFor(morphs[i]), weights[i], NULL);
+                }
+            }
+            vertices = new LLPolyMorphCache::Vertices(mesh.cachedBytes());
+            mesh.copyToCache(vertices->getData());
+            cache.put(key, vertices);
+        }
+
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            ensure("kernel result", sameVertices(*reference[a], *blended[a], 0.f));
+            ensure("cached result", sameVertices(*reference[a], *cached[a], 0.f));
+        }
+        ensure_equals("misses", cache.getMisses(), (U64)SHAPES);
+        ensure_equals("hits", cache.getHits(), (U64)(AVATARS - SHAPES));
+    }
+
+    template<> template<>
+    void polymorphblend_test_object_t::test<4>()
+    {
+        set_test_name("cached coords, own normals");
+
+        const U32 VERTICES = 500;
+        std::vector<Morph> morphs;
+        std::vector<F32> weights;
+        for (U32 i = 0; i < 10; ++i)
+        {
+            // overlapping morphs, so that the order shows in the normals
+            morphs.push_back(makeMorph(VERTICES, 200 + mRandom() % 200, i % 4 == 0));
+            morphs.back().mClothing = (i % 3 == 0);
+            if (i % 5 == 2)
+            {
+                for (size_t k = 0; k < morphs.back().mIndices.size(); ++k)
+                {
+                    morphs.back().mMask.push_back(frand(0.f, 1.f));
+                }
+            }
+            weights.push_back(frand(-1.f, 1.f));
+        }
+
+        // one avatar fills the cache applying the morphs in one order...
+        Mesh filler(VERTICES);
+        initMesh(filler);
+        for (size_t i = 0; i < morphs.size(); ++i)
+        {
+            LLPolyMorphBlend::blend(morphs[i].deltas(), filler.verticesFor(morphs[i]), weights[i],
+                                    morphs[i].mMask.empty() ? NULL : morphs[i].mMask.data());
+        }
+        LLPolyMorphCache::vertices_ptr_t vertices = new LLPolyMorphCache::Vertices(filler.cachedBytes());
+        filler.copyToCache(vertices->getData());
+
+        // ...and another reaches the same weights in the opposite order
+        Mesh fresh(VERTICES);
+        Mesh cached(VERTICES);
+        initMesh(fresh);
+        initMesh(cached);
+        cached.copyFromCache(vertices->getData());
+        for (size_t i = morphs.size(); i-- > 0; )
+        {
+            const F32* mask = morphs[i].mMask.empty() ? NULL : morphs[i].mMask.data();
+            LLPolyMorphBlend::blend(morphs[i].deltas(), fresh.verticesFor(morphs[i]), weights[i], mask);
+            LLPolyMorphBlend::blendNormals(morphs[i].deltas(), cached.verticesFor(morphs[i]), weights[i], mask);
+        }
+
+        const size_t vector_bytes = VERTICES * sizeof(LLVector4a);
+        ensure("coords from the cache",
+               memcmp(cached.mVertices.mCoords, filler.mVertices.mCoords, vector_bytes) == 0);
+        ensure("texture coords from the cache",
+               memcmp(cached.mVertices.mTexCoords, filler.mVertices.mTexCoords, VERTICES * sizeof(LLVector2)) == 0);
+        ensure("normals as computed fresh",
+               memcmp(cached.mVertices.mNormals, fresh.mVertices.mNormals, vector_bytes) == 0);
+        ensure("scaled normals as computed fresh",
+               memcmp(cached.mVertices.mScaledNormals, fresh.mVertices.mScaledNormals, vector_bytes) == 0);
+        ensure("binormals as computed fresh",
+               memcmp(cached.mVertices.mBinormals, fresh.mVertices.mBinormals, vector_bytes) == 0);
+        ensure("scaled binormals as computed fresh",
+               memcmp(cached.mVertices.mScaledBinormals, fresh.mVertices.mScaledBinormals, vector_bytes) == 0);
+        ensure("coords the same but for rounding", sameVertices(cached, fresh, 1.e-5f));
+    }
+}
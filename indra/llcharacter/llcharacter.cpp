@@ -33,6 +33,8 @@
 #include "llcharacter.h"
 #include "llstring.h"
 #include "llfasttimer.h"
+#include "llcriticaldamp.h" // <FS/> Parallel animation evaluation
+#include "llparallelfor.h" // <FS/> Parallel animation evaluation
 
 #define SKEL_HEADER "Linden Skeleton 1.0"
 
@@ -50,7 +52,9 @@ LLCharacter::LLCharacter()
     mPreferredPelvisHeight( 0.f ),
     mSex( SEX_FEMALE ),
     mAppearanceSerialNum( 0 ),
-    mSkeletonSerialNum( 0 )
+    mSkeletonSerialNum( 0 ),
+    mUpdatingMotions( false ), // <FS/> Parallel animation evaluation
+    mVisualParamUpdateDeferred( false ) // <FS/> Parallel animation evaluation
 {
     llassert_always(sAllowInstancesChange) ;
 
@@ -192,6 +196,121 @@ void LLCharacter::updateMotions(e_update_t update_type)
 }
 
 
+// <FS> Parallel animation evaluation
+//-----------------------------------------------------------------------------
+// canUpdateMotionsConcurrently()
+//-----------------------------------------------------------------------------
+bool LLCharacter::canUpdateMotionsConcurrently(e_update_t update_type)
+{
+    // hidden updates are cheap enough as they are
+    return update_type != HIDDEN_UPDATE && mMotionController.canEvaluateConcurrently();
+}
+
+//-----------------------------------------------------------------------------
+// beginUpdateMotions()
+//-----------------------------------------------------------------------------
+void LLCharacter::beginUpdateMotions(e_update_t update_type)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    llassert(update_type != HIDDEN_UPDATE && !mUpdatingMotions);
+
+    // unpause if the number of outstanding pause requests has dropped to the initial one
+    if (mMotionController.isPaused() && mPauseRequest->getNumRefs() == 1)
+    {
+        mMotionController.unpauseAllMotions();
+    }
+    mMotionController.prepareMotions(update_type == FORCE_UPDATE);
+    mUpdatingMotions = true;
+}
+
+//-----------------------------------------------------------------------------
+// finishUpdateMotions()
+//-----------------------------------------------------------------------------
+void LLCharacter::finishUpdateMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    llassert(mUpdatingMotions);
+
+    // deactivated motions may still ask for a visual param update
+    mMotionController.applyMotions();
+    for (const DeferredWeight& deferred : mDeferredWeights)
+    {
+        deferred.mParam->setWeight(deferred.mWeight, deferred.mUploadBake);
+    }
+    mDeferredWeights.clear();
+    mUpdatingMotions = false;
+
+    if (mVisualParamUpdateDeferred)
+    {
+        mVisualParamUpdateDeferred = false;
+        updateVisualParams();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// evaluateMotionsConcurrently()
+//-----------------------------------------------------------------------------
+// static
+void LLCharacter::evaluateMotionsConcurrently(const std::vector<LLCharacter*>& characters,
+                                              const std::string& queue_name, size_t max_helpers)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    // motions share the interpolant cache
+    LLSmoothInterpolation::setCacheFrozen(true);
+    LL::parallel_for(queue_name, characters.size(),
+                     [&characters](size_t i)
+                     {
+                         characters[i]->evaluateMotions();
+                     },
+                     max_helpers);
+    LLSmoothInterpolation::setCacheFrozen(false);
+}
+
+//-----------------------------------------------------------------------------
+// deferVisualParamUpdate()
+//-----------------------------------------------------------------------------
+bool LLCharacter::deferVisualParamUpdate()
+{
+    if (!mUpdatingMotions)
+    {
+        return false;
+    }
+    mVisualParamUpdateDeferred = true;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// setParamWeight()
+//-----------------------------------------------------------------------------
+void LLCharacter::setParamWeight(LLVisualParam* param, F32 weight, bool upload_bake)
+{
+    if (mUpdatingMotions)
+    {
+        // only the thread evaluating this character's motions gets here
+        mDeferredWeights.push_back({ param, weight, upload_bake });
+    }
+    else
+    {
+        param->setWeight(weight, upload_bake);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// getParamWeight()
+//-----------------------------------------------------------------------------
+F32 LLCharacter::getParamWeight(const LLVisualParam* param) const
+{
+    for (auto it = mDeferredWeights.rbegin(); it != mDeferredWeights.rend(); ++it)
+    {
+        if (it->mParam == param)
+        {
+            return it->mWeight;
+        }
+    }
+    return param->getWeight();
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // deactivateAllMotions()
 //-----------------------------------------------------------------------------
@@ -271,7 +390,10 @@ bool LLCharacter::setVisualParamWeight(const LLVisualParam* which_param, F32 wei
     {
         // <FS:Ansariel> [Legacy Bake]
         //index_iter->second->setWeight(weight);
-        index_iter->second->setWeight(weight, upload_bake);
+        // <FS> Parallel animation evaluation
+        //index_iter->second->setWeight(weight, upload_bake);
+        setParamWeight(index_iter->second, weight, upload_bake);
+        // </FS>
         return true;
     }
     return false;
@@ -292,7 +414,10 @@ bool LLCharacter::setVisualParamWeight(const char* param_name, F32 weight, bool
     {
         // <FS:Ansariel> [Legacy Bake]
         //name_iter->second->setWeight(weight);
-        name_iter->second->setWeight(weight, upload_bake);
+        // <FS> Parallel animation evaluation
+        //name_iter->second->setWeight(weight, upload_bake);
+        setParamWeight(name_iter->second, weight, upload_bake);
+        // </FS>
         return true;
     }
     LL_WARNS() << "LLCharacter::setVisualParamWeight() Invalid visual parameter: " << param_name << LL_ENDL;
@@ -311,7 +436,10 @@ bool LLCharacter::setVisualParamWeight(S32 index, F32 weight, bool upload_bake)
     {
         // <FS:Ansariel> [Legacy Bake]
         //index_iter->second->setWeight(weight);
-        index_iter->second->setWeight(weight, upload_bake);
+        // <FS> Parallel animation evaluation
+        //index_iter->second->setWeight(weight, upload_bake);
+        setParamWeight(index_iter->second, weight, upload_bake);
+        // </FS>
         return true;
     }
     LL_WARNS() << "LLCharacter::setVisualParamWeight() Invalid visual parameter index: " << index << LL_ENDL;
@@ -327,7 +455,7 @@ F32 LLCharacter::getVisualParamWeight(LLVisualParam *which_param)
     visual_param_index_map_t::iterator index_iter = mVisualParamIndexMap.find(index);
     if (index_iter != mVisualParamIndexMap.end())
     {
-        return index_iter->second->getWeight();
+        return getParamWeight(index_iter->second); // <FS/> Parallel animation evaluation
     }
     else
     {
@@ -347,7 +475,7 @@ F32 LLCharacter::getVisualParamWeight(const char* param_name)
     visual_param_name_map_t::iterator name_iter = mVisualParamNameMap.find(tableptr);
     if (name_iter != mVisualParamNameMap.end())
     {
-        return name_iter->second->getWeight();
+        return getParamWeight(name_iter->second); // <FS/> Parallel animation evaluation
     }
     LL_WARNS() << "LLCharacter::getVisualParamWeight() Invalid visual parameter: " << param_name << LL_ENDL;
     return 0.f;
@@ -361,7 +489,7 @@ F32 LLCharacter::getVisualParamWeight(S32 index)
     visual_param_index_map_t::iterator index_iter = mVisualParamIndexMap.find(index);
     if (index_iter != mVisualParamIndexMap.end())
     {
-        return index_iter->second->getWeight();
+        return getParamWeight(index_iter->second); // <FS/> Parallel animation evaluation
     }
     else
     {
@@ -477,6 +605,14 @@ void LLCharacter::addVisualParam(LLVisualParam *param)
 //-----------------------------------------------------------------------------
 void LLCharacter::updateVisualParams()
 {
+    // <FS> Parallel animation evaluation
+    if (deferVisualParamUpdate())
+    {
+        return;
+    }
+    // </FS>
+
+    beginApplyVisualParams(); // <FS/> Shared morphed meshes
     for (LLVisualParam *param = getFirstVisualParam();
         param;
         param = getNextVisualParam())
@@ -492,6 +628,7 @@ void LLCharacter::updateVisualParams()
             param->apply( mSex );
         }
     }
+    finishApplyVisualParams(); // <FS/> Shared morphed meshes
 }
 
 LLAnimPauseRequest LLCharacter::requestPause()
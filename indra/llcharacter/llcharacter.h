@@ -33,6 +33,7 @@
 #include <string>
 
 #include "lljoint.h"
+#include "lljointhierarchy.h" // <FS/> Batched skeleton update
 #include "llmotioncontroller.h"
 #include "llvisualparam.h"
 #include "llstringtable.h"
@@ -117,6 +118,15 @@ public:
     // updates all visual parameters for this character
     virtual void updateVisualParams();
 
+    // <FS> Shared morphed meshes
+    // Called around the visual param loop of updateVisualParams(), so
+    // subclasses can batch the mesh work the params leave behind. Not around
+    // applyAllVisualParams(): the appearance blend changes every param a
+    // little each frame, which is not worth batching.
+    virtual void beginApplyVisualParams() {}
+    virtual void finishApplyVisualParams() {}
+    // </FS>
+
     virtual void addDebugText( const std::string& text ) = 0;
 
     virtual std::string getDebugName() const { return getID().asString(); }
@@ -157,6 +167,26 @@ public:
     enum e_update_t { NORMAL_UPDATE, HIDDEN_UPDATE, FORCE_UPDATE };
     void updateMotions(e_update_t update_type);
 
+    // <FS> Parallel animation evaluation
+    // updateMotions() in three steps, so the motions of many characters can be
+    // evaluated at once. Only if canUpdateMotionsConcurrently(): call
+    // beginUpdateMotions() and finishUpdateMotions() on the main thread and
+    // evaluateMotions() on any thread in between. Visual param weights set
+    // by motions meanwhile are queued and set in order at the end, where
+    // updateVisualParams() calls are folded into one.
+    bool canUpdateMotionsConcurrently(e_update_t update_type);
+    void beginUpdateMotions(e_update_t update_type);
+    void evaluateMotions() { mMotionController.evaluateMotions(); }
+    void finishUpdateMotions();
+    bool isUpdatingMotions() const { return mUpdatingMotions; }
+
+    // evaluateMotions() for every character in the list, spread across the
+    // threads of the named work queue
+    static void evaluateMotionsConcurrently(const std::vector<LLCharacter*>& characters,
+                                            const std::string& queue_name = "General",
+                                            size_t max_helpers = 0);
+    // </FS>
+
     LLAnimPauseRequest requestPause();
     bool areAnimationsPaused() const { return mMotionController.isPaused(); }
     void setAnimTimeFactor(F32 factor) { mMotionController.setTimeFactor(factor); }
@@ -164,6 +194,13 @@ public:
 
     LLMotionController& getMotionController() { return mMotionController; }
 
+    // <FS> Batched skeleton update
+    // Equivalent to getRootJoint()->updateWorldMatrixChildren(), done in one
+    // pass over a flattened copy of the skeleton.
+    void updateJointWorldMatrices() { mJointHierarchy.update(getRootJoint()); }
+    const LLJointHierarchy& getJointHierarchy() const { return mJointHierarchy; }
+    // </FS>
+
     // Releases all motion instances which should result in
     // no cached references to character joint data.  This is
     // useful if a character wants to rebuild it's skeleton.
@@ -302,6 +339,33 @@ protected:
     U32                 mSkeletonSerialNum;
     LLAnimPauseRequest  mPauseRequest;
 
+    LLJointHierarchy    mJointHierarchy; // <FS/> Batched skeleton update
+
+    // <FS> Parallel animation evaluation
+    // For updateVisualParams() overrides: while motions are updating, notes
+    // the request for finishUpdateMotions() and returns true
+    bool deferVisualParamUpdate();
+
+    bool                mUpdatingMotions;
+    bool                mVisualParamUpdateDeferred;
+
+private:
+    // Setting a weight can reach the params a driver param drives and the
+    // appearance state behind them, which belong to the main thread. While
+    // motions are updating, setVisualParamWeight() queues the weight instead,
+    // and getVisualParamWeight() returns the last one queued.
+    struct DeferredWeight
+    {
+        LLVisualParam*  mParam;
+        F32             mWeight;
+        bool            mUploadBake;
+    };
+    void setParamWeight(LLVisualParam* param, F32 weight, bool upload_bake);
+    F32 getParamWeight(const LLVisualParam* param) const;
+
+    std::vector<DeferredWeight> mDeferredWeights;
+    // </FS>
+
 private:
     // visual parameter stuff
     typedef std::map<S32, LLVisualParam *>      visual_param_index_map_t;
@@ -95,6 +95,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_HAND; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // motions must report their priority
     virtual LLJoint::JointPriority getPriority() { return LLJoint::MEDIUM_PRIORITY; }
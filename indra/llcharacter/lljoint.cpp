@@ -34,8 +34,13 @@
 #include "llmath.h"
 #include <boost/algorithm/string.hpp>
 
-S32 LLJoint::sNumUpdates = 0;
-S32 LLJoint::sNumTouches = 0;
+// <FS> Parallel animation evaluation
+//S32 LLJoint::sNumUpdates = 0;
+//S32 LLJoint::sNumTouches = 0;
+thread_local S32 LLJoint::sNumUpdates = 0;
+thread_local S32 LLJoint::sNumTouches = 0;
+// </FS>
+std::atomic<U32> LLJoint::sNextTopologySerial(1); // <FS/> Batched skeleton update
 
 template <class T>
 bool attachment_map_iter_compare_key(const T& a, const T& b)
@@ -110,6 +115,7 @@ void LLJoint::init()
     mUpdateXform = true;
     mSupport = SUPPORT_BASE;
     mEnd = LLVector3(0.0f, 0.0f, 0.0f);
+    mTopologySerial = sNextTopologySerial++; // <FS/> Batched skeleton update
 }
 
 LLJoint::LLJoint() :
@@ -271,6 +277,7 @@ void LLJoint::addChild(LLJoint* joint)
         joint->mParent->removeChild(joint);
 
     mChildren.push_back(joint);
+    topologyChanged(); // <FS/> Batched skeleton update
     joint->mXform.setParent(&mXform);
     joint->mParent = this;
     joint->touch();
@@ -286,6 +293,7 @@ void LLJoint::removeChild(LLJoint* joint)
     if (iter != mChildren.end())
     {
         mChildren.erase(iter);
+        topologyChanged(); // <FS/> Batched skeleton update
 
         joint->mXform.setParent(NULL);
         joint->mParent = NULL;
@@ -310,8 +318,23 @@ void LLJoint::removeAllChildren()
         }
     }
     mChildren.clear();
+    topologyChanged(); // <FS/> Batched skeleton update
 }
 
+// <FS> Batched skeleton update
+//--------------------------------------------------------------------
+// topologyChanged()
+//--------------------------------------------------------------------
+void LLJoint::topologyChanged()
+{
+    const U32 serial = sNextTopologySerial++;
+    for (LLJoint* joint = this; joint; joint = joint->mParent)
+    {
+        joint->mTopologySerial = serial;
+    }
+}
+// </FS>
+
 
 //--------------------------------------------------------------------
 // getPosition()
@@ -991,6 +1014,20 @@ void LLJoint::updateWorldMatrix()
     }
 }
 
+// <FS> Batched skeleton update
+//-----------------------------------------------------------------------------
+// setWorldTransform()
+//-----------------------------------------------------------------------------
+void LLJoint::setWorldTransform(const LLVector4a& pos, const LLVector4a& rot, const LLMatrix4a& mat)
+{
+    sNumUpdates++;
+    const F32* q = rot.getF32ptr();
+    mXform.setWorldTransform(LLVector3(pos.getF32ptr()), LLQuaternion(q[VX], q[VY], q[VZ], q[VW]), mat.asMatrix4());
+    mWorldMatrix = mat;
+    mDirtyFlags = 0x0;
+}
+// </FS>
+
 //--------------------------------------------------------------------
 // getSkinOffset()
 //--------------------------------------------------------------------
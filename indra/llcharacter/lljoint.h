@@ -32,6 +32,7 @@
 //-----------------------------------------------------------------------------
 #include <string>
 #include <list>
+#include <atomic> // <FS/> Batched skeleton update
 
 #include "v3math.h"
 #include "v4math.h"
@@ -149,8 +150,12 @@ public:
     joints_t mChildren;
 
     // debug statics
-    static S32      sNumTouches;
-    static S32      sNumUpdates;
+    // <FS> Parallel animation evaluation: motions may update joints on worker threads
+    //static S32      sNumTouches;
+    //static S32      sNumUpdates;
+    static thread_local S32 sNumTouches;
+    static thread_local S32 sNumUpdates;
+    // </FS>
     typedef std::set<std::string> debug_joint_name_t;
     static debug_joint_name_t s_debugJointNames;
     static void setDebugJointNames(const debug_joint_name_t& names);
@@ -192,6 +197,21 @@ public:
 private:
     void init();
 
+    // <FS> Batched skeleton update
+    friend class LLJointHierarchy;
+    // Store a world transform computed by LLJointHierarchy, as updateWorldMatrix() would.
+    void setWorldTransform(const LLVector4a& pos, const LLVector4a& rot, const LLMatrix4a& mat);
+
+    // Give this joint and all its ancestors a new topology serial.
+    void topologyChanged();
+
+    // Changes whenever a joint in the subtree below gains or loses a child,
+    // so an LLJointHierarchy rooted here knows to rebuild. Values are never
+    // reused, even by a new joint at the address of a deleted one.
+    U32 mTopologySerial;
+    static std::atomic<U32> sNextTopologySerial;
+    // </FS>
+
 public:
     // set name and parent
     void setup( const std::string &name, LLJoint *parent=NULL );
@@ -0,0 +1,265 @@
+/**
+ * @file lljointhierarchy.cpp
+ * @brief Flattened joint hierarchy with batched world transform updates.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lljointhierarchy.h"
+#include "lljoint.h"
+
+namespace
+{
+    enum : U8
+    {
+        JOINT_SKIPPED,  // mUpdateXform is off here or above
+        JOINT_CLEAN,    // world transform already current
+        JOINT_DIRTY     // world transform needs recomputing
+    };
+
+    // Lane selection for _mm_shuffle_ps(a, b, ...): result is <a[x], a[y], b[z], b[w]>
+    #define LL_JH_SHUFFLE(x, y, z, w) _MM_SHUFFLE(w, z, y, x)
+
+    inline LLQuad cross3(LLQuad a, LLQuad b)
+    {
+        // a.yzx * b.zxy - a.zxy * b.yzx
+        LLQuad a_yzx = _mm_shuffle_ps(a, a, LL_JH_SHUFFLE(1, 2, 0, 3));
+        LLQuad b_yzx = _mm_shuffle_ps(b, b, LL_JH_SHUFFLE(1, 2, 0, 3));
+        LLQuad c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+        return _mm_shuffle_ps(c, c, LL_JH_SHUFFLE(1, 2, 0, 3));
+    }
+
+    inline LLQuad splatW(LLQuad a)
+    {
+        return _mm_shuffle_ps(a, a, LL_JH_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Same as LLQuaternion's a * b.
+    inline LLQuad quatMul(LLQuad a, LLQuad b)
+    {
+        const LLQuad flip_w = _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0, 0));
+        const LLQuad flip_all = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+
+        // x = bw*ax + bx*aw + by*az - bz*ay
+        // y = bw*ay + by*aw + bz*ax - bx*az
+        // z = bw*az + bz*aw + bx*ay - by*ax
+        // w = bw*aw - bx*ax - by*ay - bz*az
+        LLQuad t1 = _mm_mul_ps(splatW(b), a);
+        LLQuad t2 = _mm_mul_ps(_mm_shuffle_ps(b, b, LL_JH_SHUFFLE(0, 1, 2, 0)),
+                               _mm_shuffle_ps(a, a, LL_JH_SHUFFLE(3, 3, 3, 0)));
+        LLQuad t3 = _mm_mul_ps(_mm_shuffle_ps(b, b, LL_JH_SHUFFLE(1, 2, 0, 1)),
+                               _mm_shuffle_ps(a, a, LL_JH_SHUFFLE(2, 0, 1, 1)));
+        LLQuad t4 = _mm_mul_ps(_mm_shuffle_ps(b, b, LL_JH_SHUFFLE(2, 0, 1, 2)),
+                               _mm_shuffle_ps(a, a, LL_JH_SHUFFLE(1, 2, 0, 2)));
+        LLQuad sum = _mm_add_ps(_mm_xor_ps(t2, flip_w), _mm_xor_ps(t3, flip_w));
+        return _mm_add_ps(t1, _mm_add_ps(sum, _mm_xor_ps(t4, flip_all)));
+    }
+
+    // Same as LLVector3 * LLQuaternion.
+    inline LLQuad quatRotate(LLQuad v, LLQuad q)
+    {
+        // r = q * (v, 0) and n = r * ~q, expanded:
+        // n = w * r + dot(u, v) * u + u x r, where u = q.xyz and r = w * v + u x v
+        LLQuad w = splatW(q);
+        LLQuad u = _mm_and_ps(q, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+        LLQuad r = _mm_add_ps(_mm_mul_ps(w, v), cross3(u, v));
+        LLQuad uv = _mm_mul_ps(u, v);
+        LLQuad dot = _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(uv, uv, LL_JH_SHUFFLE(0, 0, 0, 0)),
+                                           _mm_shuffle_ps(uv, uv, LL_JH_SHUFFLE(1, 1, 1, 1))),
+                                _mm_shuffle_ps(uv, uv, LL_JH_SHUFFLE(2, 2, 2, 2)));
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, r), _mm_mul_ps(dot, u)), cross3(u, r));
+    }
+
+    // Same as LLMatrix4::initAll(scale, rot, pos).
+    inline void composeMatrix(LLMatrix4a& mat, LLQuad scale, LLQuad q, LLQuad pos)
+    {
+        const LLQuad zero = _mm_setzero_ps();
+        const LLQuad one = _mm_set_ps(0.f, 1.f, 1.f, 1.f);
+
+        LLQuad q2 = _mm_add_ps(q, q);                                   // 2x 2y 2z 2w
+        LLQuad sq = _mm_mul_ps(q, q2);                                  // 2xx 2yy 2zz 2ww
+        LLQuad diag = _mm_sub_ps(_mm_sub_ps(one, _mm_shuffle_ps(sq, sq, LL_JH_SHUFFLE(1, 0, 0, 3))),
+                                 _mm_shuffle_ps(sq, sq, LL_JH_SHUFFLE(2, 2, 1, 3)));
+                                                                        // 1-2(yy+zz) 1-2(xx+zz) 1-2(xx+yy)
+        LLQuad v0 = _mm_mul_ps(_mm_shuffle_ps(q, q, LL_JH_SHUFFLE(0, 0, 1, 3)),
+                               _mm_shuffle_ps(q2, q2, LL_JH_SHUFFLE(2, 1, 2, 3))); // 2xz 2xy 2yz
+        LLQuad v1 = _mm_mul_ps(splatW(q),
+                               _mm_shuffle_ps(q2, q2, LL_JH_SHUFFLE(1, 2, 0, 3))); // 2yw 2zw 2xw
+        LLQuad sum = _mm_add_ps(v0, v1);                                // 2(xz+yw) 2(xy+zw) 2(yz+xw)
+        LLQuad diff = _mm_sub_ps(v0, v1);                               // 2(xz-yw) 2(xy-zw) 2(yz-xw)
+
+        // row 0: <diag.x, sum.y, diff.x, 0>
+        LLQuad a = _mm_shuffle_ps(diag, sum, LL_JH_SHUFFLE(0, 0, 1, 1));
+        LLQuad b = _mm_shuffle_ps(diff, zero, LL_JH_SHUFFLE(0, 0, 0, 0));
+        LLQuad row0 = _mm_shuffle_ps(a, b, LL_JH_SHUFFLE(0, 2, 0, 2));
+        // row 1: <diff.y, diag.y, sum.z, 0>
+        a = _mm_shuffle_ps(diff, diag, LL_JH_SHUFFLE(1, 1, 1, 1));
+        b = _mm_shuffle_ps(sum, zero, LL_JH_SHUFFLE(2, 2, 0, 0));
+        LLQuad row1 = _mm_shuffle_ps(a, b, LL_JH_SHUFFLE(0, 2, 0, 2));
+        // row 2: <sum.x, diff.z, diag.z, 0>
+        a = _mm_shuffle_ps(sum, diff, LL_JH_SHUFFLE(0, 0, 2, 2));
+        b = _mm_shuffle_ps(diag, zero, LL_JH_SHUFFLE(2, 2, 0, 0));
+        LLQuad row2 = _mm_shuffle_ps(a, b, LL_JH_SHUFFLE(0, 2, 0, 2));
+
+        mat.mMatrix[0] = _mm_mul_ps(row0, _mm_shuffle_ps(scale, scale, LL_JH_SHUFFLE(0, 0, 0, 0)));
+        mat.mMatrix[1] = _mm_mul_ps(row1, _mm_shuffle_ps(scale, scale, LL_JH_SHUFFLE(1, 1, 1, 1)));
+        mat.mMatrix[2] = _mm_mul_ps(row2, _mm_shuffle_ps(scale, scale, LL_JH_SHUFFLE(2, 2, 2, 2)));
+        // <pos.x, pos.y, pos.z, 1>
+        LLQuad pw = _mm_shuffle_ps(pos, one, LL_JH_SHUFFLE(2, 2, 0, 0));
+        mat.mMatrix[3] = _mm_shuffle_ps(pos, pw, LL_JH_SHUFFLE(0, 1, 0, 2));
+    }
+
+    #undef LL_JH_SHUFFLE
+}
+
+LLJointHierarchy::LLJointHierarchy()
+:   mRoot(nullptr),
+    mTopologySerial(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+// rebuild()
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::rebuild(LLJoint* root)
+{
+    mRoot = root;
+    mTopologySerial = root->mTopologySerial;
+    mJoints.clear();
+    mParents.clear();
+
+    // depth-first, children in the same order updateWorldMatrixChildren() visits them
+    std::vector<std::pair<LLJoint*, S32> > stack;
+    stack.emplace_back(root, -1);
+    while (!stack.empty())
+    {
+        LLJoint* joint = stack.back().first;
+        S32 parent = stack.back().second;
+        stack.pop_back();
+
+        S32 index = (S32)mJoints.size();
+        mJoints.push_back(joint);
+        mParents.push_back(parent);
+        for (LLJoint::joints_t::reverse_iterator it = joint->mChildren.rbegin(); it != joint->mChildren.rend(); ++it)
+        {
+            stack.emplace_back(*it, index);
+        }
+    }
+
+    const size_t count = mJoints.size();
+    mState.resize(count);
+    mLocalPosition.resize(count);
+    mLocalRotation.resize(count);
+    mLocalScale.resize(count);
+    mWorldPosition.resize(count);
+    mWorldRotation.resize(count);
+    mWorldMatrix.resize(count);
+}
+
+//-----------------------------------------------------------------------------
+// update()
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::update(LLJoint* root)
+{
+    if (!root)
+    {
+        return;
+    }
+    if (root != mRoot || mTopologySerial != root->mTopologySerial)
+    {
+        rebuild(root);
+    }
+
+    const U32 count = getNumJoints();
+
+    // Gather what the pass needs: local PRS of dirty joints, world PR of clean
+    // ones their children hang off, and the local scale of every joint (it
+    // scales the offsets of its children).
+    bool any_dirty = false;
+    for (U32 i = 0; i < count; ++i)
+    {
+        LLJoint* joint = mJoints[i];
+        S32 parent = mParents[i];
+        if (!joint->mUpdateXform || (parent >= 0 && mState[parent] == JOINT_SKIPPED))
+        {
+            mState[i] = JOINT_SKIPPED;
+            continue;
+        }
+
+        LLXformMatrix* xform = joint->getXform();
+        mLocalScale[i].load3(xform->getScale().mV);
+        if (parent >= 0 && (joint->mDirtyFlags & LLJoint::MATRIX_DIRTY))
+        {
+            mState[i] = JOINT_DIRTY;
+            mLocalPosition[i].load3(xform->getPosition().mV);
+            mLocalRotation[i].loadua(xform->getRotation().mQ);
+            any_dirty = true;
+        }
+        else
+        {
+            // The root may hang off something outside the skeleton (e.g. the
+            // drawable of the object being sat on), so leave it to LLXform.
+            if (parent < 0)
+            {
+                joint->updateWorldMatrix();
+            }
+            mState[i] = JOINT_CLEAN;
+            mWorldPosition[i].load3(xform->getWorldPosition().mV);
+            mWorldRotation[i].loadua(xform->getWorldRotation().mQ);
+            mWorldMatrix[i] = joint->mWorldMatrix;
+        }
+    }
+
+    if (!any_dirty)
+    {
+        return;
+    }
+
+    // Parents always precede their children, so one forward pass is enough.
+    for (U32 i = 1; i < count; ++i)
+    {
+        if (mState[i] != JOINT_DIRTY)
+        {
+            continue;
+        }
+        const S32 parent = mParents[i];
+
+        // LLXformMatrix::update() with mScaleChildOffset set, which LLJoint always does
+        LLQuad offset = _mm_mul_ps(mLocalPosition[i], mLocalScale[parent]);
+        LLQuad position = _mm_add_ps(quatRotate(offset, mWorldRotation[parent]), mWorldPosition[parent]);
+        LLQuad rotation = quatMul(mLocalRotation[i], mWorldRotation[parent]);
+        mWorldPosition[i] = position;
+        mWorldRotation[i] = rotation;
+        composeMatrix(mWorldMatrix[i], mLocalScale[i], rotation, position);
+    }
+
+    // Scatter back into the joints for the LLJoint API
+    for (U32 i = 1; i < count; ++i)
+    {
+        if (mState[i] == JOINT_DIRTY)
+        {
+            mJoints[i]->setWorldTransform(mWorldPosition[i], mWorldRotation[i], mWorldMatrix[i]);
+        }
+    }
+}
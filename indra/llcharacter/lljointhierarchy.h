@@ -0,0 +1,86 @@
+/**
+ * @file lljointhierarchy.h
+ * @brief Flattened joint hierarchy with batched world transform updates.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLJOINTHIERARCHY_H
+#define LL_LLJOINTHIERARCHY_H
+
+#include "llmath.h"
+#include "llmatrix4a.h"
+
+#include <vector>
+
+class LLJoint;
+
+//-----------------------------------------------------------------------------
+// class LLJointHierarchy
+//
+// A skeleton flattened into arrays in depth-first order, so every joint comes
+// after its parent. update() refreshes the world transforms of all dirty joints
+// in one linear SSE2 pass instead of LLJoint::updateWorldMatrixChildren()'s
+// recursion, then writes the results back into each LLJoint so getWorldMatrix(),
+// getWorldMatrix4a(), getLastWorldPosition() etc. return exactly what they did.
+//
+// The arrays are rebuilt on the next update() whenever a joint of this skeleton
+// is added, removed or destroyed (see LLJoint::mTopologySerial), so holding
+// LLJoint pointers here is safe as long as the owner passes in a live root.
+//-----------------------------------------------------------------------------
+class LLJointHierarchy
+{
+public:
+    LLJointHierarchy();
+
+    // Same result as root->updateWorldMatrixChildren().
+    void update(LLJoint* root);
+
+    // Forget the current layout; the next update() rebuilds it.
+    void invalidate() { mRoot = nullptr; }
+
+    // Valid after update(); entries for joints that were skipped (mUpdateXform
+    // false on them or an ancestor) are stale, as they are on the joints.
+    U32 getNumJoints() const                        { return (U32)mJoints.size(); }
+    LLJoint* getJoint(U32 index) const              { return mJoints[index]; }
+    S32 getParentIndex(U32 index) const             { return mParents[index]; }
+    const LLMatrix4a& getWorldMatrix(U32 index) const { return mWorldMatrix[index]; }
+
+private:
+    void rebuild(LLJoint* root);
+
+    LLJoint* mRoot;
+    U32 mTopologySerial;
+
+    // Per joint, indexed in depth-first order
+    std::vector<LLJoint*> mJoints;
+    std::vector<S32> mParents;          // -1 for the root
+    std::vector<U8> mState;             // SKIPPED/CLEAN/DIRTY for this pass
+    std::vector<LLVector4a> mLocalPosition;
+    std::vector<LLVector4a> mLocalRotation; // <x, y, z, w>
+    std::vector<LLVector4a> mLocalScale;
+    std::vector<LLVector4a> mWorldPosition;
+    std::vector<LLVector4a> mWorldRotation;
+    std::vector<LLMatrix4a> mWorldMatrix;
+};
+
+#endif // LL_LLJOINTHIERARCHY_H
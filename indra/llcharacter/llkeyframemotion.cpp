@@ -153,6 +153,17 @@ LLKeyframeMotion::ScaleCurve::~ScaleCurve()
 //-----------------------------------------------------------------------------
 LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
 {
+    // <FS> Keyframe curve evaluation
+    U32 cursor = 0;
+    return getValue(time, duration, cursor);
+}
+
+//-----------------------------------------------------------------------------
+// getValue()
+//-----------------------------------------------------------------------------
+LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration, U32& cursor)
+{
+    // </FS>
     LLVector3 value;
 
     if (mKeys.empty())
@@ -161,35 +172,28 @@ LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
         return value;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    // <FS> Keyframe curve evaluation
+    U32 right = mKeys.lowerBound(time, cursor);
+    if (right == mKeys.size())
     {
         // Past last key
-        --right;
-        value = right->second.mScale;
+        value = mKeys.getKey(right - 1).mScale;
     }
-    else if (right == mKeys.begin() || right->first == time)
+    else if (right == 0 || mKeys.getKey(right).mTime == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mScale;
+        value = mKeys.getKey(right).mScale;
     }
     else
     {
         // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        ScaleKey& scale_before = left->second;
-        ScaleKey& scale_after = right->second;
-        if (right == mKeys.end())
-        {
-            scale_after = mLoopInKey;
-            index_after = duration;
-        }
+        ScaleKey& scale_before = mKeys.getKey(right - 1);
+        ScaleKey& scale_after = mKeys.getKey(right);
 
-        F32 u = (time - index_before) / (index_after - index_before);
+        F32 u = (time - scale_before.mTime) / (scale_after.mTime - scale_before.mTime);
         value = interp(u, scale_before, scale_after);
     }
+    // </FS>
     return value;
 }
 
@@ -233,6 +237,17 @@ LLKeyframeMotion::RotationCurve::~RotationCurve()
 //-----------------------------------------------------------------------------
 LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
 {
+    // <FS> Keyframe curve evaluation
+    U32 cursor = 0;
+    return getValue(time, duration, cursor);
+}
+
+//-----------------------------------------------------------------------------
+// RotationCurve::getValue()
+//-----------------------------------------------------------------------------
+LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration, U32& cursor)
+{
+    // </FS>
     LLQuaternion value;
 
     if (mKeys.empty())
@@ -241,35 +256,28 @@ LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
         return value;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    // <FS> Keyframe curve evaluation
+    U32 right = mKeys.lowerBound(time, cursor);
+    if (right == mKeys.size())
     {
         // Past last key
-        --right;
-        value = right->second.mRotation;
+        value = mKeys.getKey(right - 1).mRotation;
     }
-    else if (right == mKeys.begin() || right->first == time)
+    else if (right == 0 || mKeys.getKey(right).mTime == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mRotation;
+        value = mKeys.getKey(right).mRotation;
     }
     else
     {
         // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        RotationKey& rot_before = left->second;
-        RotationKey& rot_after = right->second;
-        if (right == mKeys.end())
-        {
-            rot_after = mLoopInKey;
-            index_after = duration;
-        }
+        RotationKey& rot_before = mKeys.getKey(right - 1);
+        RotationKey& rot_after = mKeys.getKey(right);
 
-        F32 u = (time - index_before) / (index_after - index_before);
+        F32 u = (time - rot_before.mTime) / (rot_after.mTime - rot_before.mTime);
         value = interp(u, rot_before, rot_after);
     }
+    // </FS>
     return value;
 }
 
@@ -286,7 +294,16 @@ LLQuaternion LLKeyframeMotion::RotationCurve::interp(F32 u, RotationKey& before,
     default:
     case IT_LINEAR:
     case IT_SPLINE:
-        return nlerp(u, before.mRotation, after.mRotation);
+        // <FS> Keyframe curve evaluation
+        //return nlerp(u, before.mRotation, after.mRotation);
+        {
+            LLQuaternion2 value;
+            value.setNlerp(u, LLQuaternion2(before.mRotation), LLQuaternion2(after.mRotation));
+            LLQuaternion result;
+            _mm_storeu_ps(result.mQ, value.getVector4a());
+            return result;
+        }
+        // </FS>
     }
 }
 
@@ -314,6 +331,17 @@ LLKeyframeMotion::PositionCurve::~PositionCurve()
 //-----------------------------------------------------------------------------
 LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
 {
+    // <FS> Keyframe curve evaluation
+    U32 cursor = 0;
+    return getValue(time, duration, cursor);
+}
+
+//-----------------------------------------------------------------------------
+// PositionCurve::getValue()
+//-----------------------------------------------------------------------------
+LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration, U32& cursor)
+{
+    // </FS>
     LLVector3 value;
 
     if (mKeys.empty())
@@ -322,35 +350,28 @@ LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
         return value;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    // <FS> Keyframe curve evaluation
+    U32 right = mKeys.lowerBound(time, cursor);
+    if (right == mKeys.size())
     {
         // Past last key
-        --right;
-        value = right->second.mPosition;
+        value = mKeys.getKey(right - 1).mPosition;
     }
-    else if (right == mKeys.begin() || right->first == time)
+    else if (right == 0 || mKeys.getKey(right).mTime == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mPosition;
+        value = mKeys.getKey(right).mPosition;
     }
     else
     {
         // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        PositionKey& pos_before = left->second;
-        PositionKey& pos_after = right->second;
-        if (right == mKeys.end())
-        {
-            pos_after = mLoopInKey;
-            index_after = duration;
-        }
+        PositionKey& pos_before = mKeys.getKey(right - 1);
+        PositionKey& pos_after = mKeys.getKey(right);
 
-        F32 u = (time - index_before) / (index_after - index_before);
+        F32 u = (time - pos_before.mTime) / (pos_after.mTime - pos_before.mTime);
         value = interp(u, pos_before, pos_after);
     }
+    // </FS>
 
     llassert(value.isFinite());
 
@@ -419,6 +440,48 @@ void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time,
     }
 }
 
+// <FS> Keyframe curve evaluation
+//-----------------------------------------------------------------------------
+// JointMotion::update()
+// As above, looking keys up from where this motion instance last left off
+//-----------------------------------------------------------------------------
+void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time, F32 duration, KeyCursor& cursor)
+{
+    // this value being 0 is the cause of https://jira.lindenlab.com/browse/SL-22678 but I haven't
+    // managed to get a stack to see how it got here. Testing for 0 here will stop the crash.
+    if ( joint_state == NULL )
+    {
+        return;
+    }
+
+    U32 usage = joint_state->getUsage();
+
+    //-------------------------------------------------------------------------
+    // update scale component of joint state
+    //-------------------------------------------------------------------------
+    if ((usage & LLJointState::SCALE) && mScaleCurve.mNumKeys)
+    {
+        joint_state->setScale( mScaleCurve.getValue( time, duration, cursor.mScale ) );
+    }
+
+    //-------------------------------------------------------------------------
+    // update rotation component of joint state
+    //-------------------------------------------------------------------------
+    if ((usage & LLJointState::ROT) && mRotationCurve.mNumKeys)
+    {
+        joint_state->setRotation( mRotationCurve.getValue( time, duration, cursor.mRotation ) );
+    }
+
+    //-------------------------------------------------------------------------
+    // update position component of joint state
+    //-------------------------------------------------------------------------
+    if ((usage & LLJointState::POS) && mPositionCurve.mNumKeys)
+    {
+        joint_state->setPosition( mPositionCurve.getValue( time, duration, cursor.mPosition ) );
+    }
+}
+// </FS>
+
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -680,6 +743,29 @@ bool LLKeyframeMotion::onActivate()
     return true;
 }
 
+// <FS> Parallel animation evaluation
+//-----------------------------------------------------------------------------
+// LLKeyframeMotion::canUpdateConcurrently()
+//-----------------------------------------------------------------------------
+bool LLKeyframeMotion::canUpdateConcurrently()
+{
+    if (!mJointMotionList)
+    {
+        return false;
+    }
+
+    // activateConstraint() looks up ground targets with getGround()
+    for (JointConstraintSharedData* shared_constraintp : mJointMotionList->mConstraints)
+    {
+        if (shared_constraintp->mConstraintTargetType == CONSTRAINT_TARGET_TYPE_GROUND)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // LLKeyframeMotion::onUpdate()
 //-----------------------------------------------------------------------------
@@ -738,12 +824,25 @@ bool LLKeyframeMotion::onUpdate(F32 time, U8* joint_mask)
 void LLKeyframeMotion::applyKeyframes(F32 time)
 {
     llassert_always (mJointMotionList->getNumJointMotions() <= mJointStates.size());
+    // <FS> Keyframe curve evaluation
+    //for (U32 i=0; i<mJointMotionList->getNumJointMotions(); i++)
+    //{
+    //    mJointMotionList->getJointMotion(i)->update(mJointStates[i],
+    //                                                  time,
+    //                                                  mJointMotionList->mDuration );
+    //}
+    if (mKeyCursors.size() != mJointMotionList->getNumJointMotions())
+    {
+        mKeyCursors.assign(mJointMotionList->getNumJointMotions(), KeyCursor());
+    }
     for (U32 i=0; i<mJointMotionList->getNumJointMotions(); i++)
     {
         mJointMotionList->getJointMotion(i)->update(mJointStates[i],
                                                       time,
-                                                      mJointMotionList->mDuration );
+                                                      mJointMotionList->mDuration,
+                                                      mKeyCursors[i]);
     }
+    // </FS>
 
     LLJoint::JointPriority* pose_priority = (LLJoint::JointPriority* )mCharacter->getAnimationData("Hand Pose Priority");
     if (pose_priority)
@@ -2088,9 +2187,13 @@ bool LLKeyframeMotion::serialize(LLDataPacker& dp) const
             << " name: " << joint_motionp->mJointName
             << " Rotation keys: " << joint_motionp->mRotationCurve.mKeys.size()
             << " Position keys: " << joint_motionp->mPositionCurve.mKeys.size() << LL_ENDL;
-        for (RotationCurve::key_map_t::value_type& rot_pair : joint_motionp->mRotationCurve.mKeys)
+        // <FS> Keyframe curve evaluation
+        //for (RotationCurve::key_map_t::value_type& rot_pair : joint_motionp->mRotationCurve.mKeys)
+        //{
+        //    RotationKey& rot_key = rot_pair.second;
+        for (RotationKey& rot_key : joint_motionp->mRotationCurve.mKeys)
         {
-            RotationKey& rot_key = rot_pair.second;
+        // </FS>
             U16 time_short = F32_to_U16(rot_key.mTime, 0.f, mJointMotionList->mDuration);
             success &= dp.packU16(time_short, "time");
 
@@ -2109,9 +2212,13 @@ bool LLKeyframeMotion::serialize(LLDataPacker& dp) const
         }
 
         success &= dp.packS32(static_cast<S32>(joint_motionp->mPositionCurve.mKeys.size()), "num_pos_keys");
-        for (PositionCurve::key_map_t::value_type& pos_pair : joint_motionp->mPositionCurve.mKeys)
+        // <FS> Keyframe curve evaluation
+        //for (PositionCurve::key_map_t::value_type& pos_pair : joint_motionp->mPositionCurve.mKeys)
+        //{
+        //    PositionKey& pos_key = pos_pair.second;
+        for (PositionKey& pos_key : joint_motionp->mPositionCurve.mKeys)
         {
-            PositionKey& pos_key = pos_pair.second;
+        // </FS>
             U16 time_short = F32_to_U16(pos_key.mTime, 0.f, mJointMotionList->mDuration);
             success &= dp.packU16(time_short, "time");
 
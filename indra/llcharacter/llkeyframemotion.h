@@ -31,7 +31,9 @@
 // Header files
 //-----------------------------------------------------------------------------
 
+#include <algorithm> // <FS/> Keyframe curve evaluation
 #include <string>
+#include <vector> // <FS/> Keyframe curve evaluation
 
 #include "llassetstorage.h"
 #include "llbboxlocal.h"
@@ -129,6 +131,9 @@ public:
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_KEYFRAME; }
 
+    // unless a constraint targets the ground
+    virtual bool canUpdateConcurrently(); // <FS/> Parallel animation evaluation
+
     // run-time (post constructor) initialization,
     // called after parameters have been set
     // must return true to indicate success and be available for activation
@@ -317,6 +322,95 @@ public:
         LLVector3   mPosition;
     };
 
+    // <FS> Keyframe curve evaluation
+    //-------------------------------------------------------------------------
+    // KeyArray
+    // The keys of a curve in one sorted array. operator[] behaves like
+    // std::map's, so a curve is loaded the same way it always was; lookups
+    // take a cursor, which a motion keeps per curve since the keys are
+    // shared by every instance playing the animation.
+    //-------------------------------------------------------------------------
+    template <class KEY>
+    class KeyArray
+    {
+    public:
+        typedef typename std::vector<KEY>::iterator iterator;
+        typedef typename std::vector<KEY>::const_iterator const_iterator;
+
+        // The key at time, added if there isn't one. Keys mostly arrive in
+        // order, so check the end before searching.
+        KEY& operator[](F32 time)
+        {
+            if (mKeys.empty() || mKeys.back().mTime < time)
+            {
+                mKeys.push_back(KEY());
+                mKeys.back().mTime = time;
+                return mKeys.back();
+            }
+            iterator it = std::lower_bound(mKeys.begin(), mKeys.end(), time, keyBefore);
+            if (it == mKeys.end() || it->mTime != time)
+            {
+                it = mKeys.insert(it, KEY());
+                it->mTime = time;
+            }
+            return *it;
+        }
+
+        KEY& getKey(U32 index)              { return mKeys[index]; }
+        size_t size() const                 { return mKeys.size(); }
+        bool empty() const                  { return mKeys.empty(); }
+        void clear()                        { mKeys.clear(); }
+        iterator begin()                    { return mKeys.begin(); }
+        iterator end()                      { return mKeys.end(); }
+        const_iterator begin() const        { return mKeys.begin(); }
+        const_iterator end() const          { return mKeys.end(); }
+
+        // Index of the first key at or after time, like std::map::lower_bound().
+        // Playback mostly moves forward a key or two per update, so start at
+        // cursor and step; search when time jumps or goes back (looping).
+        U32 lowerBound(F32 time, U32& cursor) const
+        {
+            const U32 count = (U32)mKeys.size();
+            U32 index = llmin(cursor, count);
+            if (index > 0 && !(mKeys[index - 1].mTime < time))
+            {
+                index = (U32)(std::lower_bound(mKeys.begin(), mKeys.begin() + index, time, keyBefore) - mKeys.begin());
+            }
+            else
+            {
+                for (U32 steps = 0; index < count && mKeys[index].mTime < time; ++index)
+                {
+                    if (++steps > MAX_CURSOR_STEPS)
+                    {
+                        index = (U32)(std::lower_bound(mKeys.begin() + index, mKeys.end(), time, keyBefore) - mKeys.begin());
+                        break;
+                    }
+                }
+            }
+            cursor = index;
+            return index;
+        }
+
+    private:
+        static const U32 MAX_CURSOR_STEPS = 4;
+
+        static bool keyBefore(const KEY& key, F32 time) { return key.mTime < time; }
+
+        std::vector<KEY> mKeys;
+    };
+
+    // Where each curve of a joint motion was last evaluated
+    class KeyCursor
+    {
+    public:
+        KeyCursor() : mScale(0), mRotation(0), mPosition(0) {}
+
+        U32 mScale;
+        U32 mRotation;
+        U32 mPosition;
+    };
+    // </FS>
+
     //-------------------------------------------------------------------------
     // ScaleCurve
     //-------------------------------------------------------------------------
@@ -326,12 +420,17 @@ public:
         ScaleCurve();
         ~ScaleCurve();
         LLVector3 getValue(F32 time, F32 duration);
+        LLVector3 getValue(F32 time, F32 duration, U32& cursor); // <FS/> Keyframe curve evaluation
         LLVector3 interp(F32 u, ScaleKey& before, ScaleKey& after);
 
         InterpolationType   mInterpolationType;
         S32                 mNumKeys;
-        typedef std::map<F32, ScaleKey> key_map_t;
-        key_map_t           mKeys;
+        // <FS> Keyframe curve evaluation
+        //typedef std::map<F32, ScaleKey> key_map_t;
+        //key_map_t           mKeys;
+        typedef KeyArray<ScaleKey> key_array_t;
+        key_array_t         mKeys;
+        // </FS>
         ScaleKey            mLoopInKey;
         ScaleKey            mLoopOutKey;
     };
@@ -345,12 +444,17 @@ public:
         RotationCurve();
         ~RotationCurve();
         LLQuaternion getValue(F32 time, F32 duration);
+        LLQuaternion getValue(F32 time, F32 duration, U32& cursor); // <FS/> Keyframe curve evaluation
         LLQuaternion interp(F32 u, RotationKey& before, RotationKey& after);
 
         InterpolationType   mInterpolationType;
         S32                 mNumKeys;
-        typedef std::map<F32, RotationKey> key_map_t;
-        key_map_t       mKeys;
+        // <FS> Keyframe curve evaluation
+        //typedef std::map<F32, RotationKey> key_map_t;
+        //key_map_t       mKeys;
+        typedef KeyArray<RotationKey> key_array_t;
+        key_array_t     mKeys;
+        // </FS>
         RotationKey     mLoopInKey;
         RotationKey     mLoopOutKey;
     };
@@ -364,12 +468,17 @@ public:
         PositionCurve();
         ~PositionCurve();
         LLVector3 getValue(F32 time, F32 duration);
+        LLVector3 getValue(F32 time, F32 duration, U32& cursor); // <FS/> Keyframe curve evaluation
         LLVector3 interp(F32 u, PositionKey& before, PositionKey& after);
 
         InterpolationType   mInterpolationType;
         S32                 mNumKeys;
-        typedef std::map<F32, PositionKey> key_map_t;
-        key_map_t       mKeys;
+        // <FS> Keyframe curve evaluation
+        //typedef std::map<F32, PositionKey> key_map_t;
+        //key_map_t       mKeys;
+        typedef KeyArray<PositionKey> key_array_t;
+        key_array_t     mKeys;
+        // </FS>
         PositionKey     mLoopInKey;
         PositionKey     mLoopOutKey;
     };
@@ -388,6 +497,7 @@ public:
         LLJoint::JointPriority  mPriority;
 
         void update(LLJointState* joint_state, F32 time, F32 duration);
+        void update(LLJointState* joint_state, F32 time, F32 duration, KeyCursor& cursor); // <FS/> Keyframe curve evaluation
     };
 
     //-------------------------------------------------------------------------
@@ -434,6 +544,7 @@ protected:
     F32                             mLastUpdateTime;
     F32                             mLastLoopedTime;
     AssetStatus                     mAssetStatus;
+    std::vector<KeyCursor>          mKeyCursors; // <FS/> Keyframe curve evaluation, one per joint motion
 
 public:
     void setCharacter(LLCharacter* character) { mCharacter = character; }
@@ -67,6 +67,11 @@ public:
     void    onDeactivate();
     virtual bool onUpdate(F32 time, U8* joint_mask);
 
+    // <FS> Parallel animation evaluation
+    // foot placement casts against the ground every update
+    virtual bool canUpdateConcurrently() { return false; }
+    // </FS>
+
 public:
     //-------------------------------------------------------------------------
     // Member Data
@@ -109,6 +109,7 @@ public:
     virtual F32 getEaseInDuration() { return 0.f; }
     virtual F32 getEaseOutDuration() { return 0.f; }
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_WALK_ADJUST; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
     virtual LLMotionBlendType getBlendType() { return ADDITIVE_BLEND; }
 
 public:
@@ -159,6 +160,7 @@ public:
     virtual F32 getEaseInDuration() { return 0.f; }
     virtual F32 getEaseOutDuration() { return 0.f; }
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_FLY_ADJUST; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
     virtual LLMotionBlendType getBlendType() { return ADDITIVE_BLEND; }
 
 protected:
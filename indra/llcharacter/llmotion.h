@@ -156,6 +156,15 @@ public:
     // requires this
     virtual bool canDeprecate();
 
+    // <FS> Parallel animation evaluation
+    // can onUpdate() run on a worker thread, alongside other characters'
+    // motions? It may then only touch this motion, its joint states and
+    // per-character data; LLCharacter::updateVisualParams() and
+    // requestStopMotion() are held back until the main thread applies the
+    // result. Anything reaching into the world (getGround() etc.) must say no.
+    virtual bool canUpdateConcurrently() { return false; }
+    // </FS>
+
     // optional callback routine called when animation deactivated.
     void    setDeactivateCallback( void (*cb)(void *), void* userdata );
 
@@ -244,6 +253,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     /*virtual*/ F32 getMinPixelArea() { return 0.f; }
+    /*virtual*/ bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // run-time (post constructor) initialization,
     // called after parameters have been set
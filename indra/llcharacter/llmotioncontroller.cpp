@@ -141,6 +141,8 @@ LLMotionController::LLMotionController()
       mTimeStepCount(0),
       mLastInterp(0.f),
       mIsSelf(false),
+      mDeferring(false), // <FS/> Parallel animation evaluation
+      mForceUpdate(false), // <FS/> Parallel animation evaluation
       mLastCountAfterPurge(0)
 {
 }
@@ -510,7 +512,8 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     if (motionp->isStopped() && mAnimTime > motionp->getStopTime() + motionp->getEaseOutDuration())
     {
-        deactivateMotionInstance(motionp);
+        //deactivateMotionInstance(motionp);
+        deactivateOrDeferMotionInstance(motionp); // <FS/> Parallel animation evaluation
     }
     else if (motionp->isStopped() && mAnimTime > motionp->getStopTime())
     {
@@ -527,7 +530,8 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
         // this will only be called when an animation stops itself (runs out of time)
         if (mLastTime <= motionp->mSendStopTimestamp)
         {
-            mCharacter->requestStopMotion( motionp );
+            //mCharacter->requestStopMotion( motionp );
+            notifyStopMotion(motionp); // <FS/> Parallel animation evaluation
             stopMotionInstance(motionp, false);
         }
     }
@@ -629,7 +633,8 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    //mCharacter->requestStopMotion( motionp );
+                    notifyStopMotion(motionp); // <FS/> Parallel animation evaluation
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -639,7 +644,8 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 if (motionp->isStopped() && mAnimTime > motionp->getStopTime() + motionp->getEaseOutDuration())
                 {
                     posep->setWeight(0.f);
-                    deactivateMotionInstance(motionp);
+                    //deactivateMotionInstance(motionp);
+                    deactivateOrDeferMotionInstance(motionp); // <FS/> Parallel animation evaluation
                 }
                 continue;
             }
@@ -666,7 +672,8 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
             else
             {
                 posep->setWeight(0.f);
-                deactivateMotionInstance(motionp);
+                //deactivateMotionInstance(motionp);
+                deactivateOrDeferMotionInstance(motionp); // <FS/> Parallel animation evaluation
                 continue;
             }
         }
@@ -710,7 +717,8 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    //mCharacter->requestStopMotion( motionp );
+                    notifyStopMotion(motionp); // <FS/> Parallel animation evaluation
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -756,7 +764,8 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // animation has stopped itself due to internal logic
                 // propagate this to the network
                 // as not all viewers are guaranteed to have access to the same logic
-                mCharacter->requestStopMotion( motionp );
+                //mCharacter->requestStopMotion( motionp );
+                notifyStopMotion(motionp); // <FS/> Parallel animation evaluation
                 stopMotionInstance(motionp, false);
             }
 
@@ -910,6 +919,149 @@ void LLMotionController::updateMotions(bool force_update)
 //  LL_INFOS() << "Motion controller time " << motionTimer.getElapsedTimeF32() << LL_ENDL;
 }
 
+// <FS> Parallel animation evaluation
+//-----------------------------------------------------------------------------
+// canEvaluateConcurrently()
+//-----------------------------------------------------------------------------
+bool LLMotionController::canEvaluateConcurrently()
+{
+    // The time quantum path interpolates from the main thread, and motions
+    // finishing their load get activated there
+    if (mTimeStep != 0.f || !mLoadingMotions.empty())
+    {
+        return false;
+    }
+
+    for (LLMotion* motionp : mActiveMotions)
+    {
+        if (motionp && !motionp->canUpdateConcurrently())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// prepareMotions()
+// The part of updateMotions() ahead of evaluation, without the time quantum
+//-----------------------------------------------------------------------------
+void LLMotionController::prepareMotions(bool force_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    llassert(!mDeferring && mTimeStep == 0.f);
+
+    // Always update mPrevTimerElapsed
+    F32 cur_time = mTimer.getElapsedTimeF32();
+    F32 delta_time = cur_time - mPrevTimerElapsed;
+    mPrevTimerElapsed = cur_time;
+    mLastTime = mAnimTime;
+
+    // Always cap the number of loaded motions
+    purgeExcessMotions();
+
+    // Update timing info for this time step.
+    if (!mPaused)
+    {
+        mAnimTime = mAnimTime + delta_time * mTimeFactor * mUpdateFactor;
+    }
+
+    updateLoadingMotions();
+
+    mDeferring = true;
+    mForceUpdate = force_update;
+}
+
+//-----------------------------------------------------------------------------
+// evaluateMotions()
+//-----------------------------------------------------------------------------
+void LLMotionController::evaluateMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    llassert(mDeferring);
+
+    resetJointSignatures();
+
+    if (mPaused && !mForceUpdate)
+    {
+        updateIdleActiveMotions();
+    }
+    else
+    {
+        // update additive motions
+        updateAdditiveMotions();
+
+        resetJointSignatures();
+
+        // update all regular motions
+        updateRegularMotions();
+
+        // joints are only written in applyMotions()
+        mPoseBlender.blendAndStage();
+    }
+
+    mHasRunOnce = true;
+}
+
+//-----------------------------------------------------------------------------
+// applyMotions()
+//-----------------------------------------------------------------------------
+void LLMotionController::applyMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    llassert(mDeferring);
+
+    mPoseBlender.applyStaged();
+
+    mDeferring = false;
+
+    // may delete deprecated motions, so after everything else has seen them
+    for (deferred_action_list_t::value_type& action : mDeferredActions)
+    {
+        if (action.first == DEFERRED_STOP_REQUEST)
+        {
+            mCharacter->requestStopMotion(action.second);
+        }
+        else
+        {
+            deactivateMotionInstance(action.second);
+        }
+    }
+    mDeferredActions.clear();
+}
+
+//-----------------------------------------------------------------------------
+// notifyStopMotion()
+//-----------------------------------------------------------------------------
+void LLMotionController::notifyStopMotion(LLMotion* motionp)
+{
+    if (mDeferring)
+    {
+        mDeferredActions.emplace_back(DEFERRED_STOP_REQUEST, motionp);
+    }
+    else
+    {
+        mCharacter->requestStopMotion(motionp);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// deactivateOrDeferMotionInstance()
+//-----------------------------------------------------------------------------
+void LLMotionController::deactivateOrDeferMotionInstance(LLMotion* motionp)
+{
+    if (mDeferring)
+    {
+        // stays on mActiveMotions until then; each pass only visits it once
+        mDeferredActions.emplace_back(DEFERRED_DEACTIVATE, motionp);
+    }
+    else
+    {
+        deactivateMotionInstance(motionp);
+    }
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // updateMotionsMinimal()
 // minimal update (e.g. while hidden)
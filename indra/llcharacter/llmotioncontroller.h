@@ -33,6 +33,7 @@
 #include <string>
 #include <map>
 #include <deque>
+#include <vector> // <FS/> Parallel animation evaluation
 
 #include "llmotion.h"
 #include "llpose.h"
@@ -134,6 +135,17 @@ public:
     // minimal update (e.g. while hidden)
     void updateMotionsMinimal();
 
+    // <FS> Parallel animation evaluation
+    // updateMotions() split up so several characters can be evaluated at once.
+    // prepareMotions() and applyMotions() run on the main thread;
+    // evaluateMotions() only touches this controller's character and may run
+    // on any thread in between. Only valid while canEvaluateConcurrently().
+    bool canEvaluateConcurrently();
+    void prepareMotions(bool force_update = false);
+    void evaluateMotions();
+    void applyMotions();
+    // </FS>
+
     void clearBlenders() { mPoseBlender.clearBlenders(); }
 
     // flush motions
@@ -194,6 +206,12 @@ protected:
     void purgeExcessMotions();
     void deactivateStoppedMotions();
 
+    // <FS> Parallel animation evaluation
+    // Act right away, or queue for applyMotions() inside evaluateMotions()
+    void notifyStopMotion(LLMotion* motion);
+    void deactivateOrDeferMotionInstance(LLMotion* motion);
+    // </FS>
+
 protected:
     F32                 mTimeFactor;            // 1.f for normal speed
     static F32          sCurrentTimeFactor;     // Value to use for initialization
@@ -231,6 +249,18 @@ protected:
     F32                 mLastInterp;
 
     U8                  mJointSignature[2][LL_CHARACTER_MAX_ANIMATED_JOINTS];
+
+    // <FS> Parallel animation evaluation
+    enum EDeferredAction
+    {
+        DEFERRED_STOP_REQUEST,
+        DEFERRED_DEACTIVATE
+    };
+    typedef std::vector<std::pair<EDeferredAction, LLMotion*> > deferred_action_list_t;
+    deferred_action_list_t mDeferredActions;    // in the order evaluateMotions() ran into them
+    bool                mDeferring;             // between prepareMotions() and applyMotions()
+    bool                mForceUpdate;
+    // </FS>
 private:
     U32                 mLastCountAfterPurge; //for logging and debugging purposes
 };
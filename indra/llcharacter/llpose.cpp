@@ -450,6 +450,26 @@ void LLJointStateBlender::resetCachedJoint()
     mJointCache.setRotation(source_joint->getRotation());
 }
 
+// <FS> Parallel animation evaluation
+//-----------------------------------------------------------------------------
+// applyCachedJoint()
+//-----------------------------------------------------------------------------
+void LLJointStateBlender::applyCachedJoint()
+{
+    if (!mJointStates[0])
+    {
+        return;
+    }
+    LLJoint* target_joint = mJointStates[0]->getJoint();
+    // SL-315
+    target_joint->setPosition(mJointCache.getPosition());
+    target_joint->setScale(mJointCache.getScale());
+    target_joint->setRotation(mJointCache.getRotation());
+
+    clear();
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // LLPoseBlender
 //-----------------------------------------------------------------------------
@@ -539,6 +559,38 @@ void LLPoseBlender::blendAndCache(bool reset_cached_joints)
     }
 }
 
+// <FS> Parallel animation evaluation
+//-----------------------------------------------------------------------------
+// blendAndStage()
+//-----------------------------------------------------------------------------
+void LLPoseBlender::blendAndStage()
+{
+    for (blender_list_t::iterator iter = mActiveBlenders.begin();
+         iter != mActiveBlenders.end(); ++iter)
+    {
+        LLJointStateBlender* jsbp = *iter;
+        // start from the joint, as blendAndApply() does
+        jsbp->resetCachedJoint();
+        jsbp->blendJointStates(false);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// applyStaged()
+//-----------------------------------------------------------------------------
+void LLPoseBlender::applyStaged()
+{
+    for (blender_list_t::iterator iter = mActiveBlenders.begin();
+         iter != mActiveBlenders.end(); ++iter)
+    {
+        (*iter)->applyCachedJoint();
+    }
+
+    // we're done now so there are no more active blenders for this frame
+    mActiveBlenders.clear();
+}
+// </FS>
+
 //-----------------------------------------------------------------------------
 // interpolate()
 //-----------------------------------------------------------------------------
@@ -96,6 +96,7 @@ public:
     void interpolate(F32 u);
     void clear();
     void resetCachedJoint();
+    void applyCachedJoint(); // <FS/> Parallel animation evaluation
 
 public:
     LL_ALIGN_16(LLJoint mJointCache);
@@ -134,6 +135,13 @@ public:
     // interpolate all joints towards cached values
     void interpolate(F32 u);
 
+    // <FS> Parallel animation evaluation
+    // blendAndApply() in two halves: blendAndStage() only writes each
+    // blender's cached joint, applyStaged() then copies those to the skeleton.
+    void blendAndStage();
+    void applyStaged();
+    // </FS>
+
     LLPose* getBlendedPose() { return &mBlendedPose; }
 };
 
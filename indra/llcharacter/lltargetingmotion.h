@@ -84,6 +84,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_TARGETING; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // run-time (post constructor) initialization,
     // called after parameters have been set
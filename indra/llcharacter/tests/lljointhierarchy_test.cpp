@@ -0,0 +1,299 @@
+/**
+ * @file lljointhierarchy_test.cpp
+ * @brief LLJointHierarchy test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../lljoint.h"
+#include "../lljointhierarchy.h"
+
+#include "../test/lltut.h"
+
+#include <random>
+
+namespace tut
+{
+    // Roughly the shape of an avatar skeleton: a spine with limbs, fingers,
+    // collision volumes and attachment points hanging off it.
+    struct Skeleton
+    {
+        std::vector<LLJoint*> mJoints;
+
+        Skeleton(std::mt19937& random, S32 count)
+        {
+            mJoints.push_back(new LLJoint());
+            mJoints.back()->setName("mRoot");
+            for (S32 i = 1; i < count; i++)
+            {
+                // mostly chains, with the odd branch back towards the root
+                S32 parent = (random() % 4) ? i - 1 : (S32)(random() % i);
+                mJoints.push_back(new LLJoint());
+                mJoints.back()->setup(llformat("joint%d", i), mJoints[parent]);
+            }
+        }
+
+        ~Skeleton()
+        {
+            // children first, so nothing is left pointing at a deleted parent
+            for (std::vector<LLJoint*>::reverse_iterator it = mJoints.rbegin(); it != mJoints.rend(); ++it)
+            {
+                delete *it;
+            }
+        }
+
+        LLJoint* root() const { return mJoints[0]; }
+    };
+
+    struct lljointhierarchy_test
+    {
+        std::mt19937 mRandom;
+
+        lljointhierarchy_test() : mRandom(0x5ce1e7) {}
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        LLQuaternion randomRotation()
+        {
+            LLQuaternion rot(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f));
+            rot.normalize();
+            return rot;
+        }
+
+        // Pose both skeletons identically.
+        void pose(Skeleton& a, Skeleton& b, bool rotations_only)
+        {
+            for (size_t i = 0; i < a.mJoints.size(); i++)
+            {
+                LLQuaternion rot = randomRotation();
+                a.mJoints[i]->setRotation(rot);
+                b.mJoints[i]->setRotation(rot);
+                if (!rotations_only)
+                {
+                    LLVector3 pos(frand(-0.5f, 0.5f), frand(-0.5f, 0.5f), frand(-0.5f, 0.5f));
+                    LLVector3 scale(frand(0.5f, 2.f), frand(0.5f, 2.f), frand(0.5f, 2.f));
+                    a.mJoints[i]->setPosition(pos);
+                    b.mJoints[i]->setPosition(pos);
+                    a.mJoints[i]->setScale(scale);
+                    b.mJoints[i]->setScale(scale);
+                }
+            }
+        }
+
+        // Largest difference between the world matrices of the two skeletons.
+        // getLastWorldPosition() doesn't update anything, so it also checks
+        // that the hierarchy wrote the world position back.
+        F32 compare(Skeleton& a, Skeleton& b)
+        {
+            F32 max_diff = 0.f;
+            for (size_t i = 0; i < a.mJoints.size(); i++)
+            {
+                const F32* ma = a.mJoints[i]->getWorldMatrix4a().getF32ptr();
+                const F32* mb = b.mJoints[i]->getWorldMatrix4a().getF32ptr();
+                for (S32 j = 0; j < 16; j++)
+                {
+                    max_diff = llmax(max_diff, fabsf(ma[j] - mb[j]) / llmax(1.f, fabsf(ma[j])));
+                }
+                max_diff = llmax(max_diff, dist_vec(a.mJoints[i]->getLastWorldPosition(), b.mJoints[i]->getLastWorldPosition()));
+                const F32* mb3 = &b.mJoints[i]->getWorldMatrix().mMatrix[0][0];
+                for (S32 j = 0; j < 16; j++)
+                {
+                    max_diff = llmax(max_diff, fabsf(ma[j] - mb3[j]) / llmax(1.f, fabsf(ma[j])));
+                }
+            }
+            return max_diff;
+        }
+    };
+    typedef test_group<lljointhierarchy_test> lljointhierarchy_test_t;
+    typedef lljointhierarchy_test_t::object lljointhierarchy_object_t;
+    tut::lljointhierarchy_test_t tut_lljointhierarchy_test("LLJointHierarchy");
+
+    template<> template<>
+    void lljointhierarchy_object_t::test<1>()
+    {
+        set_test_name("batched update matches updateWorldMatrixChildren()");
+
+        std::mt19937 shape(0x0b0d7);
+        Skeleton recursive(shape, 200);
+        shape.seed(0x0b0d7);
+        Skeleton batched(shape, 200);
+        LLJointHierarchy hierarchy;
+
+        for (S32 n = 0; n < 50; n++)
+        {
+            pose(recursive, batched, n % 2);
+            recursive.root()->updateWorldMatrixChildren();
+            hierarchy.update(batched.root());
+            ensure_equals("all joints flattened", hierarchy.getNumJoints(), (U32)batched.mJoints.size());
+            ensure("world transforms match", compare(recursive, batched) < 1e-5f);
+            for (size_t i = 0; i < batched.mJoints.size(); i++)
+            {
+                ensure("joint cleaned", !(batched.mJoints[i]->mDirtyFlags & LLJoint::MATRIX_DIRTY));
+            }
+        }
+
+        // Parents are always flattened ahead of their children
+        for (U32 i = 1; i < hierarchy.getNumJoints(); i++)
+        {
+            S32 parent = hierarchy.getParentIndex(i);
+            ensure("parent first", parent >= 0 && (U32)parent < i);
+            ensure("parent matches", hierarchy.getJoint(parent) == hierarchy.getJoint(i)->getParent());
+        }
+    }
+
+    template<> template<>
+    void lljointhierarchy_object_t::test<2>()
+    {
+        set_test_name("mUpdateXform and topology changes");
+
+        std::mt19937 shape(0x70b0);
+        Skeleton recursive(shape, 60);
+        shape.seed(0x70b0);
+        Skeleton batched(shape, 60);
+        LLJointHierarchy hierarchy;
+
+        // A frozen subtree is left alone by both paths
+        recursive.mJoints[20]->mUpdateXform = false;
+        batched.mJoints[20]->mUpdateXform = false;
+        pose(recursive, batched, false);
+        recursive.root()->updateWorldMatrixChildren();
+        hierarchy.update(batched.root());
+        for (size_t i = 0; i < batched.mJoints.size(); i++)
+        {
+            ensure_equals("same joints left dirty",
+                          (batched.mJoints[i]->mDirtyFlags & LLJoint::MATRIX_DIRTY),
+                          (recursive.mJoints[i]->mDirtyFlags & LLJoint::MATRIX_DIRTY));
+        }
+        recursive.mJoints[20]->mUpdateXform = true;
+        batched.mJoints[20]->mUpdateXform = true;
+        recursive.root()->updateWorldMatrixChildren();
+        hierarchy.update(batched.root());
+        ensure("frozen subtree caught up", compare(recursive, batched) < 1e-5f);
+
+        // Re-parenting a joint is picked up on the next update
+        recursive.mJoints[3]->addChild(recursive.mJoints[40]);
+        batched.mJoints[3]->addChild(batched.mJoints[40]);
+        pose(recursive, batched, true);
+        recursive.root()->updateWorldMatrixChildren();
+        hierarchy.update(batched.root());
+        ensure("re-parented joint matches", compare(recursive, batched) < 1e-5f);
+
+        // Only the joints touched since the last update are recomputed
+        LLQuaternion rot = randomRotation();
+        recursive.mJoints[10]->setRotation(rot);
+        batched.mJoints[10]->setRotation(rot);
+        recursive.root()->updateWorldMatrixChildren();
+        S32 before = LLJoint::sNumUpdates;
+        hierarchy.update(batched.root());
+        S32 batched_updates = LLJoint::sNumUpdates - before;
+        ensure("partial update matches", compare(recursive, batched) < 1e-5f);
+        ensure("partial update is partial", batched_updates > 0 && batched_updates < (S32)batched.mJoints.size());
+    }
+
+    template<> template<>
+    void lljointhierarchy_object_t::test<3>()
+    {
+        set_test_name("100 skeletons over many frames");
+
+        const S32 AVATARS = 100;
+        const S32 JOINTS = 200;
+        const S32 FRAMES = 20;
+
+        std::vector<std::unique_ptr<Skeleton> > recursive, batched;
+        std::vector<LLJointHierarchy> hierarchies(AVATARS);
+        for (S32 i = 0; i < AVATARS; i++)
+        {
+            std::mt19937 shape(i);
+            recursive.emplace_back(new Skeleton(shape, JOINTS));
+            shape.seed(i);
+            batched.emplace_back(new Skeleton(shape, JOINTS));
+        }
+
+        // A fixed set of animated rotations, as motions would set each frame
+        std::vector<LLQuaternion> rotations(JOINTS * 8);
+        for (LLQuaternion& rot : rotations)
+        {
+            rot = randomRotation();
+        }
+
+        for (S32 frame = 0; frame < FRAMES; frame++)
+        {
+            const LLQuaternion* frame_rotations = &rotations[(frame % 8) * JOINTS];
+            for (S32 i = 0; i < AVATARS; i++)
+            {
+                for (S32 j = 0; j < JOINTS; j++)
+                {
+                    recursive[i]->mJoints[j]->setRotation(frame_rotations[j]);
+                    batched[i]->mJoints[j]->setRotation(frame_rotations[j]);
+                }
+            }
+
+            for (S32 i = 0; i < AVATARS; i++)
+            {
+                recursive[i]->root()->updateWorldMatrixChildren();
+                hierarchies[i].update(batched[i]->root());
+            }
+        }
+
+        for (S32 i = 0; i < AVATARS; i++)
+        {
+            ensure("last frame matches", compare(*recursive[i], *batched[i]) < 1e-5f);
+        }
+    }
+
+    template<> template<>
+    void lljointhierarchy_object_t::test<4>()
+    {
+        set_test_name("topology serials are kept per skeleton");
+
+        std::mt19937 shape(0x5e71);
+        Skeleton skeleton(shape, 30);
+        LLJointHierarchy hierarchy;
+        hierarchy.update(skeleton.root());
+
+        // A change deep in the skeleton is seen from its root
+        LLJoint* leaf = skeleton.mJoints[29];
+        leaf->getParent()->removeChild(leaf);
+        hierarchy.update(skeleton.root());
+        ensure_equals("leaf dropped", hierarchy.getNumJoints(), (U32)29);
+        skeleton.mJoints[5]->addChild(leaf);
+        hierarchy.update(skeleton.root());
+        ensure_equals("leaf back", hierarchy.getNumJoints(), (U32)30);
+
+        // A new root at the address of a deleted one is never mistaken for it
+        LLJointHierarchy single;
+        LLJoint* root = new LLJoint();
+        single.update(root);
+        delete root;
+        root = new LLJoint();
+        root->addChild(new LLJoint());
+        single.update(root);
+        ensure_equals("new root rebuilt", single.getNumJoints(), (U32)2);
+        delete root->mChildren[0];
+        delete root;
+    }
+}
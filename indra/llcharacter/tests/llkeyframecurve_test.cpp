@@ -0,0 +1,334 @@
+/**
+ * @file llkeyframecurve_test.cpp
+ * @brief LLKeyframeMotion curve evaluation test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "llmath.h"
+#include "llquantize.h"
+
+#include "../llkeyframemotion.h"
+
+#include "../test/lltut.h"
+
+#include <map>
+#include <random>
+
+namespace tut
+{
+    // Opens up the curve classes, which are only meant for LLKeyframeMotion
+    // and its subclasses
+    class KeyframeCurveAccess : public LLKeyframeMotion
+    {
+    public:
+        typedef LLKeyframeMotion::JointMotion JointMotion;
+        typedef LLKeyframeMotion::KeyCursor KeyCursor;
+        typedef LLKeyframeMotion::RotationKey RotationKey;
+        typedef LLKeyframeMotion::PositionKey PositionKey;
+
+    private:
+        KeyframeCurveAccess();
+    };
+
+    typedef KeyframeCurveAccess::JointMotion JointMotion;
+    typedef KeyframeCurveAccess::KeyCursor KeyCursor;
+
+    // A joint's keys as LLKeyframeMotion used to keep them, with the lookup
+    // and interpolation it used to do
+    struct ReferenceJoint
+    {
+        std::map<F32, LLQuaternion> mRotations;
+        std::map<F32, LLVector3> mPositions;
+
+        LLQuaternion getRotation(F32 time) const
+        {
+            std::map<F32, LLQuaternion>::const_iterator right = mRotations.lower_bound(time);
+            if (right == mRotations.end())
+            {
+                --right;
+                return right->second;
+            }
+            if (right == mRotations.begin() || right->first == time)
+            {
+                return right->second;
+            }
+            std::map<F32, LLQuaternion>::const_iterator left = right; --left;
+            F32 u = (time - left->first) / (right->first - left->first);
+            return nlerp(u, left->second, right->second);
+        }
+
+        LLVector3 getPosition(F32 time) const
+        {
+            std::map<F32, LLVector3>::const_iterator right = mPositions.lower_bound(time);
+            if (right == mPositions.end())
+            {
+                --right;
+                return right->second;
+            }
+            if (right == mPositions.begin() || right->first == time)
+            {
+                return right->second;
+            }
+            std::map<F32, LLVector3>::const_iterator left = right; --left;
+            F32 u = (time - left->first) / (right->first - left->first);
+            return lerp(left->second, right->second, u);
+        }
+    };
+
+    // One generated animation, loaded both ways
+    struct Animation
+    {
+        F32 mDuration;
+        std::vector<std::unique_ptr<JointMotion> > mJoints;
+        std::vector<ReferenceJoint> mReference;
+    };
+
+    struct llkeyframecurve_test
+    {
+        std::mt19937 mRandom;
+
+        llkeyframecurve_test() : mRandom(0xc0a7e) {}
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        // Keys arrive as deserialize() reads them: times quantized to U16,
+        // so duplicates happen, and not necessarily in order.
+        Animation* makeAnimation(S32 joints, S32 max_keys)
+        {
+            Animation* anim = new Animation;
+            anim->mDuration = frand(0.5f, 10.f);
+            anim->mReference.resize(joints);
+            for (S32 j = 0; j < joints; j++)
+            {
+                anim->mJoints.emplace_back(new JointMotion);
+                JointMotion* joint = anim->mJoints.back().get();
+                ReferenceJoint& reference = anim->mReference[j];
+
+                joint->mRotationCurve.mNumKeys = 1 + (S32)(mRandom() % max_keys);
+                LLQuaternion rot;
+                for (S32 k = 0; k < joint->mRotationCurve.mNumKeys; k++)
+                {
+                    U16 time_short = (mRandom() % 8) ? (U16)(k * 65535 / joint->mRotationCurve.mNumKeys) : (U16)mRandom();
+                    F32 time = U16_to_F32(time_short, 0.f, anim->mDuration);
+                    // mostly small steps, with the odd flip into the other hemisphere
+                    rot = rot * LLQuaternion(frand(-0.6f, 0.6f), LLVector3(frand(-1.f, 1.f), frand(-1.f, 1.f), 1.f));
+                    LLQuaternion key_rot = (mRandom() % 10) ? rot : -rot;
+
+                    KeyframeCurveAccess::RotationKey rot_key(time, key_rot);
+                    joint->mRotationCurve.mKeys[time] = rot_key;
+                    reference.mRotations[time] = key_rot;
+                }
+
+                if (j == 0)
+                {
+                    // only the pelvis moves
+                    joint->mPositionCurve.mNumKeys = 1 + (S32)(mRandom() % max_keys);
+                    for (S32 k = 0; k < joint->mPositionCurve.mNumKeys; k++)
+                    {
+                        F32 time = U16_to_F32((U16)mRandom(), 0.f, anim->mDuration);
+                        LLVector3 pos(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f));
+                        KeyframeCurveAccess::PositionKey pos_key(time, pos);
+                        joint->mPositionCurve.mKeys[pos_key.mTime] = pos_key;
+                        reference.mPositions[time] = pos;
+                    }
+                }
+            }
+            return anim;
+        }
+
+        static bool same(F32 a, F32 b)
+        {
+#if defined(__aarch64__) || defined(__arm64__)
+            // the scalar reference may be compiled to fused multiply-adds here
+            return fabsf(a - b) <= 1e-6f;
+#else
+            return a == b;
+#endif
+        }
+
+        static bool sameRotation(const LLQuaternion& a, const LLQuaternion& b)
+        {
+            return same(a.mQ[VX], b.mQ[VX]) && same(a.mQ[VY], b.mQ[VY]) && same(a.mQ[VZ], b.mQ[VZ]) && same(a.mQ[VW], b.mQ[VW]);
+        }
+
+        static bool samePosition(const LLVector3& a, const LLVector3& b)
+        {
+            return same(a.mV[VX], b.mV[VX]) && same(a.mV[VY], b.mV[VY]) && same(a.mV[VZ], b.mV[VZ]);
+        }
+    };
+    typedef test_group<llkeyframecurve_test> llkeyframecurve_test_t;
+    typedef llkeyframecurve_test_t::object llkeyframecurve_object_t;
+    tut::llkeyframecurve_test_t tut_llkeyframecurve_test("LLKeyframeCurve");
+
+    template<> template<>
+    void llkeyframecurve_object_t::test<1>()
+    {
+        set_test_name("keys load like std::map");
+
+        std::unique_ptr<Animation> anim(makeAnimation(30, 80));
+        for (size_t j = 0; j < anim->mJoints.size(); j++)
+        {
+            const JointMotion* joint = anim->mJoints[j].get();
+            const ReferenceJoint& reference = anim->mReference[j];
+            ensure_equals("duplicates folded", joint->mRotationCurve.mKeys.size(), reference.mRotations.size());
+
+            std::map<F32, LLQuaternion>::const_iterator ref_it = reference.mRotations.begin();
+            for (const KeyframeCurveAccess::RotationKey& key : joint->mRotationCurve.mKeys)
+            {
+                ensure_equals("sorted by time", key.mTime, ref_it->first);
+                ensure("last write wins", key.mRotation == ref_it->second);
+                ++ref_it;
+            }
+        }
+    }
+
+    template<> template<>
+    void llkeyframecurve_object_t::test<2>()
+    {
+        set_test_name("joint outputs identical to map lookup and nlerp");
+
+        std::unique_ptr<Animation> anim(makeAnimation(40, 120));
+        std::vector<KeyCursor> cursors(anim->mJoints.size());
+        LLPointer<LLJointState> state = new LLJointState;
+        state->setUsage(LLJointState::ROT | LLJointState::POS);
+
+        F32 time = 0.f;
+        for (S32 step = 0; step < 5000; step++)
+        {
+            S32 action = mRandom() % 100;
+            if (action < 2)
+            {
+                // seek anywhere, including before the start and past the end
+                time = frand(-0.5f, anim->mDuration + 0.5f);
+            }
+            else if (action < 5)
+            {
+                // land exactly on a key
+                const ReferenceJoint& reference = anim->mReference[mRandom() % anim->mReference.size()];
+                std::map<F32, LLQuaternion>::const_iterator it = reference.mRotations.begin();
+                std::advance(it, mRandom() % reference.mRotations.size());
+                time = it->first;
+            }
+            else
+            {
+                // play on at a ragged frame rate, looping
+                time += frand(0.f, 0.05f);
+                if (time > anim->mDuration)
+                {
+                    time -= anim->mDuration;
+                }
+            }
+
+            for (size_t j = 0; j < anim->mJoints.size(); j++)
+            {
+                JointMotion* joint = anim->mJoints[j].get();
+                const ReferenceJoint& reference = anim->mReference[j];
+
+                joint->update(state, time, anim->mDuration, cursors[j]);
+                ensure("same rotation", sameRotation(state->getRotation(), reference.getRotation(time)));
+                ensure("same as without a cursor", sameRotation(state->getRotation(), joint->mRotationCurve.getValue(time, anim->mDuration)));
+                if (!reference.mPositions.empty())
+                {
+                    ensure("same position", samePosition(state->getPosition(), reference.getPosition(time)));
+                }
+            }
+        }
+    }
+
+    template<> template<>
+    void llkeyframecurve_object_t::test<3>()
+    {
+        set_test_name("slerp and nlerp match LLQuaternion");
+
+        for (S32 i = 0; i < 20000; i++)
+        {
+            LLQuaternion a(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f));
+            LLQuaternion b(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f));
+            if (i % 4 == 0)
+            {
+                // nearly the same rotation
+                b = a * LLQuaternion(frand(-0.001f, 0.001f), LLVector3::z_axis);
+            }
+            F32 t = frand(0.f, 1.f);
+
+            LLQuaternion2 result;
+            LLQuaternion out;
+            result.setNlerp(t, LLQuaternion2(a), LLQuaternion2(b));
+            _mm_storeu_ps(out.mQ, result.getVector4a());
+            ensure("nlerp", sameRotation(out, nlerp(t, a, b)));
+
+            result.setSlerp(t, LLQuaternion2(a), LLQuaternion2(b));
+            _mm_storeu_ps(out.mQ, result.getVector4a());
+            ensure("slerp", sameRotation(out, slerp(t, a, b)));
+        }
+    }
+
+    template<> template<>
+    void llkeyframecurve_object_t::test<4>()
+    {
+        set_test_name("cursors over a library of playing animations");
+
+        const S32 ANIMATIONS = 40;
+        const S32 JOINTS = 30;
+        const S32 INSTANCES = 200;      // motions playing, a few per avatar
+        const S32 FRAMES = 100;
+        const F32 FRAME_TIME = 1.f / 45.f;
+
+        std::vector<std::unique_ptr<Animation> > library;
+        for (S32 i = 0; i < ANIMATIONS; i++)
+        {
+            library.emplace_back(makeAnimation(JOINTS, 150));
+        }
+
+        std::vector<Animation*> playing(INSTANCES);
+        std::vector<F32> start(INSTANCES);
+        std::vector<std::vector<KeyCursor> > cursors(INSTANCES);
+        for (S32 i = 0; i < INSTANCES; i++)
+        {
+            playing[i] = library[mRandom() % ANIMATIONS].get();
+            start[i] = frand(0.f, playing[i]->mDuration);
+            cursors[i].resize(JOINTS);
+        }
+
+        LLPointer<LLJointState> state = new LLJointState;
+        state->setUsage(LLJointState::ROT | LLJointState::POS);
+
+        for (S32 frame = 0; frame < FRAMES; frame++)
+        {
+            for (S32 i = 0; i < INSTANCES; i++)
+            {
+                F32 time = fmodf(start[i] + frame * FRAME_TIME, playing[i]->mDuration);
+                for (S32 j = 0; j < JOINTS; j++)
+                {
+                    playing[i]->mJoints[j]->update(state, time, playing[i]->mDuration, cursors[i][j]);
+                }
+                ensure("last rotation matches",
+                       sameRotation(playing[i]->mReference.back().getRotation(time), state->getRotation()));
+            }
+        }
+    }
+}
@@ -0,0 +1,479 @@
+/**
+ * @file llmotionbatch_test.cpp
+ * @brief Test cases for evaluating character motions concurrently.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "llframetimer.h"
+#include "lltimer.h"
+#include "threadpool.h"
+#include "v3dmath.h"
+
+#include "../llcharacter.h"
+#include "../lljoint.h"
+#include "../llmotion.h"
+#include "../llvisualparam.h"
+
+#include "../test/lltut.h"
+
+#include <cmath>
+#include <thread>
+
+namespace tut
+{
+    const S32 TEST_JOINTS = 100;
+
+    const LLUUID WAVE_MOTION_ID("6b56b4d6-7a3d-4bd8-a2b1-1d6f2a1c4a01");
+    const LLUUID SWAY_MOTION_ID("6b56b4d6-7a3d-4bd8-a2b1-1d6f2a1c4a02");
+    const LLUUID GESTURE_MOTION_ID("6b56b4d6-7a3d-4bd8-a2b1-1d6f2a1c4a03");
+    const LLUUID BLINK_MOTION_ID("6b56b4d6-7a3d-4bd8-a2b1-1d6f2a1c4a04");
+
+    const S32 BLINK_PARAM_ID = 42;
+
+    // Rotates every joint but the first, as a keyframe motion would, from the
+    // number of updates so far rather than the time: the two characters
+    // being compared have their own frame timers.
+    class WaveMotion : public LLMotion
+    {
+    public:
+        WaveMotion(const LLUUID& id) : LLMotion(id), mUpdates(0) {}
+        static LLMotion* create(const LLUUID& id) { return new WaveMotion(id); }
+
+        bool getLoop() { return true; }
+        F32 getDuration() { return 0.f; }
+        F32 getEaseInDuration() { return 0.f; }
+        F32 getEaseOutDuration() { return 0.f; }
+        LLJoint::JointPriority getPriority() { return LLJoint::MEDIUM_PRIORITY; }
+        LLMotionBlendType getBlendType() { return NORMAL_BLEND; }
+        F32 getMinPixelArea() { return 0.f; }
+        bool canUpdateConcurrently() { return true; }
+
+        LLMotionInitStatus onInitialize(LLCharacter* character)
+        {
+            for (S32 i = 1; i < TEST_JOINTS; i++)
+            {
+                LLPointer<LLJointState> state = new LLJointState(character->getCharacterJoint(i));
+                state->setUsage(LLJointState::ROT);
+                addJointState(state);
+                mStates.push_back(state);
+            }
+            return STATUS_SUCCESS;
+        }
+
+        bool onActivate() { return true; }
+
+        bool onUpdate(F32 time, U8* joint_mask)
+        {
+            F32 phase = (F32)mUpdates++ * phaseStep();
+            for (size_t i = 0; i < mStates.size(); i++)
+            {
+                // a few quaternion products per joint, about what a keyframe
+                // curve lookup and slerp cost
+                LLQuaternion rot;
+                for (S32 j = 0; j < 4; j++)
+                {
+                    rot = rot * LLQuaternion(sinf(phase + (F32)(i + j)) * 0.5f, LLVector3(0.3f * j, 1.f, 0.2f * i));
+                }
+                mStates[i]->setRotation(rot);
+            }
+            return true;
+        }
+
+        void onDeactivate() {}
+
+    protected:
+        virtual F32 phaseStep() const { return 0.05f; }
+
+        std::vector<LLPointer<LLJointState> > mStates;
+        U32 mUpdates;
+    };
+
+    // Blended on top of the wave, like breathing or body noise
+    class SwayMotion : public WaveMotion
+    {
+    public:
+        SwayMotion(const LLUUID& id) : WaveMotion(id) {}
+        static LLMotion* create(const LLUUID& id) { return new SwayMotion(id); }
+
+        LLMotionBlendType getBlendType() { return ADDITIVE_BLEND; }
+
+    protected:
+        F32 phaseStep() const { return 0.13f; }
+    };
+
+    // Runs briefly on the first joint and stops itself
+    class GestureMotion : public LLMotion
+    {
+    public:
+        GestureMotion(const LLUUID& id) : LLMotion(id) {}
+        static LLMotion* create(const LLUUID& id) { return new GestureMotion(id); }
+
+        bool getLoop() { return false; }
+        F32 getDuration() { return 0.02f; }
+        F32 getEaseInDuration() { return 0.f; }
+        F32 getEaseOutDuration() { return 0.01f; }
+        LLJoint::JointPriority getPriority() { return LLJoint::HIGH_PRIORITY; }
+        LLMotionBlendType getBlendType() { return NORMAL_BLEND; }
+        F32 getMinPixelArea() { return 0.f; }
+        bool canUpdateConcurrently() { return true; }
+
+        LLMotionInitStatus onInitialize(LLCharacter* character)
+        {
+            mState = new LLJointState(character->getCharacterJoint(0));
+            mState->setUsage(LLJointState::ROT);
+            addJointState(mState);
+            return STATUS_SUCCESS;
+        }
+
+        bool onActivate() { return true; }
+
+        bool onUpdate(F32 time, U8* joint_mask)
+        {
+            mState->setRotation(LLQuaternion(time, LLVector3::z_axis));
+            return true;
+        }
+
+        void onDeactivate() {}
+
+    private:
+        LLPointer<LLJointState> mState;
+    };
+
+    // A visual param that notes which thread sets it, as a driver param
+    // would touch the params it drives
+    class TestParamInfo : public LLVisualParamInfo
+    {
+    public:
+        TestParamInfo()
+        {
+            mID = BLINK_PARAM_ID;
+            mName = "Blink_Test";
+        }
+    };
+
+    class TestParam : public LLVisualParam
+    {
+    public:
+        TestParam() : mWrites(0)
+        {
+            mInfo = &mTestInfo;
+            mID = mTestInfo.getID();
+        }
+
+        void apply(ESex avatar_sex) {}
+
+        void setWeight(F32 weight, bool upload_bake)
+        {
+            ++mWrites;
+            mWriteThread = std::this_thread::get_id();
+            LLVisualParam::setWeight(weight, upload_bake);
+        }
+
+        TestParamInfo mTestInfo;
+        S32 mWrites;
+        std::thread::id mWriteThread;
+    };
+
+    // Sets the param through the character each update, as LLHeadRotMotion
+    // blinks, and reads it back
+    class BlinkMotion : public GestureMotion
+    {
+    public:
+        BlinkMotion(const LLUUID& id) : GestureMotion(id), mCharacter(NULL), mUpdates(0), mReadBack(-1.f) {}
+        static LLMotion* create(const LLUUID& id) { return new BlinkMotion(id); }
+
+        bool getLoop() { return true; }
+        F32 getDuration() { return 0.f; }
+
+        LLMotionInitStatus onInitialize(LLCharacter* character)
+        {
+            mCharacter = character;
+            return GestureMotion::onInitialize(character);
+        }
+
+        bool onUpdate(F32 time, U8* joint_mask)
+        {
+            mCharacter->setVisualParamWeight("Blink_Test", expected(++mUpdates));
+            mReadBack = mCharacter->getVisualParamWeight("Blink_Test");
+            return GestureMotion::onUpdate(time, joint_mask);
+        }
+
+        static F32 expected(U32 updates) { return (F32)(updates % 10) / 10.f; }
+
+        LLCharacter* mCharacter;
+        U32 mUpdates;
+        F32 mReadBack;
+    };
+
+    class TestCharacter : public LLCharacter
+    {
+    public:
+        TestCharacter() : mID(LLUUID::generateNewID()), mStopRequests(0)
+        {
+            mRoot.setName("mRoot");
+            for (S32 i = 0; i < TEST_JOINTS; i++)
+            {
+                mJoints.push_back(new LLJoint(i));
+                mJoints.back()->setup(llformat("joint%d", i), i ? mJoints[i - 1] : &mRoot);
+            }
+            registerMotion(WAVE_MOTION_ID, WaveMotion::create);
+            registerMotion(SWAY_MOTION_ID, SwayMotion::create);
+            registerMotion(GESTURE_MOTION_ID, GestureMotion::create);
+            registerMotion(BLINK_MOTION_ID, BlinkMotion::create);
+        }
+
+        ~TestCharacter()
+        {
+            for (std::vector<LLJoint*>::reverse_iterator it = mJoints.rbegin(); it != mJoints.rend(); ++it)
+            {
+                delete *it;
+            }
+        }
+
+        const char* getAnimationPrefix() { return "test"; }
+        LLJoint* getRootJoint() { return &mRoot; }
+        LLVector3 getCharacterPosition() { return LLVector3::zero; }
+        LLQuaternion getCharacterRotation() { return LLQuaternion::DEFAULT; }
+        LLVector3 getCharacterVelocity() { return LLVector3::zero; }
+        LLVector3 getCharacterAngularVelocity() { return LLVector3::zero; }
+        void getGround(const LLVector3& inPos, LLVector3& outPos, LLVector3& outNorm)
+        {
+            outPos = inPos;
+            outPos.mV[VZ] = 0.f;
+            outNorm = LLVector3::z_axis;
+        }
+        LLJoint* getCharacterJoint(U32 i) { return i < mJoints.size() ? mJoints[i] : NULL; }
+        F32 getTimeDilation() { return 1.f; }
+        F32 getPixelArea() const { return 1000.f; }
+        LLPolyMesh* getHeadMesh() { return NULL; }
+        LLPolyMesh* getUpperBodyMesh() { return NULL; }
+        LLVector3d getPosGlobalFromAgent(const LLVector3& position) { return LLVector3d(position); }
+        LLVector3 getPosAgentFromGlobal(const LLVector3d& position) { return LLVector3(position); }
+        void addDebugText(const std::string& text) {}
+        const LLUUID& getID() const { return mID; }
+
+        void requestStopMotion(LLMotion* motion)
+        {
+            ++mStopRequests;
+            mStopThread = std::this_thread::get_id();
+        }
+
+        LLUUID mID;
+        LLJoint mRoot;
+        std::vector<LLJoint*> mJoints;
+        S32 mStopRequests;
+        std::thread::id mStopThread;
+    };
+
+    struct llmotionbatch_test
+    {
+        LL::ThreadPool mPool{"MotionBatchTest", 3};
+
+        llmotionbatch_test()
+        {
+            mPool.start();
+        }
+
+        ~llmotionbatch_test()
+        {
+            mPool.close();
+        }
+
+        void startLooping(TestCharacter& character)
+        {
+            character.startMotion(WAVE_MOTION_ID);
+            character.startMotion(SWAY_MOTION_ID);
+        }
+
+        void updateBatch(const std::vector<LLCharacter*>& characters, size_t max_helpers = 0)
+        {
+            for (LLCharacter* character : characters)
+            {
+                character->beginUpdateMotions(LLCharacter::NORMAL_UPDATE);
+            }
+            LLCharacter::evaluateMotionsConcurrently(characters, "MotionBatchTest", max_helpers);
+            for (LLCharacter* character : characters)
+            {
+                character->finishUpdateMotions();
+            }
+        }
+
+        // Largest difference between the joint rotations of two characters
+        F32 compare(TestCharacter& a, TestCharacter& b)
+        {
+            F32 max_diff = 0.f;
+            for (S32 i = 1; i < TEST_JOINTS; i++)
+            {
+                const LLQuaternion& ra = a.mJoints[i]->getRotation();
+                const LLQuaternion& rb = b.mJoints[i]->getRotation();
+                for (S32 j = 0; j < 4; j++)
+                {
+                    max_diff = llmax(max_diff, fabsf(ra.mQ[j] - rb.mQ[j]));
+                }
+            }
+            return max_diff;
+        }
+    };
+    typedef test_group<llmotionbatch_test> llmotionbatch_test_t;
+    typedef llmotionbatch_test_t::object llmotionbatch_object_t;
+    tut::llmotionbatch_test_t tut_llmotionbatch_test("LLMotionBatch");
+
+    template<> template<>
+    void llmotionbatch_object_t::test<1>()
+    {
+        set_test_name("batched evaluation matches updateMotions()");
+
+        TestCharacter serial;
+        std::vector<std::unique_ptr<TestCharacter> > batched;
+        std::vector<LLCharacter*> characters;
+        startLooping(serial);
+        for (S32 i = 0; i < 8; i++)
+        {
+            batched.emplace_back(new TestCharacter());
+            startLooping(*batched.back());
+            characters.push_back(batched.back().get());
+        }
+
+        for (S32 frame = 0; frame < 50; frame++)
+        {
+            serial.updateMotions(LLCharacter::NORMAL_UPDATE);
+            for (LLCharacter* character : characters)
+            {
+                ensure("can batch", character->canUpdateMotionsConcurrently(LLCharacter::NORMAL_UPDATE));
+            }
+            updateBatch(characters);
+            for (std::unique_ptr<TestCharacter>& character : batched)
+            {
+                ensure("same pose", compare(serial, *character) < 1e-6f);
+                ensure("not left updating", !character->isUpdatingMotions());
+            }
+        }
+        ensure("hidden updates stay serial", !characters[0]->canUpdateMotionsConcurrently(LLCharacter::HIDDEN_UPDATE));
+    }
+
+    template<> template<>
+    void llmotionbatch_object_t::test<2>()
+    {
+        set_test_name("stop requests and deactivation wait for the main thread");
+
+        TestCharacter character;
+        std::vector<LLCharacter*> characters(1, &character);
+        startLooping(character);
+        character.startMotion(GESTURE_MOTION_ID);
+        ensure("gesture active", character.isMotionActive(GESTURE_MOTION_ID));
+
+        for (S32 frame = 0; frame < 200 && character.isMotionActive(GESTURE_MOTION_ID); frame++)
+        {
+            ms_sleep(1);
+            LLFrameTimer::updateFrameTime();
+            character.beginUpdateMotions(LLCharacter::NORMAL_UPDATE);
+            S32 requests = character.mStopRequests;
+            bool active = character.isMotionActive(GESTURE_MOTION_ID);
+            LLCharacter::evaluateMotionsConcurrently(characters, "MotionBatchTest");
+            ensure_equals("no stop request during evaluation", character.mStopRequests, requests);
+            ensure_equals("not deactivated during evaluation", character.isMotionActive(GESTURE_MOTION_ID), active);
+            character.finishUpdateMotions();
+        }
+
+        ensure("gesture deactivated", !character.isMotionActive(GESTURE_MOTION_ID));
+        ensure_equals("stop requested once", character.mStopRequests, 1);
+        ensure("stop requested on the main thread", character.mStopThread == std::this_thread::get_id());
+    }
+
+    template<> template<>
+    void llmotionbatch_object_t::test<3>()
+    {
+        set_test_name("same pose whatever the pool width");
+
+        const S32 CHARACTERS = 24;
+        const S32 FRAMES = 20;
+
+        for (size_t helpers = 1; helpers <= 3; helpers++)
+        {
+            TestCharacter serial;
+            startLooping(serial);
+            std::vector<std::unique_ptr<TestCharacter> > owned;
+            std::vector<LLCharacter*> characters;
+            for (S32 i = 0; i < CHARACTERS; i++)
+            {
+                owned.emplace_back(new TestCharacter());
+                startLooping(*owned.back());
+                characters.push_back(owned.back().get());
+            }
+
+            for (S32 frame = 0; frame < FRAMES; frame++)
+            {
+                serial.updateMotions(LLCharacter::NORMAL_UPDATE);
+                updateBatch(characters, helpers);
+            }
+            for (std::unique_ptr<TestCharacter>& character : owned)
+            {
+                ensure("same pose", compare(serial, *character) < 1e-6f);
+            }
+        }
+    }
+
+    template<> template<>
+    void llmotionbatch_object_t::test<4>()
+    {
+        set_test_name("visual param weights are set on the main thread");
+
+        TestCharacter character;
+        TestParam* param = new TestParam();
+        character.addVisualParam(param);
+        std::vector<LLCharacter*> characters(1, &character);
+        character.startMotion(BLINK_MOTION_ID);
+        BlinkMotion* blink = dynamic_cast<BlinkMotion*>(character.findMotion(BLINK_MOTION_ID));
+        ensure("blink motion", blink != NULL);
+
+        for (S32 frame = 0; frame < 20; frame++)
+        {
+            ms_sleep(1);
+            LLFrameTimer::updateFrameTime();
+            character.beginUpdateMotions(LLCharacter::NORMAL_UPDATE);
+            const S32 writes = param->mWrites;
+            const F32 weight = param->getWeight();
+            const U32 updates = blink->mUpdates;
+            LLCharacter::evaluateMotionsConcurrently(characters, "MotionBatchTest");
+            if (blink->mUpdates == updates)
+            {
+                character.finishUpdateMotions();
+                continue;
+            }
+            ensure_equals("param untouched during evaluation", param->mWrites, writes);
+            ensure_equals("weight unchanged during evaluation", param->getWeight(), weight);
+            ensure_equals("motion reads back what it set", blink->mReadBack, BlinkMotion::expected(blink->mUpdates));
+
+            character.finishUpdateMotions();
+            ensure_equals("set once when finished", param->mWrites, writes + 1);
+            ensure("set on the main thread", param->mWriteThread == std::this_thread::get_id());
+            ensure_equals("weight set when finished", param->getWeight(), BlinkMotion::expected(blink->mUpdates));
+        }
+        ensure("motion updated", blink->mUpdates > 0);
+
+        // outside a batch, weights are set right away
+        character.setVisualParamWeight("Blink_Test", 0.75f);
+        ensure_equals("set directly", param->getWeight(), 0.75f);
+    }
+}
@@ -345,6 +345,10 @@ void LLApp::setErrorHandler(LLAppErrorHandler handler)
 // static
 void LLApp::runErrorHandler()
 {
+    // <FS> Async logging: get what was logged up to the crash into the log
+    LLError::flushAsyncLog();
+    // </FS>
+
     if (LLApp::sErrorHandler)
     {
         LLApp::sErrorHandler();
@@ -0,0 +1,270 @@
+/**
+ * @file llasyncfile.cpp
+ * @brief File reads and writes for coroutines, on I/O threads.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llasyncfile.h"
+
+#include "llcoros.h"
+#include "llfile.h"
+#include "stringize.h"
+#include "threadpool.h"
+
+#include <cerrno>
+#include <functional>
+
+namespace
+{
+    const std::string POOL_NAME("AsyncFile");
+
+    int seek(LLFILE* file, S64 offset, int origin = SEEK_SET)
+    {
+#if LL_WINDOWS
+        return _fseeki64(file, offset, origin);
+#else
+        return fseeko(file, (off_t)offset, origin);
+#endif
+    }
+
+    S64 tell(LLFILE* file)
+    {
+#if LL_WINDOWS
+        return _ftelli64(file);
+#else
+        return ftello(file);
+#endif
+    }
+
+    // On an I/O thread
+    LLAsyncFile::EStatus read_file(const std::string& filename, S64 offset, S64 length,
+                                   std::string& data, const LLAsyncFile::CancelToken& cancel)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        data.clear();
+        if (cancel.isCancelled())
+        {
+            return LLAsyncFile::CANCELLED;
+        }
+
+        LLFILE* file = LLFile::fopen(filename, "rb");
+        if (!file)
+        {
+            return errno == ENOENT ? LLAsyncFile::NOT_FOUND : LLAsyncFile::FAILED;
+        }
+        // what there is to read, so that data is allocated once
+        S64 size = (seek(file, 0, SEEK_END) == 0) ? tell(file) : -1;
+        if (seek(file, llmax(offset, S64(0))) != 0)
+        {
+            fclose(file);
+            return LLAsyncFile::FAILED;
+        }
+        if (size >= 0)
+        {
+            S64 available = llmax(size - offset, S64(0));
+            data.reserve((size_t)(length < 0 ? available : llmin(length, available)));
+        }
+
+        LLAsyncFile::EStatus status = LLAsyncFile::OK;
+        S64 remaining = length;
+        while (remaining)
+        {
+            if (cancel.isCancelled())
+            {
+                status = LLAsyncFile::CANCELLED;
+                break;
+            }
+            size_t chunk = LLAsyncFile::CHUNK_SIZE;
+            if (remaining > 0)
+            {
+                chunk = llmin(chunk, (size_t)remaining);
+            }
+            size_t start = data.size();
+            data.resize(start + chunk);
+            size_t got = fread(&data[start], 1, chunk, file);
+            data.resize(start + got);
+            if (remaining > 0)
+            {
+                remaining -= got;
+            }
+            if (got < chunk)
+            {
+                if (ferror(file))
+                {
+                    status = LLAsyncFile::FAILED;
+                }
+                break;
+            }
+        }
+        fclose(file);
+
+        if (status != LLAsyncFile::OK)
+        {
+            data.clear();
+        }
+        return status;
+    }
+
+    // On an I/O thread
+    LLAsyncFile::EStatus write_file(const std::string& filename, const std::string& data,
+                                    LLAsyncFile::EWriteMode mode, const LLAsyncFile::CancelToken& cancel)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        if (cancel.isCancelled())
+        {
+            return LLAsyncFile::CANCELLED;
+        }
+
+        LLFILE* file = LLFile::fopen(filename, mode == LLAsyncFile::WRITE_APPEND ? "ab" : "wb");
+        if (!file)
+        {
+            return LLAsyncFile::FAILED;
+        }
+
+        LLAsyncFile::EStatus status = LLAsyncFile::OK;
+        for (size_t written = 0; written < data.size(); )
+        {
+            if (cancel.isCancelled())
+            {
+                status = LLAsyncFile::CANCELLED;
+                break;
+            }
+            size_t chunk = llmin(LLAsyncFile::CHUNK_SIZE, data.size() - written);
+            if (fwrite(data.data() + written, 1, chunk, file) != chunk)
+            {
+                status = LLAsyncFile::FAILED;
+                break;
+            }
+            written += chunk;
+        }
+        if (fclose(file) != 0 && status == LLAsyncFile::OK)
+        {
+            status = LLAsyncFile::FAILED;
+        }
+        return status;
+    }
+}
+
+LLAsyncFile::LLAsyncFile()
+{
+    size_t threads = llmax(LL::ThreadPoolBase::getConfiguredWidth(POOL_NAME, DEFAULT_THREADS), size_t(1));
+    for (size_t i = 0; i < threads; ++i)
+    {
+        Lane* lane = new Lane;
+        lane->mPool.reset(new LL::ThreadPool(STRINGIZE(POOL_NAME << '.' << i), 1));
+        lane->mPool->start();
+        mLanes.emplace_back(lane);
+    }
+}
+
+LLAsyncFile::~LLAsyncFile()
+{
+    for (auto& lane : mLanes)
+    {
+        lane->mPool->close();
+    }
+}
+
+LLAsyncFile::Lane& LLAsyncFile::getLane(const std::string& filename)
+{
+    return *mLanes[std::hash<std::string>()(filename) % mLanes.size()];
+}
+
+// On the lane's thread
+void LLAsyncFile::Lane::run(U64 ticket, std::function<void()>&& operation)
+{
+    mWaiting.emplace(ticket, std::move(operation));
+    while (!mWaiting.empty() && mWaiting.begin()->first == mNextRun)
+    {
+        std::function<void()> next(std::move(mWaiting.begin()->second));
+        mWaiting.erase(mWaiting.begin());
+        ++mNextRun;
+        next();
+    }
+}
+
+LLAsyncFile::EStatus LLAsyncFile::call(const std::string& filename, std::function<EStatus()>&& operation)
+{
+    // as WorkQueue::waitForResult(): the default coroutine has nobody to
+    // hand over to
+    if (LLCoros::getName().empty())
+    {
+        LLTHROW(LL::WorkQueueBase::Error("Do not call LLAsyncFile from a thread's default coroutine"));
+    }
+
+    Lane& lane = getLane(filename);
+    // before anything that could let another coroutine in
+    U64 ticket = lane.mNextTicket++;
+
+    // The caller waits for the result, so the lane can work on the caller's
+    // own data
+    LLCoros::Promise<EStatus> promise;
+    auto future{ LLCoros::getFuture(promise) };
+    bool posted = lane.mPool->getQueue().post(
+        [&lane, ticket, &promise, &operation]()
+        {
+            lane.run(ticket, [&promise, &operation]()
+            {
+                try
+                {
+                    promise.set_value(operation());
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+            });
+        });
+    if (!posted)
+    {
+        LLTHROW(LL::WorkQueueBase::Closed());
+    }
+    LLCoros::TempStatus st("waiting for LLAsyncFile");
+    return future.get();
+}
+
+LLAsyncFile::EStatus LLAsyncFile::read(const std::string& filename, std::string& data,
+                                       const CancelToken& cancel)
+{
+    return read(filename, 0, -1, data, cancel);
+}
+
+LLAsyncFile::EStatus LLAsyncFile::read(const std::string& filename, S64 offset, S64 length,
+                                       std::string& data, const CancelToken& cancel)
+{
+    return call(filename, [&filename, offset, length, &data, cancel]()
+    {
+        return read_file(filename, offset, length, data, cancel);
+    });
+}
+
+LLAsyncFile::EStatus LLAsyncFile::write(const std::string& filename, const std::string& data,
+                                        EWriteMode mode, const CancelToken& cancel)
+{
+    return call(filename, [&filename, &data, mode, cancel]()
+    {
+        return write_file(filename, data, mode, cancel);
+    });
+}
@@ -0,0 +1,137 @@
+/**
+ * @file llasyncfile.h
+ * @brief File reads and writes for coroutines, on I/O threads.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLASYNCFILE_H
+#define LL_LLASYNCFILE_H
+
+#include "llsingleton.h"
+#include "threadpool_fwd.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// LLAsyncFile
+//
+// Reads and writes files on I/O threads for a coroutine, which waits for the
+// result without holding up the rest of its thread: a coroutine on the main
+// thread doing file I/O this way lets the main loop keep running.
+//
+// Every call must come from a coroutine launched with LLCoros, not from a
+// thread's main coroutine, which would have nobody to hand over to while it
+// waits (see WorkQueue::waitForResult()).
+//
+// Operations on the same file run one after the other, in the order the
+// calls were made; operations on different files may run at the same time.
+// The number of I/O threads is the "AsyncFile" entry of ThreadPoolSizes.
+//-----------------------------------------------------------------------------
+class LL_COMMON_API LLAsyncFile: public LLSingleton<LLAsyncFile>
+{
+    LLSINGLETON(LLAsyncFile);
+    ~LLAsyncFile();
+
+public:
+    enum EStatus
+    {
+        OK = 0,
+        NOT_FOUND,          // no such file to read
+        FAILED,             // couldn't open, read or write the file
+        CANCELLED
+    };
+
+    enum EWriteMode
+    {
+        WRITE_REPLACE = 0,
+        WRITE_APPEND
+    };
+
+    // Cancels the operations it is passed to: one not started yet when
+    // cancel() is called doesn't run, one under way stops at the next chunk.
+    // Copies share the same state, so keep one and hand copies out.
+    class CancelToken
+    {
+    public:
+        CancelToken()
+        :   mCancelled(std::make_shared<std::atomic<bool>>(false))
+        {}
+
+        void cancel()               { *mCancelled = true; }
+        bool isCancelled() const    { return *mCancelled; }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> mCancelled;
+    };
+
+    // I/O threads unless ThreadPoolSizes says otherwise
+    static const size_t DEFAULT_THREADS = 2;
+    // Reads and writes are done in chunks of this, checking for cancellation
+    // in between
+    static const size_t CHUNK_SIZE = 256 * 1024;
+
+    // All of filename into data
+    EStatus read(const std::string& filename, std::string& data,
+                 const CancelToken& cancel = CancelToken());
+    // Up to length bytes of filename from offset into data, less when the
+    // file ends before
+    EStatus read(const std::string& filename, S64 offset, S64 length, std::string& data,
+                 const CancelToken& cancel = CancelToken());
+    // data to filename. A cancelled write may have written part of data.
+    EStatus write(const std::string& filename, const std::string& data,
+                  EWriteMode mode = WRITE_REPLACE,
+                  const CancelToken& cancel = CancelToken());
+
+    size_t getThreadCount() const   { return mLanes.size(); }
+
+private:
+    // A single I/O thread. Every operation takes a ticket when it's called,
+    // and the thread runs them in ticket order, whatever order they reach its
+    // queue in: posting to the queue can let another coroutine's call in
+    // first.
+    struct Lane
+    {
+        std::unique_ptr<LL::ThreadPool> mPool;
+        std::atomic<U64> mNextTicket{ 0 };
+        // only touched on the lane's thread
+        U64 mNextRun = 0;
+        std::map<U64, std::function<void()>> mWaiting;
+
+        void run(U64 ticket, std::function<void()>&& operation);
+    };
+
+    // The lane all operations on filename go to
+    Lane& getLane(const std::string& filename);
+
+    // Runs operation on filename's lane, waiting for its result
+    EStatus call(const std::string& filename, std::function<EStatus()>&& operation);
+
+    std::vector<std::unique_ptr<Lane>> mLanes;
+};
+
+#endif // LL_LLASYNCFILE_H
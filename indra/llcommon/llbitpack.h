@@ -72,25 +72,7 @@ public:
             data = *total_data++;
 
             data <<= (MAX_DATA_BITS - dsize);
-            while (dsize > 0)
-            {
-                if (mLoadSize == MAX_DATA_BITS)
-                {
-                    *(mBuffer + mBufferSize++) = mLoad;
-                    if (mBufferSize > mMaxSize)
-                    {
-                        LL_ERRS() << "mBufferSize exceeding mMaxSize!" << LL_ENDL;
-                    }
-                    mLoadSize = 0;
-                    mLoad = 0x00;
-                }
-                mLoad <<= 1;
-                mLoad |= (data >> (MAX_DATA_BITS - 1));
-                data <<= 1;
-                mLoadSize++;
-                mTotalBits++;
-                dsize--;
-            }
+            packBits(data, dsize); // <FS/> was a bit-at-a-time loop
         }
         return mBufferSize;
     }
@@ -115,25 +97,7 @@ public:
 
             data = *total_data++;
 
-            while (dsize > 0)
-            {
-                if (mLoadSize == MAX_DATA_BITS)
-                {
-                    *(mBuffer + mBufferSize++) = mLoad;
-                    if (mBufferSize > mMaxSize)
-                    {
-                        LL_ERRS() << "mBufferSize exceeding mMaxSize!" << LL_ENDL;
-                    }
-                    mLoadSize = 0;
-                    mLoad = 0x00;
-                }
-                mLoad <<= 1;
-                mLoad |= (data >> (MAX_DATA_BITS - 1));
-                data <<= 1;
-                mLoadSize++;
-                mTotalBits++;
-                dsize--;
-            }
+            packBits(data, dsize); // <FS/> was a bit-at-a-time loop
         }
         return mBufferSize;
     }
@@ -158,6 +122,7 @@ public:
 
             retval = total_retval++;
             *retval = 0x00;
+            // <FS> Move as many bits per step as the load byte allows rather than one at a time
             while (dsize > 0)
             {
                 if (mLoadSize == 0)
@@ -172,12 +137,13 @@ public:
                     mLoad = *(mBuffer + mBufferSize++);
                     mLoadSize = MAX_DATA_BITS;
                 }
-                *retval <<= 1;
-                *retval |= (mLoad >> (MAX_DATA_BITS - 1));
-                mLoadSize--;
-                mLoad <<= 1;
-                dsize--;
+                U32 bits = llmin(dsize, mLoadSize);
+                *retval = (U8)((*retval << bits) | (mLoad >> (MAX_DATA_BITS - bits)));
+                mLoadSize -= bits;
+                mLoad = (U8)(mLoad << bits);
+                dsize -= bits;
             }
+            // </FS>
         }
         return mBufferSize;
     }
@@ -197,6 +163,35 @@ public:
         return mBufferSize;
     }
 
+// <FS> Word-at-a-time bit packing
+private:
+    // Append the top dsize bits of data. The load byte is only written out once
+    // another bit needs room, as the original bit-at-a-time loop did.
+    void packBits(U8 data, U32 dsize)
+    {
+        while (dsize > 0)
+        {
+            if (mLoadSize == MAX_DATA_BITS)
+            {
+                *(mBuffer + mBufferSize++) = mLoad;
+                if (mBufferSize > mMaxSize)
+                {
+                    LL_ERRS() << "mBufferSize exceeding mMaxSize!" << LL_ENDL;
+                }
+                mLoadSize = 0;
+                mLoad = 0x00;
+            }
+            U32 bits = llmin(dsize, MAX_DATA_BITS - mLoadSize);
+            mLoad = (U8)((mLoad << bits) | (data >> (MAX_DATA_BITS - bits)));
+            data = (U8)(data << bits);
+            mLoadSize += bits;
+            mTotalBits += bits;
+            dsize -= bits;
+        }
+    }
+// </FS>
+
+public:
     U8      *mBuffer;
     U32     mBufferSize;
     U8      mLoad;
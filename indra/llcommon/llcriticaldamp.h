@@ -41,6 +41,12 @@ public:
     // MANIPULATORS
     static void updateInterpolants();
 
+    // <FS> Parallel animation evaluation
+    // While frozen, getInterpolant() computes cache misses without storing
+    // them, so it may be called from several threads at once.
+    static void setCacheFrozen(bool frozen) { sCacheFrozen = frozen; }
+    // </FS>
+
     // ACCESSORS
     static F32 getInterpolant(F32SecondsImplicit time_constant, bool use_cache = true);
 
@@ -66,6 +72,7 @@ protected:
     typedef std::vector<Interpolant> interpolant_vec_t;
     static interpolant_vec_t    sInterpolants;
     static F32                  sTimeDelta;
+    static bool                 sCacheFrozen; // <FS/> Parallel animation evaluation
 };
 
 typedef LLSmoothInterpolation LLCriticalDamp;
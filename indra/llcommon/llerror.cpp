@@ -31,11 +31,14 @@
 #include "llerrorcontrol.h"
 #include "llsdutil.h"
 
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #ifdef __GNUC__
 # include <cxxabi.h>
 #endif // __GNUC__
 #include <sstream>
+#include <thread>
 #if !LL_WINDOWS
 # include <syslog.h>
 # include <unistd.h>
@@ -65,6 +68,11 @@
 #include <boost/stacktrace.hpp>
 
 namespace {
+    // <FS> Async logging
+    // Set on the async log writer thread
+    thread_local bool sIsLogWriterThread = false;
+    // </FS>
+
 #if LL_WINDOWS
     void debugger_print(const std::string& s)
     {
@@ -107,6 +115,8 @@ namespace {
             return LLError::getEnabledLogTypesMask() & 0x01;
         }
 
+        virtual bool allowsAsync() override { return true; } // <FS/> Async logging
+
         virtual void recordMessage(LLError::ELevel level,
                                     const std::string& message) override
         {
@@ -167,11 +177,24 @@ namespace {
 
         std::string getFilename() const { return mName; }
 
+        // <FS> Async logging
+        virtual bool allowsAsync() override { return true; }
+
+        // The writer thread flushes after each batch instead of each message
+        void flush()
+        {
+            mFile.flush();
+        }
+        // </FS>
+
         virtual void recordMessage(LLError::ELevel level,
                                     const std::string& message) override
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
-            if (LLError::getAlwaysFlush())
+            // <FS> Async logging: the settings are not for the writer thread
+            //if (LLError::getAlwaysFlush())
+            if (!sIsLogWriterThread && LLError::getAlwaysFlush())
+            // </FS>
             {
                 mFile << message << std::endl;
             }
@@ -200,6 +223,8 @@ namespace {
             return LLError::getEnabledLogTypesMask() & 0x04;
         }
 
+        virtual bool allowsAsync() override { return true; } // <FS/> Async logging
+
         LL_FORCE_INLINE std::string createBoldANSI()
         {
             std::string ansi_code;
@@ -351,6 +376,362 @@ namespace {
 #endif
 }
 
+// <FS> Async logging
+namespace
+{
+    // Defined with writeToRecorders()
+    std::string formatMessage(const LLError::RecorderPtr& r, const LLError::CallSite& site,
+                              const std::string& time, const std::string& message,
+                              std::string& escaped_message);
+
+    // A message as it was logged, for the recorders that allow async logging.
+    // The writer thread formats it for each of them.
+    struct AsyncLogRecord
+    {
+        std::vector<LLError::RecorderPtr> mRecorders;
+        const LLError::CallSite* mSite = nullptr; // call sites flush the queue when they go
+        std::string mTime;
+        std::string mMessage;
+    };
+
+    // Bounded lock-free queue: each cell carries a sequence number that tells
+    // pushers and the popper whose turn it is (D. Vyukov's bounded MPMC queue,
+    // used here with one popper)
+    class AsyncLogQueue
+    {
+    public:
+        AsyncLogQueue(size_t capacity)
+            : mCells(new Cell[capacity]),
+              mMask(capacity - 1),
+              mPushPos(0),
+              mPopPos(0)
+        {
+            llassert((capacity & mMask) == 0);
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                mCells[i].mSequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // False if the queue is full
+        bool push(AsyncLogRecord&& record)
+        {
+            size_t pos = mPushPos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = mCells[pos & mMask];
+                const size_t seq = cell.mSequence.load(std::memory_order_acquire);
+                const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0)
+                {
+                    if (mPushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.mRecord = std::move(record);
+                        cell.mSequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = mPushPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // One thread at a time. False if the queue is empty.
+        bool pop(AsyncLogRecord& record)
+        {
+            const size_t pos = mPopPos.load(std::memory_order_relaxed);
+            Cell& cell = mCells[pos & mMask];
+            const size_t seq = cell.mSequence.load(std::memory_order_acquire);
+            if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+            {
+                return false;
+            }
+            mPopPos.store(pos + 1, std::memory_order_relaxed);
+            record = std::move(cell.mRecord);
+            cell.mSequence.store(pos + mMask + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> mSequence;
+            AsyncLogRecord mRecord;
+        };
+
+        std::unique_ptr<Cell[]> mCells;
+        const size_t mMask;
+        alignas(64) std::atomic<size_t> mPushPos;
+        alignas(64) std::atomic<size_t> mPopPos;
+    };
+
+    // Owns the queue and the thread that writes it out.
+    //
+    // While it runs, the writer thread is the only one calling the async
+    // recorders. stop() turns new messages away first, waits for the
+    // record() calls already past that check, and only then has the writer
+    // drain the queue and exit. Messages that arrive meanwhile wait for the
+    // writer to be gone before their thread records them itself.
+    class AsyncLogWriter
+    {
+    public:
+        static constexpr size_t QUEUE_CAPACITY = 16384;         // messages
+        static constexpr size_t MAX_QUEUED_BYTES = 8 << 20;     // of message text
+        static constexpr U32 FLUSH_TIMEOUT_MS = 3000;
+
+        static AsyncLogWriter& instance()
+        {
+            // never destroyed, so that logging during static destruction
+            // still finds it; stopped by LLError::setAsyncLogging(false)
+            static AsyncLogWriter* sInstance = new AsyncLogWriter;
+            return *sInstance;
+        }
+
+        void start()
+        {
+            std::lock_guard<std::mutex> lock(mControlMutex);
+            if (mState == STOPPED)
+            {
+                if (!mAtExit)
+                {
+                    // write out what is queued on the way out
+                    std::atexit([]() { instance().stop(); });
+                    mAtExit = true;
+                }
+                mStopping = false;
+                mThread = std::thread([this]() { run(); });
+                mState = RUNNING;
+            }
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(mControlMutex);
+            if (mState == RUNNING)
+            {
+                mState = STOPPING;
+                // record() calls that saw RUNNING finish their push
+                while (mPushing)
+                {
+                    std::this_thread::yield();
+                }
+                {
+                    std::lock_guard<std::mutex> wake_lock(mWakeMutex);
+                    mStopping = true;
+                }
+                mWake.notify_one();
+                mThread.join();
+                {
+                    std::lock_guard<std::mutex> wake_lock(mWakeMutex);
+                    mState = STOPPED;
+                }
+                mFlushed.notify_all();
+            }
+        }
+
+        bool isRunning() const { return mState == RUNNING; }
+
+        // False if not running, for the caller to record the message itself.
+        // True if the message was queued or dropped; recorders and time have
+        // been moved from then.
+        bool record(const LLError::CallSite& site, std::vector<LLError::RecorderPtr>& recorders,
+                    std::string& time, const std::string& message)
+        {
+            if (sIsLogWriterThread)
+            {
+                // nobody else writes to the recorders meanwhile
+                return false;
+            }
+
+            ++mPushing;
+            if (mState != RUNNING)
+            {
+                --mPushing;
+                if (mState == STOPPING)
+                {
+                    // don't write alongside the writer draining the queue:
+                    // stop() holds mControlMutex until the writer is gone
+                    std::lock_guard<std::mutex> lock(mControlMutex);
+                }
+                return false;
+            }
+
+            const size_t bytes = time.size() + message.size();
+            if (mQueuedBytes.fetch_add(bytes) + bytes > MAX_QUEUED_BYTES ||
+                !mQueue.push(AsyncLogRecord{ std::move(recorders), &site, std::move(time), message }))
+            {
+                mQueuedBytes -= bytes;
+                ++mDropped;
+                --mPushing;
+                return true;
+            }
+            // counted once queued, so flush() never waits on a dropped
+            // message; the writer may already have written this one
+            ++mQueued;
+            --mPushing;
+
+            if (mSleeping)
+            {
+                std::lock_guard<std::mutex> lock(mWakeMutex);
+                mWake.notify_one();
+            }
+            return true;
+        }
+
+        void flush()
+        {
+            if (mState != RUNNING || sIsLogWriterThread)
+            {
+                return;
+            }
+
+            const U64 target = mQueued;
+            if (mWritten >= target)
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            ++mFlushWaiters;
+            mFlushed.wait_for(lock, std::chrono::milliseconds(FLUSH_TIMEOUT_MS),
+                              [this, target]() { return mWritten >= target || mState != RUNNING; });
+            --mFlushWaiters;
+        }
+
+        U64 getDropped() const { return mDropped; }
+
+    private:
+        enum EState { STOPPED, RUNNING, STOPPING };
+
+        AsyncLogWriter()
+            : mQueue(QUEUE_CAPACITY),
+              mState(STOPPED),
+              mPushing(0),
+              mAtExit(false),
+              mStopping(false),
+              mSleeping(false),
+              mFlushWaiters(0),
+              mQueuedBytes(0),
+              mQueued(0),
+              mWritten(0),
+              mDropped(0),
+              mDroppedReported(0)
+        {}
+
+        void run()
+        {
+            sIsLogWriterThread = true;
+            LL_PROFILER_SET_THREAD_NAME("Log writer");
+
+            for (;;)
+            {
+                if (write())
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mWakeMutex);
+                if (mStopping)
+                {
+                    break;
+                }
+                mSleeping = true;
+                mWake.wait(lock, [this]() { return mStopping || mWritten < mQueued; });
+                mSleeping = false;
+            }
+
+            // whatever came in after the last write(); stop() has waited for
+            // the pushes in progress, so nothing comes after this
+            write();
+        }
+
+        // Formats and writes out what is queued. False if there was nothing.
+        bool write()
+        {
+            std::vector<LLError::RecorderPtr> recorders;
+            AsyncLogRecord record;
+            U64 written = 0;
+            while (mQueue.pop(record))
+            {
+                mQueuedBytes -= record.mTime.size() + record.mMessage.size();
+                std::string escaped_message;
+                for (const LLError::RecorderPtr& recorder : record.mRecorders)
+                {
+                    recorder->recordMessage(record.mSite->mLevel,
+                                            formatMessage(recorder, *record.mSite, record.mTime,
+                                                          record.mMessage, escaped_message));
+                    if (std::find(recorders.begin(), recorders.end(), recorder) == recorders.end())
+                    {
+                        recorders.push_back(recorder);
+                    }
+                }
+                record.mRecorders.clear();
+                ++written;
+            }
+
+            const U64 dropped = mDropped;
+            if (dropped != mDroppedReported && !recorders.empty())
+            {
+                const std::string message = "(" + std::to_string(dropped - mDroppedReported)
+                                            + " log messages dropped, the async log queue was full)";
+                mDroppedReported = dropped;
+                for (const LLError::RecorderPtr& recorder : recorders)
+                {
+                    recorder->recordMessage(LLError::LEVEL_WARN, message);
+                }
+            }
+
+            for (const LLError::RecorderPtr& recorder : recorders)
+            {
+                if (auto file = std::dynamic_pointer_cast<RecordToFile>(recorder))
+                {
+                    file->flush();
+                }
+            }
+
+            if (written)
+            {
+                mWritten += written;
+                if (mFlushWaiters)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mWakeMutex);
+                    }
+                    mFlushed.notify_all();
+                }
+            }
+            return written != 0;
+        }
+
+        AsyncLogQueue mQueue;
+        std::mutex mControlMutex;
+        std::thread mThread;
+        std::atomic<EState> mState;
+        std::atomic<U32> mPushing;  // record() calls between their state check and push
+        bool mAtExit;
+
+        std::mutex mWakeMutex;
+        std::condition_variable mWake;
+        std::condition_variable mFlushed;
+        bool mStopping;
+        std::atomic<bool> mSleeping;
+        std::atomic<U32> mFlushWaiters;
+
+        std::atomic<size_t> mQueuedBytes;
+        std::atomic<U64> mQueued;
+        std::atomic<U64> mWritten;
+        std::atomic<U64> mDropped;
+        U64 mDroppedReported;   // writer thread only
+    };
+} // anonymous
+// </FS>
+
 
 namespace
 {
@@ -697,6 +1078,9 @@ namespace LLError
 
     CallSite::~CallSite()
     {
+        // <FS> Async logging: queued messages point at their call site
+        AsyncLogWriter::instance().flush();
+        // </FS>
         delete []mTags;
     }
 
@@ -852,6 +1236,35 @@ namespace LLError
         return s->mEnabledLogTypesMask;
     }
 
+    // <FS> Async logging
+    void setAsyncLogging(bool async)
+    {
+        if (async)
+        {
+            AsyncLogWriter::instance().start();
+        }
+        else
+        {
+            AsyncLogWriter::instance().stop();
+        }
+    }
+
+    bool getAsyncLogging()
+    {
+        return AsyncLogWriter::instance().isRunning();
+    }
+
+    void flushAsyncLog()
+    {
+        AsyncLogWriter::instance().flush();
+    }
+
+    U64 getAsyncLogDropped()
+    {
+        return AsyncLogWriter::instance().getDropped();
+    }
+    // </FS>
+
     void setFunctionLevel(const std::string& function_name, ELevel level)
     {
         Globals *g = Globals::getInstance();
@@ -944,6 +1357,12 @@ namespace LLError
         {
             setEnabledLogTypesMask(config["enabled-log-types-mask"].asInteger());
         }
+        // <FS> Async logging
+        if (config.has("log-async"))
+        {
+            setAsyncLogging(config["log-async"]);
+        }
+        // </FS>
 
         if (config.has("settings") && config["settings"].isArray())
         {
@@ -1224,6 +1643,63 @@ namespace
         return out.str();
     }
 
+    // <FS> Async logging
+    // The message as writeToRecorders() always formatted it for recorder r,
+    // now also on the async log writer thread. time is only used if r wants
+    // it; escaped_message is filled in the first time it is needed.
+    std::string formatMessage(const LLError::RecorderPtr& r, const LLError::CallSite& site,
+                              const std::string& time, const std::string& message,
+                              std::string& escaped_message)
+    {
+        std::ostringstream message_stream;
+
+        if (r->wantsTime())
+        {
+            message_stream << time;
+        }
+        message_stream << " ";
+
+        if (r->wantsLevel())
+        {
+            message_stream << site.mLevelString;
+        }
+        message_stream << " ";
+
+        if (r->wantsTags())
+        {
+            message_stream << site.mTagString;
+        }
+        message_stream << " ";
+
+        if (r->wantsLocation() || site.mLevel == LLError::LEVEL_ERROR)
+        {
+            message_stream << site.mLocationString;
+        }
+        message_stream << " ";
+
+        if (r->wantsFunctionName())
+        {
+            message_stream << site.mFunctionString;
+        }
+        message_stream << " : ";
+
+        if (r->wantsMultiline())
+        {
+            message_stream << message;
+        }
+        else
+        {
+            if (escaped_message.empty())
+            {
+                escaped_message = escapedMessageLines(message);
+            }
+            message_stream << escaped_message;
+        }
+
+        return message_stream.str();
+    }
+    // </FS>
+
     void writeToRecorders(const LLError::CallSite& site, const std::string& message)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
@@ -1232,6 +1708,15 @@ namespace
 
         std::string escaped_message;
 
+        // <FS> Async logging
+        // Formatting moved to formatMessage(), and the recorders that allow
+        // it get theirs formatted on the async log writer thread
+        std::string time;
+        bool have_time = false;
+        std::vector<LLError::RecorderPtr> async_recorders;
+        const bool async = AsyncLogWriter::instance().isRunning();
+        // </FS>
+
         std::unique_lock lock(s->mRecorderMutex); LL_PROFILE_MUTEX_LOCK(s->mRecorderMutex);
         for (LLError::RecorderPtr& r : s->mRecorders)
         {
@@ -1242,53 +1727,37 @@ namespace
                 continue;
             }
 
-            std::ostringstream message_stream;
-
-            if (r->wantsTime() && s->mTimeFunction != nullptr)
-            {
-                message_stream << s->mTimeFunction();
-            }
-            message_stream << " ";
-
-            if (r->wantsLevel())
+            // <FS> Async logging
+            if (r->wantsTime() && s->mTimeFunction != nullptr && !have_time)
             {
-                message_stream << site.mLevelString;
+                time = s->mTimeFunction();
+                have_time = true;
             }
-            message_stream << " ";
 
-            if (r->wantsTags())
+            if (async && r->allowsAsync())
             {
-                message_stream << site.mTagString;
-            }
-            message_stream << " ";
-
-            if (r->wantsLocation() || level == LLError::LEVEL_ERROR)
-            {
-                message_stream << site.mLocationString;
+                async_recorders.push_back(r);
+                continue;
             }
-            message_stream << " ";
 
-            if (r->wantsFunctionName())
-            {
-                message_stream << site.mFunctionString;
-            }
-            message_stream << " : ";
+            //r->recordMessage(level, message_stream.str());
+            r->recordMessage(level, formatMessage(r, site, time, message, escaped_message));
+            // </FS>
+        }
 
-            if (r->wantsMultiline())
-            {
-                message_stream << message;
-            }
-            else
+        // <FS> Async logging
+        if (!async_recorders.empty())
+        {
+            if (!AsyncLogWriter::instance().record(site, async_recorders, time, message))
             {
-                if (escaped_message.empty())
+                // stopped meanwhile
+                for (const LLError::RecorderPtr& r : async_recorders)
                 {
-                    escaped_message = escapedMessageLines(message);
+                    r->recordMessage(level, formatMessage(r, site, time, message, escaped_message));
                 }
-                message_stream << escaped_message;
             }
-
-            r->recordMessage(level, message_stream.str());
         }
+        // </FS>
     }
 }
 
@@ -1449,6 +1918,7 @@ namespace LLError
 
         if (site.mLevel == LEVEL_ERROR)
         {
+            flushAsyncLog(); // <FS/> Async logging
             g->mFatalMessage = message;
             if (s->mCrashFunction)
             {
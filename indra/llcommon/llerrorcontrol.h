@@ -76,6 +76,21 @@ namespace LLError
     LL_COMMON_API bool getAlwaysFlush();
     LL_COMMON_API void setEnabledLogTypesMask(U32 mask);
     LL_COMMON_API U32 getEnabledLogTypesMask();
+    // <FS> Async logging
+    LL_COMMON_API void setAsyncLogging(bool async);
+    LL_COMMON_API bool getAsyncLogging();
+        // When on, messages for the recorders that allow it (the file, stderr
+        // and syslog recorders) are queued for a writer thread instead of
+        // formatted and written by the thread that logged them. The queue is
+        // bounded: when it is full, messages are dropped and counted. Turning
+        // it off writes out what is queued before the logging threads write
+        // to those recorders themselves again.
+    LL_COMMON_API void flushAsyncLog();
+        // Waits, a few seconds at most, for the writer thread to write out
+        // the messages queued so far. Done before calling the fatal function;
+        // crash handlers should call it too.
+    LL_COMMON_API U64 getAsyncLogDropped();
+    // </FS>
     LL_COMMON_API void setFunctionLevel(const std::string& function_name, LLError::ELevel);
     LL_COMMON_API void setClassLevel(const std::string& class_name, LLError::ELevel);
     LL_COMMON_API void setFileLevel(const std::string& file_name, LLError::ELevel);
@@ -149,6 +164,12 @@ namespace LLError
 
         virtual bool enabled() { return true; }
 
+        // <FS> Async logging
+        // Whether recordMessage() may be called on the async log writer
+        // thread, see setAsyncLogging()
+        virtual bool allowsAsync() { return false; }
+        // </FS>
+
         bool wantsTime();
         bool wantsTags();
         bool wantsLevel();
@@ -162,6 +162,21 @@ LLEventPump& LLEventPumps::obtain(const std::string& name)
     return make(name, false, type);
 }
 
+// <FS> Interned strings
+LLEventPump& LLEventPumps::obtain(const LLInternedString& name)
+{
+    InternedPumpMap::iterator found = mInternedPumps.find(name);
+    if (found != mInternedPumps.end())
+    {
+        return *found->second;
+    }
+    // obtain() doesn't tweak names, so the pump is registered under name
+    LLEventPump& pump = obtain(name.str());
+    mInternedPumps.emplace(name, &pump);
+    return pump;
+}
+// </FS>
+
 LLEventPump& LLEventPumps::make(const std::string& name, bool tweak,
                                 const std::string& type)
 {
@@ -311,6 +326,13 @@ void LLEventPumps::unregister(const LLEventPump& pump)
     {
         mPumpMap.erase(found);
     }
+    // <FS> Interned strings
+    InternedPumpMap::iterator ifound = mInternedPumps.find(std::string_view(pump.getName()));
+    if (ifound != mInternedPumps.end() && ifound->second == &pump)
+    {
+        mInternedPumps.erase(ifound);
+    }
+    // </FS>
     // If this instance is one we created, also remove it from mOurPumps so we
     // won't try again to delete it later!
     PumpSet::iterator psfound = mOurPumps.find(const_cast<LLEventPump*>(&pump));
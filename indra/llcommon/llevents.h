@@ -35,6 +35,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map> // <FS/> Interned strings
 #include <vector>
 #include <deque>
 #include <functional>
@@ -50,6 +51,7 @@
 #include "llexception.h"
 #include "llhandle.h"
 #include "llcoros.h"
+#include "llstringtable.h" // <FS/> Interned strings
 
 /*==========================================================================*|
 // override this to allow binding free functions with more parameters
@@ -234,6 +236,11 @@ public:
      * an instance without conferring @em ownership.
      */
     LLEventPump& obtain(const std::string& name);
+    // <FS> Interned strings
+    // For names obtained over and over, e.g. every frame: keep the
+    // LLInternedString and the lookup hashes nothing.
+    LLEventPump& obtain(const LLInternedString& name);
+    // </FS>
 
     /// exception potentially thrown by make()
     struct BadType: public LLException
@@ -349,6 +356,13 @@ testable:
     // lifespan.
     typedef std::map<std::string, LLEventPump*> PumpMap;
     PumpMap mPumpMap;
+    // <FS> Interned strings
+    // The pumps obtain(const LLInternedString&) has found. Only names callers
+    // intern themselves end up here; tweaked and anonymous names don't.
+    typedef std::unordered_map<LLInternedString, LLEventPump*,
+                               LLInternedString::Hash, LLInternedString::Equal> InternedPumpMap;
+    InternedPumpMap mInternedPumps;
+    // </FS>
     // Set of all LLEventPumps we instantiated. Membership in this set means
     // we claim ownership, and will delete them when this LLEventPumps is
     // destroyed.
@@ -0,0 +1,197 @@
+/**
+ * @file   llparallelfor.h
+ * @brief  Fork/join helper that spreads a loop across a ThreadPool
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLPARALLELFOR_H)
+#define LL_LLPARALLELFOR_H
+
+#include "threadpool.h"
+#include "workqueue.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+namespace LL
+{
+    namespace detail
+    {
+        /// State shared between a parallel_for() call and the helpers it posts
+        class ParallelForState
+        {
+        public:
+            ParallelForState(size_t count):
+                mCount(count),
+                mNext(0),
+                mStarted(false),
+                mDone(0)
+            {}
+
+            /**
+             * Posting a helper can yield to other coroutines on the calling
+             * thread (a locking WorkQueue's lock is a fiber mutex), so helpers
+             * don't start on the caller's data until every post is done.
+             */
+            void start()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mDoneMutex);
+                    mStarted = true;
+                }
+                mDoneCond.notify_all();
+            }
+
+            void waitStarted()
+            {
+                std::unique_lock<std::mutex> lock(mDoneMutex);
+                mDoneCond.wait(lock, [this](){ return mStarted; });
+            }
+
+            /**
+             * Claim and run indices until none remain. A helper may only get
+             * around to calling this after its parallel_for() has returned;
+             * by then every index has been claimed, so body is never
+             * dereferenced.
+             */
+            template <typename FUNC>
+            void run(FUNC* body)
+            {
+                size_t ran = 0;
+                for (size_t index; (index = mNext++) < mCount; ++ran)
+                {
+                    try
+                    {
+                        (*body)(index);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(mErrorMutex);
+                        if (! mError)
+                        {
+                            mError = std::current_exception();
+                        }
+                    }
+                }
+                if (ran)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mDoneMutex);
+                        mDone += ran;
+                    }
+                    mDoneCond.notify_all();
+                }
+            }
+
+            /**
+             * Block the calling thread until every index has run. This is a
+             * std::condition_variable rather than LLCond on purpose: the
+             * caller's data is typically half-updated meanwhile, so other
+             * coroutines on the calling thread must not get to run.
+             */
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(mDoneMutex);
+                mDoneCond.wait(lock, [this](){ return mDone == mCount; });
+            }
+
+            void rethrow()
+            {
+                std::lock_guard<std::mutex> lock(mErrorMutex);
+                if (mError)
+                {
+                    std::rethrow_exception(mError);
+                }
+            }
+
+        private:
+            const size_t mCount;
+            std::atomic<size_t> mNext;
+            std::mutex mDoneMutex;
+            std::condition_variable mDoneCond;
+            bool mStarted;
+            size_t mDone;
+            std::mutex mErrorMutex;
+            std::exception_ptr mError;
+        };
+    } // namespace detail
+
+    /**
+     * parallel_for() calls func(index) once for each index in [0, count),
+     * spreading the calls across the threads servicing the named WorkQueue
+     * (normally a ThreadPool, such as "General") and the calling thread, and
+     * returns once every call has completed. From the first call to
+     * func until then, the calling thread blocks rather than letting other
+     * coroutines on it run.
+     *
+     * The calling thread claims indices too, so parallel_for() still finishes
+     * if the pool is saturated, closed or doesn't exist; at worst it degrades
+     * to a plain loop. func must be safe to call concurrently for distinct
+     * indices. If func throws, the first exception is rethrown on the calling
+     * thread after all claimed calls have finished.
+     *
+     * By default one helper is posted per pool thread; pass max_helpers to
+     * post fewer.
+     */
+    template <typename FUNC>
+    void parallel_for(const std::string& queue_name, size_t count, FUNC&& func,
+                      size_t max_helpers = 0)
+    {
+        if (! count)
+        {
+            return;
+        }
+
+        using body_t = std::remove_reference_t<FUNC>;
+        body_t* body = &func;
+        auto state = std::make_shared<detail::ParallelForState>(count);
+
+        if (count > 1)
+        {
+            size_t helpers = max_helpers? max_helpers : ThreadPoolBase::getWidth(queue_name, 1);
+            helpers = std::min(helpers, count - 1);
+            auto queue = WorkQueue::getInstance(queue_name);
+            for (size_t i = 0; queue && i < helpers; ++i)
+            {
+                // tryPost() so a full or closed queue just leaves more work
+                // for the calling thread
+                if (! queue->tryPost([state, body](){ state->waitStarted(); state->run(body); }))
+                {
+                    break;
+                }
+            }
+        }
+
+        state->start();
+        state->run(body);
+        state->wait();
+        state->rethrow();
+    }
+} // namespace LL
+
+#endif /* ! defined(LL_LLPARALLELFOR_H) */
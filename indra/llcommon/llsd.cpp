@@ -35,6 +35,7 @@
 #include "../llmath/llmath.h"
 #include "llformat.h"
 #include "llsdserialize.h"
+#include "llstringtable.h" // <FS/> Interned strings
 #include "stringize.h"
 
 #include <limits>
@@ -102,6 +103,10 @@ protected:
     virtual ~Impl();
 
     bool shared() const                         { return (mUseCount > 1) && (mUseCount != STATIC_USAGE_COUNT); }
+    // <FS> Shared LLSD scalars
+    // Static values are shared by every LLSD that holds them and never change
+    bool isStatic() const                       { return mUseCount == STATIC_USAGE_COUNT; }
+    // </FS>
 
     U32 mUseCount;
 
@@ -214,12 +219,18 @@ namespace
     public:
         ImplBase(DataRef value) : mValue(value) { }
         ImplBase(DataMove value) : mValue(std::move(value)) { }
+        // <FS> Shared LLSD scalars
+        ImplBase(DataRef value, StaticAllocationMarker marker) : Impl(marker), mValue(value) { }
+        // </FS>
 
         virtual LLSD::Type type() const { return T; }
 
         using LLSD::Impl::assign; // Unhiding base class virtuals...
         virtual void assign(LLSD::Impl*& var, DataRef value) {
-            if (shared())
+            // <FS> Shared LLSD scalars
+            //if (shared())
+            if (shared() || isStatic())
+            // </FS>
             {
                 Impl::assign(var, value);
             }
@@ -229,7 +240,10 @@ namespace
             }
         }
         virtual void assign(LLSD::Impl*& var, DataMove value) {
-            if (shared())
+            // <FS> Shared LLSD scalars
+            //if (shared())
+            if (shared() || isStatic())
+            // </FS>
             {
                 Impl::assign(var, std::move(value));
             }
@@ -246,6 +260,9 @@ namespace
     {
     public:
         ImplBoolean(LLSD::Boolean v) : Base(v) { }
+        ImplBoolean(LLSD::Boolean v, StaticAllocationMarker marker) : Base(v, marker) { } // <FS/> Shared LLSD scalars
+
+        static Impl* create(LLSD::Boolean v); // <FS/> Shared LLSD scalars
 
         virtual LLSD::Boolean   asBoolean() const   { return mValue; }
         virtual LLSD::Integer   asInteger() const   { return mValue ? 1 : 0; }
@@ -269,6 +286,9 @@ namespace
     {
     public:
         ImplInteger(LLSD::Integer v) : Base(v) { }
+        ImplInteger(LLSD::Integer v, StaticAllocationMarker marker) : Base(v, marker) { } // <FS/> Shared LLSD scalars
+
+        static Impl* create(LLSD::Integer v); // <FS/> Shared LLSD scalars
 
         virtual LLSD::Boolean   asBoolean() const   { return mValue != 0; }
         virtual LLSD::Integer   asInteger() const   { return mValue; }
@@ -287,6 +307,9 @@ namespace
     {
     public:
         ImplReal(LLSD::Real v) : Base(v) { }
+        ImplReal(LLSD::Real v, StaticAllocationMarker marker) : Base(v, marker) { } // <FS/> Shared LLSD scalars
+
+        static Impl* create(LLSD::Real v); // <FS/> Shared LLSD scalars
 
         virtual LLSD::Boolean   asBoolean() const;
         virtual LLSD::Integer   asInteger() const;
@@ -312,6 +335,14 @@ namespace
     public:
         ImplString(const LLSD::String& v) : Base(v) { }
         ImplString(LLSD::String&& v) : Base(std::move(v)) {}
+        ImplString(const LLSD::String& v, StaticAllocationMarker marker) : Base(v, marker) { } // <FS/> Shared LLSD scalars
+
+        // <FS> Shared LLSD scalars
+        static Impl* create(const char* v);
+        static Impl* create(const LLSD::String& v);
+        static Impl* create(LLSD::String&& v);
+        static Impl* empty();
+        // </FS>
 
         virtual LLSD::Boolean   asBoolean() const   { return !mValue.empty(); }
         virtual LLSD::Integer   asInteger() const;
@@ -328,7 +359,10 @@ namespace
         using LLSD::Impl::assign; // Unhiding base class virtuals...
         virtual void assign(LLSD::Impl*& var, const char* value)
         {
-            if (shared())
+            // <FS> Shared LLSD scalars
+            //if (shared())
+            if (shared() || isStatic())
+            // </FS>
             {
                 Impl::assign(var, value);
             }
@@ -361,6 +395,12 @@ namespace
     public:
         ImplUUID(const LLSD::UUID& v) : Base(v) { }
         ImplUUID(LLSD::UUID&& v) : Base(std::move(v)) { }
+        ImplUUID(const LLSD::UUID& v, StaticAllocationMarker marker) : Base(v, marker) { } // <FS/> Shared LLSD scalars
+
+        // <FS> Shared LLSD scalars
+        static Impl* create(const LLSD::UUID& v);
+        static Impl* create(LLSD::UUID&& v);
+        // </FS>
 
         virtual LLSD::String    asString() const{ return mValue.asString(); }
         virtual LLSD::UUID      asUUID() const  { return mValue; }
@@ -808,6 +848,97 @@ namespace
     }
 }
 
+// <FS> Shared LLSD scalars
+// The scalar values messages are mostly made of: false, true, small
+// integers, 0.0 and 1.0, the empty string and the null UUID. Each of these is
+// one static Impl that every LLSD holding the value shares, instead of an
+// Impl per LLSD. Static Impls aren't reference counted and never change in
+// place: assigning to an LLSD that holds one gives it another Impl, the same
+// as for any shared Impl. They are never freed either, so LLSDs destroyed
+// late in static destruction can still hold them.
+namespace
+{
+    const LLSD::Integer MIN_STATIC_INTEGER = -1;
+    const LLSD::Integer MAX_STATIC_INTEGER = 255;
+}
+
+LLSD::Impl* ImplBoolean::create(LLSD::Boolean v)
+{
+    static ImplBoolean* const values[2] =
+    {
+        new ImplBoolean(false, STATIC_USAGE_COUNT),
+        new ImplBoolean(true, STATIC_USAGE_COUNT)
+    };
+    return values[v ? 1 : 0];
+}
+
+LLSD::Impl* ImplInteger::create(LLSD::Integer v)
+{
+    if (v < MIN_STATIC_INTEGER || v > MAX_STATIC_INTEGER)
+    {
+        return new ImplInteger(v);
+    }
+    static ImplInteger* const* const values = []()
+    {
+        ImplInteger** values = new ImplInteger*[MAX_STATIC_INTEGER - MIN_STATIC_INTEGER + 1];
+        for (LLSD::Integer i = MIN_STATIC_INTEGER; i <= MAX_STATIC_INTEGER; ++i)
+        {
+            values[i - MIN_STATIC_INTEGER] = new ImplInteger(i, STATIC_USAGE_COUNT);
+        }
+        return values;
+    }();
+    return values[v - MIN_STATIC_INTEGER];
+}
+
+LLSD::Impl* ImplReal::create(LLSD::Real v)
+{
+    // not -0.0, which has to stay -0.0
+    if (v == 0.0 && !std::signbit(v))
+    {
+        static ImplReal* const zero = new ImplReal(0.0, STATIC_USAGE_COUNT);
+        return zero;
+    }
+    if (v == 1.0)
+    {
+        static ImplReal* const one = new ImplReal(1.0, STATIC_USAGE_COUNT);
+        return one;
+    }
+    return new ImplReal(v);
+}
+
+LLSD::Impl* ImplString::empty()
+{
+    static ImplString* const value = new ImplString(LLSD::String(), STATIC_USAGE_COUNT);
+    return value;
+}
+
+LLSD::Impl* ImplString::create(const char* v)
+{
+    return *v ? new ImplString(v) : empty();
+}
+
+LLSD::Impl* ImplString::create(const LLSD::String& v)
+{
+    return v.empty() ? empty() : new ImplString(v);
+}
+
+LLSD::Impl* ImplString::create(LLSD::String&& v)
+{
+    return v.empty() ? empty() : new ImplString(std::move(v));
+}
+
+LLSD::Impl* ImplUUID::create(const LLSD::UUID& v)
+{
+    static ImplUUID* const null = new ImplUUID(LLUUID::null, STATIC_USAGE_COUNT);
+    return v.isNull() ? null : new ImplUUID(v);
+}
+
+LLSD::Impl* ImplUUID::create(LLSD::UUID&& v)
+{
+    return v.isNull() ? create(static_cast<const LLSD::UUID&>(v)) : new ImplUUID(std::move(v));
+}
+// </FS>
+
 LLSD::Impl::Impl()
     : mUseCount(0)
 {
@@ -816,7 +947,10 @@ LLSD::Impl::Impl()
 }
 
 LLSD::Impl::Impl(StaticAllocationMarker)
-    : mUseCount(0)
+    // <FS> Shared LLSD scalars
+    //: mUseCount(0)
+    : mUseCount(STATIC_USAGE_COUNT)
+    // </FS>
 {
 }
 
@@ -896,32 +1030,50 @@ void LLSD::Impl::assignUndefined(Impl*& var)
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Boolean v)
 {
-    reset(var, new ImplBoolean(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplBoolean(v));
+    reset(var, ImplBoolean::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Integer v)
 {
-    reset(var, new ImplInteger(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplInteger(v));
+    reset(var, ImplInteger::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Real v)
 {
-    reset(var, new ImplReal(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplReal(v));
+    reset(var, ImplReal::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, const char* v)
 {
-    reset(var, new ImplString(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplString(v));
+    reset(var, ImplString::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::String& v)
 {
-    reset(var, new ImplString(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplString(v));
+    reset(var, ImplString::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::UUID& v)
 {
-    reset(var, new ImplUUID(v));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplUUID(v));
+    reset(var, ImplUUID::create(v));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::Date& v)
@@ -941,12 +1093,18 @@ void LLSD::Impl::assign(Impl*& var, const LLSD::Binary& v)
 
 void LLSD::Impl::assign(Impl*& var, LLSD::String&& v)
 {
-    reset(var, new ImplString(std::move(v)));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplString(std::move(v)));
+    reset(var, ImplString::create(std::move(v)));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::UUID&& v)
 {
-    reset(var, new ImplUUID(std::move(v)));
+    // <FS> Shared LLSD scalars
+    //reset(var, new ImplUUID(std::move(v)));
+    reset(var, ImplUUID::create(std::move(v)));
+    // </FS>
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Date&& v)
@@ -1152,6 +1310,13 @@ const LLSD& LLSD::operator[](const std::string_view k) const
     return safe(impl).ref(k);
 }
 
+// <FS> Interned strings
+bool LLSD::has(const LLInternedString& k) const     { return has(k.view()); }
+LLSD LLSD::get(const LLInternedString& k) const     { return get(k.view()); }
+LLSD& LLSD::operator[](const LLInternedString& k)   { return (*this)[k.view()]; }
+const LLSD& LLSD::operator[](const LLInternedString& k) const { return (*this)[k.view()]; }
+// </FS>
+
 LLSD LLSD::emptyArray()
 {
     LLSD v;
@@ -148,6 +148,8 @@
 // Normally undefined, used for diagnostics
 //#define LLSD_DEBUG_INFO   1
 
+class LLInternedString; // <FS/> Interned strings
+
 class LL_COMMON_API LLSD
 {
 public:
@@ -359,6 +361,14 @@ public:
         {
             return c ? (*this)[std::string_view(c)] : *this;
         }
+        // <FS> Interned strings
+        // Interned keys, as from LLInternedString, look up by string, so
+        // map-heavy code can keep its keys interned
+        bool has(const LLInternedString&) const;
+        LLSD get(const LLInternedString&) const;
+        LLSD& operator[](const LLInternedString&);
+        const LLSD& operator[](const LLInternedString&) const;
+        // </FS>
     //@}
 
     /** @name Array Values */
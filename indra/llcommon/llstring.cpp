@@ -30,8 +30,17 @@
 #include "llerror.h"
 #include "llfasttimer.h"
 #include "llsd.h"
+#include <bit>
 #include <vector>
 
+// <FS> Fast UTF transcoding
+#if LL_ARM64
+#include "sse2neon.h"
+#else
+#include <emmintrin.h>
+#endif
+// </FS>
+
 #if LL_WINDOWS
 #include "llwin32headers.h"
 #endif
@@ -396,91 +405,178 @@ S32 wstring_utf8_length(const LLWString& wstr)
     return len;
 }
 
-LLWString utf8str_to_wstring(const char* utf8str, size_t len)
+// <FS> Fast UTF transcoding
+namespace
 {
-    LLWString wout;
+    // Conversions build their output in a stack buffer of this many
+    // characters and append it to the string when it fills up
+    const size_t CONVERT_BUFFER_SIZE = 256;
+    // Characters the SSE2 kernels take at a time
+    const size_t CONVERT_BLOCK_SIZE = 16;
+    // Bytes wchar_to_utf8chars() writes at most
+    const size_t MAX_UTF8_SEQUENCE = 6;
+
+    // Widens the 16 bytes at in to 16 llwchar at out, and returns how many of
+    // them, from the start, are ASCII. Only those are to be kept.
+    inline size_t widen_ascii_block(const char* in, llwchar* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        U32 non_ascii = (U32)_mm_movemask_epi8(bytes);
+
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+
+        return non_ascii ? std::countr_zero(non_ascii) : CONVERT_BLOCK_SIZE;
+    }
+
+    // Narrows the 16 llwchar at in to 16 bytes at out, and returns how many
+    // of them, from the start, are ASCII other than NUL. Only those are to be
+    // kept: NUL, like anything over 0x7F, goes through wchar_to_utf8chars().
+    inline size_t narrow_ascii_block(const llwchar* in, char* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i high = _mm_set1_epi32(~0x7F);
+        __m128i chars[4];
+        __m128i ascii[4];
+        for (S32 i = 0; i < 4; ++i)
+        {
+            chars[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+            // no bits over 0x7F, and not 0
+            ascii[i] = _mm_andnot_si128(_mm_cmpeq_epi32(chars[i], zero),
+                                        _mm_cmpeq_epi32(_mm_and_si128(chars[i], high), zero));
+        }
 
-    S32 i = 0;
-    while (i < len)
+        // saturation only garbles characters that are not kept
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(chars[0], chars[1]), _mm_packs_epi32(chars[2], chars[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+
+        U32 kept = (U32)_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(ascii[0], ascii[1]),
+                                                          _mm_packs_epi32(ascii[2], ascii[3])));
+        return std::countr_one(kept);
+    }
+
+    // Decodes the sequence with its lead byte at utf8str[i], leaving i on the
+    // last byte it takes. Malformed sequences come out as LL_UNKNOWN_CHAR.
+    llwchar utf8_sequence_to_wchar(const char* utf8str, size_t len, size_t& i)
     {
         llwchar unichar;
         U8 cur_char = utf8str[i];
 
-        if (cur_char < 0x80)
+        S32 cont_bytes = 0;
+        if ((cur_char >> 5) == 0x6)         // Two byte UTF8 -> 1 UTF32
         {
-            // Ascii character, just add it
-            unichar = cur_char;
+            unichar = (0x1F&cur_char);
+            cont_bytes = 1;
+        }
+        else if ((cur_char >> 4) == 0xe)    // Three byte UTF8 -> 1 UTF32
+        {
+            unichar = (0x0F&cur_char);
+            cont_bytes = 2;
+        }
+        else if ((cur_char >> 3) == 0x1e)   // Four byte UTF8 -> 1 UTF32
+        {
+            unichar = (0x07&cur_char);
+            cont_bytes = 3;
+        }
+        else if ((cur_char >> 2) == 0x3e)   // Five byte UTF8 -> 1 UTF32
+        {
+            unichar = (0x03&cur_char);
+            cont_bytes = 4;
+        }
+        else if ((cur_char >> 1) == 0x7e)   // Six byte UTF8 -> 1 UTF32
+        {
+            unichar = (0x01&cur_char);
+            cont_bytes = 5;
         }
         else
         {
-            S32 cont_bytes = 0;
-            if ((cur_char >> 5) == 0x6)         // Two byte UTF8 -> 1 UTF32
-            {
-                unichar = (0x1F&cur_char);
-                cont_bytes = 1;
-            }
-            else if ((cur_char >> 4) == 0xe)    // Three byte UTF8 -> 1 UTF32
-            {
-                unichar = (0x0F&cur_char);
-                cont_bytes = 2;
-            }
-            else if ((cur_char >> 3) == 0x1e)   // Four byte UTF8 -> 1 UTF32
-            {
-                unichar = (0x07&cur_char);
-                cont_bytes = 3;
-            }
-            else if ((cur_char >> 2) == 0x3e)   // Five byte UTF8 -> 1 UTF32
-            {
-                unichar = (0x03&cur_char);
-                cont_bytes = 4;
-            }
-            else if ((cur_char >> 1) == 0x7e)   // Six byte UTF8 -> 1 UTF32
+            return LL_UNKNOWN_CHAR;
+        }
+
+        // Check that this character doesn't go past the end of the string
+        auto end = (len < (i + cont_bytes)) ? len : (i + cont_bytes);
+        do
+        {
+            ++i;
+
+            cur_char = utf8str[i];
+            if ( (cur_char >> 6) == 0x2 )
             {
-                unichar = (0x01&cur_char);
-                cont_bytes = 5;
+                unichar <<= 6;
+                unichar += (0x3F&cur_char);
             }
             else
             {
-                wout += LL_UNKNOWN_CHAR;
-                ++i;
-                continue;
+                // Malformed sequence - roll back to look at this as a new char
+                unichar = LL_UNKNOWN_CHAR;
+                --i;
+                break;
             }
+        } while(i < end);
+
+        // Handle overlong characters and NULL characters
+        if ( ((cont_bytes == 1) && (unichar < 0x80))
+            || ((cont_bytes == 2) && (unichar < 0x800))
+            || ((cont_bytes == 3) && (unichar < 0x10000))
+            || ((cont_bytes == 4) && (unichar < 0x200000))
+            || ((cont_bytes == 5) && (unichar < 0x4000000)) )
+        {
+            unichar = LL_UNKNOWN_CHAR;
+        }
+        return unichar;
+    }
+}
+// </FS>
 
-            // Check that this character doesn't go past the end of the string
-            auto end = (len < (i + cont_bytes)) ? len : (i + cont_bytes);
-            do
-            {
-                ++i;
+LLWString utf8str_to_wstring(const char* utf8str, size_t len)
+{
+    LLWString wout;
 
-                cur_char = utf8str[i];
-                if ( (cur_char >> 6) == 0x2 )
-                {
-                    unichar <<= 6;
-                    unichar += (0x3F&cur_char);
-                }
-                else
-                {
-                    // Malformed sequence - roll back to look at this as a new char
-                    unichar = LL_UNKNOWN_CHAR;
-                    --i;
-                    break;
-                }
-            } while(i < end);
-
-            // Handle overlong characters and NULL characters
-            if ( ((cont_bytes == 1) && (unichar < 0x80))
-                || ((cont_bytes == 2) && (unichar < 0x800))
-                || ((cont_bytes == 3) && (unichar < 0x10000))
-                || ((cont_bytes == 4) && (unichar < 0x200000))
-                || ((cont_bytes == 5) && (unichar < 0x4000000)) )
+    // <FS> Fast UTF transcoding: runs of ASCII go 16 bytes at a time, the
+    // rest one sequence at a time as before
+    wout.reserve(len);
+    llwchar buffer[CONVERT_BUFFER_SIZE];
+    size_t count = 0;
+
+    size_t i = 0;
+    while (i < len)
+    {
+        if (count + CONVERT_BLOCK_SIZE > CONVERT_BUFFER_SIZE)
+        {
+            wout.append(buffer, count);
+            count = 0;
+        }
+
+        if (len - i >= CONVERT_BLOCK_SIZE)
+        {
+            size_t ascii = widen_ascii_block(utf8str + i, buffer + count);
+            count += ascii;
+            i += ascii;
+            if (ascii == CONVERT_BLOCK_SIZE)
             {
-                unichar = LL_UNKNOWN_CHAR;
+                continue;
             }
         }
 
-        wout += unichar;
+        U8 cur_char = utf8str[i];
+        if (cur_char < 0x80)
+        {
+            // Ascii character, just add it
+            buffer[count++] = cur_char;
+        }
+        else
+        {
+            buffer[count++] = utf8_sequence_to_wchar(utf8str, len, i);
+        }
         ++i;
     }
+    wout.append(buffer, count);
+    // </FS>
     return wout;
 }
 
@@ -488,15 +584,43 @@ std::string wstring_to_utf8str(const llwchar* utf32str, size_t len)
 {
     std::string out;
 
-    S32 i = 0;
+    // <FS> Fast UTF transcoding: runs of ASCII go 16 characters at a time,
+    // the rest one character at a time as before
+    out.reserve(len);
+    char buffer[CONVERT_BUFFER_SIZE];
+    size_t count = 0;
+
+    size_t i = 0;
     while (i < len)
     {
-        char tchars[8];     /* Flawfinder: ignore */
-        auto n = wchar_to_utf8chars(utf32str[i], tchars);
-        tchars[n] = 0;
-        out += tchars;
-        i++;
+        // room for part of a block and the character that ended it
+        if (count + CONVERT_BLOCK_SIZE + MAX_UTF8_SEQUENCE > CONVERT_BUFFER_SIZE)
+        {
+            out.append(buffer, count);
+            count = 0;
+        }
+
+        if (len - i >= CONVERT_BLOCK_SIZE)
+        {
+            size_t ascii = narrow_ascii_block(utf32str + i, buffer + count);
+            count += ascii;
+            i += ascii;
+            if (ascii == CONVERT_BLOCK_SIZE)
+            {
+                continue;
+            }
+        }
+
+        // NUL characters were always dropped, by appending what
+        // wchar_to_utf8chars() wrote as a C string
+        if (utf32str[i])
+        {
+            count += wchar_to_utf8chars(utf32str[i], buffer + count);
+        }
+        ++i;
     }
+    out.append(buffer, count);
+    // </FS>
     return out;
 }
 
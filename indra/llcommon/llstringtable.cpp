@@ -29,6 +29,7 @@
 
 #include "llstringtable.h"
 #include "llstl.h"
+#include "llmutex.h" // <FS/> Interned strings
 
 LLStringTable gStringTable(32768);
 
@@ -349,3 +350,68 @@ void LLStringTable::removeString(const char *str)
     }
 }
 
+// <FS> Interned strings
+namespace
+{
+    struct InternTable
+    {
+        InternTable()
+        :   mStrings(4096),
+            mCount(0)
+        {}
+
+        LLMutex mMutex;
+        LLStdStringTable mStrings;
+        size_t mCount;
+    };
+
+    // Never destroyed, so that interned strings in static objects stay good
+    // through static destruction
+    InternTable& intern_table()
+    {
+        static InternTable* table = new InternTable;
+        return *table;
+    }
+
+    LLStdStringHandle intern(std::string_view str)
+    {
+        InternTable& table = intern_table();
+        std::string key(str);
+        LLMutexLock lock(&table.mMutex);
+        LLStdStringHandle handle = table.mStrings.lookup(key);
+        if (!handle)
+        {
+            handle = table.mStrings.insert(key);
+            ++table.mCount;
+        }
+        return handle;
+    }
+
+    // Default constructed strings don't take the lock
+    LLStdStringHandle empty_string()
+    {
+        static LLStdStringHandle empty = intern(std::string_view());
+        return empty;
+    }
+}
+
+LLInternedString::LLInternedString()
+:   mString(empty_string()),
+    mHash(std::hash<std::string_view>()(std::string_view()))
+{
+}
+
+LLInternedString::LLInternedString(std::string_view str)
+:   mString(intern(str)),
+    mHash(std::hash<std::string_view>()(str))
+{
+}
+
+//static
+size_t LLInternedString::getCount()
+{
+    InternTable& table = intern_table();
+    LLMutexLock lock(&table.mMutex);
+    return table.mCount;
+}
+// </FS>
@@ -33,6 +33,7 @@
 #include "llstl.h"
 #include <list>
 #include <set>
+#include <string_view> // <FS/> Interned strings
 
 #if LL_WINDOWS
 # if (_MSC_VER >= 1300 && _MSC_VER < 1400)
@@ -205,5 +206,81 @@ private:
     string_set_t* mStringList; // [mTableSize]
 };
 
+//============================================================================
+
+// <FS> Interned strings
+// A string from a global LLStdStringTable, for names that are looked up over
+// and over, like event pump names. Equal strings are the same handle, so
+// interned strings compare by pointer and carry their hash, worked out once
+// when the string is interned. Interned strings are never freed: keep them
+// for names, not for data.
+// Lookups with std::string or std::string_view keep working in containers
+// that use LLInternedString::Hash and LLInternedString::Equal.
+
+class LL_COMMON_API LLInternedString
+{
+public:
+    // The empty string
+    LLInternedString();
+    explicit LLInternedString(std::string_view str);
+    explicit LLInternedString(const char* str)
+    :   LLInternedString(std::string_view(str ? str : ""))
+    {}
+
+    const std::string& str() const      { return *mString; }
+    operator const std::string&() const { return *mString; }
+    std::string_view view() const       { return *mString; }
+    const char* c_str() const           { return mString->c_str(); }
+    size_t length() const               { return mString->length(); }
+    bool empty() const                  { return mString->empty(); }
+
+    // std::hash<std::string_view> of the string
+    size_t hash() const                 { return mHash; }
+
+    bool operator==(const LLInternedString& other) const { return mString == other.mString; }
+    bool operator!=(const LLInternedString& other) const { return mString != other.mString; }
+    // by string, as for std::string
+    bool operator<(const LLInternedString& other) const
+    {
+        return mString != other.mString && *mString < *other.mString;
+    }
+
+    // Hash and equality for unordered containers keyed by interned strings
+    // that can be searched with any string
+    struct Hash
+    {
+        using is_transparent = void;
+        size_t operator()(const LLInternedString& str) const { return str.hash(); }
+        size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+    };
+
+    struct Equal
+    {
+        using is_transparent = void;
+        bool operator()(const LLInternedString& a, const LLInternedString& b) const { return a == b; }
+        bool operator()(const LLInternedString& a, std::string_view b) const { return a.view() == b; }
+        bool operator()(std::string_view a, const LLInternedString& b) const { return a == b.view(); }
+    };
+
+    // Distinct strings interned so far
+    static size_t getCount();
+
+private:
+    LLStdStringHandle mString;
+    size_t mHash;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const LLInternedString& str)
+{
+    return out << str.str();
+}
+
+template <>
+struct std::hash<LLInternedString>
+{
+    size_t operator()(const LLInternedString& str) const { return str.hash(); }
+};
+// </FS>
+
 
 #endif
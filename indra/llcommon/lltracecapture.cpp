@@ -0,0 +1,820 @@
+/**
+ * @file lltracecapture.cpp
+ * @brief Binary capture of per frame LLTrace recordings, and its reader.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltracecapture.h"
+
+#include "lldate.h"
+#include "llfasttimer.h"
+#include "llstring.h"
+#include "lltrace.h"
+#include "lltracerecording.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace
+{
+    // Record tags
+    const U8 TAG_STAT = 1;
+    const U8 TAG_FRAME = 2;
+
+    // Ends the values of a frame record, stat ids start at 1
+    const U32 END_OF_FRAME = 0;
+
+    void put_u8(std::string& out, U8 value)
+    {
+        out += (char)value;
+    }
+
+    void put_varint(std::string& out, U64 value)
+    {
+        while (value >= 0x80)
+        {
+            out += (char)((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += (char)value;
+    }
+
+    void put_f64(std::string& out, F64 value)
+    {
+        // little endian, like every platform the viewer runs on
+        char bytes[sizeof(F64)];
+        memcpy(bytes, &value, sizeof(F64));
+        out.append(bytes, sizeof(F64));
+    }
+
+    void put_string(std::string& out, const std::string& value)
+    {
+        put_varint(out, value.size());
+        out.append(value);
+    }
+
+    // The StatType behind each accumulator index of ACCUMULATOR
+    template<typename ACCUMULATOR>
+    void get_stats(std::vector<LLTrace::StatBase*>& stats)
+    {
+        stats.clear();
+        stats.resize(LLTrace::StatType<ACCUMULATOR>::getNumIndices(), NULL);
+        for (auto& stat : typename LLTrace::StatType<ACCUMULATOR>::instance_snapshot())
+        {
+            if (stat.getIndex() < stats.size())
+            {
+                stats[stat.getIndex()] = &stat;
+            }
+        }
+    }
+
+    std::string csv_escape(const std::string& value)
+    {
+        if (value.find_first_of(",\"\n") == std::string::npos)
+        {
+            return value;
+        }
+        std::string escaped("\"");
+        for (char c : value)
+        {
+            if (c == '"')
+            {
+                escaped += '"';
+            }
+            escaped += c;
+        }
+        escaped += '"';
+        return escaped;
+    }
+
+    // Reads records out of a capture as it streams in; every get fails
+    // once past the end
+    class CaptureParser
+    {
+    public:
+        // Longest stat name or unit taken as such, rather than as garbage
+        static const U64 MAX_STRING_LENGTH = 64 * 1024;
+
+        CaptureParser(std::istream& in)
+        :   mIn(in),
+            mOk(true)
+        {}
+
+        bool ok() const     { return mOk; }
+        bool atEnd()        { return mIn.peek() == std::istream::traits_type::eof(); }
+
+        U8 getU8()
+        {
+            int byte = mOk ? mIn.get() : std::istream::traits_type::eof();
+            if (byte == std::istream::traits_type::eof())
+            {
+                mOk = false;
+                return 0;
+            }
+            return (U8)byte;
+        }
+
+        U64 getVarint()
+        {
+            U64 value = 0;
+            for (U32 shift = 0; shift < 64; shift += 7)
+            {
+                U8 byte = getU8();
+                if (!mOk)
+                {
+                    return 0;
+                }
+                value |= (U64)(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                {
+                    return value;
+                }
+            }
+            mOk = false;
+            return 0;
+        }
+
+        F64 getF64()
+        {
+            F64 value = 0.0;
+            char bytes[sizeof(F64)];
+            if (!getBytes(bytes, sizeof(F64)))
+            {
+                return value;
+            }
+            memcpy(&value, bytes, sizeof(F64));
+            return value;
+        }
+
+        std::string getString()
+        {
+            U64 length = getVarint();
+            if (!mOk || length > MAX_STRING_LENGTH)
+            {
+                mOk = false;
+                return std::string();
+            }
+            std::string value((size_t)length, '\0');
+            if (length && !getBytes(&value[0], (size_t)length))
+            {
+                return std::string();
+            }
+            return value;
+        }
+
+        bool getBytes(char* bytes, size_t count)
+        {
+            if (mOk && (!mIn.read(bytes, count) || (size_t)mIn.gcount() != count))
+            {
+                mOk = false;
+            }
+            return mOk;
+        }
+
+    private:
+        std::istream&   mIn;
+        bool            mOk;
+    };
+
+    bool value_less(const std::pair<U32, LLTrace::TraceCaptureReader::Value>& a,
+                    const std::pair<U32, LLTrace::TraceCaptureReader::Value>& b)
+    {
+        return a.first < b.first;
+    }
+}
+
+namespace LLTrace
+{
+
+///////////////////////////////////////////////////////////////////////
+// TraceCapture
+///////////////////////////////////////////////////////////////////////
+
+const char* TraceCapture::MAGIC = "LLTRACE\x1a";
+
+// static
+const char* TraceCapture::getKindName(EStatKind kind)
+{
+    switch (kind)
+    {
+    case STAT_COUNT:    return "count";
+    case STAT_SAMPLE:   return "sample";
+    case STAT_EVENT:    return "event";
+    case STAT_TIMER:    return "timer";
+    default:            return "unknown";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////
+// TraceCaptureWriter
+///////////////////////////////////////////////////////////////////////
+
+TraceCaptureWriter::TraceCaptureWriter()
+:   mFile(NULL),
+    mBytesWritten(0),
+    mFrameCount(0),
+    mNextStatId(1)
+{}
+
+TraceCaptureWriter::~TraceCaptureWriter()
+{
+    close();
+}
+
+bool TraceCaptureWriter::open(const std::string& filename)
+{
+    close();
+
+    mFile = LLFile::fopen(filename, "wb");
+    if (!mFile)
+    {
+        LL_WARNS("LLTrace") << "Can't create trace capture " << filename << LL_ENDL;
+        return false;
+    }
+
+    mBytesWritten = 0;
+    mFrameCount = 0;
+    mNextStatId = 1;
+    for (auto& ids : mStatIds)
+    {
+        ids.clear();
+    }
+    mSampleWritten.clear();
+
+    mBuffer.reserve(WRITE_BLOCK_SIZE + WRITE_BLOCK_SIZE / 4);
+    mBuffer.assign(TraceCapture::MAGIC, 8);
+    put_varint(mBuffer, TraceCapture::VERSION);
+    put_f64(mBuffer, LLDate::now().secondsSinceEpoch());
+    flush();
+
+    LL_INFOS("LLTrace") << "Capturing frame stats to " << filename << LL_ENDL;
+    return true;
+}
+
+void TraceCaptureWriter::close()
+{
+    if (mFile)
+    {
+        flush();
+        LLFile::close(mFile);
+        mFile = NULL;
+
+        LL_INFOS("LLTrace") << "Trace capture closed after " << mFrameCount << " frames, "
+                            << mBytesWritten << " bytes" << LL_ENDL;
+    }
+}
+
+void TraceCaptureWriter::flush()
+{
+    if (mFile && !mBuffer.empty())
+    {
+        if (fwrite(mBuffer.data(), 1, mBuffer.size(), mFile) != mBuffer.size())
+        {
+            LL_WARNS("LLTrace") << "Trace capture write failed, closing it" << LL_ENDL;
+            mBuffer.clear();
+            LLFile::close(mFile);
+            mFile = NULL;
+            return;
+        }
+        fflush(mFile);
+        mBytesWritten += mBuffer.size();
+        mBuffer.clear();
+    }
+}
+
+void TraceCaptureWriter::writeFrame(const Recording& frame)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_STATS;
+    if (!mFile)
+    {
+        return;
+    }
+    // a started recording has part of its data in the thread recorder
+    llassert(!frame.isStarted());
+
+    const AccumulatorBufferGroup& buffers = *frame.mBuffers;
+
+    // Stats get declared in mBuffer as they are first seen, so the values
+    // are put aside until the frame record can follow the declarations
+    std::string& values = mFrameValues;
+    values.clear();
+
+    const AccumulatorBuffer<CountAccumulator>& counts = buffers.mCounts;
+    size_t num = llmin(counts.size(), counts.capacity());
+    for (size_t i = 0; i < num; ++i)
+    {
+        const CountAccumulator& acc = counts[i];
+        if (acc.getSampleCount() > 0)
+        {
+            put_varint(values, getStatId(TraceCapture::STAT_COUNT, i));
+            put_f64(values, acc.getSum());
+            put_varint(values, acc.getSampleCount());
+        }
+    }
+
+    const AccumulatorBuffer<SampleAccumulator>& samples = buffers.mSamples;
+    num = llmin(samples.size(), samples.capacity());
+    if (mSampleWritten.size() < num)
+    {
+        mSampleWritten.resize(num, false);
+    }
+    for (size_t i = 0; i < num; ++i)
+    {
+        // An unsampled stat carries its last value over, which the reader
+        // knows about once the stat has been written
+        const SampleAccumulator& acc = samples[i];
+        if (acc.getSampleCount() > 0 || (acc.hasValue() && !mSampleWritten[i]))
+        {
+            mSampleWritten[i] = true;
+            put_varint(values, getStatId(TraceCapture::STAT_SAMPLE, i));
+            put_f64(values, acc.getMean());
+            put_f64(values, acc.getMin());
+            put_f64(values, acc.getMax());
+            put_f64(values, acc.getLastValue());
+            put_varint(values, acc.getSampleCount());
+        }
+    }
+
+    const AccumulatorBuffer<EventAccumulator>& events = buffers.mEvents;
+    num = llmin(events.size(), events.capacity());
+    for (size_t i = 0; i < num; ++i)
+    {
+        const EventAccumulator& acc = events[i];
+        if (acc.getSampleCount() > 0)
+        {
+            put_varint(values, getStatId(TraceCapture::STAT_EVENT, i));
+            put_f64(values, acc.getSum());
+            put_f64(values, acc.getMin());
+            put_f64(values, acc.getMax());
+            put_f64(values, acc.getLastValue());
+            put_varint(values, acc.getSampleCount());
+        }
+    }
+
+    const F64 seconds_per_count = 1.0 / (F64)BlockTimer::countsPerSecond();
+    const AccumulatorBuffer<TimeBlockAccumulator>& timers = buffers.mStackTimers;
+    num = llmin(timers.size(), timers.capacity());
+    for (size_t i = 0; i < num; ++i)
+    {
+        const TimeBlockAccumulator& acc = timers[i];
+        if (acc.mCalls > 0 || acc.mTotalTimeCounter > 0)
+        {
+            put_varint(values, getStatId(TraceCapture::STAT_TIMER, i));
+            put_f64(values, (F64)acc.mTotalTimeCounter * seconds_per_count);
+            put_f64(values, (F64)acc.mSelfTimeCounter * seconds_per_count);
+            put_varint(values, (U32)llmax(acc.mCalls, 0));
+        }
+    }
+
+    put_u8(mBuffer, TAG_FRAME);
+    put_f64(mBuffer, frame.getDuration().value());
+    mBuffer.append(values);
+    put_varint(mBuffer, END_OF_FRAME);
+
+    ++mFrameCount;
+    if (mBuffer.size() >= WRITE_BLOCK_SIZE)
+    {
+        flush();
+    }
+}
+
+U32 TraceCaptureWriter::getStatId(TraceCapture::EStatKind kind, size_t index)
+{
+    std::vector<U32>& ids = mStatIds[kind];
+    if (index < ids.size() && ids[index])
+    {
+        return ids[index];
+    }
+
+    // Declare every stat of the kind that hasn't been, rather than look up
+    // the StatTypes one at a time: the first frame has most of them
+    std::vector<StatBase*> stats;
+    switch (kind)
+    {
+    case TraceCapture::STAT_COUNT:  get_stats<CountAccumulator>(stats); break;
+    case TraceCapture::STAT_SAMPLE: get_stats<SampleAccumulator>(stats); break;
+    case TraceCapture::STAT_EVENT:  get_stats<EventAccumulator>(stats); break;
+    case TraceCapture::STAT_TIMER:  get_stats<TimeBlockAccumulator>(stats); break;
+    default: break;
+    }
+    if (ids.size() < llmax(stats.size(), index + 1))
+    {
+        ids.resize(llmax(stats.size(), index + 1), 0);
+    }
+
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        if (stats[i] && !ids[i])
+        {
+            ids[i] = mNextStatId++;
+            declareStat(kind, ids[i], stats[i]->getName(),
+                        kind == TraceCapture::STAT_TIMER ? std::string("ms") : std::string(stats[i]->getUnitLabel()));
+        }
+    }
+
+    if (!ids[index])
+    {
+        // a stat that is gone, only its accumulator is left
+        ids[index] = mNextStatId++;
+        declareStat(kind, ids[index], llformat("%s_%u", TraceCapture::getKindName(kind), (U32)index), std::string());
+    }
+    return ids[index];
+}
+
+void TraceCaptureWriter::declareStat(TraceCapture::EStatKind kind, U32 id, const std::string& name, const std::string& unit)
+{
+    put_u8(mBuffer, TAG_STAT);
+    put_varint(mBuffer, id);
+    put_u8(mBuffer, (U8)kind);
+    put_string(mBuffer, name);
+    put_string(mBuffer, unit);
+}
+
+///////////////////////////////////////////////////////////////////////
+// TraceCaptureReader
+///////////////////////////////////////////////////////////////////////
+
+F64 TraceCaptureReader::Value::getPrimary(TraceCapture::EStatKind kind) const
+{
+    switch (kind)
+    {
+    case TraceCapture::STAT_COUNT:  return mSum;
+    case TraceCapture::STAT_TIMER:  return mSum * 1000.0;
+    default:                        return mMean;
+    }
+}
+
+const TraceCaptureReader::Value* TraceCaptureReader::Frame::find(U32 id) const
+{
+    auto it = std::lower_bound(mValues.begin(), mValues.end(), id,
+                               [](const std::pair<U32, Value>& entry, U32 id) { return entry.first < id; });
+    return (it != mValues.end() && it->first == id) ? &it->second : NULL;
+}
+
+TraceCaptureReader::TraceCaptureReader()
+:   mStartTime(0.0),
+    mTruncated(false)
+{}
+
+bool TraceCaptureReader::load(const std::string& filename)
+{
+    llifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        LL_WARNS("LLTrace") << "Can't open trace capture " << filename << LL_ENDL;
+        return false;
+    }
+    return parse(file);
+}
+
+bool TraceCaptureReader::parse(const std::string& data)
+{
+    std::istringstream in(data);
+    return parse(in);
+}
+
+bool TraceCaptureReader::parse(std::istream& in)
+{
+    mStats.clear();
+    mFrames.clear();
+    mSampledFrames.clear();
+    mStartTime = 0.0;
+    mTruncated = false;
+
+    char magic[8];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, TraceCapture::MAGIC, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+    CaptureParser parser(in);
+    U64 version = parser.getVarint();
+    mStartTime = parser.getF64();
+    if (!parser.ok() || version > TraceCapture::VERSION)
+    {
+        return false;
+    }
+
+    // Stats by id, ids start at 1
+    std::vector<S32> stat_index(1, -1);
+    F64 time = 0.0;
+
+    while (!parser.atEnd())
+    {
+        U8 tag = parser.getU8();
+        if (tag == TAG_STAT)
+        {
+            U64 id = parser.getVarint();
+            U8 kind = parser.getU8();
+            Stat stat;
+            stat.mName = parser.getString();
+            stat.mUnit = parser.getString();
+            if (!parser.ok() || kind >= TraceCapture::NUM_STAT_KINDS || id == 0 || id > 0xffffff)
+            {
+                break;
+            }
+            stat.mKind = (TraceCapture::EStatKind)kind;
+            if (stat_index.size() <= id)
+            {
+                stat_index.resize((size_t)id + 1, -1);
+            }
+            stat_index[(size_t)id] = (S32)mStats.size();
+            mStats.push_back(stat);
+            mSampledFrames.resize(mStats.size());
+        }
+        else if (tag == TAG_FRAME)
+        {
+            Frame frame;
+            frame.mTime = time;
+            frame.mDuration = parser.getF64();
+            for (U64 id = parser.getVarint(); parser.ok() && id != END_OF_FRAME; id = parser.getVarint())
+            {
+                if (id >= stat_index.size() || stat_index[(size_t)id] < 0)
+                {
+                    parser.getU8();     // fail
+                    break;
+                }
+                U32 index = (U32)stat_index[(size_t)id];
+                Value value;
+                switch (mStats[index].mKind)
+                {
+                case TraceCapture::STAT_COUNT:
+                    value.mSum = parser.getF64();
+                    value.mCount = (U32)parser.getVarint();
+                    value.mMean = value.mCount ? value.mSum / value.mCount : 0.0;
+                    break;
+                case TraceCapture::STAT_SAMPLE:
+                    value.mMean = parser.getF64();
+                    value.mMin = parser.getF64();
+                    value.mMax = parser.getF64();
+                    value.mLast = parser.getF64();
+                    value.mCount = (U32)parser.getVarint();
+                    value.mSum = value.mMean * frame.mDuration;
+                    break;
+                case TraceCapture::STAT_EVENT:
+                    value.mSum = parser.getF64();
+                    value.mMin = parser.getF64();
+                    value.mMax = parser.getF64();
+                    value.mLast = parser.getF64();
+                    value.mCount = (U32)parser.getVarint();
+                    value.mMean = value.mCount ? value.mSum / value.mCount : 0.0;
+                    break;
+                case TraceCapture::STAT_TIMER:
+                    value.mSum = parser.getF64();
+                    value.mSelf = parser.getF64();
+                    value.mCount = (U32)parser.getVarint();
+                    value.mMean = value.mCount ? value.mSum / value.mCount : 0.0;
+                    break;
+                default:
+                    break;
+                }
+                frame.mValues.emplace_back(index, value);
+            }
+            if (!parser.ok())
+            {
+                break;
+            }
+
+            std::sort(frame.mValues.begin(), frame.mValues.end(), value_less);
+            for (const auto& entry : frame.mValues)
+            {
+                if (mStats[entry.first].mKind == TraceCapture::STAT_SAMPLE)
+                {
+                    mSampledFrames[entry.first].push_back((U32)mFrames.size());
+                }
+            }
+
+            time += frame.mDuration;
+            mFrames.push_back(std::move(frame));
+        }
+        else
+        {
+            parser.getU8();     // fail
+            break;
+        }
+    }
+
+    // Frames are written whole, so anything left over is a capture that
+    // was cut short
+    mTruncated = !parser.ok();
+    if (mTruncated)
+    {
+        LL_WARNS("LLTrace") << "Trace capture is truncated after " << mFrames.size() << " frames" << LL_ENDL;
+    }
+    return true;
+}
+
+bool TraceCaptureReader::getValue(size_t frame_index, U32 id, Value& value) const
+{
+    if (frame_index >= mFrames.size() || id >= mStats.size())
+    {
+        return false;
+    }
+    const Frame& frame = mFrames[frame_index];
+    const Value* written = frame.find(id);
+    if (written)
+    {
+        value = *written;
+        return true;
+    }
+    if (mStats[id].mKind != TraceCapture::STAT_SAMPLE)
+    {
+        return false;
+    }
+
+    // The last frame the stat was sampled in before this one
+    const std::vector<U32>& sampled = mSampledFrames[id];
+    auto it = std::upper_bound(sampled.begin(), sampled.end(), (U32)frame_index);
+    if (it == sampled.begin())
+    {
+        return false;
+    }
+    value = carryOver(*mFrames[*(it - 1)].find(id), frame.mDuration);
+    return true;
+}
+
+// static
+TraceCaptureReader::Value TraceCaptureReader::carryOver(const Value& sampled, F64 duration)
+{
+    // An unsampled sample stat held its last value all frame long
+    Value value;
+    value.mMean = value.mMin = value.mMax = value.mLast = sampled.mLast;
+    value.mSum = value.mMean * duration;
+    return value;
+}
+
+S32 TraceCaptureReader::findStat(const std::string& name, TraceCapture::EStatKind kind) const
+{
+    for (size_t i = 0; i < mStats.size(); ++i)
+    {
+        if (mStats[i].mKind == kind && mStats[i].mName == name)
+        {
+            return (S32)i;
+        }
+    }
+    return -1;
+}
+
+TraceCaptureReader::Summary TraceCaptureReader::summarize(U32 id) const
+{
+    Summary summary;
+    if (id >= mStats.size())
+    {
+        return summary;
+    }
+
+    const TraceCapture::EStatKind kind = mStats[id].mKind;
+    std::vector<F64> values;
+    values.reserve(kind == TraceCapture::STAT_SAMPLE ? mFrames.size() : 0);
+    F64 total = 0.0;
+    const Value* last_sample = NULL;
+    for (const Frame& frame : mFrames)
+    {
+        const Value* value = frame.find(id);
+        F64 primary;
+        if (value)
+        {
+            primary = value->getPrimary(kind);
+            if (kind == TraceCapture::STAT_SAMPLE)
+            {
+                last_sample = value;
+            }
+        }
+        else if (last_sample)
+        {
+            primary = carryOver(*last_sample, frame.mDuration).getPrimary(kind);
+        }
+        else
+        {
+            continue;
+        }
+        values.push_back(primary);
+        total += primary;
+    }
+
+    if (!values.empty())
+    {
+        summary.mFrames = (U32)values.size();
+        summary.mMean = total / values.size();
+        summary.mP50 = percentile(values, 0.5);
+        summary.mP95 = percentile(values, 0.95);
+        summary.mP99 = percentile(values, 0.99);
+        summary.mMin = values.front();
+        summary.mMax = values.back();
+    }
+    return summary;
+}
+
+void TraceCaptureReader::writeCSV(std::ostream& out) const
+{
+    out << "frame,time,frame_ms";
+    for (const Stat& stat : mStats)
+    {
+        out << ',' << csv_escape(stat.mUnit.empty() ? stat.mName : stat.mName + " (" + stat.mUnit + ")");
+    }
+    out << '\n';
+
+    out << std::setprecision(9);
+    // The last sample of each sample stat, for the frames it wasn't sampled in
+    std::vector<const Value*> last_samples(mStats.size(), NULL);
+    for (size_t i = 0; i < mFrames.size(); ++i)
+    {
+        const Frame& frame = mFrames[i];
+        out << i << ',' << frame.mTime << ',' << frame.mDuration * 1000.0;
+        // values are sorted by id
+        auto it = frame.mValues.begin();
+        for (U32 id = 0; id < mStats.size(); ++id)
+        {
+            out << ',';
+            if (it != frame.mValues.end() && it->first == id)
+            {
+                out << it->second.getPrimary(mStats[id].mKind);
+                if (mStats[id].mKind == TraceCapture::STAT_SAMPLE)
+                {
+                    last_samples[id] = &it->second;
+                }
+                ++it;
+            }
+            else if (last_samples[id])
+            {
+                out << carryOver(*last_samples[id], frame.mDuration).getPrimary(mStats[id].mKind);
+            }
+        }
+        out << '\n';
+    }
+}
+
+void TraceCaptureReader::writeSummary(std::ostream& out) const
+{
+    out << "stat,kind,unit,frames,mean,min,p50,p95,p99,max\n";
+    out << std::setprecision(9);
+
+    std::vector<F64> frame_ms;
+    frame_ms.reserve(mFrames.size());
+    F64 total = 0.0;
+    for (const Frame& frame : mFrames)
+    {
+        frame_ms.push_back(frame.mDuration * 1000.0);
+        total += frame_ms.back();
+    }
+    if (!frame_ms.empty())
+    {
+        out << "frame,,ms," << frame_ms.size() << ',' << total / frame_ms.size() << ','
+            << percentile(frame_ms, 0.0) << ',' << percentile(frame_ms, 0.5) << ','
+            << percentile(frame_ms, 0.95) << ',' << percentile(frame_ms, 0.99) << ','
+            << frame_ms.back() << '\n';
+    }
+
+    for (U32 id = 0; id < mStats.size(); ++id)
+    {
+        Summary summary = summarize(id);
+        if (!summary.mFrames)
+        {
+            continue;
+        }
+        const Stat& stat = mStats[id];
+        out << csv_escape(stat.mName) << ',' << TraceCapture::getKindName(stat.mKind) << ',' << csv_escape(stat.mUnit) << ','
+            << summary.mFrames << ',' << summary.mMean << ',' << summary.mMin << ','
+            << summary.mP50 << ',' << summary.mP95 << ',' << summary.mP99 << ',' << summary.mMax << '\n';
+    }
+}
+
+// static
+F64 TraceCaptureReader::percentile(std::vector<F64>& values, F64 p)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = (size_t)std::ceil(llclamp(p, 0.0, 1.0) * values.size());
+    return values[rank ? rank - 1 : 0];
+}
+
+}
@@ -0,0 +1,223 @@
+/**
+ * @file lltracecapture.h
+ * @brief Binary capture of per frame LLTrace recordings, and its reader.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRACECAPTURE_H
+#define LL_LLTRACECAPTURE_H
+
+#include "stdtypes.h"
+#include "llpreprocessor.h"
+#include "llfile.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace LLTrace
+{
+class Recording;
+
+//-----------------------------------------------------------------------------
+// A capture file is a header followed by records, appended as they come:
+// - a stat record names a stat the first time it has a value, and gives it
+//   the id the frame records use for it;
+// - a frame record holds the duration of a frame and the values of every
+//   stat that had any that frame. Sample stats keep their value from one
+//   frame to the next, so they are only written when they were sampled.
+// Ids and counts are variable length integers, values are F64 and times are
+// in seconds. A capture cut short by a crash reads up to its last whole frame.
+//-----------------------------------------------------------------------------
+class LL_COMMON_API TraceCapture
+{
+public:
+    enum EStatKind
+    {
+        STAT_COUNT = 0,
+        STAT_SAMPLE,
+        STAT_EVENT,
+        STAT_TIMER,
+        NUM_STAT_KINDS
+    };
+
+    static const char*  MAGIC;          // 8 bytes
+    static const U32    VERSION = 1;
+
+    static const char* getKindName(EStatKind kind);
+};
+
+//-----------------------------------------------------------------------------
+// TraceCaptureWriter
+//
+// Appends the periods of a recording to a capture file, typically each frame
+// of LLTrace::get_frame_recording(). Records are buffered and written out in
+// blocks; nothing is done for stats that had nothing happen that frame.
+// Main thread only, like the frame recording.
+//-----------------------------------------------------------------------------
+class LL_COMMON_API TraceCaptureWriter
+{
+public:
+    // Buffered bytes that trigger a write to the file
+    static const size_t WRITE_BLOCK_SIZE = 64 * 1024;
+
+    TraceCaptureWriter();
+    ~TraceCaptureWriter();
+
+    // Creates or truncates the file and writes the header
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const                 { return mFile != NULL; }
+
+    // Appends a finished period: a recording that is stopped, as
+    // PeriodicRecording::getLastRecording() is right after nextPeriod()
+    void writeFrame(const Recording& frame);
+
+    // Writes out the buffered records
+    void flush();
+
+    U32 getFrameCount() const           { return mFrameCount; }
+    U64 getBytesWritten() const         { return mBytesWritten + mBuffer.size(); }
+
+private:
+    // The capture id of the stat at this accumulator index, naming the stat
+    // in the file the first time it is seen
+    U32 getStatId(TraceCapture::EStatKind kind, size_t index);
+    void declareStat(TraceCapture::EStatKind kind, U32 id, const std::string& name, const std::string& unit);
+
+    LLFILE*         mFile;
+    std::string     mBuffer;
+    std::string     mFrameValues;
+    U64             mBytesWritten;
+    U32             mFrameCount;
+    U32             mNextStatId;
+
+    // Capture ids by accumulator index, 0 until the stat is declared
+    std::vector<U32> mStatIds[TraceCapture::NUM_STAT_KINDS];
+    // Sample stats by accumulator index, true once written
+    std::vector<bool> mSampleWritten;
+};
+
+//-----------------------------------------------------------------------------
+// TraceCaptureReader
+//
+// Loads a capture file for analysis: per frame values, CSV export and per
+// stat percentile summaries. The file is read a record at a time, and frames
+// keep only the values written for them; a sample stat's value in the frames
+// it wasn't sampled in is worked out when asked for.
+//-----------------------------------------------------------------------------
+class LL_COMMON_API TraceCaptureReader
+{
+public:
+    struct Stat
+    {
+        TraceCapture::EStatKind mKind;
+        std::string mName;
+        std::string mUnit;
+    };
+
+    // What the frame recording would have said about a stat that frame.
+    // Timers: mSum is the total time and mSelf the self time, in seconds.
+    struct Value
+    {
+        F64 mSum = 0.0;
+        F64 mMean = 0.0;
+        F64 mMin = 0.0;
+        F64 mMax = 0.0;
+        F64 mLast = 0.0;
+        F64 mSelf = 0.0;
+        U32 mCount = 0;                 // samples, events or calls
+
+        // The one number a column of the CSV shows: the sum of counts, the
+        // mean of samples and events, the total of timers in milliseconds
+        F64 getPrimary(TraceCapture::EStatKind kind) const;
+    };
+
+    struct Frame
+    {
+        F64 mTime = 0.0;                // since the start of the capture
+        F64 mDuration = 0.0;
+        // The values written that frame, by index in getStats(), sorted
+        std::vector<std::pair<U32, Value> > mValues;
+
+        // The value written that frame, NULL if none: see getValue()
+        const Value* find(U32 id) const;
+    };
+
+    struct Summary
+    {
+        U32 mFrames = 0;                // frames the stat had a value in
+        F64 mMean = 0.0;
+        F64 mMin = 0.0;
+        F64 mP50 = 0.0;
+        F64 mP95 = 0.0;
+        F64 mP99 = 0.0;
+        F64 mMax = 0.0;
+    };
+
+    TraceCaptureReader();
+
+    // False if the file can't be read or isn't a capture
+    bool load(const std::string& filename);
+    bool parse(const std::string& data);
+    bool parse(std::istream& in);
+
+    F64 getStartTime() const            { return mStartTime; }  // seconds since epoch
+    bool isTruncated() const            { return mTruncated; }
+
+    const std::vector<Stat>& getStats() const   { return mStats; }
+    const std::vector<Frame>& getFrames() const { return mFrames; }
+
+    // Index in getStats() by name and kind, -1 if the capture never saw it
+    S32 findStat(const std::string& name, TraceCapture::EStatKind kind) const;
+
+    // The stat's value in a frame. A sample stat that wasn't sampled that
+    // frame held its last sample. False if the stat has no value there.
+    bool getValue(size_t frame, U32 id, Value& value) const;
+
+    // Over the frames the stat has a value in, of Value::getPrimary()
+    Summary summarize(U32 id) const;
+
+    // A row per frame with the time, the frame duration in milliseconds and
+    // a column per stat, empty where the stat has no value
+    void writeCSV(std::ostream& out) const;
+    // A row per stat: kind, unit and Summary fields
+    void writeSummary(std::ostream& out) const;
+
+    // p in [0, 1], nearest rank. Sorts values.
+    static F64 percentile(std::vector<F64>& values, F64 p);
+
+private:
+    static Value carryOver(const Value& sampled, F64 duration);
+
+    F64                 mStartTime;
+    bool                mTruncated;
+    std::vector<Stat>   mStats;
+    std::vector<Frame>  mFrames;
+    // By index in getStats(), the frames each sample stat was sampled in
+    std::vector<std::vector<U32> > mSampledFrames;
+};
+
+}
+
+#endif // LL_LLTRACECAPTURE_H
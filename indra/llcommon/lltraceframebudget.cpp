@@ -0,0 +1,305 @@
+/**
+ * @file lltraceframebudget.cpp
+ * @brief Attribution of frame time to a fixed set of subsystem buckets.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceframebudget.h"
+
+#include "llfasttimer.h"
+#include "llfile.h"
+#include "llsdjson.h"
+#include "llthread.h"
+#include "lltracecapture.h"
+
+namespace
+{
+    const char* BUCKET_NAMES[LLTrace::FrameBudget::NUM_BUCKETS] =
+    {
+        "network",
+        "object_updates",
+        "culling",
+        "rebuilds",
+        "render",
+        "avatars",
+        "ui",
+        "other"
+    };
+
+    // Frames between updates of the median frame time hitches are measured
+    // against
+    const U32 MEDIAN_PERIOD = 32;
+
+    LLSD percentiles_to_llsd(const LLTrace::FrameBudget::Percentiles& percentiles)
+    {
+        LLSD out;
+        out["mean"] = percentiles.mMean;
+        out["p50"] = percentiles.mP50;
+        out["p95"] = percentiles.mP95;
+        out["p99"] = percentiles.mP99;
+        out["max"] = percentiles.mMax;
+        return out;
+    }
+}
+
+namespace LLTrace
+{
+
+FrameBudget* FrameBudget::sActive = nullptr;
+
+FrameBudget::EBucket FrameBudget::Hitch::getWorstBucket() const
+{
+    S32 worst = 0;
+    for (S32 bucket = 1; bucket < NUM_BUCKETS; ++bucket)
+    {
+        if (mBuckets[bucket] > mBuckets[worst])
+        {
+            worst = bucket;
+        }
+    }
+    return (EBucket)worst;
+}
+
+FrameBudget::FrameBudget(U32 window)
+:   mFrames(window ? window : 1),
+    mFrameCount(0),
+    mMedianMs(0.0),
+    mHitchMinMs(50.0),
+    mHitchMultiple(2.0),
+    mHitchCount(0),
+    mCurrentScope(nullptr)
+{
+    mPending.fill(0);
+}
+
+FrameBudget::~FrameBudget()
+{
+    setActive(false);
+}
+
+//static
+const char* FrameBudget::getBucketName(EBucket bucket)
+{
+    return bucket < NUM_BUCKETS ? BUCKET_NAMES[bucket] : "";
+}
+
+void FrameBudget::setHitchThreshold(F64 min_ms, F64 median_multiple)
+{
+    mHitchMinMs = min_ms;
+    mHitchMultiple = median_multiple;
+}
+
+void FrameBudget::addFrame(F64 frame_ms, const bucket_times_t& buckets)
+{
+    Frame& frame = mFrames[mFrameCount % mFrames.size()];
+    frame.mFrameMs = frame_ms;
+    frame.mBuckets = buckets;
+
+    F64 accounted = 0.0;
+    for (S32 bucket = 0; bucket < OTHER; ++bucket)
+    {
+        accounted += buckets[bucket];
+    }
+    frame.mBuckets[OTHER] = llmax(frame_ms - accounted, 0.0);
+
+    if (mFrameCount >= MIN_HITCH_FRAMES
+        && frame_ms > mHitchMinMs
+        && frame_ms > mHitchMultiple * mMedianMs)
+    {
+        Hitch hitch;
+        hitch.mFrame = mFrameCount;
+        hitch.mFrameMs = frame_ms;
+        hitch.mMedianMs = mMedianMs;
+        hitch.mBuckets = frame.mBuckets;
+        mHitches.push_back(hitch);
+        if (mHitches.size() > MAX_HITCHES)
+        {
+            mHitches.pop_front();
+        }
+        ++mHitchCount;
+    }
+
+    ++mFrameCount;
+    if (mFrameCount >= MIN_HITCH_FRAMES && (mFrameCount - MIN_HITCH_FRAMES) % MEDIAN_PERIOD == 0)
+    {
+        updateMedian();
+    }
+}
+
+void FrameBudget::setActive(bool active)
+{
+    if (active)
+    {
+        sActive = this;
+    }
+    else if (sActive == this)
+    {
+        sActive = nullptr;
+    }
+}
+
+void FrameBudget::endFrame(F64 frame_ms)
+{
+    const F64 ms_per_count = 1000.0 / (F64)BlockTimer::countsPerSecond();
+    bucket_times_t buckets;
+    for (S32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        buckets[bucket] = (F64)mPending[bucket] * ms_per_count;
+    }
+    mPending.fill(0);
+    addFrame(frame_ms, buckets);
+}
+
+FrameBudget::Percentiles FrameBudget::getFramePercentiles() const
+{
+    return getPercentiles(-1);
+}
+
+FrameBudget::Percentiles FrameBudget::getBucketPercentiles(EBucket bucket) const
+{
+    return getPercentiles(bucket);
+}
+
+// of the frame time for bucket -1
+FrameBudget::Percentiles FrameBudget::getPercentiles(S32 bucket) const
+{
+    Percentiles percentiles;
+    U32 frames = getWindowFrames();
+    if (!frames)
+    {
+        return percentiles;
+    }
+
+    std::vector<F64> values;
+    values.reserve(frames);
+    F64 sum = 0.0;
+    for (U32 i = 0; i < frames; ++i)
+    {
+        const Frame& frame = mFrames[i];
+        F64 value = bucket < 0 ? frame.mFrameMs : frame.mBuckets[bucket];
+        values.push_back(value);
+        sum += value;
+    }
+
+    percentiles.mMean = sum / frames;
+    percentiles.mP50 = TraceCaptureReader::percentile(values, 0.5);
+    percentiles.mP95 = TraceCaptureReader::percentile(values, 0.95);
+    percentiles.mP99 = TraceCaptureReader::percentile(values, 0.99);
+    percentiles.mMax = values.back();
+    return percentiles;
+}
+
+void FrameBudget::updateMedian()
+{
+    mMedianMs = getFramePercentiles().mP50;
+}
+
+LLSD FrameBudget::getReport() const
+{
+    LLSD report;
+    report["frames"] = (LLSD::Integer)mFrameCount;
+    report["window_frames"] = (LLSD::Integer)getWindowFrames();
+
+    Percentiles frame = getFramePercentiles();
+    report["frame_ms"] = percentiles_to_llsd(frame);
+
+    LLSD& buckets = report["buckets"];
+    for (S32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        Percentiles percentiles = getBucketPercentiles((EBucket)bucket);
+        LLSD& out = buckets[BUCKET_NAMES[bucket]];
+        out = percentiles_to_llsd(percentiles);
+        // of the mean frame
+        out["share"] = frame.mMean > 0.0 ? percentiles.mMean / frame.mMean : 0.0;
+    }
+
+    report["hitch_count"] = (LLSD::Integer)mHitchCount;
+    report["hitch_threshold"]["min_ms"] = mHitchMinMs;
+    report["hitch_threshold"]["median_multiple"] = mHitchMultiple;
+    LLSD& hitches = report["hitches"];
+    hitches = LLSD::emptyArray();
+    for (const Hitch& hitch : mHitches)
+    {
+        LLSD out;
+        out["frame"] = (LLSD::Integer)hitch.mFrame;
+        out["frame_ms"] = hitch.mFrameMs;
+        out["median_ms"] = hitch.mMedianMs;
+        out["worst"] = BUCKET_NAMES[hitch.getWorstBucket()];
+        for (S32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            out["buckets"][BUCKET_NAMES[bucket]] = hitch.mBuckets[bucket];
+        }
+        hitches.append(out);
+    }
+    return report;
+}
+
+bool FrameBudget::writeReport(const std::string& filename) const
+{
+    llofstream out(filename.c_str());
+    if (!out.is_open())
+    {
+        LL_WARNS("FrameBudget") << "Can't write frame budget report " << filename << LL_ENDL;
+        return false;
+    }
+    out << boost::json::serialize(LlsdToJson(getReport())) << std::endl;
+    return out.good();
+}
+
+void FrameBudget::reset()
+{
+    mFrameCount = 0;
+    mMedianMs = 0.0;
+    mHitchCount = 0;
+    mHitches.clear();
+    mPending.fill(0);
+}
+
+void FrameBudget::Scope::start(EBucket bucket)
+{
+    // the budget is the main loop's
+    if (!on_main_thread())
+    {
+        mBudget = nullptr;
+        return;
+    }
+    mBucket = bucket;
+    mParent = mBudget->mCurrentScope;
+    mBudget->mCurrentScope = this;
+    mStartTime = BlockTimer::getCPUClockCount64();
+}
+
+void FrameBudget::Scope::stop()
+{
+    U64 elapsed = BlockTimer::getCPUClockCount64() - mStartTime;
+    mBudget->mPending[mBucket] += elapsed - llmin(mChildTime, elapsed);
+    if (mParent)
+    {
+        mParent->mChildTime += elapsed;
+    }
+    mBudget->mCurrentScope = mParent;
+}
+
+}
@@ -0,0 +1,203 @@
+/**
+ * @file lltraceframebudget.h
+ * @brief Attribution of frame time to a fixed set of subsystem buckets.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRACEFRAMEBUDGET_H
+#define LL_LLTRACEFRAMEBUDGET_H
+
+#include "stdtypes.h"
+#include "llpreprocessor.h"
+#include "llsd.h"
+
+#include <array>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Charges the time until the end of the enclosing scope to a FrameBudget
+// bucket, e.g. LL_RECORD_FRAME_BUDGET(CULLING). Goes next to the profile
+// zone of a subsystem's top level entry point.
+#define LL_RECORD_FRAME_BUDGET(bucket) LLTrace::FrameBudget::Scope LL_GLUE_TOKENS(frame_budget_scope, __LINE__)(LLTrace::FrameBudget::bucket)
+
+namespace LLTrace
+{
+
+//-----------------------------------------------------------------------------
+// FrameBudget
+//
+// Where the frame went: each frame is split into a fixed set of buckets,
+// and the last frames are kept to report the 50th, 95th and 99th percentile
+// of each bucket and to pick out hitches, frames well over the usual frame
+// time, with what they were spent on.
+//
+// Buckets are filled either with explicit times through addFrame(), or by
+// LL_RECORD_FRAME_BUDGET scopes on the main thread while the budget is the
+// active one, in which case endFrame() closes the frame. Scopes nest like
+// fast timers do: an inner scope's time is charged to its own bucket only,
+// and whatever no scope covered ends up in OTHER.
+//-----------------------------------------------------------------------------
+class LL_COMMON_API FrameBudget
+{
+public:
+    enum EBucket
+    {
+        NETWORK = 0,        // reading and decoding messages
+        OBJECT_UPDATES,     // applying object updates, object list update
+        CULLING,
+        REBUILDS,           // geometry and spatial group rebuilds
+        RENDER,             // the rest of the render pipeline
+        AVATARS,            // avatar updates and drawing
+        UI,
+        OTHER,              // frame time no bucket accounts for
+        NUM_BUCKETS
+    };
+
+    typedef std::array<F64, NUM_BUCKETS> bucket_times_t;     // milliseconds
+
+    struct Percentiles
+    {
+        F64 mMean = 0.0;
+        F64 mP50 = 0.0;
+        F64 mP95 = 0.0;
+        F64 mP99 = 0.0;
+        F64 mMax = 0.0;
+    };
+
+    struct Hitch
+    {
+        U64 mFrame = 0;
+        F64 mFrameMs = 0.0;
+        F64 mMedianMs = 0.0;            // usual frame time when it happened
+        bucket_times_t mBuckets{};
+
+        EBucket getWorstBucket() const;
+    };
+
+    // Frames the percentiles are over
+    static const U32 DEFAULT_WINDOW = 1000;
+    // Frames it takes before hitches are looked for
+    static const U32 MIN_HITCH_FRAMES = 30;
+    // Hitches the report keeps, the latest ones
+    static const U32 MAX_HITCHES = 100;
+
+    FrameBudget(U32 window = DEFAULT_WINDOW);
+    ~FrameBudget();
+
+    static const char* getBucketName(EBucket bucket);
+
+    // A frame is a hitch when it takes longer than both min_ms and
+    // median_multiple times the median frame time of the window
+    void setHitchThreshold(F64 min_ms, F64 median_multiple);
+
+    // Adds a frame of frame_ms, of which buckets says where it went. OTHER
+    // is worked out, whatever buckets has in it.
+    void addFrame(F64 frame_ms, const bucket_times_t& buckets);
+
+    // LL_RECORD_FRAME_BUDGET scopes charge the active budget, if any
+    void setActive(bool active);
+    bool isActive() const               { return sActive == this; }
+    static FrameBudget* getActive()     { return sActive; }
+
+    // Adds a frame of frame_ms from the time the scopes have charged since
+    // the last call
+    void endFrame(F64 frame_ms);
+
+    U64 getFrameCount() const           { return mFrameCount; }
+    U32 getWindowFrames() const         { return (U32)(mFrameCount < mFrames.size() ? mFrameCount : mFrames.size()); }
+    U64 getHitchCount() const           { return mHitchCount; }
+    const std::deque<Hitch>& getHitches() const { return mHitches; }
+
+    // Over the frames in the window
+    Percentiles getFramePercentiles() const;
+    Percentiles getBucketPercentiles(EBucket bucket) const;
+
+    // The percentiles of the frame and of each bucket, and the hitches
+    LLSD getReport() const;
+    // getReport() as JSON
+    bool writeReport(const std::string& filename) const;
+
+    void reset();
+
+    class Scope
+    {
+    public:
+        Scope(EBucket bucket)
+        :   mBudget(sActive)
+        {
+            if (mBudget)
+            {
+                start(bucket);
+            }
+        }
+
+        ~Scope()
+        {
+            if (mBudget)
+            {
+                stop();
+            }
+        }
+
+    private:
+        void start(EBucket bucket);
+        void stop();
+
+        FrameBudget*    mBudget;
+        Scope*          mParent = nullptr;
+        U64             mStartTime = 0;
+        U64             mChildTime = 0;
+        EBucket         mBucket = OTHER;
+    };
+
+private:
+    struct Frame
+    {
+        F64 mFrameMs = 0.0;
+        bucket_times_t mBuckets{};
+    };
+
+    Percentiles getPercentiles(S32 bucket) const;
+    void updateMedian();
+
+    static FrameBudget* sActive;
+
+    // Ring of the last frames, mFrameCount % size() is the next one written
+    std::vector<Frame>  mFrames;
+    U64                 mFrameCount;
+    F64                 mMedianMs;
+
+    F64                 mHitchMinMs;
+    F64                 mHitchMultiple;
+    U64                 mHitchCount;
+    std::deque<Hitch>   mHitches;
+
+    // Charged by scopes this frame, in clock counts
+    std::array<U64, NUM_BUCKETS> mPending;
+    Scope*              mCurrentScope;
+};
+
+}
+
+#endif // LL_LLTRACEFRAMEBUDGET_H
@@ -294,6 +294,7 @@ namespace LLTrace
 
     protected:
         friend class ThreadRecorder;
+        friend class TraceCaptureWriter; // <FS/> Trace capture reads the buffers as they are
 
         // implementation for LLStopWatchControlsMixin
         /*virtual*/ void handleStart();
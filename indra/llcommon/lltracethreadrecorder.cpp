@@ -120,8 +120,36 @@ ThreadRecorder::~ThreadRecorder()
 
     if (mParentRecorder)
     {
-        mParentRecorder->removeChildRecorder(this);
+        // <FS> Lock-free stats handoff
+        //mParentRecorder->removeChildRecorder(this);
+
+        // what was recorded since the last pushToParent(), now that
+        // deactivate() brought mThreadRecordingBuffers up to date
+        AccumulatorBufferGroup* last_stats = mSharedRecording.mReady.exchange(NULL, std::memory_order_acquire);
+        if (!last_stats)
+        {
+            last_stats = mSharedRecording.mSpare.exchange(NULL, std::memory_order_acquire);
+        }
+        if (!last_stats)
+        {
+            last_stats = new AccumulatorBufferGroup();
+            last_stats->reset();
+        }
+        last_stats->append(mThreadRecordingBuffers);
+        mParentRecorder->removeChildRecorder(this, last_stats);
+        // </FS>
     }
+
+    // <FS> Lock-free stats handoff
+    // the parent is done with us, but may have left buffers behind
+    delete mSharedRecording.mReady.exchange(NULL);
+    delete mSharedRecording.mSpare.exchange(NULL);
+    for (AccumulatorBufferGroup* orphan : mOrphanedRecordings)
+    {
+        delete orphan;
+    }
+    mOrphanedRecordings.clear();
+    // </FS>
 #endif
 }
 
@@ -254,26 +282,67 @@ void ThreadRecorder::addChildRecorder(ThreadRecorder* child)
 }
 
 // called by child thread
-void ThreadRecorder::removeChildRecorder(ThreadRecorder* child)
+// <FS> Lock-free stats handoff
+//void ThreadRecorder::removeChildRecorder(ThreadRecorder* child)
+void ThreadRecorder::removeChildRecorder(ThreadRecorder* child, AccumulatorBufferGroup* last_stats)
+// </FS>
 {
 #if LL_TRACE_ENABLED
     LLMutexLock lock(&mChildListMutex);
     mChildThreadRecorders.remove(child);
+    // <FS> Lock-free stats handoff
+    if (last_stats)
+    {
+        mOrphanedRecordings.push_back(last_stats);
+    }
+    // </FS>
 #endif
 }
 
-void ThreadRecorder::pushToParent()
+// <FS> Lock-free stats handoff
+//void ThreadRecorder::pushToParent()
+//{
+//#if LL_TRACE_ENABLED
+//    if (ThreadRecorder* recorder = LLTrace::get_thread_recorder())
+//    {
+//        LLMutexLock lock(&mSharedRecordingMutex);
+//        recorder->bringUpToDate(&mThreadRecordingBuffers);
+//        mSharedRecordingBuffers.append(mThreadRecordingBuffers);
+//        mThreadRecordingBuffers.reset();
+//    }
+//#endif
+//}
+
+// called by child thread
+bool ThreadRecorder::pushToParent()
 {
 #if LL_TRACE_ENABLED
-    if (ThreadRecorder* recorder = LLTrace::get_thread_recorder())
+    // the parent has yet to pick up the last lot, keep recording into ours
+    if (!mParentRecorder || mSharedRecording.mReady.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_STATS;
+    AccumulatorBufferGroup* buffers = mSharedRecording.mSpare.exchange(NULL, std::memory_order_acquire);
+    if (!buffers)
     {
-        LLMutexLock lock(&mSharedRecordingMutex);
-        recorder->bringUpToDate(&mThreadRecordingBuffers);
-        mSharedRecordingBuffers.append(mThreadRecordingBuffers);
-        mThreadRecordingBuffers.reset();
+        // first time, or the parent is busy putting the spare back
+        buffers = new AccumulatorBufferGroup();
+        buffers->reset();
     }
+
+    bringUpToDate(&mThreadRecordingBuffers);
+    buffers->append(mThreadRecordingBuffers);
+    mThreadRecordingBuffers.reset();
+
+    mSharedRecording.mReady.store(buffers, std::memory_order_release);
+    return true;
+#else
+    return false;
 #endif
 }
+// </FS>
 
 
 void ThreadRecorder::pullFromChildren()
@@ -287,10 +356,29 @@ void ThreadRecorder::pullFromChildren()
         target_recording_buffers.sync();
         for (LLTrace::ThreadRecorder* rec : mChildThreadRecorders)
         {
-            LLMutexLock lock(&(rec->mSharedRecordingMutex));
-            target_recording_buffers.merge(rec->mSharedRecordingBuffers);
-            rec->mSharedRecordingBuffers.reset();
+            // <FS> Lock-free stats handoff
+            //LLMutexLock lock(&(rec->mSharedRecordingMutex));
+            //target_recording_buffers.merge(rec->mSharedRecordingBuffers);
+            //rec->mSharedRecordingBuffers.reset();
+            AccumulatorBufferGroup* ready = rec->mSharedRecording.mReady.exchange(NULL, std::memory_order_acquire);
+            if (ready)
+            {
+                target_recording_buffers.merge(*ready);
+                ready->reset();
+                // the child may have made new buffers while the spare was out
+                delete rec->mSharedRecording.mSpare.exchange(ready, std::memory_order_acq_rel);
+            }
+            // </FS>
+        }
+
+        // <FS> Lock-free stats handoff
+        for (AccumulatorBufferGroup* orphan : mOrphanedRecordings)
+        {
+            target_recording_buffers.merge(*orphan);
+            delete orphan;
         }
+        mOrphanedRecordings.clear();
+        // </FS>
     }
 #endif
 }
@@ -33,6 +33,8 @@
 #include "llmutex.h"
 #include "lltraceaccumulators.h"
 
+#include <atomic>
+
 namespace LLTrace
 {
     class LL_COMMON_API ThreadRecorder
@@ -51,11 +53,23 @@ namespace LLTrace
         active_recording_list_t::iterator bringUpToDate(AccumulatorBufferGroup* recording);
 
         void addChildRecorder(class ThreadRecorder* child);
-        void removeChildRecorder(class ThreadRecorder* child);
+        // <FS> Lock-free stats handoff
+        //void removeChildRecorder(class ThreadRecorder* child);
+        // last_stats: what the child recorded since its last pushToParent(),
+        // for the next pullFromChildren()
+        void removeChildRecorder(class ThreadRecorder* child, AccumulatorBufferGroup* last_stats = NULL);
+        // </FS>
 
         // call this periodically to gather stats data from child threads
         void pullFromChildren();
-        void pushToParent();
+        // <FS> Lock-free stats handoff
+        //void pushToParent();
+        // Called by the child thread as often as convenient: hands what it
+        // recorded so far to the parent, unless the parent has yet to pick up
+        // the previous lot. Never waits on the parent. False if nothing was
+        // handed over.
+        bool pushToParent();
+        // </FS>
 
         TimeBlockTreeNode* getTimeBlockTreeNode(size_t index);
 
@@ -85,8 +99,24 @@ namespace LLTrace
 
         child_thread_recorder_list_t    mChildThreadRecorders;  // list of child thread recorders associated with this master
         LLMutex                         mChildListMutex;        // protects access to child list
-        LLMutex                         mSharedRecordingMutex;
-        AccumulatorBufferGroup          mSharedRecordingBuffers;
+        // <FS> Lock-free stats handoff
+        //LLMutex                         mSharedRecordingMutex;
+        //AccumulatorBufferGroup          mSharedRecordingBuffers;
+
+        // The stats a child hands to its parent. The child fills mReady once
+        // the parent has emptied it, with the buffers the parent left in
+        // mSpare after emptying the previous ones, so neither thread waits on
+        // the other. On a cache line of its own, as the child checks mReady
+        // after every work item while the parent goes about its business.
+        struct alignas(64) SharedRecording
+        {
+            std::atomic<AccumulatorBufferGroup*> mReady{ nullptr };
+            std::atomic<AccumulatorBufferGroup*> mSpare{ nullptr };
+        };
+        SharedRecording                 mSharedRecording;
+        // last stats of the children that are gone, protected by mChildListMutex
+        std::vector<AccumulatorBufferGroup*> mOrphanedRecordings;
+        // </FS>
         ThreadRecorder*                 mParentRecorder;
 
     };
@@ -0,0 +1,439 @@
+/**
+ * @file   lockfreequeue.h
+ * @brief  LLThreadSafeQueue variant that only takes a lock to wait.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LOCKFREEQUEUE_H)
+#define LL_LOCKFREEQUEUE_H
+
+#include "llthreadsafequeue.h"
+#include "concurrentqueue.h"
+#include <atomic>
+#include <new>                      // std::bad_alloc
+#include <thread>                   // std::this_thread::yield()
+
+namespace LL
+{
+    /**
+     * Pass LockFreeQueue<T> as LLThreadSafeQueue's QueueT to get a queue with
+     * the same API whose push and pop go straight to a lock-free
+     * moodycamel::ConcurrentQueue. The mutex and condition variables are only
+     * touched by callers that have to wait, because the queue is full or
+     * empty, and by whoever then has to wake them.
+     *
+     * Capacity, blocking, close() and LLThreadSafeQueueInterrupt behave as
+     * for LLThreadSafeQueue, with one difference: items pushed by one thread
+     * pop in the order they were pushed, but items pushed by different
+     * threads may pop in any order relative to each other.
+     *
+     * There is no canPop() hook, so this can't back ThreadSafeSchedule.
+     */
+    template <typename T>
+    struct LockFreeQueue
+    {
+        typedef T value_type;
+    };
+} // namespace LL
+
+template <typename ElementT>
+class LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>
+{
+public:
+    typedef ElementT value_type;
+
+    LLThreadSafeQueue(size_t capacity = 1024);
+    virtual ~LLThreadSafeQueue() {}
+
+    // See LLThreadSafeQueue for all of these.
+    template <typename T>
+    void push(T&& element);
+    void pushFront(ElementT const & element) { return push(element); }
+
+    template <typename T>
+    bool pushIfOpen(T&& element);
+
+    template <typename T>
+    bool tryPush(T&& element);
+    bool tryPushFront(ElementT const & element) { return tryPush(element); }
+
+    template <typename Rep, typename Period, typename T>
+    bool tryPushFor(const std::chrono::duration<Rep, Period>& timeout,
+                    T&& element);
+    template <typename Rep, typename Period>
+    bool tryPushFrontFor(const std::chrono::duration<Rep, Period>& timeout,
+                         ElementT const & element) { return tryPushFor(timeout, element); }
+
+    template <typename Clock, typename Duration, typename T>
+    bool tryPushUntil(const std::chrono::time_point<Clock, Duration>& until,
+                      T&& element);
+
+    ElementT pop(void);
+    ElementT popBack(void) { return pop(); }
+
+    bool tryPop(ElementT & element);
+    bool tryPopBack(ElementT & element) { return tryPop(element); }
+
+    template <typename Rep, typename Period>
+    bool tryPopFor(const std::chrono::duration<Rep, Period>& timeout, ElementT& element);
+
+    template <typename Clock, typename Duration>
+    bool tryPopUntil(const std::chrono::time_point<Clock, Duration>& until,
+                     ElementT& element);
+
+    // Items pushed and not yet popped, counting pushes under way.
+    size_t size() { return mSize; }
+
+    U32 capacity() { return (U32)mCapacity; }
+
+    void close();
+
+    bool isClosed() { return mClosed; }
+    bool done() { return mClosed && mSize == 0; }
+
+protected:
+    typedef LL::LockFreeQueue<ElementT> queue_type;
+    // tries at an empty or full queue before waiting on mEmptyCond or
+    // mCapacityCond
+    static constexpr U32 SPIN_BEFORE_WAIT = 32;
+    moodycamel::ConcurrentQueue<ElementT> mStorage;
+    size_t mCapacity;
+    // Claimed by a push before it checks mClosed, so that a consumer never
+    // sees the queue closed and empty while a push is still on its way in.
+    std::atomic<size_t> mSize;
+    std::atomic<bool> mClosed;
+
+    // Only for waiting. A waiter counts itself in under the lock before it
+    // checks again, so whoever changes the state either sees the count or
+    // is seen by that check.
+    boost::fibers::mutex mLock;
+    typedef std::unique_lock<decltype(mLock)> lock_t;
+    boost::fibers::condition_variable_any mCapacityCond;
+    boost::fibers::condition_variable_any mEmptyCond;
+    std::atomic<U32> mPushWaiters;
+    std::atomic<U32> mPopWaiters;
+
+    enum push_result { CLOSED, FULL, PUSHED };
+    template <typename T>
+    push_result push_(T&& element);
+    // pop the head element, without waking anybody
+    bool pop_(ElementT& element);
+    // wake whoever the last pop_() might be keeping waiting
+    void popped();
+    template <typename Clock, typename Duration, typename T>
+    bool pushUntil_(const std::chrono::time_point<Clock, Duration>* until, T&& element);
+    template <typename Clock, typename Duration>
+    bool popUntil_(const std::chrono::time_point<Clock, Duration>* until, ElementT& element);
+    void wake(std::atomic<U32>& waiters, boost::fibers::condition_variable_any& cond, bool all=false);
+};
+
+/*****************************************************************************
+*   implementation
+*****************************************************************************/
+template <typename ElementT>
+LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::LLThreadSafeQueue(size_t capacity) :
+    mCapacity(capacity),
+    mSize(0),
+    mClosed(false),
+    mPushWaiters(0),
+    mPopWaiters(0)
+{
+}
+
+
+template <typename ElementT>
+void LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::wake(
+    std::atomic<U32>& waiters, boost::fibers::condition_variable_any& cond, bool all)
+{
+    // pairs with the waiter's increment: either we see it, or it sees
+    // whatever we just did to the queue
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters)
+    {
+        // Anybody who has counted themselves in is waiting by the time we
+        // get the lock.
+        { lock_t lock(mLock); }
+        if (all)
+            cond.notify_all();
+        else
+            cond.notify_one();
+    }
+}
+
+
+template <typename ElementT>
+template <typename T>
+typename LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::push_result
+LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::push_(T&& element)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
+    if (mClosed)
+        return CLOSED;
+
+    // claim a slot
+    size_t size = mSize;
+    do
+    {
+        if (size >= mCapacity)
+            return FULL;
+    } while (! mSize.compare_exchange_weak(size, size + 1));
+
+    if (mClosed || ! mStorage.enqueue(std::forward<T>(element)))
+    {
+        bool closed = mClosed;
+        --mSize;
+        // a consumer may be waiting for this push to land before it decides
+        // the queue is done
+        wake(mPopWaiters, mEmptyCond, true);
+        if (closed)
+            return CLOSED;
+        throw std::bad_alloc();
+    }
+    // now that we've pushed, if somebody's been waiting to pop, signal them
+    wake(mPopWaiters, mEmptyCond);
+    return PUSHED;
+}
+
+
+template <typename ElementT>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::pop_(ElementT& element)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
+    if (! mStorage.try_dequeue(element))
+        return false;
+    --mSize;
+    return true;
+}
+
+
+template <typename ElementT>
+void LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::popped()
+{
+    // now that we've popped, if somebody's been waiting to push, signal them
+    wake(mPushWaiters, mCapacityCond);
+    // and if that was the last of a closed queue, the other consumers are done
+    if (mClosed && mSize == 0)
+    {
+        wake(mPopWaiters, mEmptyCond, true);
+    }
+}
+
+
+// until == nullptr waits as long as it takes
+template <typename ElementT>
+template <typename Clock, typename Duration, typename T>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::pushUntil_(
+    const std::chrono::time_point<Clock, Duration>* until, T&& element)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
+    while (true)
+    {
+        // as in popUntil_(), a consumer is often just about to make room
+        for (U32 spin = 0; spin < SPIN_BEFORE_WAIT; ++spin)
+        {
+            push_result pushed = push_(std::forward<T>(element));
+            if (pushed != FULL)
+                return pushed == PUSHED;
+            std::this_thread::yield();
+        }
+
+        // Storage Full. Wait for signal.
+        lock_t lock(mLock);
+        ++mPushWaiters;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool timed_out = false;
+        if (! mClosed && mSize >= mCapacity)
+        {
+            if (! until)
+                mCapacityCond.wait(lock);
+            else
+                timed_out = (LLCoros::cv_status::timeout == mCapacityCond.wait_until(lock, *until));
+        }
+        --mPushWaiters;
+        if (timed_out)
+            return false;
+    }
+}
+
+
+template <typename ElementT>
+template <typename T>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::pushIfOpen(T&& element)
+{
+    return pushUntil_<std::chrono::steady_clock, std::chrono::steady_clock::duration>(
+        nullptr, std::forward<T>(element));
+}
+
+
+template <typename ElementT>
+template <typename T>
+void LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::push(T&& element)
+{
+    if (! pushIfOpen(std::forward<T>(element)))
+    {
+        LLTHROW(LLThreadSafeQueueInterrupt());
+    }
+}
+
+
+template <typename ElementT>
+template <typename T>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPush(T&& element)
+{
+    return push_(std::forward<T>(element)) == PUSHED;
+}
+
+
+template <typename ElementT>
+template <typename Rep, typename Period, typename T>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPushFor(
+    const std::chrono::duration<Rep, Period>& timeout,
+    T&& element)
+{
+    return tryPushUntil(std::chrono::steady_clock::now() + timeout,
+                        std::forward<T>(element));
+}
+
+
+template <typename ElementT>
+template <typename Clock, typename Duration, typename T>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPushUntil(
+    const std::chrono::time_point<Clock, Duration>& until,
+    T&& element)
+{
+    return pushUntil_(&until, std::forward<T>(element));
+}
+
+
+// until == nullptr waits as long as it takes, and throws once done
+template <typename ElementT>
+template <typename Clock, typename Duration>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::popUntil_(
+    const std::chrono::time_point<Clock, Duration>* until, ElementT& element)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
+    while (true)
+    {
+        // On the consumer side, we always try to pop before checking mClosed
+        // so we can finish draining the queue. A producer is often just
+        // about to push, so give it a moment before going to sleep.
+        for (U32 spin = 0; spin < SPIN_BEFORE_WAIT; ++spin)
+        {
+            if (pop_(element))
+            {
+                popped();
+                return true;
+            }
+            if (done())
+                break;
+            std::this_thread::yield();
+        }
+
+        bool popped_here = false, is_done = false, timed_out = false;
+        {
+            lock_t lock(mLock);
+            ++mPopWaiters;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            popped_here = pop_(element);
+            is_done = ! popped_here && done();
+            if (! popped_here && ! is_done)
+            {
+                if (! until)
+                    mEmptyCond.wait(lock);
+                else
+                    timed_out = (LLCoros::cv_status::timeout == mEmptyCond.wait_until(lock, *until));
+            }
+            --mPopWaiters;
+        }
+        if (popped_here)
+        {
+            popped();
+            return true;
+        }
+        if (is_done)
+        {
+            // Once the queue is done, there will never be any more coming.
+            if (! until)
+                LLTHROW(LLThreadSafeQueueInterrupt());
+            return false;
+        }
+        if (timed_out)
+            return false;
+    }
+}
+
+
+template <typename ElementT>
+ElementT LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::pop(void)
+{
+    ElementT value;
+    popUntil_<std::chrono::steady_clock, std::chrono::steady_clock::duration>(nullptr, value);
+    return value;
+}
+
+
+template <typename ElementT>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPop(ElementT & element)
+{
+    if (! pop_(element))
+        return false;
+    popped();
+    return true;
+}
+
+
+template <typename ElementT>
+template <typename Rep, typename Period>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPopFor(
+    const std::chrono::duration<Rep, Period>& timeout,
+    ElementT& element)
+{
+    return tryPopUntil(std::chrono::steady_clock::now() + timeout, element);
+}
+
+
+template <typename ElementT>
+template <typename Clock, typename Duration>
+bool LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::tryPopUntil(
+    const std::chrono::time_point<Clock, Duration>& until,
+    ElementT& element)
+{
+    return popUntil_(&until, element);
+}
+
+
+template <typename ElementT>
+void LLThreadSafeQueue<ElementT, LL::LockFreeQueue<ElementT>>::close()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
+    {
+        lock_t lock(mLock);
+        mClosed = true;
+    }
+    // wake up any blocked pop() calls
+    mEmptyCond.notify_all();
+    // wake up any blocked push() calls
+    mCapacityCond.notify_all();
+}
+
+#endif /* ! defined(LL_LOCKFREEQUEUE_H) */
@@ -0,0 +1,242 @@
+/**
+ * @file llasyncfile_test.cpp
+ * @brief Test for LLAsyncFile.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llasyncfile.h"
+
+#include "llcoros.h"
+#include "lleventcoro.h"
+#include "llfile.h"
+#include "lltimer.h"
+#include "stringize.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+namespace tut
+{
+    struct async_file
+    {
+        // Runs the main coroutine until done() or timeout
+        template <typename PRED>
+        static void pump(PRED done, F64 timeout = 30.0)
+        {
+            LLTimer timer;
+            while (!done())
+            {
+                ensure("timed out", timer.getElapsedTimeF64() < timeout);
+                llcoro::suspend();
+                std::this_thread::yield();
+            }
+        }
+
+        static std::string fileContents(const std::string& filename)
+        {
+            llifstream in(filename.c_str(), std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        }
+    };
+
+    typedef test_group<async_file> async_file_t;
+    typedef async_file_t::object async_file_object_t;
+    tut::async_file_t tut_singleton("LLAsyncFile");
+
+    // reads and writes
+    template<> template<>
+    void async_file_object_t::test<1>()
+    {
+        NamedTempFile file("asyncfile", "", ".txt");
+        std::string name(file.getName());
+        // more than a chunk
+        std::string big(LLAsyncFile::CHUNK_SIZE * 2 + 17, 'x');
+        for (size_t i = 0; i < big.size(); i += 1000)
+        {
+            big[i] = 'a' + (i / 1000) % 26;
+        }
+
+        bool done = false;
+        LLAsyncFile::EStatus write_status = LLAsyncFile::FAILED;
+        LLAsyncFile::EStatus read_status = LLAsyncFile::FAILED;
+        LLAsyncFile::EStatus range_status = LLAsyncFile::FAILED;
+        LLAsyncFile::EStatus tail_status = LLAsyncFile::FAILED;
+        LLAsyncFile::EStatus missing_status = LLAsyncFile::OK;
+        std::string read, range, tail, missing;
+        LLCoros::instance().launch("asyncfile read write", [&]()
+        {
+            write_status = LLAsyncFile::instance().write(name, big);
+            read_status = LLAsyncFile::instance().read(name, read);
+            range_status = LLAsyncFile::instance().read(name, 1000, 2000, range);
+            tail_status = LLAsyncFile::instance().read(name, big.size() - 10, 100, tail);
+            missing_status = LLAsyncFile::instance().read(name + ".nonesuch", missing);
+            done = true;
+        });
+        pump([&done]() { return done; });
+
+        ensure_equals("write", write_status, LLAsyncFile::OK);
+        ensure_equals("written", fileContents(name), big);
+        ensure_equals("read", read_status, LLAsyncFile::OK);
+        ensure("read all", read == big);
+        ensure_equals("range", range_status, LLAsyncFile::OK);
+        ensure_equals("range read", range, big.substr(1000, 2000));
+        ensure_equals("tail", tail_status, LLAsyncFile::OK);
+        ensure_equals("short read at end", tail, big.substr(big.size() - 10));
+        ensure_equals("missing", missing_status, LLAsyncFile::NOT_FOUND);
+        ensure("nothing read", missing.empty());
+    }
+
+    // operations on a file happen in the order they were made
+    template<> template<>
+    void async_file_object_t::test<2>()
+    {
+        NamedTempFile file("asyncfile", "", ".txt");
+        std::string name(file.getName());
+        const S32 COROUTINES = 50;
+
+        S32 done = 0;
+        std::string expected;
+        for (S32 i = 0; i < COROUTINES; ++i)
+        {
+            std::string line(STRINGIZE(i << '\n'));
+            expected += line;
+            LLCoros::instance().launch(STRINGIZE("asyncfile append " << i), [&done, name, line]()
+            {
+                LLAsyncFile::instance().write(name, line, LLAsyncFile::WRITE_APPEND);
+                ++done;
+            });
+        }
+        std::string read;
+        LLCoros::instance().launch("asyncfile read back", [&done, &read, name]()
+        {
+            LLAsyncFile::instance().read(name, read);
+            ++done;
+        });
+        pump([&done]() { return done == COROUTINES + 1; });
+
+        ensure_equals("appended in order", fileContents(name), expected);
+        ensure_equals("read after the writes", read, expected);
+    }
+
+    // cancellation
+    template<> template<>
+    void async_file_object_t::test<3>()
+    {
+        NamedTempFile file("asyncfile", "before", ".txt");
+        std::string name(file.getName());
+
+        LLAsyncFile::CancelToken cancelled;
+        cancelled.cancel();
+        LLAsyncFile::CancelToken queued;
+        LLAsyncFile::CancelToken unused;
+
+        S32 done = 0;
+        LLAsyncFile::EStatus early = LLAsyncFile::OK;
+        LLAsyncFile::EStatus early_read = LLAsyncFile::OK;
+        LLAsyncFile::EStatus first = LLAsyncFile::FAILED;
+        LLAsyncFile::EStatus second = LLAsyncFile::OK;
+        LLAsyncFile::EStatus third = LLAsyncFile::FAILED;
+        std::string early_data("untouched");
+        LLCoros::instance().launch("asyncfile cancelled", [&]()
+        {
+            early = LLAsyncFile::instance().write(name, "never", LLAsyncFile::WRITE_REPLACE, cancelled);
+            early_read = LLAsyncFile::instance().read(name, early_data, cancelled);
+            ++done;
+        });
+        pump([&done]() { return done == 1; });
+        ensure_equals("cancelled write", early, LLAsyncFile::CANCELLED);
+        ensure_equals("file untouched", fileContents(name), std::string("before"));
+        ensure_equals("cancelled read", early_read, LLAsyncFile::CANCELLED);
+        ensure("nothing read", early_data.empty());
+
+        // the second write is cancelled before it gets its turn, and the
+        // ones either side of it still run in order
+        LLCoros::instance().launch("asyncfile first", [&]()
+        {
+            first = LLAsyncFile::instance().write(name, "first", LLAsyncFile::WRITE_REPLACE, unused);
+            ++done;
+        });
+        LLCoros::instance().launch("asyncfile second", [&]()
+        {
+            second = LLAsyncFile::instance().write(name, "second", LLAsyncFile::WRITE_APPEND, queued);
+            ++done;
+        });
+        LLCoros::instance().launch("asyncfile third", [&]()
+        {
+            third = LLAsyncFile::instance().write(name, "third", LLAsyncFile::WRITE_APPEND);
+            ++done;
+        });
+        queued.cancel();
+        pump([&done]() { return done == 4; });
+        ensure_equals("first", first, LLAsyncFile::OK);
+        ensure_equals("second", second, LLAsyncFile::CANCELLED);
+        ensure_equals("third", third, LLAsyncFile::OK);
+        ensure_equals("cancelled write skipped", fileContents(name), std::string("firstthird"));
+    }
+
+    // many coroutines reading at once, against reading on the main coroutine
+    template<> template<>
+    void async_file_object_t::test<4>()
+    {
+        const S32 FILES = 64;
+        const size_t FILE_SIZE = 256 * 1024;
+        std::vector<std::unique_ptr<NamedTempFile>> files;
+        for (S32 i = 0; i < FILES; ++i)
+        {
+            files.emplace_back(new NamedTempFile("asyncfile", std::string(FILE_SIZE, 'a' + i % 26), ".dat"));
+        }
+
+        // the main coroutine is held up for all of it
+        size_t sync_bytes = 0;
+        for (const auto& file : files)
+        {
+            sync_bytes += fileContents(file->getName()).size();
+        }
+
+        S32 done = 0;
+        size_t async_bytes = 0;
+        for (const auto& file : files)
+        {
+            std::string name(file->getName());
+            LLCoros::instance().launch("asyncfile bench", [&done, &async_bytes, name]()
+            {
+                std::string data;
+                if (LLAsyncFile::instance().read(name, data) == LLAsyncFile::OK)
+                {
+                    async_bytes += data.size();
+                }
+                ++done;
+            });
+        }
+        pump([&done, FILES]() { return done == FILES; });
+
+        ensure_equals("read on main coroutine", sync_bytes, FILES * FILE_SIZE);
+        ensure_equals("read on coroutines", async_bytes, FILES * FILE_SIZE);
+    }
+}
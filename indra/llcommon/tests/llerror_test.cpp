@@ -36,6 +36,11 @@
 #include "../llsd.h"
 
 #include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+#include <atomic>
+#include <fstream>
+#include <thread>
 
 enum LogFieldIndex
 {
@@ -921,6 +926,176 @@ namespace tut
     }
 }
 
+namespace tut
+{
+    // Recorded by the async log writer thread
+    class AsyncTestRecorder : public TestRecorder
+    {
+    public:
+        bool allowsAsync() override { return true; }
+
+        void recordMessage(LLError::ELevel level, const std::string& message) override
+        {
+            while (mHold)
+            {
+                std::this_thread::yield();
+            }
+            TestRecorder::recordMessage(level, message);
+        }
+
+        std::atomic<bool> mHold{ false };
+    };
+
+    template<> template<>
+    void ErrorTestObject::test<19>()
+        // async logging
+    {
+        std::shared_ptr<AsyncTestRecorder> recorder(new AsyncTestRecorder);
+        LLError::addRecorder(recorder);
+        LLError::setAsyncLogging(true);
+        ensure("async", LLError::getAsyncLogging());
+
+        const int COUNT = 1000;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            LL_INFOS("Async") << "message " << i << LL_ENDL;
+        }
+        ensure_message_count(COUNT);
+        LLError::flushAsyncLog();
+        ensure_equals("all written", recorder->countMessages(), COUNT);
+        for (int i = 0; i < COUNT; i += 97)
+        {
+            ensure_ends_with("in order", recorder->message(i), " : message " + std::to_string(i));
+        }
+
+        // the writer stuck on a message while the queue fills up
+        recorder->clearMessages();
+        const U64 dropped = LLError::getAsyncLogDropped();
+        recorder->mHold = true;
+        const int FLOOD = 20000;
+        for (int i = 0; i < FLOOD; ++i)
+        {
+            LL_INFOS("Async") << "flood " << i << LL_ENDL;
+        }
+        const U64 flood_dropped = LLError::getAsyncLogDropped() - dropped;
+        recorder->mHold = false;
+        ensure("dropped", flood_dropped > 0);
+        LLError::flushAsyncLog();
+        ensure_equals("the rest written", (U64)recorder->countMessages(), FLOOD - flood_dropped + 1);
+        ensure_contains("dropped reported", recorder->message(recorder->countMessages() - 1),
+                        std::to_string(flood_dropped) + " log messages dropped");
+
+        // off again: written as they come
+        LLError::setAsyncLogging(false);
+        ensure("not async", !LLError::getAsyncLogging());
+        recorder->clearMessages();
+        LL_INFOS("Async") << "sync again" << LL_ENDL;
+        ensure_equals("written right away", recorder->countMessages(), 1);
+
+        LLError::removeRecorder(recorder);
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<20>()
+        // async logging from many threads to a file
+    {
+        // what a chatty subsystem does to the log file, from 8 threads
+        LLError::removeRecorder(mRecorder);
+        LLError::setDefaultLevel(LLError::LEVEL_INFO);
+        const U32 THREADS = 8;
+        const U32 COUNT = 5000;
+
+        auto run = [&](bool async)
+        {
+            NamedTempFile file("async", "");
+            LLError::logToFile(file.getName());
+            LLError::setAsyncLogging(async);
+
+            std::atomic<U32> ready(0);
+            std::vector<std::thread> threads;
+            for (U32 t = 0; t < THREADS; ++t)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    ++ready;
+                    while (ready < THREADS)
+                    {
+                        std::this_thread::yield();
+                    }
+                    for (U32 i = 0; i < COUNT; ++i)
+                    {
+                        LL_INFOS("AsyncBench") << "thread " << t << " message " << i << LL_ENDL;
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            LLError::setAsyncLogging(false);
+            LLError::logToFile("");
+            std::ifstream in(file.getName());
+            std::string line;
+            U32 lines = 0;
+            while (std::getline(in, line))
+            {
+                if (line.find("thread ") != std::string::npos && line.find(" message ") != std::string::npos)
+                {
+                    ++lines;
+                }
+            }
+            return lines;
+        };
+
+        const U64 dropped = LLError::getAsyncLogDropped();
+        const U32 sync_lines = run(false);
+        const U32 async_lines = run(true);
+        const U64 async_dropped = LLError::getAsyncLogDropped() - dropped;
+
+        // the log mutex is only tried, so a contended message can go missing
+        // either way; the async writer never writes more than was logged
+        ensure("sync logged", sync_lines > 0);
+        ensure("async logged", async_lines > 0);
+        ensure("async logged or dropped", async_lines + async_dropped <= U64(THREADS * COUNT));
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<21>()
+        // async logging turned off while another thread logs
+    {
+        std::shared_ptr<AsyncTestRecorder> recorder(new AsyncTestRecorder);
+        LLError::addRecorder(recorder);
+        LLError::setAsyncLogging(true);
+
+        const int COUNT = 4000;
+        std::atomic<int> logged(0);
+        std::thread logger([&]()
+        {
+            for (int i = 0; i < COUNT; ++i)
+            {
+                LL_INFOS("Async") << "message " << i << LL_ENDL;
+                ++logged;
+            }
+        });
+        while (logged < COUNT / 4)
+        {
+            std::this_thread::yield();
+        }
+        LLError::setAsyncLogging(false);
+        logger.join();
+
+        // nothing lost after the last drain, nothing written out of turn
+        ensure_equals("all written", recorder->countMessages(), COUNT);
+        for (int i = 0; i < COUNT; ++i)
+        {
+            ensure_ends_with("in order", recorder->message(i), " : message " + std::to_string(i));
+        }
+
+        LLError::removeRecorder(recorder);
+    }
+}
+
 /* Tests left:
     handling of classes without LOG_CLASS
 
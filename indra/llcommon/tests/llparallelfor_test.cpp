@@ -0,0 +1,155 @@
+/**
+ * @file   llparallelfor_test.cpp
+ * @brief  Test for llparallelfor.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llparallelfor.h"
+// STL headers
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "llcoros.h"
+#include "lleventcoro.h"
+#include "stringize.h"
+#include "threadpool.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llparallelfor_data
+    {
+        LL::ThreadPool pool{"parallelfor", 4};
+
+        llparallelfor_data()
+        {
+            pool.start();
+        }
+
+        ~llparallelfor_data()
+        {
+            pool.close();
+        }
+    };
+    typedef test_group<llparallelfor_data> llparallelfor_group;
+    typedef llparallelfor_group::object object;
+    llparallelfor_group llparallelforgrp("llparallelfor");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("every index exactly once");
+        const size_t count = 10000;
+        std::vector<std::atomic<int>> hits(count);
+        LL::parallel_for("parallelfor", count, [&hits](size_t i){ ++hits[i]; });
+        for (size_t i = 0; i < count; ++i)
+        {
+            ensure_equals(STRINGIZE("index " << i), hits[i].load(), 1);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("uses pool threads");
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+        LL::parallel_for("parallelfor", 64,
+                         [&mutex, &threads](size_t)
+                         {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                             std::lock_guard<std::mutex> lock(mutex);
+                             threads.insert(std::this_thread::get_id());
+                         });
+        ensure("never left the calling thread", threads.size() > 1);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("no such queue");
+        size_t total = 0;
+        // runs entirely on this thread, so a plain size_t is fine
+        LL::parallel_for("nonexistent", 100, [&total](size_t i){ total += i; });
+        ensure_equals("wrong total", total, size_t(4950));
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("exception");
+        std::atomic<size_t> calls{ 0 };
+        std::string threw;
+        try
+        {
+            LL::parallel_for("parallelfor", 100,
+                             [&calls](size_t i)
+                             {
+                                 ++calls;
+                                 if (i == 42)
+                                 {
+                                     throw std::runtime_error("index 42");
+                                 }
+                             });
+        }
+        catch (const std::runtime_error& e)
+        {
+            threw = e.what();
+        }
+        ensure_equals("exception not propagated", threw, "index 42");
+        ensure_equals("remaining indices skipped", calls.load(), size_t(100));
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("blocks other coroutines");
+        std::atomic<size_t> ticks{ 0 };
+        bool stop = false, stopped = false;
+        LLCoros::instance().launch("parallelfor ticker",
+                                   [&ticks, &stop, &stopped]()
+                                   {
+                                       while (! stop)
+                                       {
+                                           ++ticks;
+                                           llcoro::suspend();
+                                       }
+                                       stopped = true;
+                                   });
+        llcoro::suspend();
+        // what the coroutine had got to as each call started
+        std::mutex mutex;
+        std::set<size_t> seen;
+        LL::parallel_for("parallelfor", 8,
+                         [&ticks, &mutex, &seen](size_t)
+                         {
+                             size_t now = ticks;
+                             std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                             std::lock_guard<std::mutex> lock(mutex);
+                             seen.insert(now);
+                         });
+        ensure_equals("coroutine ran between calls", seen.size(), size_t(1));
+        ensure_equals("coroutine ran while waiting", ticks.load(), *seen.begin());
+        stop = true;
+        while (! stopped)
+        {
+            llcoro::suspend();
+        }
+    }
+} // namespace tut
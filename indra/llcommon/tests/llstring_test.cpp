@@ -32,6 +32,138 @@
 #include "StringVec.h"                  // must come BEFORE lltut.h
 #include "../test/lltut.h"
 
+#include <random>
+
+namespace
+{
+    // The one code point at a time conversions the SSE2 ones replace, to
+    // check they are still what they were
+
+    LLWString reference_utf8str_to_wstring(const char* utf8str, size_t len)
+    {
+        LLWString wout;
+
+        S32 i = 0;
+        while (i < len)
+        {
+            llwchar unichar;
+            U8 cur_char = utf8str[i];
+
+            if (cur_char < 0x80)
+            {
+                // Ascii character, just add it
+                unichar = cur_char;
+            }
+            else
+            {
+                S32 cont_bytes = 0;
+                if ((cur_char >> 5) == 0x6)         // Two byte UTF8 -> 1 UTF32
+                {
+                    unichar = (0x1F&cur_char);
+                    cont_bytes = 1;
+                }
+                else if ((cur_char >> 4) == 0xe)    // Three byte UTF8 -> 1 UTF32
+                {
+                    unichar = (0x0F&cur_char);
+                    cont_bytes = 2;
+                }
+                else if ((cur_char >> 3) == 0x1e)   // Four byte UTF8 -> 1 UTF32
+                {
+                    unichar = (0x07&cur_char);
+                    cont_bytes = 3;
+                }
+                else if ((cur_char >> 2) == 0x3e)   // Five byte UTF8 -> 1 UTF32
+                {
+                    unichar = (0x03&cur_char);
+                    cont_bytes = 4;
+                }
+                else if ((cur_char >> 1) == 0x7e)   // Six byte UTF8 -> 1 UTF32
+                {
+                    unichar = (0x01&cur_char);
+                    cont_bytes = 5;
+                }
+                else
+                {
+                    wout += LL_UNKNOWN_CHAR;
+                    ++i;
+                    continue;
+                }
+
+                // Check that this character doesn't go past the end of the string
+                auto end = (len < (i + cont_bytes)) ? len : (i + cont_bytes);
+                do
+                {
+                    ++i;
+
+                    cur_char = utf8str[i];
+                    if ( (cur_char >> 6) == 0x2 )
+                    {
+                        unichar <<= 6;
+                        unichar += (0x3F&cur_char);
+                    }
+                    else
+                    {
+                        // Malformed sequence - roll back to look at this as a new char
+                        unichar = LL_UNKNOWN_CHAR;
+                        --i;
+                        break;
+                    }
+                } while(i < end);
+
+                // Handle overlong characters and NULL characters
+                if ( ((cont_bytes == 1) && (unichar < 0x80))
+                    || ((cont_bytes == 2) && (unichar < 0x800))
+                    || ((cont_bytes == 3) && (unichar < 0x10000))
+                    || ((cont_bytes == 4) && (unichar < 0x200000))
+                    || ((cont_bytes == 5) && (unichar < 0x4000000)) )
+                {
+                    unichar = LL_UNKNOWN_CHAR;
+                }
+            }
+
+            wout += unichar;
+            ++i;
+        }
+        return wout;
+    }
+
+    std::string reference_wstring_to_utf8str(const llwchar* utf32str, size_t len)
+    {
+        std::string out;
+
+        S32 i = 0;
+        while (i < len)
+        {
+            char tchars[8];     /* Flawfinder: ignore */
+            auto n = wchar_to_utf8chars(utf32str[i], tchars);
+            tchars[n] = 0;
+            out += tchars;
+            i++;
+        }
+        return out;
+    }
+
+    LLWString reference_utf8str_to_wstring(const std::string& utf8str)
+    {
+        return reference_utf8str_to_wstring(utf8str.c_str(), utf8str.length());
+    }
+
+    std::string reference_wstring_to_utf8str(const LLWString& wstr)
+    {
+        return reference_wstring_to_utf8str(wstr.c_str(), wstr.length());
+    }
+
+    std::string hex_bytes(const std::string& str)
+    {
+        std::ostringstream out;
+        for (char c : str)
+        {
+            out << std::hex << std::setw(2) << std::setfill('0') << (U32)(U8)c << ' ';
+        }
+        return out.str();
+    }
+}
+
 namespace tut
 {
     struct string_index
@@ -856,4 +988,180 @@ namespace tut
                       LLStringUtil::getTokens("want x^^2", " ", "", "", "^"), StringVec{ "want", "x^2" });
         ensure_equals("escape at end", LLStringUtil::getTokens("it's^ up there^", " ", "", "'", "^"), StringVec{ "it's up", "there^" });
     }
+
+    // UTF-8 to UTF-32 is what it was for any bytes at all
+    template<> template<>
+    void string_index_object_t::test<43>()
+    {
+        // ASCII around the bytes, of every length up to a block and a bit, so
+        // that they start and end anywhere in and across blocks
+        const std::string ascii("The quick brown fox jumps");
+        auto ensure_decodes_at = [&ascii](const std::string& bytes, size_t before, size_t after)
+        {
+            std::string str = ascii.substr(0, before) + bytes + ascii.substr(0, after);
+            if (utf8str_to_wstring(str) != reference_utf8str_to_wstring(str))
+            {
+                fail("decodes differently: " + hex_bytes(str));
+            }
+        };
+        auto ensure_decodes = [&ensure_decodes_at](const std::string& bytes)
+        {
+            for (size_t before = 0; before <= 17; before += 1 + before / 4)
+            {
+                for (size_t after : { 0, 1, 15, 16 })
+                {
+                    ensure_decodes_at(bytes, before, after);
+                }
+            }
+        };
+
+        // every one and two byte string
+        for (U32 first = 0; first < 256; ++first)
+        {
+            std::string bytes(1, (char)first);
+            ensure_decodes(bytes);
+            bytes += ' ';
+            for (U32 second = 0; second < 256; ++second)
+            {
+                bytes[1] = (char)second;
+                ensure_decodes(bytes);
+            }
+        }
+
+        // every three byte string starting outside ASCII, in a block of its own
+        std::string block(ascii.substr(0, 13));
+        block.resize(16);
+        for (U32 bytes = 0x800000; bytes < 0x1000000; ++bytes)
+        {
+            block[13] = (char)(bytes >> 16);
+            block[14] = (char)(bytes >> 8);
+            block[15] = (char)bytes;
+            if (utf8str_to_wstring(block) != reference_utf8str_to_wstring(block))
+            {
+                fail("decodes differently: " + hex_bytes(block));
+            }
+        }
+
+        // every code point the encoder takes, as it encodes them, and cut
+        // short at every byte
+        for (U32 code = 0; code < 0x80000000; code = code < 0x110000 ? code + 1 : code * 2 + 1)
+        {
+            char sequence[8];
+            std::string bytes(sequence, wchar_to_utf8chars(code, sequence));
+            ensure_decodes_at(bytes, code % 17, code / 17 % 17);
+            for (size_t cut = 1; cut < bytes.length(); ++cut)
+            {
+                std::string str = ascii.substr(0, 16 - cut) + bytes.substr(0, cut);
+                ensure("short sequence decodes the same", utf8str_to_wstring(str) == reference_utf8str_to_wstring(str));
+            }
+        }
+
+        // a sequence cut short by the length, rather than the end of the
+        // string, reads on as it always did
+        std::string longer = ascii.substr(0, 14) + "\xE2\x82\xAC";
+        for (size_t len = 14; len <= longer.length(); ++len)
+        {
+            ensure("cut by length", utf8str_to_wstring(longer.c_str(), len) == reference_utf8str_to_wstring(longer.c_str(), len));
+        }
+
+        // and random strings, from mostly ASCII to none at all
+        std::mt19937 random(43);
+        for (S32 ascii_percent : { 99, 90, 50, 10, 0 })
+        {
+            for (S32 n = 0; n < 2000; ++n)
+            {
+                std::string str(random() % 80, ' ');
+                for (char& c : str)
+                {
+                    c = (char)((S32)(random() % 100) < ascii_percent ? random() % 0x80 : 0x80 + random() % 0x80);
+                }
+                if (utf8str_to_wstring(str) != reference_utf8str_to_wstring(str))
+                {
+                    fail("decodes differently: " + hex_bytes(str));
+                }
+            }
+        }
+    }
+
+    // UTF-32 to UTF-8 is what it was for any characters at all
+    template<> template<>
+    void string_index_object_t::test<44>()
+    {
+        // every code point, in runs that start anywhere in a block
+        const size_t RUN = 1000;
+        for (U32 start = 0; start < 0x110000; start += RUN)
+        {
+            LLWString wstr;
+            for (U32 code = start; code < start + RUN; ++code)
+            {
+                wstr += (llwchar)code;
+            }
+            for (size_t offset : { 0, 3, 15 })
+            {
+                LLWString str = wstr.substr(offset);
+                ensure("encodes the same", wstring_to_utf8str(str) == reference_wstring_to_utf8str(str));
+            }
+        }
+
+        // past the Unicode range, NUL wherever it lands in a block, and what
+        // the encoder won't take
+        for (U32 code : { 0x110000u, 0x1FFFFFu, 0x200000u, 0x3FFFFFFu, 0x4000000u, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu, 0x0u })
+        {
+            for (size_t at = 0; at < 20; ++at)
+            {
+                LLWString wstr(20, (llwchar)'a');
+                wstr[at] = (llwchar)code;
+                ensure("encodes the same", wstring_to_utf8str(wstr) == reference_wstring_to_utf8str(wstr));
+                if (code >= 0x80000000)
+                {
+                    // warns every time
+                    break;
+                }
+            }
+        }
+
+        // and random strings, from mostly ASCII to none at all
+        std::mt19937 random(44);
+        for (S32 ascii_percent : { 99, 90, 50, 10, 0 })
+        {
+            for (S32 n = 0; n < 2000; ++n)
+            {
+                LLWString wstr(random() % 80, ' ');
+                for (llwchar& c : wstr)
+                {
+                    c = (llwchar)((S32)(random() % 100) < ascii_percent ? random() % 0x80 : random() % 0x110000);
+                }
+                ensure("encodes the same", wstring_to_utf8str(wstr) == reference_wstring_to_utf8str(wstr));
+                ensure("round trip", utf8str_to_wstring(wstring_to_utf8str(wstr)) == reference_utf8str_to_wstring(reference_wstring_to_utf8str(wstr)));
+            }
+        }
+    }
+
+    // conversion of a megabyte of chat like text in a few scripts
+    template<> template<>
+    void string_index_object_t::test<45>()
+    {
+        const char* lines[] =
+        {
+            "Hello everyone, the sim restarts in five minutes, please save your builds.",
+            "[12:04] Someone: lol ok brb, grabbing coffee",
+            "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xD0\xBA\xD0\xB0\xD0\xBA \xD0\xB4\xD0\xB5\xD0\xBB\xD0\xB0?",   // Cyrillic
+            "\xE3\x81\x93\xE3\x82\x93\xE3\x81\xAB\xE3\x81\xA1\xE3\x81\xAF\xE4\xB8\x96\xE7\x95\x8C",       // Japanese
+            "Nice outfit! \xF0\x9F\x98\x80\xF0\x9F\x91\x8D",                                    // emoji
+        };
+        std::string text;
+        while (text.length() < 1024 * 1024)
+        {
+            for (const char* line : lines)
+            {
+                text += line;
+                text += '\n';
+            }
+        }
+        const LLWString wtext = utf8str_to_wstring(text);
+        ensure("text round trips", wstring_to_utf8str(wtext) == text);
+
+        ensure("decodes the same", wtext == reference_utf8str_to_wstring(text));
+        ensure("encodes the same", wstring_to_utf8str(wtext) == reference_wstring_to_utf8str(wtext));
+    }
 }
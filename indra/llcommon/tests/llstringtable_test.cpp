@@ -0,0 +1,186 @@
+/**
+ * @file llstringtable_test.cpp
+ * @brief Test for interned strings.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llstringtable.h"
+
+#include "llevents.h"
+#include "llsd.h"
+
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    struct interned_string
+    {
+        typedef std::unordered_map<LLInternedString, S32,
+                                   LLInternedString::Hash, LLInternedString::Equal> interned_map_t;
+
+        // Names shaped like event pump and capability names
+        static std::vector<std::string> makeNames(S32 count)
+        {
+            std::vector<std::string> names;
+            for (S32 i = 0; i < count; ++i)
+            {
+                names.push_back(llformat("LLEventPump-%s-%d", (i % 2) ? "mainloop" : "Coro", i));
+            }
+            return names;
+        }
+    };
+
+    typedef test_group<interned_string> interned_string_t;
+    typedef interned_string_t::object interned_string_object_t;
+    tut::interned_string_t tut_singleton("LLInternedString");
+
+    // equal strings are the same handle
+    template<> template<>
+    void interned_string_object_t::test<1>()
+    {
+        std::string name("interned");
+        LLInternedString a(name);
+        LLInternedString b("interned");
+        LLInternedString c(std::string_view("interned-not").substr(0, 8));
+        ensure("same string", &a.str() == &b.str());
+        ensure("from substring", &a.str() == &c.str());
+        ensure("equal", a == b && a == c);
+        ensure_equals("contents", a.str(), name);
+        ensure_equals("hash", a.hash(), std::hash<std::string_view>()(name));
+        ensure_equals("std::hash", std::hash<LLInternedString>()(a), a.hash());
+
+        LLInternedString other("other");
+        ensure("not equal", a != other);
+        ensure("ordered by contents", a < other && !(other < a) && !(a < b));
+
+        ensure("default is empty", LLInternedString().empty());
+        ensure("default is the empty string", LLInternedString() == LLInternedString(""));
+        ensure("null is the empty string", LLInternedString((const char*)NULL) == LLInternedString());
+
+        size_t count = LLInternedString::getCount();
+        LLInternedString again("interned");
+        ensure_equals("interned once", LLInternedString::getCount(), count);
+        LLInternedString fresh("interned-fresh");
+        ensure_equals("new string", LLInternedString::getCount(), count + 1);
+    }
+
+    // threads interning the same strings get the same handles
+    template<> template<>
+    void interned_string_object_t::test<2>()
+    {
+        const S32 THREADS = 4;
+        const S32 NAMES = 500;
+        std::vector<std::string> names(makeNames(NAMES));
+        std::vector<std::vector<LLStdStringHandle>> handles(THREADS);
+        std::vector<std::thread> threads;
+        for (S32 t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([t, &names, &handles]()
+            {
+                for (const std::string& name : names)
+                {
+                    handles[t].push_back(&LLInternedString(name).str());
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        for (S32 t = 1; t < THREADS; ++t)
+        {
+            ensure("same handles", handles[t] == handles[0]);
+        }
+    }
+
+    // lookup by any string
+    template<> template<>
+    void interned_string_object_t::test<3>()
+    {
+        interned_map_t map;
+        map[LLInternedString("mainloop")] = 1;
+        map[LLInternedString("login")] = 2;
+
+        std::string mainloop("mainloop");
+        ensure("find by string", map.find(std::string_view(mainloop)) != map.end());
+        ensure("find by literal", map.find(std::string_view("login"))->second == 2);
+        ensure("find by interned", map.find(LLInternedString("mainloop"))->second == 1);
+        ensure("missing", map.find(std::string_view("mainloo")) == map.end());
+
+        LLSD sd;
+        LLInternedString key("capability");
+        sd[key] = "url";
+        ensure("has by interned", sd.has(key));
+        ensure_equals("get by string", sd["capability"].asString(), std::string("url"));
+        ensure_equals("get by interned", sd.get(key).asString(), std::string("url"));
+        const LLSD& csd(sd);
+        ensure_equals("const by interned", csd[key].asString(), std::string("url"));
+        ensure("missing by interned", !sd.has(LLInternedString("nonesuch")));
+    }
+
+    // pumps by interned name
+    template<> template<>
+    void interned_string_object_t::test<4>()
+    {
+        LLEventPumps& pumps(LLEventPumps::instance());
+        LLInternedString name("interned-pump");
+        LLEventPump& pump(pumps.obtain(name));
+        ensure_equals("name", pump.getName(), name.str());
+        ensure("same pump by string", &pumps.obtain("interned-pump") == &pump);
+        ensure("same pump by interned", &pumps.obtain(name) == &pump);
+
+        // a pump that goes away is forgotten by interned name too
+        LLInternedString stack_name("interned-stack");
+        {
+            LLEventStream stack_pump("interned-stack");
+            ensure("stack pump by interned", &pumps.obtain(stack_name) == &stack_pump);
+        }
+        ensure_equals("new pump by interned", pumps.obtain(stack_name).getName(), stack_name.str());
+
+        // tweaked names take the first free integer suffix, and aren't interned
+        size_t interned_count = LLInternedString::getCount();
+        LLEventStream first("interned-tweak", true);
+        LLEventStream second("interned-tweak", true);
+        LLEventStream third("interned-tweak", true);
+        LLEventStream other("interned-tweakx", true);
+        LLEventStream fourth("interned-tweak", true);
+        ensure_equals("first", first.getName(), std::string("interned-tweak"));
+        ensure_equals("second", second.getName(), std::string("interned-tweak1"));
+        ensure_equals("third", third.getName(), std::string("interned-tweak2"));
+        ensure_equals("other", other.getName(), std::string("interned-tweakx"));
+        ensure_equals("fourth", fourth.getName(), std::string("interned-tweak3"));
+        {
+            LLEventStream gone("interned-tweak", true);
+            ensure_equals("fifth", gone.getName(), std::string("interned-tweak4"));
+        }
+        LLEventStream reused("interned-tweak", true);
+        ensure_equals("reused", reused.getName(), std::string("interned-tweak4"));
+        ensure_equals("nothing interned", LLInternedString::getCount(), interned_count);
+    }
+}
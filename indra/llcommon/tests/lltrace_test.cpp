@@ -30,8 +30,12 @@
 #include "lltrace.h"
 #include "lltracethreadrecorder.h"
 #include "lltracerecording.h"
+#include "stringize.h"
 #include "../test/lltut.h"
 
+#include <atomic>
+#include <thread>
+
 #ifdef LL_WINDOWS
 #pragma warning(disable : 4244) // possible loss of data on conversions
 #endif
@@ -71,6 +75,7 @@ namespace tut
     static CountStatHandle<S32> sCupsOfCoffeeConsumed("coffeeconsumed", "Delicious cup of dark roast.");
     static SampleStatHandle<F32Milligrams> sCaffeineLevelStat("caffeinelevel", "Coffee buzz quotient");
     static EventStatHandle<S32Ounces> sOuncesPerCup("cupsize", "Large, huge, or ginormous");
+    static CountStatHandle<S32> sCupsBrewed("cupsbrewed", "Brewed by the baristas");
 
     static F32 sCaffeineLevel(0.f);
     const F32Milligrams sCaffeinePerOz(18.f);
@@ -143,4 +148,56 @@ namespace tut
                 && after_3pm.getMax(sCaffeineLevelStat) == sCaffeinePerOz * ((S32Ounces)S32TallCup(1) + (S32Ounces)S32GrandeCup(3) + (S32Ounces)S32VentiCup(1)).value());
     }
 
+    // worker thread stats reach the main thread's recordings, without
+    // the workers waiting on it
+    template<> template<>
+    void trace_object_t::test<2>()
+    {
+        static const S32 CUPS = 50000;
+        // how often a barista hands the cups over, as the work queues do
+        // after each work item
+        static const S32 CUPS_PER_ITEM = 16;
+
+        for (S32 threads : { 1, 2, 4, 8, 16 })
+        {
+            Recording recording;
+            recording.start();
+
+            std::atomic<S32> done(0);
+            std::vector<std::thread> baristas;
+            for (S32 t = 0; t < threads; ++t)
+            {
+                baristas.emplace_back([this, &done]()
+                {
+                    ThreadRecorder recorder(mRecorder);
+                    for (S32 i = 1; i <= CUPS; ++i)
+                    {
+                        add(sCupsBrewed, 1);
+                        if (i % CUPS_PER_ITEM == 0)
+                        {
+                            recorder.pushToParent();
+                        }
+                    }
+                    ++done;
+                });
+            }
+
+            // picks up what it can while the baristas work, like each frame
+            while (done < threads)
+            {
+                mRecorder.pullFromChildren();
+                std::this_thread::yield();
+            }
+            for (std::thread& barista : baristas)
+            {
+                barista.join();
+            }
+            // and what they handed over as they left
+            mRecorder.pullFromChildren();
+
+            ensure_equals(STRINGIZE("every cup of " << threads << " baristas counted"),
+                          recording.getSum(sCupsBrewed), threads * CUPS);
+            recording.stop();
+        }
+    }
 }
@@ -0,0 +1,240 @@
+/**
+ * @file lltracecapture_test.cpp
+ * @brief Test for the LLTrace binary capture writer and reader.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltracecapture.h"
+
+#include "llfasttimer.h"
+#include "lltrace.h"
+#include "lltracerecording.h"
+#include "lltracethreadrecorder.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+namespace tut
+{
+    using namespace LLTrace;
+
+    static CountStatHandle<S32> sCaptureCount("capturecount", "Things counted");
+    static SampleStatHandle<F64> sCaptureSample("capturesample", "Things sampled");
+    static EventStatHandle<F64> sCaptureEvent("captureevent", "Things that happened");
+    static BlockTimerStatHandle sCaptureTimer("capturetimer", "Time spent on things");
+
+    struct trace_capture
+    {
+        ThreadRecorder mRecorder;
+
+        // Records a frame with record(), and writes it
+        template <typename FUNC>
+        void writeFrame(TraceCaptureWriter& writer, FUNC&& record)
+        {
+            Recording frame;
+            frame.start();
+            record();
+            frame.stop();
+            writer.writeFrame(frame);
+        }
+
+        std::string readFile(const std::string& filename)
+        {
+            std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        }
+    };
+
+    typedef test_group<trace_capture> trace_capture_t;
+    typedef trace_capture_t::object trace_capture_object_t;
+    tut::trace_capture_t tut_singleton("LLTraceCapture");
+
+    // synthetic stats round trip
+    template<> template<>
+    void trace_capture_object_t::test<1>()
+    {
+        NamedTempFile file("capture", "", ".lltrace");
+        TraceCaptureWriter writer;
+        ensure("capture opens", writer.open(file.getName()));
+
+        writeFrame(writer, []()
+        {
+            add(sCaptureCount, 3);
+            add(sCaptureCount, 4);
+            sample(sCaptureSample, 5.0);
+            sample(sCaptureSample, 9.0);
+            record(sCaptureEvent, 2.0);
+            record(sCaptureEvent, 4.0);
+            for (S32 i = 0; i < 2; ++i)
+            {
+                LL_RECORD_BLOCK_TIME(sCaptureTimer);
+            }
+        });
+        // nothing counted or sampled
+        writeFrame(writer, []()
+        {
+            record(sCaptureEvent, 8.0);
+        });
+        writeFrame(writer, []()
+        {
+            add(sCaptureCount, 1);
+            sample(sCaptureSample, 1.0);
+        });
+        ensure_equals("frames written", writer.getFrameCount(), 3U);
+        writer.close();
+
+        TraceCaptureReader reader;
+        ensure("capture loads", reader.load(file.getName()));
+        ensure("capture is whole", !reader.isTruncated());
+        ensure_equals("frames read", reader.getFrames().size(), size_t(3));
+
+        S32 count = reader.findStat("capturecount", TraceCapture::STAT_COUNT);
+        S32 samples = reader.findStat("capturesample", TraceCapture::STAT_SAMPLE);
+        S32 events = reader.findStat("captureevent", TraceCapture::STAT_EVENT);
+        S32 timer = reader.findStat("capturetimer", TraceCapture::STAT_TIMER);
+        ensure("stats are named", count >= 0 && samples >= 0 && events >= 0 && timer >= 0);
+        ensure_equals("kinds don't mix", reader.findStat("capturecount", TraceCapture::STAT_SAMPLE), -1);
+
+        const TraceCaptureReader::Frame& first = reader.getFrames()[0];
+        const TraceCaptureReader::Frame& second = reader.getFrames()[1];
+        const TraceCaptureReader::Frame& third = reader.getFrames()[2];
+        ensure("frames are timed", first.mDuration >= 0.0 && second.mTime == first.mTime + first.mDuration);
+
+        const TraceCaptureReader::Value* value = first.find(count);
+        ensure("count in first frame", value != NULL);
+        ensure_equals("count sum", value->mSum, 7.0);
+        ensure_equals("count adds", value->mCount, 2U);
+        ensure("no count in second frame", second.find(count) == NULL);
+        ensure_equals("count in third frame", third.find(count)->mSum, 1.0);
+
+        value = first.find(samples);
+        ensure("sample in first frame", value != NULL);
+        ensure_equals("sample min", value->mMin, 5.0);
+        ensure_equals("sample max", value->mMax, 9.0);
+        ensure_equals("sample last", value->mLast, 9.0);
+        ensure_equals("samples", value->mCount, 2U);
+        ensure("only sampled frames hold samples", second.find(samples) == NULL);
+        TraceCaptureReader::Value carried;
+        ensure("sample carried over", reader.getValue(1, samples, carried));
+        ensure_equals("carried over sample", carried.mMean, 9.0);
+        ensure_equals("carried over sample is not sampled", carried.mCount, 0U);
+        ensure_equals("carried over sample lasts the frame", carried.mSum, 9.0 * second.mDuration);
+        ensure_equals("sample in third frame", third.find(samples)->mLast, 1.0);
+        ensure("getValue() has written values", reader.getValue(2, samples, carried) && carried.mLast == 1.0);
+        ensure("no count to carry over", !reader.getValue(1, count, carried));
+        ensure_equals("carried over samples are summarized", reader.summarize(samples).mFrames, 3U);
+
+        value = first.find(events);
+        ensure("event in first frame", value != NULL);
+        ensure_equals("event sum", value->mSum, 6.0);
+        ensure_equals("event mean", value->mMean, 3.0);
+        ensure_equals("event min", value->mMin, 2.0);
+        ensure_equals("event max", value->mMax, 4.0);
+        ensure_equals("events", value->mCount, 2U);
+        ensure_equals("event in second frame", second.find(events)->mSum, 8.0);
+        ensure("no event in third frame", third.find(events) == NULL);
+
+        value = first.find(timer);
+        ensure("timer in first frame", value != NULL);
+        ensure_equals("timer calls", value->mCount, 2U);
+        ensure("timer time", value->mSum >= 0.0 && value->mSelf <= value->mSum);
+    }
+
+    // percentile summaries and CSV
+    template<> template<>
+    void trace_capture_object_t::test<2>()
+    {
+        NamedTempFile file("capture", "", ".lltrace");
+        TraceCaptureWriter writer;
+        ensure("capture opens", writer.open(file.getName()));
+        // 1 to 100, shuffled a bit
+        for (S32 i = 0; i < 100; ++i)
+        {
+            S32 n = (i * 37) % 100 + 1;
+            writeFrame(writer, [n]() { add(sCaptureCount, n); });
+        }
+        writer.close();
+
+        TraceCaptureReader reader;
+        ensure("capture loads", reader.load(file.getName()));
+        S32 count = reader.findStat("capturecount", TraceCapture::STAT_COUNT);
+        ensure("count is named", count >= 0);
+
+        TraceCaptureReader::Summary summary = reader.summarize(count);
+        ensure_equals("summary frames", summary.mFrames, 100U);
+        ensure_equals("summary mean", summary.mMean, 50.5);
+        ensure_equals("summary min", summary.mMin, 1.0);
+        ensure_equals("summary p50", summary.mP50, 50.0);
+        ensure_equals("summary p95", summary.mP95, 95.0);
+        ensure_equals("summary p99", summary.mP99, 99.0);
+        ensure_equals("summary max", summary.mMax, 100.0);
+
+        std::ostringstream csv;
+        reader.writeCSV(csv);
+        std::istringstream csv_lines(csv.str());
+        std::string line;
+        S32 lines = 0;
+        while (std::getline(csv_lines, line))
+        {
+            ++lines;
+        }
+        ensure_equals("a CSV row per frame", lines, 101);
+        ensure("CSV names the stat", csv.str().find("capturecount") != std::string::npos);
+
+        std::ostringstream report;
+        reader.writeSummary(report);
+        ensure_contains("summary has the stat", report.str(), "capturecount,count,");
+        ensure_contains("summary has the frames", report.str(), "frame,,ms,100,");
+    }
+
+    // a capture cut short reads up to its last whole frame
+    template<> template<>
+    void trace_capture_object_t::test<3>()
+    {
+        NamedTempFile file("capture", "", ".lltrace");
+        TraceCaptureWriter writer;
+        ensure("capture opens", writer.open(file.getName()));
+        for (S32 i = 0; i < 10; ++i)
+        {
+            writeFrame(writer, [i]() { add(sCaptureCount, i); record(sCaptureEvent, i); });
+        }
+        writer.close();
+
+        std::string data = readFile(file.getName());
+        TraceCaptureReader reader;
+        ensure("whole capture parses", reader.parse(data));
+        ensure_equals("whole capture frames", reader.getFrames().size(), size_t(10));
+
+        data.resize(data.size() - 3);
+        ensure("cut capture parses", reader.parse(data));
+        ensure("cut capture is truncated", reader.isTruncated());
+        ensure_equals("cut capture frames", reader.getFrames().size(), size_t(9));
+
+        ensure("not a capture", !reader.parse("not a capture at all"));
+    }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file lltraceframebudget_test.cpp
+ * @brief Test for the LLTrace frame budget.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceframebudget.h"
+
+#include "llfile.h"
+
+#include <chrono>
+#include <thread>
+
+#include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+namespace tut
+{
+    using namespace LLTrace;
+
+    struct frame_budget
+    {
+        // A frame with time in a single bucket
+        static FrameBudget::bucket_times_t only(FrameBudget::EBucket bucket, F64 ms)
+        {
+            FrameBudget::bucket_times_t buckets{};
+            buckets[bucket] = ms;
+            return buckets;
+        }
+
+        static void sleep_ms(S32 ms)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+    };
+
+    typedef test_group<frame_budget> frame_budget_t;
+    typedef frame_budget_t::object frame_budget_object_t;
+    tut::frame_budget_t tut_singleton("LLTraceFrameBudget");
+
+    // synthetic bucket times make the percentiles
+    template<> template<>
+    void frame_budget_object_t::test<1>()
+    {
+        FrameBudget budget;
+        // network 1 to 100, shuffled a bit, culling a steady 2ms
+        for (S32 i = 0; i < 100; ++i)
+        {
+            F64 network = (F64)((i * 37) % 100 + 1);
+            FrameBudget::bucket_times_t buckets{};
+            buckets[FrameBudget::NETWORK] = network;
+            buckets[FrameBudget::CULLING] = 2.0;
+            budget.addFrame(network + 10.0, buckets);
+        }
+        ensure_equals("frames", budget.getFrameCount(), U64(100));
+        ensure_equals("window frames", budget.getWindowFrames(), 100U);
+
+        FrameBudget::Percentiles network = budget.getBucketPercentiles(FrameBudget::NETWORK);
+        ensure_equals("network mean", network.mMean, 50.5);
+        ensure_equals("network p50", network.mP50, 50.0);
+        ensure_equals("network p95", network.mP95, 95.0);
+        ensure_equals("network p99", network.mP99, 99.0);
+        ensure_equals("network max", network.mMax, 100.0);
+
+        FrameBudget::Percentiles culling = budget.getBucketPercentiles(FrameBudget::CULLING);
+        ensure_equals("culling p50", culling.mP50, 2.0);
+        ensure_equals("culling p99", culling.mP99, 2.0);
+
+        // what the buckets don't account for
+        FrameBudget::Percentiles other = budget.getBucketPercentiles(FrameBudget::OTHER);
+        ensure_equals("other p50", other.mP50, 8.0);
+        ensure_equals("other max", other.mMax, 8.0);
+
+        FrameBudget::Percentiles frame = budget.getFramePercentiles();
+        ensure_equals("frame p95", frame.mP95, 105.0);
+        ensure_equals("frame max", frame.mMax, 110.0);
+
+        ensure_equals("nothing in render", budget.getBucketPercentiles(FrameBudget::RENDER).mMax, 0.0);
+
+        // OTHER is never negative, whatever the buckets say
+        budget.addFrame(1.0, only(FrameBudget::UI, 3.0));
+        ensure_equals("other clamped", budget.getBucketPercentiles(FrameBudget::OTHER).mP50, 8.0);
+    }
+
+    // the percentiles are over the last frames only
+    template<> template<>
+    void frame_budget_object_t::test<2>()
+    {
+        FrameBudget budget(10);
+        for (S32 i = 1; i <= 25; ++i)
+        {
+            budget.addFrame((F64)i, only(FrameBudget::RENDER, (F64)i));
+        }
+        ensure_equals("frames", budget.getFrameCount(), U64(25));
+        ensure_equals("window frames", budget.getWindowFrames(), 10U);
+
+        FrameBudget::Percentiles render = budget.getBucketPercentiles(FrameBudget::RENDER);
+        ensure_equals("render mean", render.mMean, 20.5);
+        ensure_equals("render p50", render.mP50, 20.0);
+        ensure_equals("render p95", render.mP95, 25.0);
+        ensure_equals("render max", render.mMax, 25.0);
+
+        budget.reset();
+        ensure_equals("reset frames", budget.getWindowFrames(), 0U);
+        ensure_equals("reset percentiles", budget.getFramePercentiles().mMax, 0.0);
+    }
+
+    // hitches and the report
+    template<> template<>
+    void frame_budget_object_t::test<3>()
+    {
+        FrameBudget budget;
+        budget.setHitchThreshold(50.0, 2.0);
+        for (S32 i = 0; i < 100; ++i)
+        {
+            budget.addFrame(16.0, only(FrameBudget::RENDER, 10.0));
+        }
+        // over twice the median but under the minimum
+        budget.addFrame(40.0, only(FrameBudget::RENDER, 30.0));
+        ensure_equals("short frame is no hitch", budget.getHitchCount(), U64(0));
+
+        FrameBudget::bucket_times_t buckets{};
+        buckets[FrameBudget::RENDER] = 10.0;
+        buckets[FrameBudget::REBUILDS] = 70.0;
+        budget.addFrame(100.0, buckets);
+        ensure_equals("hitch", budget.getHitchCount(), U64(1));
+        const FrameBudget::Hitch& hitch = budget.getHitches().back();
+        ensure_equals("hitch frame", hitch.mFrame, U64(101));
+        ensure_equals("hitch median", hitch.mMedianMs, 16.0);
+        ensure_equals("hitch worst", hitch.getWorstBucket(), FrameBudget::REBUILDS);
+        ensure_equals("hitch other", hitch.mBuckets[FrameBudget::OTHER], 20.0);
+
+        LLSD report = budget.getReport();
+        ensure_equals("report frames", report["frames"].asInteger(), 102);
+        ensure_equals("report frame p50", report["frame_ms"]["p50"].asReal(), 16.0);
+        ensure_equals("report render p50", report["buckets"]["render"]["p50"].asReal(), 10.0);
+        ensure_equals("report render p99", report["buckets"]["render"]["p99"].asReal(), 10.0);
+        ensure_equals("report render max", report["buckets"]["render"]["max"].asReal(), 30.0);
+        ensure_equals("report rebuilds max", report["buckets"]["rebuilds"]["max"].asReal(), 70.0);
+        ensure("report has every bucket", report["buckets"].has("object_updates") && report["buckets"].has("other"));
+        ensure_equals("report hitch count", report["hitch_count"].asInteger(), 1);
+        ensure_equals("report hitches", report["hitches"].size(), 1);
+        ensure_equals("report hitch worst", report["hitches"][0]["worst"].asString(), std::string("rebuilds"));
+
+        NamedTempFile file("framebudget", "", ".json");
+        ensure("report written", budget.writeReport(file.getName()));
+        llifstream in(file.getName().c_str());
+        std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ensure("report not empty", !json.empty());
+    }
+
+    // nested scopes charge the innermost bucket
+    template<> template<>
+    void frame_budget_object_t::test<4>()
+    {
+        FrameBudget budget;
+        {
+            LL_RECORD_FRAME_BUDGET(RENDER);
+            ensure("inactive budget charges nothing", FrameBudget::getActive() == NULL);
+        }
+
+        budget.setActive(true);
+        ensure("active", budget.isActive());
+        {
+            LL_RECORD_FRAME_BUDGET(RENDER);
+            sleep_ms(2);
+            {
+                LL_RECORD_FRAME_BUDGET(CULLING);
+                sleep_ms(10);
+            }
+        }
+        // other threads don't charge the main loop's budget
+        std::thread([]()
+        {
+            LL_RECORD_FRAME_BUDGET(NETWORK);
+            sleep_ms(5);
+        }).join();
+        budget.endFrame(50.0);
+
+        FrameBudget::Percentiles culling = budget.getBucketPercentiles(FrameBudget::CULLING);
+        FrameBudget::Percentiles render = budget.getBucketPercentiles(FrameBudget::RENDER);
+        ensure("culling charged", culling.mMax >= 9.0);
+        ensure("render charged", render.mMax >= 1.5);
+        ensure("render does not include culling", render.mMax < culling.mMax);
+        ensure_equals("other thread not charged", budget.getBucketPercentiles(FrameBudget::NETWORK).mMax, 0.0);
+
+        // a new frame starts from nothing
+        budget.endFrame(10.0);
+        ensure_equals("frames", budget.getFrameCount(), U64(2));
+        ensure_equals("second frame is all other", budget.getBucketPercentiles(FrameBudget::OTHER).mP50, 10.0);
+
+        budget.setActive(false);
+        ensure("inactive", FrameBudget::getActive() == NULL);
+    }
+}
@@ -16,9 +16,12 @@
 // STL headers
 // std headers
 #include <chrono>
+#include <future>
 // external library headers
 // other Linden headers
 #include "../test/lltut.h"
+#include "lockfreequeue.h"
+#include "stringize.h"
 
 using namespace std::literals::chrono_literals; // ms suffix
 using namespace std::literals::string_literals; // s suffix
@@ -32,6 +35,78 @@ namespace tut
     struct threadsafeschedule_data
     {
         Queue queue;
+
+        // ThreadSafeSchedule's close() semantics, which both plain
+        // LLThreadSafeQueue policies must match
+        template <typename QUEUE>
+        static void closeSemantics(const std::string& what)
+        {
+            QUEUE q(2);
+            ensure(what + " tryPush", q.tryPush("abc"s));
+            q.push("def"s);
+            ensure(what + " tryPush over capacity", ! q.tryPush("ghi"s));
+            ensure(what + " tryPushFor over capacity", ! q.tryPushFor(10ms, "ghi"s));
+            ensure_equals(what + " size", q.size(), 2);
+            q.close();
+            ensure(what + " not closed", q.isClosed());
+            ensure(what + " prematurely done", ! q.done());
+            ensure(what + " pushIfOpen after close", ! q.pushIfOpen("ghi"s));
+            bool threw = false;
+            try
+            {
+                q.push("ghi"s);
+            }
+            catch (const LLThreadSafeQueueInterrupt&)
+            {
+                threw = true;
+            }
+            ensure(what + " push after close didn't throw", threw);
+            // still drains
+            ensure_equals(what + " first", q.pop(), "abc"s);
+            std::string s;
+            ensure(what + " second", q.tryPopFor(1s, s));
+            ensure_equals(what + " second is wrong", s, "def"s);
+            ensure(what + " not done", q.done());
+            ensure(what + " tryPopFor when done", ! q.tryPopFor(1s, s));
+            threw = false;
+            try
+            {
+                q.pop();
+            }
+            catch (const LLThreadSafeQueueInterrupt&)
+            {
+                threw = true;
+            }
+            ensure(what + " pop when done didn't throw", threw);
+
+            // close() interrupts pop() and push() already waiting
+            QUEUE empty(1);
+            auto popper = std::async(std::launch::async, [&empty]()
+            {
+                try
+                {
+                    empty.pop();
+                }
+                catch (const LLThreadSafeQueueInterrupt&)
+                {
+                    return true;
+                }
+                return false;
+            });
+            QUEUE full(1);
+            full.push("abc"s);
+            auto pusher = std::async(std::launch::async, [&full]()
+            {
+                return full.pushIfOpen("def"s);
+            });
+            ensure(what + " pop didn't wait", popper.wait_for(50ms) == std::future_status::timeout);
+            ensure(what + " push didn't wait", pusher.wait_for(50ms) == std::future_status::timeout);
+            empty.close();
+            full.close();
+            ensure(what + " close didn't interrupt pop", popper.get());
+            ensure(what + " close didn't interrupt push", ! pusher.get());
+            ensure_equals(what + " full still drains", full.pop(), "abc"s);
+        }
     };
     typedef test_group<threadsafeschedule_data> threadsafeschedule_group;
     typedef threadsafeschedule_group::object object;
@@ -67,4 +142,14 @@ namespace tut
         ensure("queue not empty", ! popped);
         ensure("queue not done", queue.done());
     }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("close");
+        // ThreadSafeSchedule itself always locks: it has to keep its items
+        // in time order
+        closeSemantics<LLThreadSafeQueue<std::string>>("locking");
+        closeSemantics<LLThreadSafeQueue<std::string, LL::LockFreeQueue<std::string>>>("lock-free");
+    }
 } // namespace tut
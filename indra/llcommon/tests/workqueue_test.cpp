@@ -13,10 +13,15 @@
 #include "linden_common.h"
 // associated header
 #include "workqueue.h"
+#include "threadpool.h"
 // STL headers
 // std headers
+#include <atomic>
 #include <chrono>
 #include <deque>
+#include <future>
+#include <thread>
+#include <vector>
 // external library headers
 // other Linden headers
 #include "../test/lltut.h"
@@ -39,7 +44,49 @@ namespace tut
     struct workqueue_data
     {
         WorkSchedule queue{"queue"};
+
+        // what each consumer thread has run, in the order it ran it
+        static thread_local std::vector<U32>* sSeen;
+
+        // Has (producers) threads post (items) each to target, and
+        // (consumers) threads run them all.
+        static void produceConsume(WorkQueue& target, U32 producers, U32 consumers, U32 items,
+                                  std::vector<std::vector<U32>>& seen)
+        {
+            seen.assign(consumers, {});
+            std::vector<std::thread> threads;
+            for (U32 c = 0; c < consumers; ++c)
+            {
+                threads.emplace_back([&target, &seen, c]()
+                {
+                    sSeen = &seen[c];
+                    target.runUntilClose();
+                });
+            }
+            std::vector<std::thread> posters;
+            for (U32 p = 0; p < producers; ++p)
+            {
+                posters.emplace_back([&target, p, items]()
+                {
+                    for (U32 i = 0; i < items; ++i)
+                    {
+                        U32 id = (p << 24) | i;
+                        target.post([id](){ sSeen->push_back(id); });
+                    }
+                });
+            }
+            for (auto& poster : posters)
+            {
+                poster.join();
+            }
+            target.close();
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
     };
+    thread_local std::vector<U32>* workqueue_data::sSeen = nullptr;
     typedef test_group<workqueue_data> workqueue_group;
     typedef workqueue_group::object object;
     workqueue_group workqueuegrp("workqueue");
@@ -236,4 +283,148 @@ namespace tut
         ensure_equals("didn't run coroutine", stored, "ran");
         ensure("void waitForResult() didn't return", done);
     }
+
+    template<> template<>
+    void object::test<7>()
+    {
+        set_test_name("lock-free post");
+        for (bool lock_free : { false, true })
+        {
+            WorkQueue q("lockfree", 1024, true, lock_free);
+            ensure_equals("policy", q.isLockFree(), lock_free);
+            std::string observe;
+            q.post([&observe](){ observe.append("a"); });
+            q.post([&observe](){ observe.append("b"); });
+            ensure_equals("size", q.size(), 2);
+            q.close();
+            ensure("not closed", q.isClosed());
+            ensure("prematurely done", ! q.done());
+            ensure("posted after close", ! q.post([&observe](){ observe.append("c"); }));
+            q.runUntilClose();
+            ensure_equals(STRINGIZE("lock_free " << lock_free), observe, "ab");
+            ensure("not done", q.done());
+        }
+    }
+
+    template<> template<>
+    void object::test<8>()
+    {
+        set_test_name("many producers and consumers");
+        const U32 PRODUCERS = 4, CONSUMERS = 3, ITEMS = 10000;
+        for (bool lock_free : { false, true })
+        {
+            // small enough that producers have to wait for consumers
+            WorkQueue q("manytomany", 64, true, lock_free);
+            std::vector<std::vector<U32>> seen;
+            produceConsume(q, PRODUCERS, CONSUMERS, ITEMS, seen);
+
+            std::vector<U32> counts(PRODUCERS * ITEMS, 0);
+            for (const auto& consumer : seen)
+            {
+                // each consumer sees each producer's items in posted order
+                std::vector<S32> last(PRODUCERS, -1);
+                for (U32 id : consumer)
+                {
+                    U32 p = id >> 24, i = id & 0xffffff;
+                    ensure(STRINGIZE("lock_free " << lock_free << " producer " << p << " out of order"),
+                           S32(i) > last[p]);
+                    last[p] = S32(i);
+                    ++counts[p * ITEMS + i];
+                }
+            }
+            for (U32 count : counts)
+            {
+                ensure_equals(STRINGIZE("lock_free " << lock_free << " ran once"), count, 1);
+            }
+        }
+    }
+
+    template<> template<>
+    void object::test<9>()
+    {
+        set_test_name("capacity and close");
+        for (bool lock_free : { false, true })
+        {
+            std::string what(STRINGIZE("lock_free " << lock_free));
+            WorkQueue q("capacity", 4, true, lock_free);
+            S32 ran = 0;
+            for (S32 i = 0; i < 4; ++i)
+            {
+                ensure(what + " tryPost below capacity", q.tryPost([&ran](){ ++ran; }));
+            }
+            ensure(what + " tryPost at capacity", ! q.tryPost([&ran](){ ++ran; }));
+
+            // post() waits for room
+            std::atomic<bool> posted{ false };
+            std::thread producer([&q, &ran, &posted]()
+            {
+                posted = q.post([&ran](){ ++ran; });
+            });
+            std::this_thread::sleep_for(50ms);
+            ensure(what + " post didn't wait", ! posted);
+            q.runOne();
+            producer.join();
+            ensure(what + " post didn't go in", bool(posted));
+            q.runPending();
+            ensure_equals(what + " ran", ran, 5);
+
+            // close() lets a consumer waiting on an empty queue go
+            auto consumer = std::async(std::launch::async, [&q](){ q.runUntilClose(); });
+            ensure(what + " consumer didn't wait",
+                   consumer.wait_for(50ms) == std::future_status::timeout);
+            q.close();
+            ensure(what + " close didn't release consumer",
+                   consumer.wait_for(10s) == std::future_status::ready);
+            ensure(what + " not done", q.done());
+        }
+    }
+
+    template<> template<>
+    void object::test<10>()
+    {
+        set_test_name("producers and consumers with either queue");
+        const U32 ITEMS = 2000;
+        for (U32 threads : { 1, 4 })
+        {
+            for (bool lock_free : { false, true })
+            {
+                WorkQueue q("producers", 1024, true, lock_free);
+                std::vector<std::vector<U32>> seen;
+                produceConsume(q, threads, threads, ITEMS, seen);
+                size_t total = 0;
+                for (const auto& consumer : seen)
+                {
+                    total += consumer.size();
+                }
+                ensure_equals("ran them all", total, size_t(threads) * ITEMS);
+            }
+        }
+    }
+
+    template<> template<>
+    void object::test<11>()
+    {
+        set_test_name("thread pool queue policy");
+        for (bool lock_free : { false, true })
+        {
+            ThreadPool pool("policypool", 2, 1024, true, lock_free);
+            ensure_equals("policy", pool.getQueue().isLockFree(), lock_free);
+            pool.start();
+            std::atomic<U32> ran(0);
+            for (U32 i = 0; i < 100; ++i)
+            {
+                pool.getQueue().post([&ran](){ ++ran; });
+            }
+            pool.close();
+            ensure_equals(STRINGIZE("lock_free " << lock_free), ran.load(), 100u);
+        }
+
+        // a WorkSchedule pool takes the flag but keeps its time-ordered queue
+        ThreadPoolUsing<WorkSchedule> schedule("policyschedule", 1, 1024, true, true);
+        schedule.start();
+        std::atomic<bool> ran(false);
+        schedule.getQueue().post([&ran](){ ran = true; });
+        schedule.close();
+        ensure("schedule didn't run", ran.load());
+    }
 } // namespace tut
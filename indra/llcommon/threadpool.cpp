@@ -21,6 +21,7 @@
 #include "llerror.h"
 #include "llevents.h"
 #include "llsd.h"
+#include "lltracethreadrecorder.h" // <FS/> Lock-free stats handoff
 #include "stringize.h"
 
 #include <boost/fiber/algo/round_robin.hpp>
@@ -142,6 +143,17 @@ void LL::ThreadPoolBase::run(const std::string& name)
     boost::fibers::use_scheduling_algorithm<sleepy_robin>();
 #endif // LL_WINDOWS
 
+    // <FS> Lock-free stats handoff
+    // Like LLThread, so that stats recorded by the workers go to their own
+    // accumulators rather than to the shared default ones, and make it to
+    // the main thread's recordings (see WorkQueueBase::callWork())
+    std::unique_ptr<LLTrace::ThreadRecorder> recorder;
+    if (LLTrace::get_master_thread_recorder())
+    {
+        recorder = std::make_unique<LLTrace::ThreadRecorder>(*LLTrace::get_master_thread_recorder());
+    }
+    // </FS>
+
     LL_DEBUGS("ThreadPool") << name << " starting" << LL_ENDL;
     run();
     LL_DEBUGS("ThreadPool") << name << " stopping" << LL_ENDL;
@@ -206,3 +218,24 @@ size_t LL::ThreadPoolBase::getWidth(const std::string& name, size_t dft)
         return getConfiguredWidth(name, dft);
     }
 }
+
+// <FS> Lock-free WorkQueue option
+//static
+bool LL::ThreadPoolBase::getConfiguredLockFree(const std::string& name, bool dft)
+{
+    LLSD lockFree;
+    try
+    {
+        // Like "ThreadPoolSizes", but a program without this setting is fine
+        // with the compiled-in defaults: don't warn about it.
+        lockFree = LL::CommonControl::get("Global", "ThreadPoolLockFree");
+    }
+    catch (const LL::CommonControl::Error& exc)
+    {
+        LL_DEBUGS("ThreadPool") << "Can't check 'ThreadPoolLockFree': " << exc.what() << LL_ENDL;
+    }
+
+    LLSD lockFreeSpec{ lockFree[name] };
+    return lockFreeSpec.isBoolean() ? lockFreeSpec.asBoolean() : dft;
+}
+// </FS>
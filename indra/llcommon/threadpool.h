@@ -18,6 +18,7 @@
 #include <memory>                   // std::unique_ptr
 #include <string>
 #include <thread>
+#include <type_traits>              // std::is_same_v <FS/> Lock-free WorkQueue option
 #include <utility>                  // std::pair
 #include <vector>
 
@@ -85,6 +86,16 @@ namespace LL
         static
         size_t getWidth(const std::string& name, size_t dft);
 
+        // <FS> Lock-free WorkQueue option
+        /**
+         * getConfiguredLockFree() returns the setting, if any, for whether
+         * the specified ThreadPool name uses a lock-free WorkQueue. Returns
+         * dft if the "ThreadPoolLockFree" map does not contain the name.
+         */
+        static
+        bool getConfiguredLockFree(const std::string& name, bool dft=false);
+        // </FS>
+
     protected:
         std::unique_ptr<WorkQueueBase> mQueue;
         std::vector<std::pair<std::string, std::thread>> mThreads;
@@ -117,13 +128,27 @@ namespace LL
          * Pass an explicit capacity to limit the size of the queue.
          * Constraining the queue can cause a submitter to block. Do not
          * constrain any ThreadPool accepting work from the main thread.
+         *
+         * lock_free likewise sets the compile-time default for a WorkQueue
+         * pool (see WorkQueue), overridden by a key matching this ThreadPool
+         * name in the "ThreadPoolLockFree" setting. A WorkSchedule is never
+         * lock-free.
          */
+        // <FS> Lock-free WorkQueue option
+        //ThreadPoolUsing(const std::string& name,
+        //                size_t threads=1,
+        //                size_t capacity=1024*1024,
+        //                bool auto_shutdown = true):
+        //    ThreadPoolBase(name, threads, new queue_t(name, capacity, false), auto_shutdown)
+        //{}
         ThreadPoolUsing(const std::string& name,
                         size_t threads=1,
                         size_t capacity=1024*1024,
-                        bool auto_shutdown = true):
-            ThreadPoolBase(name, threads, new queue_t(name, capacity, false), auto_shutdown)
+                        bool auto_shutdown = true,
+                        bool lock_free = false):
+            ThreadPoolBase(name, threads, makeQueue(name, capacity, lock_free), auto_shutdown)
         {}
+        // </FS>
         ~ThreadPoolUsing() override {}
 
         /**
@@ -131,6 +156,21 @@ namespace LL
          * post work to it
          */
         queue_t& getQueue() { return static_cast<queue_t&>(*mQueue); }
+
+    // <FS> Lock-free WorkQueue option
+    private:
+        static queue_t* makeQueue(const std::string& name, size_t capacity, bool lock_free)
+        {
+            if constexpr (std::is_same_v<queue_t, WorkQueue>)
+            {
+                return new queue_t(name, capacity, false, getConfiguredLockFree(name, lock_free));
+            }
+            else
+            {
+                return new queue_t(name, capacity, false);
+            }
+        }
+    // </FS>
     };
 
     /// ThreadPool is shorthand for using the simpler WorkQueue
@@ -23,6 +23,8 @@
 #include "llerror.h"
 #include "llevents.h"
 #include "llexception.h"
+#include "lltracethreadrecorder.h" // <FS/> Lock-free stats handoff
+#include "lockfreequeue.h" // <FS/> Lock-free WorkQueue option
 #include "stringize.h"
 
 using Mutex = LLCoros::Mutex;
@@ -245,6 +247,14 @@ void LL::WorkQueueBase::callWork(const Work& work)
         }
     }
 #endif // else LL_WINDOWS
+
+    // <FS> Lock-free stats handoff
+    // worker threads hand their stats to the main thread between work items
+    if (LLTrace::ThreadRecorder* recorder = LLTrace::get_thread_recorder())
+    {
+        recorder->pushToParent();
+    }
+    // </FS>
 }
 
 void LL::WorkQueueBase::error(const std::string& msg)
@@ -265,37 +275,71 @@ void LL::WorkQueueBase::checkCoroutine(const std::string& method)
 /*****************************************************************************
 *   WorkQueue
 *****************************************************************************/
-LL::WorkQueue::WorkQueue(const std::string& name, size_t capacity, bool auto_shutdown):
-    super(name, auto_shutdown),
-    mQueue(capacity)
+// <FS> Lock-free WorkQueue option
+//LL::WorkQueue::WorkQueue(const std::string& name, size_t capacity, bool auto_shutdown):
+//    super(name, auto_shutdown),
+//    mQueue(capacity)
+//{
+//}
+LL::WorkQueue::WorkQueue(const std::string& name, size_t capacity, bool auto_shutdown,
+                         bool lock_free):
+    super(name, auto_shutdown)
+{
+    // only the queue in use is constructed
+    if (lock_free)
+    {
+        mLockFreeQueue.reset(new LockFreeQueue(capacity));
+    }
+    else
+    {
+        mQueue.reset(new Queue(capacity));
+    }
+}
+
+LL::WorkQueue::~WorkQueue()
 {
 }
+// </FS>
 
 void LL::WorkQueue::close()
 {
-    mQueue.close();
+    // <FS> Lock-free WorkQueue option
+    if (mLockFreeQueue)
+    {
+        return mLockFreeQueue->close();
+    }
+    //mQueue.close();
+    mQueue->close();
+    // </FS>
 }
 
 size_t LL::WorkQueue::size()
 {
-    return mQueue.size();
+    return mLockFreeQueue ? mLockFreeQueue->size() : mQueue->size(); // <FS/> Lock-free WorkQueue option
 }
 
 bool LL::WorkQueue::isClosed()
 {
-    return mQueue.isClosed();
+    return mLockFreeQueue ? mLockFreeQueue->isClosed() : mQueue->isClosed(); // <FS/> Lock-free WorkQueue option
 }
 
 bool LL::WorkQueue::done()
 {
-    return mQueue.done();
+    return mLockFreeQueue ? mLockFreeQueue->done() : mQueue->done(); // <FS/> Lock-free WorkQueue option
 }
 
 bool LL::WorkQueue::post(const Work& callable)
 {
     try
     {
-        return mQueue.pushIfOpen(callable);
+        // <FS> Lock-free WorkQueue option
+        if (mLockFreeQueue)
+        {
+            return mLockFreeQueue->pushIfOpen(callable);
+        }
+        //return mQueue.pushIfOpen(callable);
+        return mQueue->pushIfOpen(callable);
+        // </FS>
     }
     catch (std::bad_alloc&)
     {
@@ -309,7 +353,14 @@ bool LL::WorkQueue::tryPost(const Work& callable)
 {
     try
     {
-        return mQueue.tryPush(callable);
+        // <FS> Lock-free WorkQueue option
+        if (mLockFreeQueue)
+        {
+            return mLockFreeQueue->tryPush(callable);
+        }
+        //return mQueue.tryPush(callable);
+        return mQueue->tryPush(callable);
+        // </FS>
     }
     catch (std::bad_alloc&)
     {
@@ -321,12 +372,12 @@ bool LL::WorkQueue::tryPost(const Work& callable)
 
 LL::WorkQueue::Work LL::WorkQueue::pop_()
 {
-    return mQueue.pop();
+    return mLockFreeQueue ? mLockFreeQueue->pop() : mQueue->pop(); // <FS/> Lock-free WorkQueue option
 }
 
 bool LL::WorkQueue::tryPop_(Work& work)
 {
-    return mQueue.tryPop(work);
+    return mLockFreeQueue ? mLockFreeQueue->tryPop(work) : mQueue->tryPop(work); // <FS/> Lock-free WorkQueue option
 }
 
 /*****************************************************************************
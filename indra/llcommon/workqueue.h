@@ -21,6 +21,7 @@
 #include <chrono>
 #include <exception>                // std::current_exception
 #include <functional>               // std::function
+#include <memory>                   // std::unique_ptr
 #include <string>
 
 class LLEventPumps;
@@ -28,6 +29,10 @@ class LLEventPumps;
 
 namespace LL
 {
+    // <FS> Lock-free WorkQueue option, see lockfreequeue.h
+    template <typename T>
+    struct LockFreeQueue;
+    // </FS>
 
 /*****************************************************************************
 *   WorkQueueBase: API for WorkQueue and WorkSchedule
@@ -222,8 +227,20 @@ namespace LL
         /**
          * You may omit the WorkQueue name, in which case a unique name is
          * synthesized; for practical purposes that makes it anonymous.
+         *
+         * A lock_free WorkQueue only locks to wait when it's full or empty,
+         * so it holds up many producers and consumers less. Work posted by
+         * one thread still runs in the order it was posted, but work posted
+         * by different threads may run in any order.
          */
-        WorkQueue(const std::string& name = std::string(), size_t capacity=1024, bool auto_shutdown = true);
+        // <FS> Lock-free WorkQueue option
+        //WorkQueue(const std::string& name = std::string(), size_t capacity=1024, bool auto_shutdown = true);
+        WorkQueue(const std::string& name = std::string(), size_t capacity=1024, bool auto_shutdown = true,
+                  bool lock_free = false);
+        ~WorkQueue() override;
+
+        bool isLockFree() const { return bool(mLockFreeQueue); }
+        // </FS>
 
         /**
          * Since the point of WorkQueue is to pass work to some other worker
@@ -267,7 +284,12 @@ namespace LL
 
     private:
         using Queue = LLThreadSafeQueue<Work>;
-        Queue mQueue;
+        // <FS> Lock-free WorkQueue option: one or the other
+        //Queue mQueue;
+        std::unique_ptr<Queue> mQueue;
+        using LockFreeQueue = LLThreadSafeQueue<Work, LL::LockFreeQueue<Work>>;
+        std::unique_ptr<LockFreeQueue> mLockFreeQueue;
+        // </FS>
 
         Work pop_() override;
         bool tryPop_(Work&) override;
@@ -92,12 +92,17 @@
 // --------------------------------------------------------------------
 
 
-// If '1', internal ready queues will not order ready
-// requests by priority, instead it's first-come-first-served.
-// Reprioritization requests have the side-effect of then
-// putting the modified request at the back of the ready queue.
-
-#define LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY        1
+// <FS> Request priorities
+// Ready queues are now ordered by priority and then arrival,
+// see HttpReadyQueue, so this no longer has any effect.
+//
+//// If '1', internal ready queues will not order ready
+//// requests by priority, instead it's first-come-first-served.
+//// Reprioritization requests have the side-effect of then
+//// putting the modified request at the back of the ready queue.
+//
+//#define LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY        1
+// </FS>
 
 
 namespace LLCore
@@ -153,6 +158,16 @@ constexpr int HTTP_CONNECTION_LIMIT_MAX = 256;
 constexpr long HTTP_PIPELINING_DEFAULT = 0L;
 constexpr long HTTP_PIPELINING_MAX = 20L;
 
+// <FS> HTTP/2 stream limits.  0 disables HTTP/2 for the class.
+constexpr long HTTP_HTTP2_STREAM_LIMIT_DEFAULT = 0L;
+constexpr long HTTP_HTTP2_STREAM_LIMIT_MAX = 100L;
+
+// Number of ready requests the policy will set aside in one pass
+// because their host is at its stream budget before it gives up
+// on the class until the next pass.
+constexpr int HTTP_HTTP2_DEFER_SCAN_LIMIT = 16;
+// </FS>
+
 // Miscellaneous defaults
 constexpr bool HTTP_USE_RETRY_AFTER_DEFAULT = true;
 constexpr long HTTP_THROTTLE_RATE_DEFAULT = 0L;
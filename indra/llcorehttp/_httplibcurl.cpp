@@ -30,6 +30,8 @@
 #include "bufferarray.h"
 #include "_httpoprequest.h"
 #include "_httppolicy.h"
+#include "httpstats.h"          // <FS/> HTTP/2 multiplexing
+#include "llstring.h"           // <FS/> HTTP/2 multiplexing
 
 #include "llhttpconstants.h"
 
@@ -64,7 +66,8 @@ HttpLibcurl::HttpLibcurl(HttpService * service)
       mPolicyCount(0),
       mMultiHandles(NULL),
       mActiveHandles(NULL),
-      mDirtyPolicy(NULL)
+      mDirtyPolicy(NULL),
+      mActiveHosts(NULL)    // <FS/> HTTP/2 multiplexing
 {}
 
 
@@ -105,6 +108,11 @@ void HttpLibcurl::shutdown()
 
         delete [] mDirtyPolicy;
         mDirtyPolicy = NULL;
+
+        // <FS> HTTP/2 multiplexing
+        delete [] mActiveHosts;
+        mActiveHosts = NULL;
+        // </FS>
     }
 
     mPolicyCount = 0;
@@ -121,6 +129,7 @@ void HttpLibcurl::start(int policy_count)
     mMultiHandles = new CURLM * [mPolicyCount];
     mActiveHandles = new int [mPolicyCount];
     mDirtyPolicy = new bool [mPolicyCount];
+    mActiveHosts = new host_count_t [mPolicyCount];     // <FS/> HTTP/2 multiplexing
 
     for (unsigned int policy_class(0); policy_class < mPolicyCount; ++policy_class)
     {
@@ -244,6 +253,7 @@ void HttpLibcurl::addOp(const HttpOpRequest::ptr_t &op)
     op->mCurlActive = true;
     mActiveOps.insert(op);
     ++mActiveHandles[op->mReqPolicy];
+    addActiveHost(op);      // <FS/> HTTP/2 multiplexing
 
     if (op->mTracing > HTTP_TRACE_OFF)
     {
@@ -278,6 +288,7 @@ bool HttpLibcurl::cancel(HttpHandle handle)
     // Drop references
     mActiveOps.erase(it);
     --mActiveHandles[op->mReqPolicy];
+    removeActiveHost(op);   // <FS/> HTTP/2 multiplexing
 
     return true;
 }
@@ -356,6 +367,7 @@ bool HttpLibcurl::completeRequest(CURLM * multi_handle, CURL * handle, CURLcode
     // Deactivate request
     mActiveOps.erase(it);
     --mActiveHandles[op->mReqPolicy];
+    removeActiveHost(op);   // <FS/> HTTP/2 multiplexing
     op->mCurlActive = false;
 
     // Set final status of request if it hasn't failed by other mechanisms yet
@@ -409,6 +421,13 @@ bool HttpLibcurl::completeRequest(CURLM * multi_handle, CURL * handle, CURLcode
         }
     }
 
+    // <FS> HTTP/2 multiplexing
+    if (handle)
+    {
+        recordTransferStats(handle);
+    }
+    // </FS>
+
     // <FS:ND> See if the requested URL matches a X-LL-URL header (if present) and the requested range.
     // If not, we assume http pipelining havng gone out of sync. If yes, yield a 503 status and switch
     // pipelining off.
@@ -508,6 +527,77 @@ int HttpLibcurl::getActiveCountInClass(unsigned int policy_class) const
     return mActiveHandles ? mActiveHandles[policy_class] : 0;
 }
 
+// <FS> HTTP/2 multiplexing
+int HttpLibcurl::getActiveCountForHost(unsigned int policy_class, const std::string & host) const
+{
+    llassert_always(policy_class < mPolicyCount);
+
+    if (! mActiveHosts)
+    {
+        return 0;
+    }
+    host_count_t::const_iterator it(mActiveHosts[policy_class].find(host));
+    return mActiveHosts[policy_class].end() == it ? 0 : it->second;
+}
+
+
+std::string HttpLibcurl::getHostKey(const std::string & url)
+{
+    // Scheme is kept so http and https to the same host stay apart.
+    size_t start(url.find("://"));
+    start = (std::string::npos == start) ? 0 : start + 3;
+    const size_t end(url.find_first_of("/?#", start));
+    std::string key(url, 0, end);
+    LLStringUtil::toLower(key);
+    return key;
+}
+
+
+void HttpLibcurl::addActiveHost(const HttpOpRequest::ptr_t &op)
+{
+    HttpPolicy & policy(mService->getPolicy());
+    if (! policy.getClassOptions(op->mReqPolicy).useHttp2())
+    {
+        return;
+    }
+
+    ++mActiveHosts[op->mReqPolicy][op->mReqHostKey];
+    op->mCurlHostActive = true;
+}
+
+
+void HttpLibcurl::removeActiveHost(const HttpOpRequest::ptr_t &op)
+{
+    if (! op->mCurlHostActive)
+    {
+        return;
+    }
+
+    host_count_t & hosts(mActiveHosts[op->mReqPolicy]);
+    host_count_t::iterator it(hosts.find(op->mReqHostKey));
+    if (hosts.end() != it && --it->second <= 0)
+    {
+        hosts.erase(it);
+    }
+    op->mCurlHostActive = false;
+}
+
+
+void HttpLibcurl::recordTransferStats(CURL * handle)
+{
+    long http_version(0L);
+#if LIBCURL_VERSION_NUM >= 0x073200     // 7.50.0
+    curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &http_version);
+#endif
+    long connects(0L);
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+    double total_time(0.0);
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &total_time);
+
+    HTTPStats::instance().recordTransfer(http_version, connects, total_time);
+}
+// </FS>
+
 void HttpLibcurl::policyUpdated(unsigned int policy_class)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
@@ -542,6 +632,29 @@ void HttpLibcurl::policyUpdated(unsigned int policy_class)
         policy.stallPolicy(policy_class, false);
         mDirtyPolicy[policy_class] = false;
 
+        // <FS> HTTP/2 multiplexing
+        if (options.useHttp2())
+        {
+            // Multiplex requests as streams over as few connections as
+            // possible.  Connections that negotiate HTTP/1.1 instead
+            // run one request at a time up to the same limits.
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_PIPELINING,
+                                     long(CURLPIPE_MULTIPLEX));
+#if LIBCURL_VERSION_NUM >= 0x074300     // 7.67.0
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_CONCURRENT_STREAMS,
+                                     long(options.mHttp2StreamLimit));
+#endif
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_HOST_CONNECTIONS,
+                                     long(options.mPerHostConnectionLimit));
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                                     long(options.mConnectionLimit));
+        }
+        else
+        // </FS>
         if (options.mPipelining > 1)
         {
             // We'll try to do pipelining on this multihandle
@@ -32,7 +32,9 @@
 #include <curl/curl.h>
 #include <curl/multi.h>
 
+#include <map>
 #include <set>
+#include <string>
 
 #include "httprequest.h"
 #include "_httpservice.h"
@@ -109,6 +111,19 @@ public:
     int getActiveCount() const;
     int getActiveCountInClass(unsigned int policy_class) const;
 
+    // <FS> HTTP/2 multiplexing
+    /// Return the count of active requests to a host in a policy
+    /// class with an HTTP/2 stream budget.  Host is a key from
+    /// getHostKey().
+    ///
+    /// Threading:  called by worker thread.
+    int getActiveCountForHost(unsigned int policy_class, const std::string & host) const;
+
+    /// Reduce a URL to the 'scheme://authority' part that identifies
+    /// the connection it will use.
+    static std::string getHostKey(const std::string & url);
+    // </FS>
+
     /// Attempt to cancel a request identified by handle.
     ///
     /// Interface shadows HttpService's method.
@@ -152,8 +167,20 @@ protected:
     /// and destroy.
     void cancelRequest(const opReqPtr_t &op);
 
+    // <FS> HTTP/2 multiplexing
+    /// Charge an op going active against its host's stream budget
+    /// and release it again when it leaves the active list.
+    void addActiveHost(const opReqPtr_t &op);
+    void removeActiveHost(const opReqPtr_t &op);
+
+    /// Record protocol, connection and latency figures for a
+    /// finished transfer.
+    void recordTransferStats(CURL * handle);
+    // </FS>
+
 protected:
     typedef std::set<opReqPtr_t> active_set_t;
+    typedef std::map<std::string, int> host_count_t;   // <FS/> HTTP/2 multiplexing
 
     /// Simple request handle cache for libcurl.
     ///
@@ -215,6 +242,7 @@ protected:
     CURLM **            mMultiHandles;      // One handle per policy class
     int *               mActiveHandles;     // Active count per policy class
     bool *              mDirtyPolicy;       // Dirty policy update waiting for stall (per pc)
+    host_count_t *      mActiveHosts;       // <FS/> Active count per host, per policy class
 
 }; // end class HttpLibcurl
 
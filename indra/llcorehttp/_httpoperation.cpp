@@ -174,7 +174,7 @@ void HttpOperation::destroyHandle()
 }
 
 /*static*/
-HttpOperation::ptr_t HttpOperation::findByHandle(HttpHandle handle)
+HttpOperation::ptr_t HttpOperation::findByHandle(HttpHandle handle, bool quiet)
 {
     wptr_t weak;
 
@@ -187,7 +187,13 @@ HttpOperation::ptr_t HttpOperation::findByHandle(HttpHandle handle)
         handleMap_t::iterator it = mHandleMap.find(handle);
         if (it == mHandleMap.end())
         {
-            LL_WARNS("LLCore::HTTP") << "Could not find operation for handle " << handle << LL_ENDL;
+            // <FS> Request priorities
+            //LL_WARNS("LLCore::HTTP") << "Could not find operation for handle " << handle << LL_ENDL;
+            if (! quiet)
+            {
+                LL_WARNS("LLCore::HTTP") << "Could not find operation for handle " << handle << LL_ENDL;
+            }
+            // </FS>
             return ptr_t();
         }
 
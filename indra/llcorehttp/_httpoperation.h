@@ -158,14 +158,17 @@ public:
     /// Retrieves a unique handle for this operation.
     HttpHandle getHandle();
 
+    // <FS> Request priorities: quiet for lookups of handles that
+    // are expected to have gone away
     template< class OPT >
-    static std::shared_ptr< OPT > fromHandle(HttpHandle handle)
+    static std::shared_ptr< OPT > fromHandle(HttpHandle handle, bool quiet = false)
     {
-        ptr_t ptr = findByHandle(handle);
+        ptr_t ptr = findByHandle(handle, quiet);
         if (!ptr)
             return std::shared_ptr< OPT >();
         return std::dynamic_pointer_cast< OPT >(ptr);
     }
+    // </FS>
 
 protected:
     /// Delivers request to reply queue on completion.  After this
@@ -202,7 +205,7 @@ private:
     static LLCoreInt::HttpMutex mOpMutex;
 
 protected:
-    static ptr_t                findByHandle(HttpHandle handle);
+    static ptr_t                findByHandle(HttpHandle handle, bool quiet = false);    // <FS/> quiet
 
 
 };  // end class HttpOperation
@@ -144,6 +144,7 @@ HttpOpRequest::HttpOpRequest()
       mCurlBodyPos(0),
       mCurlTemp(NULL),
       mCurlTempLen(0),
+      mCurlHostActive(false),                   // <FS/> HTTP/2 multiplexing
       mReplyBody(NULL),
       mReplyOffset(0),
       mReplyLength(0),
@@ -155,6 +156,11 @@ HttpOpRequest::HttpOpRequest()
       mPolicyRetryLimit(HTTP_RETRY_COUNT_DEFAULT),
       mPolicyMinRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MIN_DEFAULT)),
       mPolicyMaxRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MAX_DEFAULT)),
+      // <FS> Ready queue ordering
+      mPolicyPriority(HttpRequest::DEFAULT_PRIORITY),
+      mPolicySequence(0),
+      mPolicyReadyIndex(size_t(-1)),          // HttpReadyQueue::npos
+      // </FS>
       mCallbackSSLVerify(nullptr)
 {
     // *NOTE:  As members are added, retry initialization/cleanup
@@ -432,6 +438,7 @@ void HttpOpRequest::setupCommon(HttpRequest::policy_t policy_id,
     mProcFlags = 0U;
     mReqPolicy = policy_id;
     mReqURL = url;
+    mReqHostKey = HttpLibcurl::getHostKey(url); // <FS/> HTTP/2 multiplexing
     if (body)
     {
         body->addRef();
@@ -731,6 +738,23 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
     {
         xfer_timeout = timeout;
     }
+    // <FS> HTTP/2 multiplexing
+    if (cpolicy.useHttp2())
+    {
+        // Offer HTTP/2 during the TLS handshake, staying with HTTP/1.1
+        // for plain http and servers that don't accept it.  PIPEWAIT
+        // holds a new request until the connection to its host has
+        // said whether it can multiplex rather than opening another
+        // connection straight away.
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_PIPEWAIT, 1L);
+
+        // As with pipelining, a request can sit behind others on its
+        // host within libcurl when that host falls back to HTTP/1.1.
+        xfer_timeout *= 2L;
+    }
+    else
+    // </FS>
     if (cpolicy.mPipelining > 1L)
     {
         // Pipelining affects both connection and transfer timeout values.
@@ -194,6 +194,7 @@ public:
     // Request data
     EMethod             mReqMethod;
     std::string         mReqURL;
+    std::string         mReqHostKey;            // <FS/> HttpLibcurl::getHostKey() of mReqURL
     BufferArray *       mReqBody;
     off_t               mReqOffset;
     size_t              mReqLength;
@@ -208,6 +209,7 @@ public:
     size_t              mCurlBodyPos;
     char *              mCurlTemp;              // Scratch buffer for header processing
     size_t              mCurlTempLen;
+    bool                mCurlHostActive;        // <FS/> Charged against its host's HTTP/2 stream budget
 
     // Result data
     HttpStatus          mStatus;
@@ -226,6 +228,11 @@ public:
     int                 mPolicyRetryLimit;
     HttpTime            mPolicyMinRetryBackoff; // initial delay between retries (mcs)
     HttpTime            mPolicyMaxRetryBackoff;
+    // <FS> Ready queue ordering, see HttpReadyQueue
+    HttpRequest::priority_t mPolicyPriority;
+    U64                 mPolicySequence;        // Arrival order on the ready queue, 0 until queued
+    size_t              mPolicyReadyIndex;      // Slot on the ready queue or HttpReadyQueue::npos
+    // </FS>
 };  // end class HttpOpRequest
 
 
@@ -24,22 +24,21 @@
  * $/LicenseInfo$
  */
 
-#if 0 // DEPRECATED
 #include "_httpopsetpriority.h"
 
 #include "httpresponse.h"
 #include "httphandler.h"
 #include "_httpservice.h"
+#include "_httppolicy.h"
 
 
 namespace LLCore
 {
 
 
-HttpOpSetPriority::HttpOpSetPriority(HttpHandle handle, HttpRequest::priority_t priority)
+HttpOpSetPriority::HttpOpSetPriority(HttpRequest::priority_list_t priorities)
     : HttpOperation(),
-      mHandle(handle),
-      mPriority(priority)
+      mPriorities(std::move(priorities))
 {}
 
 
@@ -49,10 +48,17 @@ HttpOpSetPriority::~HttpOpSetPriority()
 
 void HttpOpSetPriority::stageFromRequest(HttpService * service)
 {
+    HttpPolicy & policy(service->getPolicy());
+
     // Do operations
-    if (! service->changePriority(mHandle, mPriority))
+    bool found(false);
+    for (const HttpRequest::priority_list_t::value_type & change : mPriorities)
+    {
+        found = policy.changePriority(change.first, change.second) || found;
+    }
+    if (! found && ! mPriorities.empty())
     {
-        // Request not found, fail the final status
+        // No request was waiting, fail the final status
         mStatus = HttpStatus(HttpStatus::LLCORE, HE_HANDLE_NOT_FOUND);
     }
 
@@ -62,5 +68,3 @@ void HttpOpSetPriority::stageFromRequest(HttpService * service)
 
 
 }   // end namespace LLCore
-
-#endif
@@ -1,5 +1,5 @@
 /**
- * @file _httpsetpriority.h
+ * @file _httpopsetpriority.h
  * @brief Internal declarations for HttpSetPriority
  *
  * $LicenseInfo:firstyear=2012&license=viewerlgpl$
@@ -27,7 +27,6 @@
 #ifndef _LLCORE_HTTP_SETPRIORITY_H_
 #define _LLCORE_HTTP_SETPRIORITY_H_
 
-#if 0 // DEPRECATED
 #include "httpcommon.h"
 #include "httprequest.h"
 #include "_httpoperation.h"
@@ -38,18 +37,17 @@ namespace LLCore
 {
 
 
-/// HttpOpSetPriority is an immediate request that
-/// searches the various queues looking for a given
-/// request handle and changing it's priority if
-/// found.
-///
-/// *NOTE:  This will very likely be removed in the near future
-/// when priority is removed from the library.
+/// HttpOpSetPriority is an immediate request that changes
+/// the priorities of a batch of previously issued requests.
+/// Requests still on a ready queue are moved to their new
+/// places, others are skipped.  It completes with an
+/// HE_HANDLE_NOT_FOUND error status only if none of the
+/// requests were found waiting.
 
 class HttpOpSetPriority : public HttpOperation
 {
 public:
-    HttpOpSetPriority(HttpHandle handle);
+    HttpOpSetPriority(HttpRequest::priority_list_t priorities);
 
     virtual ~HttpOpSetPriority();
 
@@ -62,11 +60,9 @@ public:
 
 protected:
     // Request Data
-    HttpHandle                  mHandle;
+    HttpRequest::priority_list_t mPriorities;
 }; // end class HttpOpSetPriority
 
 }  // end namespace LLCore
-#endif
 
 #endif  // _LLCORE_HTTP_SETPRIORITY_H_
-
@@ -249,10 +249,21 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
         }
 
         int active(transport.getActiveCountInClass(policy_class));
-        int active_limit(state.mOptions.mPipelining > 1L
-                         ? (state.mOptions.mPerHostConnectionLimit
-                            * state.mOptions.mPipelining)
-                         : state.mOptions.mConnectionLimit);
+        // <FS> HTTP/2 multiplexing
+        //int active_limit(state.mOptions.mPipelining > 1L
+        //                 ? (state.mOptions.mPerHostConnectionLimit
+        //                    * state.mOptions.mPipelining)
+        //                 : state.mOptions.mConnectionLimit);
+        int active_limit(static_cast<int>(state.mOptions.getActiveLimit()));
+
+        // With HTTP/2, a host that has used up its stream budget
+        // mustn't hold up requests for other hosts.  Its requests
+        // are set aside for this pass and go back on the queue in
+        // their original order.
+        const int host_limit(static_cast<int>(state.mOptions.getHostActiveLimit()));
+        std::vector<HttpOpRequest::ptr_t> deferred;
+        std::vector<HttpOpRequest::ptr_t> deferred_retries;
+        // </FS>
         int needed(active_limit - active);      // Expect negatives here
 
         if (needed > 0)
@@ -266,6 +277,19 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
 
                 retryq.pop();
 
+                // <FS> HTTP/2 multiplexing
+                if (host_limit && transport.getActiveCountForHost(policy_class, op->mReqHostKey) >= host_limit)
+                {
+                    HTTPStats::instance().recordHostDeferral();
+                    deferred_retries.push_back(op);
+                    if (deferred_retries.size() >= size_t(HTTP_HTTP2_DEFER_SCAN_LIMIT))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                // </FS>
+
                 op->stageFromReady(mService);
                 op.reset();
 
@@ -295,6 +319,19 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
                 HttpOpRequest::ptr_t op(readyq.top());
                 readyq.pop();
 
+                // <FS> HTTP/2 multiplexing
+                if (host_limit && transport.getActiveCountForHost(policy_class, op->mReqHostKey) >= host_limit)
+                {
+                    HTTPStats::instance().recordHostDeferral();
+                    deferred.push_back(op);
+                    if (deferred.size() >= size_t(HTTP_HTTP2_DEFER_SCAN_LIMIT))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                // </FS>
+
                 op->stageFromReady(mService);
                 op.reset();
 
@@ -321,6 +358,19 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
 
     throttle_on:
 
+        // <FS> HTTP/2 multiplexing
+        // Ops keep their arrival order and retry times so this
+        // restores them to their places.
+        for (HttpOpRequest::ptr_t & op : deferred)
+        {
+            readyq.push(op);
+        }
+        for (HttpOpRequest::ptr_t & op : deferred_retries)
+        {
+            retryq.push(op);
+        }
+        // </FS>
+
         if (! readyq.empty() || ! retryq.empty())
         {
             // If anything is ready, continue looping...
@@ -333,6 +383,18 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
 
 bool HttpPolicy::cancel(HttpHandle handle)
 {
+    // <FS> Request priorities
+    // Ready queues are indexed, find the op directly
+    HttpOpRequest::ptr_t ready_op(HttpOpRequest::fromHandle<HttpOpRequest>(handle, true));
+    if (ready_op
+        && ready_op->mReqPolicy < mClasses.size()
+        && mClasses[ready_op->mReqPolicy]->mReadyQueue.erase(ready_op))
+    {
+        ready_op->cancel();
+        return true;
+    }
+    // </FS>
+
     for (int policy_class(0); policy_class < mClasses.size(); ++policy_class)
     {
         ClassState & state(*mClasses[policy_class]);
@@ -352,24 +414,50 @@ bool HttpPolicy::cancel(HttpHandle handle)
             }
         }
 
-        // Scan ready queue
-        HttpReadyQueue::container_type & c2(state.mReadyQueue.get_container());
-        for (HttpReadyQueue::container_type::iterator iter(c2.begin()); c2.end() != iter;)
-        {
-            HttpReadyQueue::container_type::iterator cur(iter++);
+        // <FS> Request priorities
+        // Ready queue was checked above
+        //// Scan ready queue
+        //HttpReadyQueue::container_type & c2(state.mReadyQueue.get_container());
+        //for (HttpReadyQueue::container_type::iterator iter(c2.begin()); c2.end() != iter;)
+        //{
+        //    HttpReadyQueue::container_type::iterator cur(iter++);
+        //
+        //    if ((*cur)->getHandle() == handle)
+        //    {
+        //        HttpOpRequest::ptr_t op(*cur);
+        //        c2.erase(cur);                                  // All iterators are now invalidated
+        //        op->cancel();
+        //        return true;
+        //    }
+        //}
+        // </FS>
+    }
 
-            if ((*cur)->getHandle() == handle)
-            {
-                HttpOpRequest::ptr_t op(*cur);
-                c2.erase(cur);                                  // All iterators are now invalidated
-                op->cancel();
-                return true;
-            }
-        }
+    return false;
+}
+
+
+// <FS> Request priorities
+bool HttpPolicy::changePriority(HttpHandle handle, HttpRequest::priority_t priority)
+{
+    HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(handle, true));
+    if (! op || op->mReqPolicy >= mClasses.size())
+    {
+        return false;
+    }
+
+    if (mClasses[op->mReqPolicy]->mReadyQueue.reprioritize(op, priority))
+    {
+        return true;
     }
 
+    // Active or waiting to retry.  Retries go straight from the
+    // retry queue to transport so this only matters to anyone
+    // looking at the op later.
+    op->mPolicyPriority = priority;
     return false;
 }
+// </FS>
 
 
 bool HttpPolicy::stageAfterCompletion(const HttpOpRequest::ptr_t &op)
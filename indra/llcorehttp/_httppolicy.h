@@ -116,6 +116,17 @@ public:
     /// Threading:  called by worker thread
     bool cancel(HttpHandle handle);
 
+    // <FS> Request priorities
+    /// Change the priority of a previous request.  A request still
+    /// on its ready queue moves to its new place.  Otherwise the
+    /// priority is only recorded on the request.
+    ///
+    /// @return         True if the request was on a ready queue.
+    ///
+    /// Threading:  called by worker thread
+    bool changePriority(HttpHandle handle, HttpRequest::priority_t priority);
+    // </FS>
+
     /// When transport is finished with an op and takes it off the
     /// active queue, it is delivered here for dispatch.  Policy
     /// may send it back to the ready/retry queues if it needs another
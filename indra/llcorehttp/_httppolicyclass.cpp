@@ -37,7 +37,8 @@ HttpPolicyClass::HttpPolicyClass()
     : mConnectionLimit(HTTP_CONNECTION_LIMIT_DEFAULT),
       mPerHostConnectionLimit(HTTP_CONNECTION_LIMIT_DEFAULT),
       mPipelining(HTTP_PIPELINING_DEFAULT),
-      mThrottleRate(HTTP_THROTTLE_RATE_DEFAULT)
+      mThrottleRate(HTTP_THROTTLE_RATE_DEFAULT),
+      mHttp2StreamLimit(HTTP_HTTP2_STREAM_LIMIT_DEFAULT)    // <FS/> HTTP/2 multiplexing
 {}
 
 
@@ -53,6 +54,7 @@ HttpPolicyClass & HttpPolicyClass::operator=(const HttpPolicyClass & other)
         mPerHostConnectionLimit = other.mPerHostConnectionLimit;
         mPipelining = other.mPipelining;
         mThrottleRate = other.mThrottleRate;
+        mHttp2StreamLimit = other.mHttp2StreamLimit;        // <FS/> HTTP/2 multiplexing
     }
     return *this;
 }
@@ -62,7 +64,8 @@ HttpPolicyClass::HttpPolicyClass(const HttpPolicyClass & other)
     : mConnectionLimit(other.mConnectionLimit),
       mPerHostConnectionLimit(other.mPerHostConnectionLimit),
       mPipelining(other.mPipelining),
-      mThrottleRate(other.mThrottleRate)
+      mThrottleRate(other.mThrottleRate),
+      mHttp2StreamLimit(other.mHttp2StreamLimit)            // <FS/> HTTP/2 multiplexing
 {}
 
 
@@ -86,6 +89,12 @@ HttpStatus HttpPolicyClass::set(HttpRequest::EPolicyOption opt, long value)
         mThrottleRate = llclamp(value, 0L, 1000000L);
         break;
 
+    // <FS> HTTP/2 multiplexing
+    case HttpRequest::PO_HTTP2_STREAM_LIMIT:
+        mHttp2StreamLimit = llclamp(value, 0L, HTTP_HTTP2_STREAM_LIMIT_MAX);
+        break;
+    // </FS>
+
     default:
         return HttpStatus(HttpStatus::LLCORE, HE_INVALID_ARG);
     }
@@ -114,6 +123,12 @@ HttpStatus HttpPolicyClass::get(HttpRequest::EPolicyOption opt, long * value) co
         *value = mThrottleRate;
         break;
 
+    // <FS> HTTP/2 multiplexing
+    case HttpRequest::PO_HTTP2_STREAM_LIMIT:
+        *value = mHttp2StreamLimit;
+        break;
+    // </FS>
+
     default:
         return HttpStatus(HttpStatus::LLCORE, HE_INVALID_ARG);
     }
@@ -122,4 +137,26 @@ HttpStatus HttpPolicyClass::get(HttpRequest::EPolicyOption opt, long * value) co
 }
 
 
+// <FS> HTTP/2 multiplexing
+long HttpPolicyClass::getActiveLimit() const
+{
+    if (useHttp2())
+    {
+        return mConnectionLimit * mHttp2StreamLimit;
+    }
+    if (mPipelining > 1L)
+    {
+        return mPerHostConnectionLimit * mPipelining;
+    }
+    return mConnectionLimit;
+}
+
+
+long HttpPolicyClass::getHostActiveLimit() const
+{
+    return useHttp2() ? mPerHostConnectionLimit * mHttp2StreamLimit : 0L;
+}
+// </FS>
+
+
 }  // end namespace LLCore
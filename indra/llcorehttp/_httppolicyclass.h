@@ -59,11 +59,26 @@ public:
     HttpStatus set(HttpRequest::EPolicyOption opt, long value);
     HttpStatus get(HttpRequest::EPolicyOption opt, long * value) const;
 
+    // <FS> HTTP/2 multiplexing
+    bool useHttp2() const
+        {
+            return mHttp2StreamLimit > 0L;
+        }
+
+    /// Maximum number of requests the class may have in flight.
+    long getActiveLimit() const;
+
+    /// Maximum number of requests the class may have in flight
+    /// to a single host, or 0 if hosts aren't budgeted separately.
+    long getHostActiveLimit() const;
+    // </FS>
+
 public:
     long                        mConnectionLimit;
     long                        mPerHostConnectionLimit;
     long                        mPipelining;
     long                        mThrottleRate;
+    long                        mHttp2StreamLimit;      // <FS/> HTTP/2 multiplexing
 };  // end class HttpPolicyClass
 
 }  // end namespace LLCore
@@ -0,0 +1,177 @@
+/**
+ * @file _httpreadyqueue.cpp
+ * @brief Internal definitions for the operation ready queue
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "_httpreadyqueue.h"
+
+#include <algorithm>
+#include <utility>
+
+
+namespace LLCore
+{
+
+
+void HttpReadyQueue::push(const value_type & op)
+{
+    llassert(npos == op->mPolicyReadyIndex);
+
+    if (! op->mPolicySequence)
+    {
+        op->mPolicySequence = ++mSequence;
+    }
+    mHeap.push_back(op);
+    op->mPolicyReadyIndex = mHeap.size() - 1;
+    siftUp(mHeap.size() - 1);
+}
+
+
+void HttpReadyQueue::pop()
+{
+    removeAt(0);
+}
+
+
+bool HttpReadyQueue::erase(const value_type & op)
+{
+    if (! contains(op))
+    {
+        return false;
+    }
+    removeAt(op->mPolicyReadyIndex);
+    return true;
+}
+
+
+bool HttpReadyQueue::reprioritize(const value_type & op, HttpRequest::priority_t priority)
+{
+    if (! contains(op))
+    {
+        return false;
+    }
+
+    const HttpRequest::priority_t old_priority(op->mPolicyPriority);
+    op->mPolicyPriority = priority;
+    if (priority > old_priority)
+    {
+        siftUp(op->mPolicyReadyIndex);
+    }
+    else if (priority < old_priority)
+    {
+        siftDown(op->mPolicyReadyIndex);
+    }
+    return true;
+}
+
+
+// Put op in a slot and tell it where it is.
+void HttpReadyQueue::place(size_t index, value_type op)
+{
+    op->mPolicyReadyIndex = index;
+    mHeap[index] = std::move(op);
+}
+
+
+// Moves a hole up rather than swapping, so each level
+// costs one shared_ptr move instead of three.
+void HttpReadyQueue::siftUp(size_t index)
+{
+    value_type op(std::move(mHeap[index]));
+    while (index > 0)
+    {
+        const size_t parent((index - 1) / ARITY);
+        if (! before(op, mHeap[parent]))
+        {
+            break;
+        }
+        place(index, std::move(mHeap[parent]));
+        index = parent;
+    }
+    place(index, std::move(op));
+}
+
+
+void HttpReadyQueue::siftDown(size_t index)
+{
+    const size_t count(mHeap.size());
+    value_type op(std::move(mHeap[index]));
+    for (;;)
+    {
+        const size_t first(index * ARITY + 1);
+        if (first >= count)
+        {
+            break;
+        }
+
+        const size_t last(std::min(first + ARITY, count));
+        size_t best(first);
+        for (size_t child(first + 1); child < last; ++child)
+        {
+            if (before(mHeap[child], mHeap[best]))
+            {
+                best = child;
+            }
+        }
+        if (! before(mHeap[best], op))
+        {
+            break;
+        }
+        place(index, std::move(mHeap[best]));
+        index = best;
+    }
+    place(index, std::move(op));
+}
+
+
+void HttpReadyQueue::removeAt(size_t index)
+{
+    llassert(index < mHeap.size());
+
+    mHeap[index]->mPolicyReadyIndex = npos;
+
+    const size_t last(mHeap.size() - 1);
+    if (index != last)
+    {
+        // Fill the hole with the last op and let it find its level.
+        // It came from another subtree so it may need to go either way.
+        place(index, std::move(mHeap[last]));
+        mHeap.pop_back();
+        if (index > 0 && before(mHeap[index], mHeap[(index - 1) / ARITY]))
+        {
+            siftUp(index);
+        }
+        else
+        {
+            siftDown(index);
+        }
+    }
+    else
+    {
+        mHeap.pop_back();
+    }
+}
+
+
+}  // end namespace LLCore
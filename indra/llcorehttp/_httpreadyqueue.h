@@ -28,49 +28,41 @@
 #define _LLCORE_HTTP_READY_QUEUE_H_
 
 
-#include <queue>
+#include <vector>
 
-#include "_httpinternal.h"
 #include "_httpoprequest.h"
 
 
 namespace LLCore
 {
 
-/// HttpReadyQueue provides a simple priority queue for HttpOpRequest objects.
+/// HttpReadyQueue holds HttpOpRequest objects waiting for a
+/// connection, highest mPolicyPriority first and in order of
+/// arrival (mPolicySequence) among equal priorities.  With no
+/// priorities set, service is first-come-first-served.
 ///
-/// This uses the priority_queue adaptor class to provide the queue
-/// as well as the ordering scheme while allowing us access to the
-/// raw container if we follow a few simple rules.  One of the more
-/// important of those rules is that any iterator becomes invalid
-/// on element erasure.  So pay attention.
+/// It is a 4-ary heap in a vector with each queued op recording
+/// its slot in mPolicyReadyIndex.  That index lets a request be
+/// reprioritized or removed in O(log n) without searching the
+/// queue, which matters when a consumer like texture fetch is
+/// changing the priorities of thousands of waiting requests.
 ///
-/// If LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY tests true, the class
-/// implements a std::priority_queue interface but on std::deque
-/// behavior to eliminate sensitivity to priority.  In the future,
-/// this will likely become the only behavior or it may become
-/// a run-time election.
+/// An op may be on at most one ready queue at a time.
 ///
 /// Threading:  not thread-safe.  Expected to be used entirely by
 /// a single thread, typically a worker thread of some sort.
 
-#if LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-
-typedef std::deque<HttpOpRequest::ptr_t> HttpReadyQueueBase;
-
-#else
-
-typedef std::priority_queue<HttpOpRequest::ptr_t,
-                            std::deque<HttpOpRequest::ptr_t>,
-                            LLCore::HttpOpRequestCompare> HttpReadyQueueBase;
-
-#endif // LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-
-class HttpReadyQueue : public HttpReadyQueueBase
+class HttpReadyQueue
 {
 public:
+    typedef HttpOpRequest::ptr_t value_type;
+    typedef std::vector<value_type> container_type;
+
+    /// mPolicyReadyIndex value of an op not on a ready queue.
+    static constexpr size_t npos = size_t(-1);
+
     HttpReadyQueue()
-        : HttpReadyQueueBase()
+        : mSequence(0)
         {}
 
     ~HttpReadyQueue()
@@ -81,40 +73,69 @@ protected:
     void operator=(const HttpReadyQueue&) = delete;
 
 public:
+    bool empty() const
+        {
+            return mHeap.empty();
+        }
 
-#if LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-    // Types and methods needed to make a std::deque look
-    // more like a std::priority_queue, at least for our
-    // purposes.
-    typedef HttpReadyQueueBase container_type;
-
-    const_reference top() const
+    size_t size() const
         {
-            return front();
+            return mHeap.size();
         }
 
-    void pop()
+    const value_type & top() const
         {
-            pop_front();
+            return mHeap.front();
         }
 
-    void push(const value_type & v)
+    /// Ops keep the arrival order they were given the first time
+    /// they were pushed so one that is popped and pushed back
+    /// returns to its old place among equal priorities.
+    void push(const value_type & op);
+    void pop();
+
+    bool contains(const value_type & op) const
         {
-            push_back(v);
+            return op->mPolicyReadyIndex < mHeap.size() && mHeap[op->mPolicyReadyIndex] == op;
         }
 
-#endif // LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
+    /// Remove an op from anywhere in the queue.
+    ///
+    /// @return         False if op wasn't on this queue.
+    bool erase(const value_type & op);
+
+    /// Change the priority of a queued op and restore heap order.
+    ///
+    /// @return         False if op wasn't on this queue, in which
+    ///                 case nothing is changed.
+    bool reprioritize(const value_type & op, HttpRequest::priority_t priority);
 
+    /// Heap-ordered, not service-ordered.  Don't modify the
+    /// ops' ordering fields through this.
     const container_type & get_container() const
         {
-            return *this;
+            return mHeap;
         }
 
-    container_type & get_container()
+protected:
+    static constexpr size_t ARITY = 4;
+
+    /// True if a should be serviced before b.
+    static bool before(const value_type & a, const value_type & b)
         {
-            return *this;
+            return a->mPolicyPriority > b->mPolicyPriority
+                || (a->mPolicyPriority == b->mPolicyPriority
+                    && a->mPolicySequence < b->mPolicySequence);
         }
 
+    void place(size_t index, value_type op);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void removeAt(size_t index);
+
+protected:
+    container_type      mHeap;
+    U64                 mSequence;
 }; // end class HttpReadyQueue
 
 
@@ -34,6 +34,7 @@
 #include "_httpoprequest.h"
 #include "_httpopcancel.h"
 #include "_httpopsetget.h"
+#include "_httpopsetpriority.h"     // <FS/> Request priorities
 
 #include "lltimer.h"
 #include "httpstats.h"
@@ -476,6 +477,25 @@ HttpHandle HttpRequest::requestCancel(HttpHandle request, HttpHandler::ptr_t use
 }
 
 
+// <FS> Request priorities
+HttpHandle HttpRequest::requestSetPriorities(priority_list_t priorities, HttpHandler::ptr_t user_handler)
+{
+    HttpStatus status;
+
+    HttpOperation::ptr_t op = std::make_shared<HttpOpSetPriority>(std::move(priorities));
+    op->setReplyPath(mReplyQueue, user_handler);
+    if (! (status = mRequestQueue->addOp(op)))          // transfers refcount
+    {
+        mLastReqStatus = status;
+        return LLCORE_HTTP_HANDLE_INVALID;
+    }
+
+    mLastReqStatus = status;
+    return op->getHandle();
+}
+// </FS>
+
+
 // ====================================
 // Utility Methods
 // ====================================
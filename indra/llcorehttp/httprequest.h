@@ -34,6 +34,9 @@
 #include "httpheaders.h"
 #include "httpoptions.h"
 
+#include <utility>      // <FS/> Request priorities
+#include <vector>       // <FS/> Request priorities
+
 namespace LLCore
 {
 
@@ -96,6 +99,17 @@ private:
 public:
     typedef unsigned int policy_t;
 
+    // <FS> Request priorities
+    /// Requests waiting for a connection are issued highest priority
+    /// first and in order of arrival among equal priorities.  All
+    /// requests start at DEFAULT_PRIORITY so, unless priorities are
+    /// changed, service is first-come-first-served.
+    typedef float priority_t;
+    static constexpr priority_t DEFAULT_PRIORITY = 0.f;
+
+    typedef std::vector<std::pair<HttpHandle, priority_t> > priority_list_t;
+    // </FS>
+
     typedef std::shared_ptr<HttpRequest> ptr_t;
     typedef std::weak_ptr<HttpRequest>   wptr_t;
 public:
@@ -232,6 +246,24 @@ public:
         /// Global only
         PO_SSL_VERIFY_CALLBACK,
 
+        // <FS> HTTP/2 multiplexing
+        /// If greater than 0, requests in this class ask for HTTP/2
+        /// over TLS and are multiplexed as concurrent streams on a
+        /// shared connection.  Value gives the maximum number of
+        /// concurrent streams per connection.  Servers that don't
+        /// negotiate HTTP/2 are spoken to with HTTP/1.1 as before.
+        ///
+        /// When set, this takes precedence over PO_PIPELINING_DEPTH.
+        /// A host may have up to PO_PER_HOST_CONNECTION_LIMIT times
+        /// this value requests in flight and the class as a whole
+        /// up to PO_CONNECTION_LIMIT times this value.  Requests for
+        /// a host that is at its budget wait on the ready queue so
+        /// they don't hold up requests for other hosts.
+        ///
+        /// Per-class only
+        PO_HTTP2_STREAM_LIMIT,
+        // </FS>
+
         PO_LAST  // Always at end
     };
 
@@ -575,6 +607,26 @@ public:
 
     HttpHandle requestCancel(HttpHandle request, HttpHandler::ptr_t);
 
+    // <FS> Request priorities
+    /// Queue a batch of priority changes for previously issued
+    /// requests.  Requests still waiting for a connection are
+    /// reordered immediately, each in O(log n) time.  Requests
+    /// that are already active, waiting to retry or finished are
+    /// skipped.  The operation completes with HE_HANDLE_NOT_FOUND
+    /// only if none of the handles was waiting.
+    ///
+    /// Send changes for many requests in one call rather than one
+    /// call per request; each call is a trip through the request
+    /// queue.
+    ///
+    /// @param  priorities      Handle and new priority pairs.  Taken
+    ///                         by value and moved into the request.
+    /// @param  handler         @see requestGet().  May be empty.
+    /// @return                 "
+    ///
+    HttpHandle requestSetPriorities(priority_list_t priorities, HttpHandler::ptr_t handler);
+    // </FS>
+
     /// @}
 
     /// @name UtilityMethods
@@ -27,6 +27,9 @@
 #include "httpstats.h"
 #include "llerror.h"
 
+#include <curl/curl.h>          // <FS/> HTTP/2 multiplexing
+#include <algorithm>            // <FS/> HTTP/2 multiplexing
+
 namespace LLCore
 {
 HTTPStats::HTTPStats()
@@ -45,6 +48,14 @@ void HTTPStats::resetStats()
     mDataDown.reset();
     mDataUp.reset();
     mRequests = 0;
+
+    // <FS> HTTP/2 multiplexing
+    mHttp1Transfers = 0;
+    mHttp2Transfers = 0;
+    mNewConnections = 0;
+    mHostDeferrals = 0;
+    std::fill_n(mLatency, LATENCY_BUCKETS, 0);
+    // </FS>
 }
 
 
@@ -61,6 +72,52 @@ void HTTPStats::recordResultCode(S32 code)
 
 }
 
+// <FS> HTTP/2 multiplexing
+void HTTPStats::recordTransfer(long http_version, long new_connections, F64 seconds)
+{
+    if (http_version >= CURL_HTTP_VERSION_2_0)
+    {
+        ++mHttp2Transfers;
+    }
+    else
+    {
+        ++mHttp1Transfers;
+    }
+    mNewConnections += (S32)new_connections;
+
+    U64 ms = (U64)llmax(seconds * 1000.0, 0.0);
+    S32 bucket(0);
+    while (ms && bucket < LATENCY_BUCKETS - 1)
+    {
+        ms >>= 1;
+        ++bucket;
+    }
+    ++mLatency[bucket];
+}
+
+
+F32 HTTPStats::getLatencyPercentile(F32 fraction) const
+{
+    const S32 total(getTransferCount());
+    if (! total)
+    {
+        return 0.f;
+    }
+
+    const S32 wanted = llmax(1, (S32)ceilf(llclamp(fraction, 0.f, 1.f) * total));
+    S32 seen(0);
+    for (S32 bucket(0); bucket < LATENCY_BUCKETS; ++bucket)
+    {
+        seen += mLatency[bucket];
+        if (seen >= wanted)
+        {
+            return (F32)(1U << bucket);
+        }
+    }
+    return (F32)(1U << (LATENCY_BUCKETS - 1));
+}
+// </FS>
+
 namespace
 {
     std::string byte_count_converter(F32 bytes)
@@ -101,6 +158,16 @@ void HTTPStats::dumpStats()
         out << (*it).first << " " << (*it).second << std::endl;
     }
 
+    // <FS> HTTP/2 multiplexing
+    out << std::endl;
+    out << "Transfers: " << getTransferCount() << " (HTTP/2: " << mHttp2Transfers
+        << ", HTTP/1.x: " << mHttp1Transfers << ")" << std::endl;
+    out << "New connections: " << mNewConnections << std::endl;
+    out << "Deferred for host budget: " << mHostDeferrals << std::endl;
+    out << "Latency p50: <" << getLatencyPercentile(0.5f) << "mS"
+        << "  p99: <" << getLatencyPercentile(0.99f) << "mS" << std::endl;
+    // </FS>
+
     LL_WARNS("HTTPCore") << out.str() << LL_ENDL;
 }
 
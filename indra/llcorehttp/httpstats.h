@@ -59,6 +59,27 @@ namespace LLCore
 
         void    recordResultCode(S32 code);
 
+        // <FS> HTTP/2 multiplexing
+        /// Record a finished transfer.  http_version is a
+        /// CURL_HTTP_VERSION_* value (0 if unknown), new_connections
+        /// the number of connections libcurl had to open for it and
+        /// seconds its total time including any time spent queued
+        /// in libcurl.
+        void    recordTransfer(long http_version, long new_connections, F64 seconds);
+
+        void    recordHostDeferral() { ++mHostDeferrals; }
+
+        S32     getHttp2Transfers() const { return mHttp2Transfers; }
+        S32     getTransferCount() const { return mHttp1Transfers + mHttp2Transfers; }
+        S32     getNewConnections() const { return mNewConnections; }
+        S32     getHostDeferrals() const { return mHostDeferrals; }
+
+        /// Upper bound in milliseconds of the latency below which
+        /// the given fraction (0..1) of recorded transfers fell.
+        /// Resolution is one power of two.
+        F32     getLatencyPercentile(F32 fraction) const;
+        // </FS>
+
         void    dumpStats();
     private:
         StatsAccumulator mDataDown;
@@ -67,6 +88,18 @@ namespace LLCore
         S32              mRequests;
 
         std::map<S32, S32> mResutCodes;
+
+        // <FS> HTTP/2 multiplexing
+        // Bucket 0 holds transfers under 1mS, bucket n those
+        // from 2^(n-1) up to 2^n mS.  The last bucket is open.
+        static constexpr S32 LATENCY_BUCKETS = 24;
+
+        S32              mHttp1Transfers;
+        S32              mHttp2Transfers;
+        S32              mNewConnections;
+        S32              mHostDeferrals;
+        S32              mLatency[LATENCY_BUCKETS];
+        // </FS>
     };
 
 
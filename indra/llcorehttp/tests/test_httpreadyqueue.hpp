@@ -0,0 +1,249 @@
+/**
+ * @file test_httpreadyqueue.hpp
+ * @brief unit tests for the LLCore::HttpReadyQueue class
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+#ifndef TEST_LLCORE_HTTP_READYQUEUE_H_
+#define TEST_LLCORE_HTTP_READYQUEUE_H_
+
+#include "_httpreadyqueue.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace LLCore;
+
+
+
+namespace tut
+{
+
+struct HttpReadyqueueTestData
+{
+    // the test objects inherit from this so the member functions and variables
+    // can be referenced directly inside of the test functions.
+    typedef std::vector<HttpOpRequest::ptr_t> op_list_t;
+
+    op_list_t makeOps(size_t count)
+        {
+            op_list_t ops;
+            ops.reserve(count);
+            for (size_t i(0); i < count; ++i)
+            {
+                ops.push_back(std::make_shared<HttpOpRequest>());
+            }
+            return ops;
+        }
+
+    // Service order the queue promises:  priority, then arrival.
+    static bool serviceOrder(const HttpOpRequest::ptr_t & a, const HttpOpRequest::ptr_t & b)
+        {
+            if (a->mPolicyPriority != b->mPolicyPriority)
+            {
+                return a->mPolicyPriority > b->mPolicyPriority;
+            }
+            return a->mPolicySequence < b->mPolicySequence;
+        }
+
+    op_list_t drain(HttpReadyQueue & queue)
+        {
+            op_list_t out;
+            while (! queue.empty())
+            {
+                out.push_back(queue.top());
+                queue.pop();
+            }
+            return out;
+        }
+};
+
+typedef test_group<HttpReadyqueueTestData> HttpReadyqueueTestGroupType;
+typedef HttpReadyqueueTestGroupType::object HttpReadyqueueTestObjectType;
+HttpReadyqueueTestGroupType HttpReadyqueueTestGroup("HttpReadyqueue Tests");
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<1>()
+{
+    set_test_name("HttpReadyQueue is first-come-first-served without priorities");
+
+    HttpReadyQueue queue;
+    op_list_t ops(makeOps(100));
+    for (size_t i(0); i < ops.size(); ++i)
+    {
+        queue.push(ops[i]);
+    }
+    ensure_equals("All queued", queue.size(), ops.size());
+
+    op_list_t out(drain(queue));
+    ensure("Served in arrival order", out == ops);
+    for (size_t i(0); i < ops.size(); ++i)
+    {
+        ensure("Off the queue", ops[i]->mPolicyReadyIndex == HttpReadyQueue::npos);
+    }
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<2>()
+{
+    set_test_name("HttpReadyQueue reprioritize and erase");
+
+    HttpReadyQueue queue;
+    op_list_t ops(makeOps(8));
+    for (size_t i(0); i < ops.size(); ++i)
+    {
+        queue.push(ops[i]);
+    }
+
+    ensure("Raise last", queue.reprioritize(ops[7], 10.f));
+    ensure("Raise middle", queue.reprioritize(ops[3], 5.f));
+    ensure("Lower first", queue.reprioritize(ops[0], -1.f));
+    ensure("Erase one", queue.erase(ops[5]));
+    ensure("Can't erase twice", ! queue.erase(ops[5]));
+    ensure("Erased op isn't queued", ! queue.contains(ops[5]));
+    ensure("Can't reprioritize an op that isn't queued", ! queue.reprioritize(ops[5], 100.f));
+    ensure("Failed reprioritize leaves priority alone", ops[5]->mPolicyPriority == HttpRequest::DEFAULT_PRIORITY);
+
+    op_list_t out(drain(queue));
+    op_list_t expected;
+    expected.push_back(ops[7]);
+    expected.push_back(ops[3]);
+    expected.push_back(ops[1]);
+    expected.push_back(ops[2]);
+    expected.push_back(ops[4]);
+    expected.push_back(ops[6]);
+    expected.push_back(ops[0]);
+    ensure("Served by priority then arrival", out == expected);
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<3>()
+{
+    set_test_name("HttpReadyQueue keeps arrival order when an op is pushed back");
+
+    HttpReadyQueue queue;
+    op_list_t ops(makeOps(5));
+    for (size_t i(0); i < ops.size(); ++i)
+    {
+        queue.push(ops[i]);
+    }
+
+    // As HttpPolicy does when a host is over its budget
+    HttpOpRequest::ptr_t first(queue.top());
+    queue.pop();
+    HttpOpRequest::ptr_t second(queue.top());
+    queue.pop();
+    queue.push(second);
+    queue.push(first);
+
+    ensure("Original order restored", drain(queue) == ops);
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<4>()
+{
+    set_test_name("HttpReadyQueue random operations against a sorted reference");
+
+    std::mt19937 random(0x4ea9);
+    std::uniform_int_distribution<int> priority(0, 20);
+
+    HttpReadyQueue queue;
+    op_list_t ops(makeOps(2000));
+    op_list_t queued;
+
+    for (int step(0); step < 20000; ++step)
+    {
+        const int action(random() % 10);
+        if (action < 4 || queued.empty())
+        {
+            // push an op that isn't queued
+            HttpOpRequest::ptr_t op(ops[random() % ops.size()]);
+            if (! queue.contains(op))
+            {
+                queue.push(op);
+                queued.push_back(op);
+            }
+        }
+        else if (action < 7)
+        {
+            HttpOpRequest::ptr_t op(queued[random() % queued.size()]);
+            ensure("Queued op reprioritized", queue.reprioritize(op, (HttpRequest::priority_t) priority(random)));
+        }
+        else if (action < 9)
+        {
+            const size_t index(random() % queued.size());
+            ensure("Queued op erased", queue.erase(queued[index]));
+            queued.erase(queued.begin() + index);
+        }
+        else
+        {
+            HttpOpRequest::ptr_t expected(*std::min_element(queued.begin(), queued.end(), serviceOrder));
+            ensure("Top is the first op in service order", queue.top() == expected);
+            queue.pop();
+            queued.erase(std::find(queued.begin(), queued.end(), expected));
+        }
+        ensure_equals("Sizes agree", queue.size(), queued.size());
+    }
+
+    std::sort(queued.begin(), queued.end(), serviceOrder);
+    ensure("Drains in service order", drain(queue) == queued);
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<5>()
+{
+    set_test_name("HttpReadyQueue reprioritization of a full queue");
+
+    const size_t QUEUED(50000);
+    const int ROUNDS(10);
+    const size_t CHANGES(5000);         // priority changes per frame
+
+    std::mt19937 random(0xbe7c);
+    std::uniform_real_distribution<float> priority(0.f, 1024.f * 1024.f);
+
+    HttpReadyQueue queue;
+    op_list_t ops(makeOps(QUEUED));
+
+    for (size_t i(0); i < ops.size(); ++i)
+    {
+        queue.push(ops[i]);
+    }
+
+    for (int round(0); round < ROUNDS; ++round)
+    {
+        for (size_t i(0); i < CHANGES; ++i)
+        {
+            queue.reprioritize(ops[random() % ops.size()], priority(random));
+        }
+        ensure_equals("Nothing lost", queue.size(), QUEUED);
+    }
+
+    op_list_t out(drain(queue));
+
+    ensure_equals("Everything drained", out.size(), QUEUED);
+    ensure("Drained in service order", std::is_sorted(out.begin(), out.end(), serviceOrder));
+}
+
+}  // end namespace tut
+
+#endif  // TEST_LLCORE_HTTP_READYQUEUE_H_
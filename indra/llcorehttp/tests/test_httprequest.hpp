@@ -34,6 +34,10 @@
 #include "httpoptions.h"
 #include "_httpservice.h"
 #include "_httprequestqueue.h"
+#include "_httppolicyclass.h"
+#include "_httplibcurl.h"
+#include "_httpoprequest.h"
+#include "httpstats.h"
 
 #include <curl/curl.h>
 #include <boost/regex.hpp>
@@ -3043,6 +3047,172 @@ void HttpRequestTestObjectType::test<23>()
 }
 
 
+template <> template <>
+void HttpRequestTestObjectType::test<24>()
+{
+    set_test_name("HTTP/2 stream limit policy option");
+
+    HttpPolicyClass options;
+    long value(-1L);
+
+    ensure("Stream limit is a class option", bool(options.get(HttpRequest::PO_HTTP2_STREAM_LIMIT, &value)));
+    ensure_equals("HTTP/2 is off by default", value, 0L);
+    ensure("Default class doesn't use HTTP/2", ! options.useHttp2());
+    ensure_equals("No host budget without HTTP/2", options.getHostActiveLimit(), 0L);
+
+    options.set(HttpRequest::PO_CONNECTION_LIMIT, 16L);
+    options.set(HttpRequest::PO_PER_HOST_CONNECTION_LIMIT, 2L);
+    options.set(HttpRequest::PO_PIPELINING_DEPTH, 5L);
+    ensure_equals("Pipelined active limit", options.getActiveLimit(), 10L);
+
+    ensure("Stream limit accepted", bool(options.set(HttpRequest::PO_HTTP2_STREAM_LIMIT, 32L)));
+    ensure("Class uses HTTP/2", options.useHttp2());
+    ensure_equals("HTTP/2 active limit", options.getActiveLimit(), 16L * 32L);
+    ensure_equals("HTTP/2 host budget", options.getHostActiveLimit(), 2L * 32L);
+
+    options.set(HttpRequest::PO_HTTP2_STREAM_LIMIT, 100000L);
+    options.get(HttpRequest::PO_HTTP2_STREAM_LIMIT, &value);
+    ensure_equals("Stream limit clamped high", value, 100L);
+    options.set(HttpRequest::PO_HTTP2_STREAM_LIMIT, -4L);
+    options.get(HttpRequest::PO_HTTP2_STREAM_LIMIT, &value);
+    ensure_equals("Stream limit clamped low", value, 0L);
+
+    HttpPolicyClass copy(options);
+    options.set(HttpRequest::PO_HTTP2_STREAM_LIMIT, 8L);
+    copy = options;
+    ensure_equals("Stream limit copied", copy.mHttp2StreamLimit, 8L);
+
+    ensure_equals("Host key drops path",
+                  HttpLibcurl::getHostKey("https://Asset-CDN.example.com:443/texture/?id=1"),
+                  std::string("https://asset-cdn.example.com:443"));
+    ensure_equals("Host key drops query",
+                  HttpLibcurl::getHostKey("http://127.0.0.1:8000?x=1"),
+                  std::string("http://127.0.0.1:8000"));
+    ensure("Host key keeps scheme",
+           HttpLibcurl::getHostKey("http://example.com/") != HttpLibcurl::getHostKey("https://example.com/"));
+
+    HttpOpRequest::ptr_t op(new HttpOpRequest());
+    op->setupGet(0U, "https://Asset-CDN.example.com/texture/?id=2", HttpOptions::ptr_t(), HttpHeaders::ptr_t());
+    ensure_equals("Host key kept with the request",
+                  op->mReqHostKey, std::string("https://asset-cdn.example.com"));
+}
+
+template <> template <>
+void HttpRequestTestObjectType::test<25>()
+{
+    ScopedCurlInit ready;
+
+    set_test_name("HttpRequest small range GETs on an HTTP/2 class");
+
+    // The test peer only speaks HTTP/1.1 so by default this exercises
+    // the HTTP/2 policy class falling back to HTTP/1.1.  Point
+    // LL_HTTP2_TEST_URL at an https resource on a local HTTP/2 server
+    // (nghttpd, caddy, etc.) to check multiplexing.
+    const char * h2_url(getenv("LL_HTTP2_TEST_URL"));
+    const std::string url(h2_url ? h2_url : get_base_url());
+    const int request_count(2000);
+    const size_t range_size(h2_url ? 64 : 0);
+
+    TestHandler2 handler(this, "handler");
+    LLCore::HttpHandler::ptr_t handlerp(&handler, NoOpDeletor);
+    mHandlerCalls = 0;
+
+    HttpRequest * req = NULL;
+    HttpOptions::ptr_t opts;
+
+    try
+    {
+        // Get singletons created
+        HttpRequest::createService();
+
+        HttpRequest::policy_t policy_class(HttpRequest::createPolicyClass());
+        ensure("Policy class created", policy_class != HttpRequest::INVALID_POLICY_ID);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_CONNECTION_LIMIT, policy_class, 8L, NULL);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_PER_HOST_CONNECTION_LIMIT, policy_class, 2L, NULL);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_HTTP2_STREAM_LIMIT, policy_class, 32L, NULL);
+
+        HttpRequest::startThread();
+
+        req = new HttpRequest();
+
+        opts = HttpOptions::ptr_t(new HttpOptions());
+        opts->setRetries(0);
+        opts->setSSLVerifyPeer(false);
+        opts->setSSLVerifyHost(false);
+
+        mStatus = HttpStatus(h2_url ? 206 : 200);
+        for (int i(0); i < request_count; ++i)
+        {
+            HttpHandle handle = req->requestGetByteRange(policy_class,
+                                                         url,
+                                                         range_size * (i % 64),
+                                                         range_size,
+                                                         opts,
+                                                         HttpHeaders::ptr_t(),
+                                                         handlerp);
+            ensure("Valid handle returned for ranged request", handle != LLCORE_HTTP_HANDLE_INVALID);
+        }
+
+        // Run the notification pump.
+        int count(0);
+        int limit(LOOP_COUNT_LONG);
+        while (count++ < limit && mHandlerCalls < request_count)
+        {
+            req->update(0);
+            usleep(1000);
+        }
+        ensure("Requests executed in reasonable time", count < limit);
+        ensure_equals("One handler invocation per request", mHandlerCalls, request_count);
+
+        // Okay, request a shutdown of the servicing thread
+        mStatus = HttpStatus();
+        mHandlerCalls = 0;
+        HttpHandle handle = req->requestStopThread(handlerp);
+        ensure("Valid handle returned for stop request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        count = 0;
+        limit = LOOP_COUNT_LONG;
+        while (count++ < limit && mHandlerCalls < 1)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Stop request executed in reasonable time", count < limit);
+
+        count = 0;
+        limit = LOOP_COUNT_SHORT;
+        while (count++ < limit && ! HttpService::isStopped())
+        {
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Thread actually stopped running", HttpService::isStopped());
+
+        // Worker is gone, stats are safe to read
+        const HTTPStats & stats(HTTPStats::instance());
+        ensure_equals("Every transfer recorded", stats.getTransferCount(), request_count);
+        ensure("Connections were reused", stats.getNewConnections() < request_count);
+        if (h2_url)
+        {
+            ensure_equals("Every transfer used HTTP/2", stats.getHttp2Transfers(), request_count);
+        }
+
+        opts.reset();
+
+        delete req;
+        req = NULL;
+
+        HttpRequest::destroyService();
+    }
+    catch (...)
+    {
+        stop_thread(req);
+        opts.reset();
+        delete req;
+        HttpRequest::destroyService();
+        throw;
+    }
+}
+
 }  // end namespace tut
 
 namespace
@@ -23,7 +23,87 @@
  * $/LicenseInfo$
  */
 #include "stdtypes.h"
+// <FS> Octree node pool
+#include "linden_common.h"
+#include "lloctree.h"
+// </FS>
 
 U32 gOctreeMaxCapacity;
 F32 gOctreeMinSize;
 
+// <FS> Octree node pool
+LLOctreeNodePool::LLOctreeNodePool(size_t block_size)
+    : mBlockSize((llmax(block_size, sizeof(Block)) + 15) & ~(size_t)15),
+      mFree(NULL),
+      mAllocated(0)
+{
+}
+
+LLOctreeNodePool::~LLOctreeNodePool()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mAllocated)
+    {
+        // blocks still out there: leave them be
+        return;
+    }
+    for (void* chunk : mChunks)
+    {
+        ll_aligned_free_16(chunk);
+    }
+}
+
+void* LLOctreeNodePool::allocate()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mFree)
+    {
+        U8* chunk = (U8*)ll_aligned_malloc_16(mBlockSize * BLOCKS_PER_CHUNK);
+        if (!chunk)
+        {
+            LLError::LLUserWarningMsg::showOutOfMemory();
+            LL_ERRS() << "Out of memory allocating octree nodes" << LL_ENDL;
+        }
+        mChunks.push_back(chunk);
+        // the first block of the chunk ends up at the head of the list
+        for (S32 i = BLOCKS_PER_CHUNK - 1; i >= 0; --i)
+        {
+            Block* block = (Block*)(chunk + i * mBlockSize);
+            block->mNext = mFree;
+            mFree = block;
+        }
+    }
+
+    Block* block = mFree;
+    mFree = block->mNext;
+    ++mAllocated;
+    return block;
+}
+
+void LLOctreeNodePool::free(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Block* block = (Block*)ptr;
+    block->mNext = mFree;
+    mFree = block;
+    --mAllocated;
+}
+
+U32 LLOctreeNodePool::getAllocated() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocated;
+}
+
+U32 LLOctreeNodePool::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return (U32)mChunks.size() * BLOCKS_PER_CHUNK;
+}
+// </FS>
+
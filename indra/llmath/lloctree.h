@@ -30,6 +30,7 @@
 #include "lltreenode.h"
 #include "v3math.h"
 #include "llvector4a.h"
+#include <mutex> // <FS/> Octree node pool
 #include <vector>
 
 #include "nd/ndoctreelog.h"
@@ -59,6 +60,47 @@ extern float gOctreeMinSize;
 // the tree.
 template <class T, typename T_PTR> class LLOctreeNode;
 
+// <FS> Octree node pool
+//-----------------------------------------------------------------------------
+// class LLOctreeNodePool
+//
+// Spatial partitions make and delete octree nodes by the thousand as
+// drawables move about and the trees rebalance. Each node type gets a pool of
+// fixed size blocks carved out of chunks, so that making or deleting a node
+// is a free list pop or push rather than a trip to the heap. Chunks are kept
+// for as long as the pool lives, and pools live as long as the process.
+//
+// Thread safe: volume octrees are built off the main thread.
+//-----------------------------------------------------------------------------
+class LLOctreeNodePool
+{
+public:
+    static constexpr U32 BLOCKS_PER_CHUNK = 64;
+
+    LLOctreeNodePool(size_t block_size);
+    ~LLOctreeNodePool();
+
+    void* allocate();
+    void free(void* block);
+
+    size_t getBlockSize() const     { return mBlockSize; }
+    U32 getAllocated() const;       // blocks handed out
+    U32 getCapacity() const;        // blocks in all chunks
+
+private:
+    struct Block
+    {
+        Block* mNext;
+    };
+
+    mutable std::mutex mMutex;
+    const size_t mBlockSize;        // rounded up to keep blocks 16 byte aligned
+    Block* mFree;
+    std::vector<void*> mChunks;
+    U32 mAllocated;
+};
+// </FS>
+
 template <class T, typename T_PTR>
 class LLOctreeListener: public LLTreeListener<T>
 {
@@ -88,7 +130,44 @@ public:
 template <class T, typename T_PTR>
 class alignas(16) LLOctreeNode : public LLTreeNode<T>
 {
-    LL_ALIGN_NEW
+    // <FS> Octree node pool
+    //LL_ALIGN_NEW
+public:
+    // Nodes, and roots of the same size, come out of the pool of their type
+    void* operator new(size_t size)
+    {
+        return size == sizeof(oct_node) ? getNodePool().allocate() : ll_aligned_malloc_16(size);
+    }
+
+    void operator delete(void* ptr, size_t size)
+    {
+        if (size == sizeof(oct_node))
+        {
+            getNodePool().free(ptr);
+        }
+        else
+        {
+            ll_aligned_free_16(ptr);
+        }
+    }
+
+    void* operator new[](size_t size)
+    {
+        return ll_aligned_malloc_16(size);
+    }
+
+    void operator delete[](void* ptr)
+    {
+        ll_aligned_free_16(ptr);
+    }
+
+    static LLOctreeNodePool& getNodePool()
+    {
+        // never deleted: nodes of static trees may outlive any static pool
+        static LLOctreeNodePool* pool = new LLOctreeNodePool(sizeof(oct_node));
+        return *pool;
+    }
+    // </FS>
 public:
 
     typedef LLOctreeTraveler<T, T_PTR>                          oct_traveler;
@@ -114,7 +193,9 @@ public:
                     BaseType* parent,
                     U8 octant = NO_CHILD_NODES)
     :   mParent((oct_node*)parent),
-        mOctant(octant)
+        mOctant(octant),
+        mEmptyBranch(false), // <FS/> Octree node pool
+        mBatchDepth(0) // <FS/> Octree node pool
     {
         llassert(size[0] >= gOctreeMinSize*0.5f);
 
@@ -610,6 +691,13 @@ public:
         if( mChildCount >= 8 )
             LL_ERRS() << "Octree overrun" << LL_ENDL;
 
+        // <FS> Octree node pool
+        if (child->mEmptyBranch)
+        {
+            markEmptyBranch();
+        }
+        // </FS>
+
         mChildMap[child->getOctant()] = mChildCount;
 
         mChild[mChildCount] = child;
@@ -660,7 +748,14 @@ public:
         if (getChildCount() == 0 && getElementCount() == 0)
         {
             oct_node* parent = getOctParent();
-            if (parent)
+            // <FS> Octree node pool
+            //if (parent)
+            if (parent && isCollapseDeferred())
+            {
+                markEmptyBranch();
+            }
+            else if (parent)
+            // </FS>
             {
                 parent->deleteChild(this);
             }
@@ -681,6 +776,91 @@ public:
         OCT_ERRS << "Octree failed to delete requested child." << LL_ENDL;
     }
 
+    // <FS> Octree node pool
+    // Between beginBatch() and endBatch() on the root, nodes left empty by
+    // removals are kept rather than deleted, so that elements moving about
+    // land in the nodes they left instead of new ones made for them. The
+    // empty branches are deleted once, when the outermost batch ends.
+    void beginBatch()
+    {
+        llassert(!mParent);
+        ++mBatchDepth;
+    }
+
+    void endBatch()
+    {
+        llassert(!mParent);
+        if (mBatchDepth == 0)
+        {
+            OCT_ERRS << "Octree batch ended without being begun." << LL_ENDL;
+            return;
+        }
+        if (mBatchDepth == 1 && mEmptyBranch)
+        {
+            pruneEmpty();
+        }
+        --mBatchDepth;
+    }
+
+    bool isCollapseDeferred() const
+    {
+        const oct_node* node = this;
+        while (node->mParent)
+        {
+            node = node->mParent;
+        }
+        return node->mBatchDepth > 0;
+    }
+
+    // Inserts or removes a range of T*, in one batch. Call on the root.
+    template <typename ITER>
+    void insertBatch(ITER begin, ITER end)
+    {
+        beginBatch();
+        for (; begin != end; ++begin)
+        {
+            insert(*begin);
+        }
+        endBatch();
+    }
+
+    template <typename ITER>
+    void removeBatch(ITER begin, ITER end)
+    {
+        beginBatch();
+        for (; begin != end; ++begin)
+        {
+            remove(*begin);
+        }
+        endBatch();
+    }
+
+    // Flags the way from the root down to a node left empty in a batch, so
+    // that pruning only goes where nodes were emptied
+    void markEmptyBranch()
+    {
+        for (oct_node* node = this; node && !node->mEmptyBranch; node = node->mParent)
+        {
+            node->mEmptyBranch = true;
+        }
+    }
+
+    // Deletes the empty branches under this node, deepest first. True if
+    // this node is left empty as well.
+    bool pruneEmpty()
+    {
+        mEmptyBranch = false;
+        for (S32 i = (S32)getChildCount() - 1; i >= 0; --i)
+        {
+            if (mChild[i]->mEmptyBranch && mChild[i]->pruneEmpty())
+            {
+                removeChild(i, true);
+            }
+        }
+        return getChildCount() == 0 && getElementCount() == 0;
+    }
+    // </FS>
+
 protected:
     typedef enum
     {
@@ -697,10 +877,12 @@ protected:
 
     oct_node* mParent;
     U8 mOctant;
+    bool mEmptyBranch; // <FS/> Octree node pool, see markEmptyBranch()
 
     oct_node* mChild[8];
     U8 mChildMap[8];
     U32 mChildCount;
+    U32 mBatchDepth; // <FS/> Octree node pool, root only
 
     element_list mData;
 };
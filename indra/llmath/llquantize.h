@@ -86,6 +86,63 @@ inline F32 U16_to_F32(U16 ival, F32 lower, F32 upper)
 }
 
 
+// Four lanes of U16_to_F32(), with the same operation order so the results are
+// bit-identical to the scalar version.
+inline __m128 U16_to_F32_4(__m128i ival, __m128 lower, __m128 upper)
+{
+    const __m128 oou16max = _mm_load_ps(F_OOU16MAX_4A);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+    __m128 val = _mm_mul_ps(_mm_cvtepi32_ps(ival), oou16max);
+    __m128 delta = _mm_sub_ps(upper, lower);
+    val = _mm_mul_ps(val, delta);
+    val = _mm_add_ps(val, lower);
+
+    __m128 max_error = _mm_mul_ps(delta, oou16max);
+
+    // make sure that zero's come through as zero
+    __m128 is_zero = _mm_cmplt_ps(_mm_and_ps(val, abs_mask), max_error);
+    return _mm_andnot_ps(is_zero, val);
+}
+
+// Dequantize count values that share one range.
+inline void U16s_to_F32s(const U16 *ival, F32 *out, S32 count, F32 lower, F32 upper)
+{
+    const __m128 lower4 = _mm_set1_ps(lower);
+    const __m128 upper4 = _mm_set1_ps(upper);
+    const __m128i zero = _mm_setzero_si128();
+
+    S32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i packed = _mm_loadl_epi64((const __m128i*)(ival + i));
+        _mm_storeu_ps(out + i, U16_to_F32_4(_mm_unpacklo_epi16(packed, zero), lower4, upper4));
+    }
+    for (; i < count; i++)
+    {
+        out[i] = U16_to_F32(ival[i], lower, upper);
+    }
+}
+
+// Dequantize count values, each with its own range, e.g. a whole terse object
+// update (position, velocity, acceleration, rotation, angular velocity) at once.
+inline void U16s_to_F32s(const U16 *ival, F32 *out, S32 count, const F32 *lower, const F32 *upper)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    S32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i packed = _mm_loadl_epi64((const __m128i*)(ival + i));
+        _mm_storeu_ps(out + i, U16_to_F32_4(_mm_unpacklo_epi16(packed, zero),
+                                            _mm_loadu_ps(lower + i), _mm_loadu_ps(upper + i)));
+    }
+    for (; i < count; i++)
+    {
+        out[i] = U16_to_F32(ival[i], lower[i], upper[i]);
+    }
+}
+
 inline U8 F32_to_U8_ROUND(F32 val, F32 lower, F32 upper)
 {
     val = llclamp(val, lower, upper);
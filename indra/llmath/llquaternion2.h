@@ -84,6 +84,15 @@ public:
     // Quantize this quaternion to 16 bit precision
     inline void quantize16();
 
+    // <FS> Keyframe curve evaluation
+    // Set this quaternion to nlerp(t, p, q) (see llquaternion.h); the result
+    // is bit for bit what the LLQuaternion version returns.
+    inline void setNlerp(F32 t, const LLQuaternion2& p, const LLQuaternion2& q);
+
+    // Set this quaternion to slerp(t, p, q), matching the LLQuaternion version
+    inline void setSlerp(F32 t, const LLQuaternion2& p, const LLQuaternion2& q);
+    // </FS>
+
     /////////////////////////
     // Quaternion inspection
     /////////////////////////
@@ -98,6 +107,12 @@ public:
 
 protected:
 
+    // <FS> Keyframe curve evaluation
+    // 4D dot product summed in x, y, z, w order like the LLQuaternion code,
+    // rather than pairwise like LLVector4a::dot4()
+    static inline LLSimdScalar dotInOrder(const LLVector4a& a, const LLVector4a& b);
+    // </FS>
+
     LLVector4a mQ;
 
 };
@@ -81,6 +81,90 @@ inline void LLQuaternion2::quantize16()
     normalize();
 }
 
+// <FS> Keyframe curve evaluation
+// Set this quaternion to nlerp(t, p, q): the normalized lerp, or the slerp
+// when p and q are more than 90 degrees apart
+inline void LLQuaternion2::setNlerp(F32 t, const LLQuaternion2& p, const LLQuaternion2& q)
+{
+    if (dotInOrder(p.mQ, q.mQ).getF32() < 0.f)
+    {
+        setSlerp(t, p, q);
+        return;
+    }
+
+    LLVector4a inv_t_p;
+    inv_t_p.splat(1.f - t);
+    inv_t_p.mul(p.mQ);
+    mQ.splat(t);
+    mQ.mul(q.mQ);
+    mQ.add(inv_t_p);
+
+    // LLQuaternion::normalize(), which leaves nearly unit quaternions alone
+    F32 mag = LLSimdScalar(_mm_sqrt_ss(dotInOrder(mQ, mQ))).getF32();
+    if (mag > FP_MAG_THRESHOLD)
+    {
+        if (fabs(1.f - mag) > ONE_PART_IN_A_MILLION)
+        {
+            mQ.mul(1.f / mag);
+        }
+    }
+    else
+    {
+        mQ.set(0.f, 0.f, 0.f, 1.f);
+    }
+}
+
+// Set this quaternion to slerp(t, p, q)
+inline void LLQuaternion2::setSlerp(F32 t, const LLQuaternion2& p, const LLQuaternion2& q)
+{
+    F32 cos_t = dotInOrder(p.mQ, q.mQ).getF32();
+
+    // if q is on opposite hemisphere from p, use -p instead
+    bool flip = false;
+    if (cos_t < 0.0f)
+    {
+        cos_t = -cos_t;
+        flip = true;
+    }
+
+    F32 alpha;
+    F32 beta;
+    if (1.0f - cos_t < 0.00001f)
+    {
+        beta = 1.0f - t;
+        alpha = t;
+    }
+    else
+    {
+        F32 theta = acosf(cos_t);
+        F32 sin_t = sinf(theta);
+        beta = sinf(theta - t*theta) / sin_t;
+        alpha = sinf(t*theta) / sin_t;
+    }
+
+    if (flip)
+    {
+        beta = -beta;
+    }
+
+    LLVector4a beta_p;
+    beta_p.splat(beta);
+    beta_p.mul(p.mQ);
+    mQ.splat(alpha);
+    mQ.mul(q.mQ);
+    mQ.setAdd(beta_p, mQ);
+}
+
+// static
+inline LLSimdScalar LLQuaternion2::dotInOrder(const LLVector4a& a, const LLVector4a& b)
+{
+    const LLQuad ab = _mm_mul_ps(a, b);
+    const LLQuad y = _mm_shuffle_ps(ab, ab, _MM_SHUFFLE(1, 1, 1, 1));
+    const LLQuad z = _mm_shuffle_ps(ab, ab, _MM_SHUFFLE(2, 2, 2, 2));
+    const LLQuad w = _mm_shuffle_ps(ab, ab, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_add_ss(_mm_add_ss(_mm_add_ss(ab, y), z), w);
+}
+// </FS>
 
 /////////////////////////
 // Quaternion inspection
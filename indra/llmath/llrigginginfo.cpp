@@ -159,3 +159,37 @@ void LLJointRiggingInfoTab::merge(const LLJointRiggingInfoTab& src)
     //showDetails(*this, "output this");
 
 }
+
+// <FS> Shared rigging info cache
+void LLJointRiggingInfoTab::addRiggedVertices(const LLVector4a* positions, const LLVector4a* weights, S32 num_vertices,
+                                              const S32* joint_nums, S32 num_joints,
+                                              const LLMatrix4a* bind_poses, S32 num_bind_poses)
+{
+    for (S32 i = 0; i < num_vertices; i++)
+    {
+        const LLVector4a& pos = positions[i];
+        const F32* w = weights[i].getF32ptr();
+        for (U32 k = 0; k < 4; k++)
+        {
+            S32 joint_index = llclamp((S32)floorf(w[k]), (S32)0, mSize - 1);
+            F32 wght = w[k] - joint_index;
+            if (wght > 0.2f && num_joints > joint_index)
+            {
+                S32 joint_num = joint_nums[joint_index];
+                if (joint_num >= 0 && joint_num < mSize)
+                {
+                    mRigInfoPtr[joint_num].setIsRiggedTo(true);
+
+                    const LLMatrix4a& mat = num_bind_poses > joint_index ? bind_poses[joint_index] : LLMatrix4a::identity();
+                    LLVector4a pos_joint_space;
+
+                    mat.affineTransform(pos, pos_joint_space);
+
+                    LLVector4a *extents = mRigInfoPtr[joint_num].getRiggedExtents();
+                    update_min_max(extents[0], extents[1], pos_joint_space);
+                }
+            }
+        }
+    }
+}
+// </FS>
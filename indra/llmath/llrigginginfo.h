@@ -31,6 +31,7 @@
 #define LL_LLRIGGINGINFO_H
 
 #include "llvector4a.h"
+#include "llmatrix4a.h" // <FS/> Shared rigging info cache
 
 // Extents are in joint space
 // isRiggedTo is based on the state of all currently associated rigged meshes
@@ -62,6 +63,15 @@ public:
     void clear();
     S32 size() const { return mSize; }
     void merge(const LLJointRiggingInfoTab& src);
+    // <FS> Shared rigging info cache
+    // Mark the joints that vertices are rigged to with more than 0.2 weight
+    // and grow their extents by those vertices, in joint space. weights hold
+    // <joint_index>.<weight> as in LLVolumeFace::mWeights, joint_nums maps
+    // joint indices to joint numbers in this tab. The tab must be sized.
+    void addRiggedVertices(const LLVector4a* positions, const LLVector4a* weights, S32 num_vertices,
+                           const S32* joint_nums, S32 num_joints,
+                           const LLMatrix4a* bind_poses, S32 num_bind_poses);
+    // </FS>
     LLJointRiggingInfo& operator[](S32 i) { return mRigInfoPtr[i]; }
     const LLJointRiggingInfo& operator[](S32 i) const { return mRigInfoPtr[i]; };
     bool needsUpdate() { return mNeedsUpdate; }
@@ -0,0 +1,170 @@
+/**
+ * @file llrigginginfocache.cpp
+ * @brief Rigging info shared between volumes of the same rigged mesh.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmath.h"
+#include "llrigginginfocache.h"
+
+#include <boost/functional/hash.hpp>
+
+// Rough per entry cost of the hash map node and LRU list node
+static const size_t ENTRY_OVERHEAD_BYTES = 128;
+
+size_t LLRiggingInfoCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<LLUUID>()(key.mMeshID);
+    boost::hash_combine(hash, key.mSkinHash);
+    boost::hash_combine(hash, key.mLOD);
+    boost::hash_combine(hash, key.mFace);
+    boost::hash_combine(hash, key.mNumVertices);
+    return hash;
+}
+
+LLRiggingInfoCache::LLRiggingInfoCache(size_t max_bytes)
+    : mMaxBytes(max_bytes),
+      mBytes(0),
+      mHits(0),
+      mMisses(0)
+{
+}
+
+bool LLRiggingInfoCache::get(const Key& key, LLJointRiggingInfoTab& tab)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        ++mMisses;
+        return false;
+    }
+    ++mHits;
+
+    Entry& entry = it->second;
+    mLRU.splice(mLRU.begin(), mLRU, entry.mLRU);
+
+    // resize() keeps the old data if the size is the same, so reset it
+    tab.clear();
+    tab.resize(entry.mTabSize);
+    for (const Joint& joint : entry.mJoints)
+    {
+        LLJointRiggingInfo& info = tab[joint.mJointNum];
+        info.setIsRiggedTo(true);
+        info.getRiggedExtents()[0] = joint.mExtents[0];
+        info.getRiggedExtents()[1] = joint.mExtents[1];
+    }
+    return true;
+}
+
+void LLRiggingInfoCache::put(const Key& key, const LLJointRiggingInfoTab& tab)
+{
+    Entry entry;
+    entry.mTabSize = tab.size();
+    for (S32 i = 0; i < tab.size(); ++i)
+    {
+        if (tab[i].isRiggedTo())
+        {
+            Joint joint;
+            joint.mExtents[0] = tab[i].getRiggedExtents()[0];
+            joint.mExtents[1] = tab[i].getRiggedExtents()[1];
+            joint.mJointNum = i;
+            entry.mJoints.push_back(joint);
+        }
+    }
+    entry.mJoints.shrink_to_fit();
+    entry.mBytes = entry.mJoints.capacity() * sizeof(Joint) + sizeof(Entry) + ENTRY_OVERHEAD_BYTES;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        mBytes -= it->second.mBytes;
+        mLRU.erase(it->second.mLRU);
+        mEntries.erase(it);
+    }
+
+    mLRU.push_front(key);
+    entry.mLRU = mLRU.begin();
+    mBytes += entry.mBytes;
+    mEntries.emplace(key, std::move(entry));
+    evict();
+}
+
+void LLRiggingInfoCache::setMaxBytes(size_t max_bytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxBytes = max_bytes;
+    evict();
+}
+
+void LLRiggingInfoCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mLRU.clear();
+    mBytes = 0;
+}
+
+void LLRiggingInfoCache::evict()
+{
+    while (mBytes > mMaxBytes && !mLRU.empty())
+    {
+        auto it = mEntries.find(mLRU.back());
+        mBytes -= it->second.mBytes;
+        mEntries.erase(it);
+        mLRU.pop_back();
+    }
+}
+
+size_t LLRiggingInfoCache::getMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxBytes;
+}
+
+size_t LLRiggingInfoCache::getBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBytes;
+}
+
+size_t LLRiggingInfoCache::getNumEntries() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+U64 LLRiggingInfoCache::getHits() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+U64 LLRiggingInfoCache::getMisses() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMisses;
+}
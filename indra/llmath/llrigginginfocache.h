@@ -0,0 +1,123 @@
+/**
+ * @file llrigginginfocache.h
+ * @brief Rigging info shared between volumes of the same rigged mesh.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLRIGGINGINFOCACHE_H
+#define LL_LLRIGGINGINFOCACHE_H
+
+#include "llrigginginfo.h"
+#include "lluuid.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// class LLRiggingInfoCache
+//
+// The rigging info of a face only depends on the mesh asset: its weights,
+// positions and skin. Every avatar wearing the same mesh at the same LOD
+// would otherwise scan the same vertices again, and so would every new
+// LLVolume made for it (LOD switches, the system volume copy of a freshly
+// loaded mesh). The cache keeps the result per mesh, skin, LOD and face,
+// storing only the joints that are rigged to, and drops the least recently
+// used entries once it holds more than getMaxBytes().
+//
+// Safe to use from any thread; the mesh repository fills faces on its own
+// thread.
+//-----------------------------------------------------------------------------
+class LLRiggingInfoCache
+{
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 16 * 1024 * 1024;
+
+    struct Key
+    {
+        LLUUID mMeshID;
+        U64 mSkinHash;
+        S32 mLOD;
+        S32 mFace;
+        S32 mNumVertices;   // guards against a mesh id reused for other geometry
+
+        bool operator==(const Key& rhs) const
+        {
+            return mMeshID == rhs.mMeshID && mSkinHash == rhs.mSkinHash && mLOD == rhs.mLOD
+                && mFace == rhs.mFace && mNumVertices == rhs.mNumVertices;
+        }
+    };
+
+    LLRiggingInfoCache(size_t max_bytes = DEFAULT_MAX_BYTES);
+
+    // Fill tab with the cached rigging info for key. Returns false, leaving
+    // tab alone, if there is none.
+    bool get(const Key& key, LLJointRiggingInfoTab& tab);
+
+    // Remember tab for key, replacing any previous entry.
+    void put(const Key& key, const LLJointRiggingInfoTab& tab);
+
+    // Evicts least recently used entries until the cache fits.
+    void setMaxBytes(size_t max_bytes);
+    void clear();
+
+    size_t getMaxBytes() const;
+    // Memory held by entries, including their share of the index
+    size_t getBytes() const;
+    size_t getNumEntries() const;
+    U64 getHits() const;
+    U64 getMisses() const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Joint
+    {
+        LLVector4a mExtents[2];
+        S32 mJointNum;
+    };
+
+    struct Entry
+    {
+        std::vector<Joint> mJoints;     // rigged joints only
+        S32 mTabSize;
+        size_t mBytes;
+        std::list<Key>::iterator mLRU;
+    };
+
+    void evict();   // with mMutex held
+
+    mutable std::mutex mMutex;
+    std::unordered_map<Key, Entry, KeyHash> mEntries;
+    std::list<Key> mLRU;                // most recently used first
+    size_t mMaxBytes;
+    size_t mBytes;
+    U64 mHits;
+    U64 mMisses;
+};
+
+#endif // LL_LLRIGGINGINFOCACHE_H
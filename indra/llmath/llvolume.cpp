@@ -33,6 +33,7 @@
 #endif
 #include <cmath>
 #include <unordered_map>
+#include <atomic> // <FS/> Batched skinning
 
 #include "llerror.h"
 
@@ -5070,6 +5071,7 @@ LLVolumeFace& LLVolumeFace::operator=(const LLVolumeFace& src)
         {
             ll_aligned_free_16(mWeights);
             mWeights = NULL;
+            mWeightsSerial = 0; // <FS/> Batched skinning
             mWeightsScrubbed = false;
         }
 
@@ -5132,6 +5134,7 @@ void LLVolumeFace::freeData()
     mTangents = NULL;
     ll_aligned_free_16(mWeights);
     mWeights = NULL;
+    mWeightsSerial = 0; // <FS/> Batched skinning
 
 #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
     ll_aligned_free_16(mJointIndices);
@@ -6733,8 +6736,13 @@ void LLVolumeFace::allocateTangents(S32 num_verts)
 
 void LLVolumeFace::allocateWeights(S32 num_verts)
 {
+    // <FS> Batched skinning: faces are loaded on the mesh threads
+    static std::atomic<U64> sNextWeightsSerial(1);
+    // </FS>
+
     ll_aligned_free_16(mWeights);
     mWeights = (LLVector4a*)ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
+    mWeightsSerial = sNextWeightsSerial++; // <FS/> Batched skinning
 
 }
 
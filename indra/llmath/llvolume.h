@@ -979,6 +979,12 @@ public:
     // mWeights.size() should be empty or match mVertices.size()
     LLVector4a* mWeights;
 
+    // <FS> Batched skinning
+    // Set anew each time mWeights is allocated, 0 while there are none, so
+    // weights decoded from this face can tell when they are out of date
+    U64 mWeightsSerial = 0;
+    // </FS>
+
 #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
     LLVector4a* mJustWeights;
     U8* mJointIndices;
@@ -0,0 +1,389 @@
+/**
+ * @file lloctree_test.cpp
+ * @brief LLOctreeNode, LLOctreeRoot and LLOctreeNodePool test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+
+#include "../llmath.h"
+#include "../lloctree.h"
+
+#include <memory>
+#include <random>
+
+namespace tut
+{
+    // What a drawable's octree entry gives the tree
+    struct alignas(16) Element
+    {
+        LLVector4a mPosition;
+        F32 mRadius = 0.f;
+        S32 mBinIndex = -1;
+
+        const LLVector4a& getPositionGroup() const  { return mPosition; }
+        F32 getBinRadius() const                    { return mRadius; }
+        S32 getBinIndex() const                     { return mBinIndex; }
+        void setBinIndex(S32 index)                 { mBinIndex = index; }
+    };
+
+    typedef LLOctreeNode<Element, Element*> Node;
+    typedef LLOctreeRoot<Element, Element*> Root;
+
+    // Follows the tree as it grows, as the spatial groups do
+    struct NodeCounter : public LLOctreeListener<Element, Element*>
+    {
+        U32 mAdded = 0;
+        U32 mRemoved = 0;
+
+        void handleInsertion(const LLTreeNode<Element>* node, Element* data) override {}
+        void handleRemoval(const LLTreeNode<Element>* node, Element* data) override {}
+        void handleDestruction(const LLTreeNode<Element>* node) override {}
+        void handleStateChange(const LLTreeNode<Element>* node) override {}
+
+        void handleChildAddition(const Node* parent, Node* child) override
+        {
+            ++mAdded;
+            if (!child->getListenerCount())
+            {
+                child->addListener(this);
+            }
+        }
+
+        void handleChildRemoval(const Node* parent, const Node* child) override
+        {
+            ++mRemoved;
+        }
+    };
+
+    struct octree_test
+    {
+        std::mt19937 mRandom{0x0c7ee};
+        U32 mMaxCapacity;
+        F32 mMinSize;
+
+        octree_test()
+            : mMaxCapacity(gOctreeMaxCapacity),
+              mMinSize(gOctreeMinSize)
+        {
+            // the viewer's defaults
+            gOctreeMaxCapacity = 128;
+            gOctreeMinSize = 0.01f;
+        }
+
+        ~octree_test()
+        {
+            gOctreeMaxCapacity = mMaxCapacity;
+            gOctreeMinSize = mMinSize;
+        }
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        // Scattered over a region, small things mostly, clustered like
+        // builds are
+        std::unique_ptr<Element[]> makeElements(U32 count)
+        {
+            std::unique_ptr<Element[]> elements(new Element[count]);
+            LLVector3 cluster;
+            for (U32 i = 0; i < count; ++i)
+            {
+                if (i % 50 == 0)
+                {
+                    cluster.set(frand(10.f, 246.f), frand(10.f, 246.f), frand(20.f, 100.f));
+                }
+                elements[i].mPosition.set(cluster.mV[VX] + frand(-10.f, 10.f), cluster.mV[VY] + frand(-10.f, 10.f),
+                                          cluster.mV[VZ] + frand(-10.f, 10.f));
+                elements[i].mRadius = mRandom() % 20 ? frand(0.05f, 2.f) : frand(2.f, 30.f);
+            }
+            return elements;
+        }
+
+        static Root* makeRoot(NodeCounter* counter)
+        {
+            LLVector4a center(128.f, 128.f, 128.f);
+            LLVector4a size(128.f, 128.f, 128.f);
+            Root* root = new Root(center, size, NULL);
+            if (counter)
+            {
+                root->addListener(counter);
+            }
+            return root;
+        }
+
+        static void moveElement(Element& element, const LLVector4a& offset)
+        {
+            element.mPosition.add(offset);
+        }
+
+        // Counts the nodes and elements under node, and checks the bin
+        // indices and that no branch is empty
+        static bool checkTree(const Node* node, U32& nodes, U32& elements)
+        {
+            ++nodes;
+            elements += node->getElementCount();
+            for (U32 i = 0; i < node->getElementCount(); ++i)
+            {
+                if ((*(node->getDataBegin() + i))->getBinIndex() != (S32)i)
+                {
+                    return false;
+                }
+            }
+            if (node->getOctParent() && !node->getChildCount() && !node->getElementCount())
+            {
+                return false;
+            }
+            for (U32 i = 0; i < node->getChildCount(); ++i)
+            {
+                if (node->getChild(i)->getOctParent() != node || !checkTree(node->getChild(i), nodes, elements))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+    typedef test_group<octree_test> octree_test_t;
+    typedef octree_test_t::object octree_test_object_t;
+    tut::octree_test_t tut_octree_test("LLOctree");
+
+    template<> template<>
+    void octree_test_object_t::test<1>()
+    {
+        set_test_name("insert and remove");
+
+        gOctreeMaxCapacity = 8;
+        const U32 COUNT = 3000;
+        std::unique_ptr<Element[]> elements = makeElements(COUNT);
+
+        LLOctreeNodePool& pool = Node::getNodePool();
+        const U32 allocated = pool.getAllocated();
+
+        Root* root = makeRoot(NULL);
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            root->insert(&elements[i]);
+        }
+        U32 nodes = 0;
+        U32 count = 0;
+        ensure("valid tree", checkTree(root, nodes, count));
+        ensure_equals("all inserted", count, COUNT);
+        ensure("branched", nodes > COUNT / 8);
+        ensure_equals("nodes from the pool", pool.getAllocated(), allocated + nodes);
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            ensure("in a node", elements[i].getBinIndex() >= 0);
+        }
+
+        for (U32 i = 0; i < COUNT; i += 2)
+        {
+            ensure("removed", root->remove(&elements[i]));
+            ensure_equals("out of its node", elements[i].getBinIndex(), -1);
+        }
+        nodes = count = 0;
+        ensure("valid tree after removals", checkTree(root, nodes, count));
+        ensure_equals("half left", count, COUNT / 2);
+
+        for (U32 i = 1; i < COUNT; i += 2)
+        {
+            root->remove(&elements[i]);
+        }
+        root->balance();
+        ensure_equals("no element left", root->getElementCount(), (U32)0);
+        ensure_equals("no child left", root->getChildCount(), (U32)0);
+        ensure_equals("nodes back in the pool", pool.getAllocated(), allocated + 1);
+
+        delete root;
+        ensure_equals("root back in the pool", pool.getAllocated(), allocated);
+    }
+
+    template<> template<>
+    void octree_test_object_t::test<2>()
+    {
+        set_test_name("batches keep the nodes elements move through");
+
+        gOctreeMaxCapacity = 8;
+        const U32 COUNT = 3000;
+        std::unique_ptr<Element[]> elements = makeElements(COUNT);
+
+        LLPointer<NodeCounter> counter = new NodeCounter;
+        Root* root = makeRoot(counter);
+        std::vector<Element*> pointers;
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            pointers.push_back(&elements[i]);
+        }
+        root->insertBatch(pointers.begin(), pointers.end());
+        U32 nodes = 0;
+        U32 count = 0;
+        ensure("valid tree", checkTree(root, nodes, count));
+        ensure_equals("all inserted", count, COUNT);
+        ensure_equals("nodes made", counter->mAdded, nodes - 1);
+
+        // every element moves a little, out of its node and back in
+        LLVector4a offset(0.3f, -0.2f, 0.1f);
+        for (U32 round = 0; round < 2; ++round)
+        {
+            const U32 removed = counter->mRemoved;
+            root->beginBatch();
+            for (Element* element : pointers)
+            {
+                root->remove(element);
+                moveElement(*element, offset);
+                root->insert(element);
+            }
+            ensure_equals("no node deleted in the batch", counter->mRemoved, removed);
+            root->endBatch();
+
+            nodes = count = 0;
+            ensure("empty branches pruned", checkTree(root, nodes, count));
+            ensure_equals("all there", count, COUNT);
+            ensure_equals("nodes accounted for", counter->mAdded - counter->mRemoved, nodes - 1);
+        }
+
+        // nested batches prune once, at the end
+        root->beginBatch();
+        root->removeBatch(pointers.begin(), pointers.begin() + COUNT / 2);
+        ensure("not pruned yet", root->isCollapseDeferred());
+        root->endBatch();
+        ensure("batch over", !root->isCollapseDeferred());
+        nodes = count = 0;
+        ensure("pruned", checkTree(root, nodes, count));
+        ensure_equals("half left", count, COUNT - COUNT / 2);
+
+        root->removeBatch(pointers.begin() + COUNT / 2, pointers.end());
+        ensure_equals("emptied", root->getChildCount(), (U32)0);
+        ensure_equals("every node made was deleted", counter->mAdded, counter->mRemoved);
+
+        delete root;
+    }
+
+    template<> template<>
+    void octree_test_object_t::test<3>()
+    {
+        set_test_name("node pool");
+
+        LLOctreeNodePool pool(sizeof(Node));
+        ensure("aligned blocks", pool.getBlockSize() % 16 == 0 && pool.getBlockSize() >= sizeof(Node));
+
+        std::vector<void*> blocks;
+        for (U32 i = 0; i < LLOctreeNodePool::BLOCKS_PER_CHUNK + 1; ++i)
+        {
+            blocks.push_back(pool.allocate());
+            ensure("aligned", ((uintptr_t)blocks.back() & 15) == 0);
+            memset(blocks.back(), 0xa5, sizeof(Node));
+        }
+        ensure_equals("allocated", pool.getAllocated(), LLOctreeNodePool::BLOCKS_PER_CHUNK + 1);
+        ensure_equals("two chunks", pool.getCapacity(), LLOctreeNodePool::BLOCKS_PER_CHUNK * 2);
+
+        void* last = blocks.back();
+        pool.free(last);
+        ensure_equals("freed", pool.getAllocated(), LLOctreeNodePool::BLOCKS_PER_CHUNK);
+        ensure("last freed first reused", pool.allocate() == last);
+
+        for (void* block : blocks)
+        {
+            pool.free(block);
+        }
+        ensure_equals("all freed", pool.getAllocated(), (U32)0);
+        ensure_equals("chunks kept", pool.getCapacity(), LLOctreeNodePool::BLOCKS_PER_CHUNK * 2);
+    }
+
+    template<> template<>
+    void octree_test_object_t::test<4>()
+    {
+        set_test_name("octree stress");
+
+        // A busy region's worth of drawables, inserted, nudged back and forth
+        // as a frame's moved list would, and removed
+        const U32 COUNT = 20000;
+        const U32 ROUNDS = 2;
+        std::unique_ptr<Element[]> elements = makeElements(COUNT);
+        std::vector<Element*> pointers;
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            pointers.push_back(&elements[i]);
+        }
+        std::vector<LLVector4a> offsets;
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            offsets.push_back(LLVector4a(frand(-0.2f, 0.2f), frand(-0.2f, 0.2f), frand(-0.05f, 0.05f)));
+        }
+
+        LLPointer<NodeCounter> counter = new NodeCounter;
+        Root* root = makeRoot(counter);
+        for (Element* element : pointers)
+        {
+            root->insert(element);
+        }
+
+        // one element at a time: empty nodes go as soon as they are left
+        U32 churn = counter->mAdded + counter->mRemoved;
+        for (U32 round = 0; round < ROUNDS; ++round)
+        {
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                root->remove(pointers[i]);
+                moveElement(*pointers[i], offsets[i]);
+                root->insert(pointers[i]);
+            }
+            for (LLVector4a& offset : offsets)
+            {
+                offset.mul(-1.f);
+            }
+        }
+        const U32 move_churn = counter->mAdded + counter->mRemoved - churn;
+
+        // the same moves in batches
+        churn = counter->mAdded + counter->mRemoved;
+        for (U32 round = 0; round < ROUNDS; ++round)
+        {
+            root->beginBatch();
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                root->remove(pointers[i]);
+                moveElement(*pointers[i], offsets[i]);
+                root->insert(pointers[i]);
+            }
+            root->endBatch();
+            for (LLVector4a& offset : offsets)
+            {
+                offset.mul(-1.f);
+            }
+        }
+        const U32 batch_churn = counter->mAdded + counter->mRemoved - churn;
+
+        U32 nodes = 0;
+        U32 count = 0;
+        ensure("valid tree", checkTree(root, nodes, count));
+        ensure_equals("all there", count, COUNT);
+        ensure("fewer nodes made and deleted in batches", batch_churn < move_churn);
+
+        root->removeBatch(pointers.begin(), pointers.end());
+        ensure_equals("emptied", root->getChildCount(), (U32)0);
+        delete root;
+    }
+}
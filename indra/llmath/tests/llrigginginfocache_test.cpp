@@ -0,0 +1,296 @@
+/**
+ * @file llrigginginfocache_test.cpp
+ * @brief LLRiggingInfoCache test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+
+#include "../llmath.h"
+#include "../llrigginginfocache.h"
+
+#include <random>
+
+namespace tut
+{
+    // Same as LL_CHARACTER_MAX_ANIMATED_JOINTS, which lives in llcharacter
+    static const S32 TAB_SIZE = 216;
+
+    // The parts of a rigged mesh face and its skin that rigging info is
+    // computed from
+    struct RiggedFace
+    {
+        std::vector<LLVector4a> mPositions;
+        std::vector<LLVector4a> mWeights;
+    };
+
+    struct RiggedMesh
+    {
+        LLUUID mID;
+        std::vector<S32> mJointNums;
+        std::vector<LLMatrix4a> mBindPoses;
+        std::vector<RiggedFace> mFaces[4];  // per LOD
+    };
+
+    struct rigginginfocache_test
+    {
+        std::mt19937 mRandom{0x71661e};
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        RiggedMesh makeMesh(S32 num_faces, S32 high_lod_vertices)
+        {
+            RiggedMesh mesh;
+            mesh.mID.generate();
+
+            const S32 num_joints = 20 + mRandom() % 60;
+            for (S32 j = 0; j < num_joints; j++)
+            {
+                mesh.mJointNums.push_back(mRandom() % TAB_SIZE);
+                LLMatrix4a bind_pose;
+                bind_pose.setIdentity();
+                bind_pose.mMatrix[3].set(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f), 1.f);
+                mesh.mBindPoses.push_back(bind_pose);
+            }
+
+            for (S32 lod = 0; lod < 4; lod++)
+            {
+                const S32 num_vertices = high_lod_vertices >> (2 * (3 - lod));
+                mesh.mFaces[lod].resize(num_faces);
+                for (RiggedFace& face : mesh.mFaces[lod])
+                {
+                    for (S32 i = 0; i < num_vertices; i++)
+                    {
+                        LLVector4a pos;
+                        pos.set(frand(-0.5f, 0.5f), frand(-0.5f, 0.5f), frand(-1.f, 1.f), 1.f);
+                        face.mPositions.push_back(pos);
+                        LLVector4a weights;
+                        weights.set((F32)(mRandom() % num_joints) + frand(0.f, 0.99f),
+                                    (F32)(mRandom() % num_joints) + frand(0.f, 0.99f),
+                                    (F32)(mRandom() % num_joints) + frand(0.f, 0.5f),
+                                    (F32)(mRandom() % num_joints) + frand(0.f, 0.2f));
+                        face.mWeights.push_back(weights);
+                    }
+                }
+            }
+            return mesh;
+        }
+
+        static LLRiggingInfoCache::Key makeKey(const RiggedMesh& mesh, S32 lod, S32 face)
+        {
+            LLRiggingInfoCache::Key key;
+            key.mMeshID = mesh.mID;
+            key.mSkinHash = 0;
+            key.mLOD = lod;
+            key.mFace = face;
+            key.mNumVertices = (S32)mesh.mFaces[lod][face].mPositions.size();
+            return key;
+        }
+
+        // What LLSkinningUtil::updateRiggingInfo() does for a face
+        static void scanFace(const RiggedMesh& mesh, S32 lod, S32 face, LLJointRiggingInfoTab& tab)
+        {
+            const RiggedFace& rigged = mesh.mFaces[lod][face];
+            tab.resize(TAB_SIZE);
+            tab.addRiggedVertices(rigged.mPositions.data(), rigged.mWeights.data(), (S32)rigged.mPositions.size(),
+                                  mesh.mJointNums.data(), (S32)mesh.mJointNums.size(),
+                                  mesh.mBindPoses.data(), (S32)mesh.mBindPoses.size());
+        }
+
+        static bool sameTab(const LLJointRiggingInfoTab& a, const LLJointRiggingInfoTab& b)
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+            for (S32 i = 0; i < a.size(); i++)
+            {
+                if (a[i].isRiggedTo() != b[i].isRiggedTo()
+                    || !a[i].getRiggedExtents()[0].equals3(b[i].getRiggedExtents()[0])
+                    || !a[i].getRiggedExtents()[1].equals3(b[i].getRiggedExtents()[1]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+    typedef test_group<rigginginfocache_test> rigginginfocache_test_t;
+    typedef rigginginfocache_test_t::object rigginginfocache_object_t;
+    tut::rigginginfocache_test_t tut_rigginginfocache_test("LLRiggingInfoCache");
+
+    template<> template<>
+    void rigginginfocache_object_t::test<1>()
+    {
+        set_test_name("cached rigging info matches a fresh scan");
+
+        RiggedMesh mesh = makeMesh(3, 1024);
+        LLRiggingInfoCache cache;
+
+        LLJointRiggingInfoTab scanned;
+        scanFace(mesh, 3, 1, scanned);
+        S32 rigged = 0;
+        for (S32 i = 0; i < scanned.size(); i++)
+        {
+            rigged += scanned[i].isRiggedTo() ? 1 : 0;
+        }
+        ensure("scan found rigged joints", rigged > 0);
+
+        LLJointRiggingInfoTab tab;
+        ensure("empty cache misses", !cache.get(makeKey(mesh, 3, 1), tab));
+        ensure_equals("miss leaves tab alone", tab.size(), 0);
+        cache.put(makeKey(mesh, 3, 1), scanned);
+
+        // A stale tab is fully replaced
+        tab.resize(TAB_SIZE);
+        tab[0].setIsRiggedTo(true);
+        tab[0].getRiggedExtents()[1].splat(100.f);
+        ensure("hit", cache.get(makeKey(mesh, 3, 1), tab));
+        ensure("same as scan", sameTab(tab, scanned));
+
+        ensure("other face misses", !cache.get(makeKey(mesh, 3, 0), tab));
+        ensure("other LOD misses", !cache.get(makeKey(mesh, 2, 1), tab));
+        LLRiggingInfoCache::Key key = makeKey(mesh, 3, 1);
+        key.mNumVertices++;
+        ensure("other geometry misses", !cache.get(key, tab));
+        key = makeKey(mesh, 3, 1);
+        key.mSkinHash = 1;
+        ensure("other skin misses", !cache.get(key, tab));
+
+        ensure_equals("hits", cache.getHits(), (U64)1);
+        ensure_equals("misses", cache.getMisses(), (U64)5);
+    }
+
+    template<> template<>
+    void rigginginfocache_object_t::test<2>()
+    {
+        set_test_name("memory accounting and eviction");
+
+        RiggedMesh mesh = makeMesh(8, 64);
+        LLRiggingInfoCache cache;
+        LLJointRiggingInfoTab tab;
+        for (S32 face = 0; face < 8; face++)
+        {
+            scanFace(mesh, 3, face, tab);
+            cache.put(makeKey(mesh, 3, face), tab);
+        }
+        ensure_equals("entries", cache.getNumEntries(), (size_t)8);
+        const size_t bytes = cache.getBytes();
+        ensure("only rigged joints are kept", bytes > 0 && bytes < 8 * TAB_SIZE * sizeof(LLJointRiggingInfo));
+
+        // Replacing an entry doesn't count it twice
+        cache.put(makeKey(mesh, 3, 0), tab);
+        ensure_equals("replaced entries", cache.getNumEntries(), (size_t)8);
+
+        // Touch face 1 so face 2 is now the least recently used
+        ensure("touch", cache.get(makeKey(mesh, 3, 1), tab));
+        cache.setMaxBytes(cache.getBytes() - 1);
+        ensure_equals("one evicted", cache.getNumEntries(), (size_t)7);
+        ensure("least recently used went", !cache.get(makeKey(mesh, 3, 2), tab));
+        ensure("recently used stayed", cache.get(makeKey(mesh, 3, 1), tab));
+        ensure("within budget", cache.getBytes() <= cache.getMaxBytes());
+
+        cache.clear();
+        ensure_equals("cleared entries", cache.getNumEntries(), (size_t)0);
+        ensure_equals("cleared bytes", cache.getBytes(), (size_t)0);
+    }
+
+    template<> template<>
+    void rigginginfocache_object_t::test<3>()
+    {
+        set_test_name("50 avatars sharing outfits");
+
+        const S32 AVATARS = 50;
+        const S32 OUTFITS = 6;
+        const S32 ITEMS_PER_OUTFIT = 8;
+
+        // A mesh body and head everyone wears, plus a wardrobe of clothes,
+        // hair and shoes the outfits pick from
+        std::vector<RiggedMesh> wardrobe;
+        wardrobe.push_back(makeMesh(8, 16384));
+        wardrobe.push_back(makeMesh(4, 8192));
+        for (S32 i = 0; i < 18; i++)
+        {
+            wardrobe.push_back(makeMesh(1 + mRandom() % 3, 1024 + mRandom() % 4096));
+        }
+        std::vector<std::vector<S32> > outfits(OUTFITS);
+        for (std::vector<S32>& outfit : outfits)
+        {
+            outfit.push_back(0);
+            outfit.push_back(1);
+            while (outfit.size() < ITEMS_PER_OUTFIT)
+            {
+                outfit.push_back(2 + mRandom() % (wardrobe.size() - 2));
+            }
+        }
+
+        // Each avatar merges its attachments into its own tab, the way
+        // LLVOAvatar::updateRiggingInfo() does, from face tabs that need an
+        // update as they would on freshly made volumes.
+        auto update_avatar = [&](S32 avatar, LLRiggingInfoCache* cache, LLJointRiggingInfoTab& avatar_tab)
+        {
+            const S32 lod = 3 - avatar % 3;     // nearby avatars at high LOD
+            avatar_tab.clear();
+            for (S32 item : outfits[avatar % OUTFITS])
+            {
+                const RiggedMesh& mesh = wardrobe[item];
+                for (S32 face = 0; face < (S32)mesh.mFaces[lod].size(); face++)
+                {
+                    LLJointRiggingInfoTab face_tab;
+                    LLRiggingInfoCache::Key key = makeKey(mesh, lod, face);
+                    if (!cache || !cache->get(key, face_tab))
+                    {
+                        scanFace(mesh, lod, face, face_tab);
+                        if (cache)
+                        {
+                            cache->put(key, face_tab);
+                        }
+                    }
+                    avatar_tab.merge(face_tab);
+                }
+            }
+        };
+
+        std::vector<LLJointRiggingInfoTab> uncached_tabs(AVATARS), cached_tabs(AVATARS);
+        for (S32 avatar = 0; avatar < AVATARS; avatar++)
+        {
+            update_avatar(avatar, nullptr, uncached_tabs[avatar]);
+        }
+
+        LLRiggingInfoCache cache;
+        for (S32 avatar = 0; avatar < AVATARS; avatar++)
+        {
+            update_avatar(avatar, &cache, cached_tabs[avatar]);
+        }
+
+        for (S32 avatar = 0; avatar < AVATARS; avatar++)
+        {
+            ensure("same avatar rigging info", sameTab(uncached_tabs[avatar], cached_tabs[avatar]));
+        }
+        ensure("outfits were shared", cache.getHits() > cache.getMisses());
+    }
+}
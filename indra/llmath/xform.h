@@ -149,6 +149,15 @@ public:
 
     const LLMatrix4&    getWorldMatrix() const      { return mWorldMatrix; }
     void setWorldMatrix (const LLMatrix4& mat)   { mWorldMatrix = mat; }
+    // <FS> Batched skeleton update
+    // Store a world transform computed elsewhere, as updateMatrix(false) would.
+    void setWorldTransform(const LLVector3& pos, const LLQuaternion& rot, const LLMatrix4& mat)
+    {
+        mWorldPosition = pos;
+        mWorldRotation = rot;
+        mWorldMatrix = mat;
+    }
+    // </FS>
 
     void init()
     {
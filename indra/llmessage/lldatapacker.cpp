@@ -37,6 +37,7 @@
 #include "v3math.h"
 #include "v4math.h"
 #include "lluuid.h"
+#include "llendianswizzle.h" // <FS/>
 
 // *NOTE: there are functions below which use sscanf and rely on this
 // particular value of DP_BUFSIZE. Search for '511' (DP_BUFSIZE - 1)
@@ -740,6 +741,51 @@ void LLDataPackerBinaryBuffer::dumpBufferToLog()
     }
 }
 
+// <FS> Bulk unpacking: one length check and copy per array. An array that
+// runs past the end of the buffer goes value by value instead, so it fills
+// what fits and fails at the same place the per-value unpacks would.
+bool LLDataPackerBinaryBuffer::unpackArray(void *values, S32 elem_size, S32 count, const char *name)
+{
+    S32 size = elem_size * count;
+    if (count < 0 || (mWriteEnabled && (mCurBufferp - mBufferp) > mBufferSize - size))
+    {
+        return false;
+    }
+
+    memcpy(values, mCurBufferp, size); /* Flawfinder: ignore */
+    llendianswizzle(values, elem_size, count);
+    mCurBufferp += size;
+    return true;
+}
+
+bool LLDataPackerBinaryBuffer::unpackU16s(U16 *values, S32 count, const char *name)
+{
+    return unpackArray(values, sizeof(U16), count, name) || LLDataPacker::unpackU16s(values, count, name);
+}
+
+bool LLDataPackerBinaryBuffer::unpackS16s(S16 *values, S32 count, const char *name)
+{
+    return unpackArray(values, sizeof(S16), count, name) || LLDataPacker::unpackS16s(values, count, name);
+}
+
+bool LLDataPackerBinaryBuffer::unpackF32s(F32 *values, S32 count, const char *name)
+{
+    return unpackArray(values, sizeof(F32), count, name) || LLDataPacker::unpackF32s(values, count, name);
+}
+
+bool LLDataPackerBinaryBuffer::unpackColor4Us(LLColor4U *values, S32 count, const char *name)
+{
+    static_assert(sizeof(LLColor4U) == 4, "LLColor4U must be tightly packed");
+    return unpackArray(values[0].mV, 1, count * 4, name) || LLDataPacker::unpackColor4Us(values, count, name);
+}
+
+bool LLDataPackerBinaryBuffer::unpackUUIDs(LLUUID *values, S32 count, const char *name)
+{
+    static_assert(sizeof(LLUUID) == UUID_BYTES, "LLUUID must be tightly packed");
+    return unpackArray(values[0].mData, 1, count * UUID_BYTES, name) || LLDataPacker::unpackUUIDs(values, count, name);
+}
+// </FS>
+
 //---------------------------------------------------------------------------
 // LLDataPackerAsciiBuffer implementation
 //---------------------------------------------------------------------------
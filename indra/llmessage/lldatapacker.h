@@ -62,11 +62,11 @@ public:
 
     virtual bool        packU16(const U16 value, const char *name) = 0;
     virtual bool        unpackU16(U16 &value, const char *name) = 0;
-    bool                unpackU16s(U16 *value, S32 count, const char *name);
+    virtual bool        unpackU16s(U16 *value, S32 count, const char *name); // <FS/> virtual for bulk overrides
 
     virtual bool        packS16(const S16 value, const char *name) = 0;
     virtual bool        unpackS16(S16 &value, const char *name) = 0;
-    bool                unpackS16s(S16 *value, S32 count, const char *name);
+    virtual bool        unpackS16s(S16 *value, S32 count, const char *name); // <FS/> virtual for bulk overrides
 
     virtual bool        packU32(const U32 value, const char *name) = 0;
     virtual bool        unpackU32(U32 &value, const char *name) = 0;
@@ -76,7 +76,7 @@ public:
 
     virtual bool        packF32(const F32 value, const char *name) = 0;
     virtual bool        unpackF32(F32 &value, const char *name) = 0;
-    bool                unpackF32s(F32 *values, S32 count, const char *name);
+    virtual bool        unpackF32s(F32 *values, S32 count, const char *name); // <FS/> virtual for bulk overrides
 
     // Packs a float into an integer, using the given size
     // and picks the right U* data type to pack into.
@@ -90,7 +90,7 @@ public:
 
     virtual bool        packColor4U(const LLColor4U &value, const char *name) = 0;
     virtual bool        unpackColor4U(LLColor4U &value, const char *name) = 0;
-    bool                unpackColor4Us(LLColor4U *values, S32 count, const char *name);
+    virtual bool        unpackColor4Us(LLColor4U *values, S32 count, const char *name); // <FS/> virtual for bulk overrides
 
     virtual bool        packVector2(const LLVector2 &value, const char *name) = 0;
     virtual bool        unpackVector2(LLVector2 &value, const char *name) = 0;
@@ -103,7 +103,7 @@ public:
 
     virtual bool        packUUID(const LLUUID &value, const char *name) = 0;
     virtual bool        unpackUUID(LLUUID &value, const char *name) = 0;
-    bool                unpackUUIDs(LLUUID *values, S32 count, const char *name);
+    virtual bool        unpackUUIDs(LLUUID *values, S32 count, const char *name); // <FS/> virtual for bulk overrides
             U32         getPassFlags() const    { return mPassFlags; }
             void        setPassFlags(U32 flags) { mPassFlags = flags; }
 protected:
@@ -179,6 +179,14 @@ public:
     /*virtual*/ bool        packUUID(const LLUUID &value, const char *name);
     /*virtual*/ bool        unpackUUID(LLUUID &value, const char *name);
 
+    // <FS> Bulk unpacking: one length check and copy per array
+    /*virtual*/ bool        unpackU16s(U16 *values, S32 count, const char *name);
+    /*virtual*/ bool        unpackS16s(S16 *values, S32 count, const char *name);
+    /*virtual*/ bool        unpackF32s(F32 *values, S32 count, const char *name);
+    /*virtual*/ bool        unpackColor4Us(LLColor4U *values, S32 count, const char *name);
+    /*virtual*/ bool        unpackUUIDs(LLUUID *values, S32 count, const char *name);
+    // </FS>
+
                 S32         getCurrentSize() const  { return (S32)(mCurBufferp - mBufferp); }
                 S32         getBufferSize() const   { return mBufferSize; }
                 const U8*   getBuffer() const   { return mBufferp; }
@@ -203,6 +211,7 @@ public:
     /*virtual*/ void dumpBufferToLog();
 protected:
     inline bool verifyLength(const S32 data_size, const char *name);
+    bool unpackArray(void *values, S32 elem_size, S32 count, const char *name); // <FS/>
 
     U8 *mBufferp;
     U8 *mCurBufferp;
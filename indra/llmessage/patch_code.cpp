@@ -32,7 +32,8 @@
 #include "patch_code.h"
 #include "llbitpack.h"
 
-U32 gPatchSize, gWordBits;
+// Per thread, so that layer data can be decoded on worker threads.
+thread_local U32 gPatchSize, gWordBits;
 
 void    init_patch_coding(LLBitPack &bitpack)
 {
@@ -91,4 +91,13 @@ void init_patch_decompressor(S32 size);
 void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph);
 void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph);
 
+// Original scalar implementation of decompress_patch(), kept as the reference for the SIMD path.
+void decompress_patch_scalar(F32 *patch, S32 *cpatch, LLPatchHeader *ph);
+
+// Reentrant SIMD decompression of a 16x16 or 32x32 patch into patch, whose rows are stride floats
+// apart. Doesn't depend on set_group_of_patch_header() or init_patch_decompressor(), so it can be
+// called from worker threads. Output is bit-identical to decompress_patch_scalar(). Patches of
+// any other size are logged and left untouched.
+void decompress_patch_simd(F32 *patch, const S32 *cpatch, const LLPatchHeader *ph, S32 size, S32 stride);
+
 #endif
@@ -38,14 +38,14 @@ void set_group_of_patch_header(LLGroupHeader *gopp)
 }
 
 F32 gPatchDequantizeTable[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
-void build_patch_dequantize_table(S32 size)
+void build_patch_dequantize_table(F32 *table, S32 size)
 {
     S32 i, j;
     for (j = 0; j < size; j++)
     {
         for (i = 0; i < size; i++)
         {
-            gPatchDequantizeTable[j*size + i] = (1.f + 2.f*(i+j));
+            table[j*size + i] = (1.f + 2.f*(i+j));
         }
     }
 }
@@ -54,7 +54,7 @@ S32 gCurrentDeSize = 0;
 
 F32 gPatchICosines[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
 
-void setup_patch_icosines(S32 size)
+void setup_patch_icosines(F32 *icosines, S32 size)
 {
     S32 n, u;
     F32 oosob = F_PI*0.5f/size;
@@ -63,14 +63,14 @@ void setup_patch_icosines(S32 size)
     {
         for (n = 0; n < size; n++)
         {
-            gPatchICosines[u*size+n] = cosf((2.f*n+1.f)*u*oosob);
+            icosines[u*size+n] = cosf((2.f*n+1.f)*u*oosob);
         }
     }
 }
 
 S32 gDeCopyMatrix[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
 
-void build_decopy_matrix(S32 size)
+void build_decopy_matrix(S32 *decopy_matrix, S32 size)
 {
     S32 i, j, count;
     bool    b_diag = false;
@@ -83,7 +83,7 @@ void build_decopy_matrix(S32 size)
     while (  (i < size)
            &&(j < size))
     {
-        gDeCopyMatrix[j*size + i] = count;
+        decopy_matrix[j*size + i] = count;
 
         count++;
 
@@ -139,9 +139,9 @@ void init_patch_decompressor(S32 size)
     if (size != gCurrentDeSize)
     {
         gCurrentDeSize = size;
-        build_patch_dequantize_table(size);
-        setup_patch_icosines(size);
-        build_decopy_matrix(size);
+        build_patch_dequantize_table(gPatchDequantizeTable, size);
+        setup_patch_icosines(gPatchICosines, size);
+        build_decopy_matrix(gDeCopyMatrix, size);
     }
 }
 
@@ -587,7 +587,7 @@ inline void idct_patch_large(F32 *block)
 
 S32 gDitherNoise = 128;
 
-void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
+void decompress_patch_scalar(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
 {
     S32     i, j;
 
@@ -635,6 +635,173 @@ void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
 }
 
 
+// SIMD decompression path.
+//
+// Both passes of the separable IDCT produce four outputs per instruction. Every lane accumulates
+// its terms in the same order as the scalar loops above, using separate multiplies and adds, so
+// the output is bit-identical to decompress_patch_scalar().
+
+namespace
+{
+    // Immutable per-size copies of the decompressor tables.  gPatchICosines and friends are
+    // rebuilt whenever init_patch_decompressor() sees a new patch size, so they can't be shared
+    // between threads; these are built once and then only read.
+    class LLPatchDecompressTables
+    {
+    public:
+        LLPatchDecompressTables(S32 size)
+        {
+            build_patch_dequantize_table(mDequantize, size);
+            setup_patch_icosines(mICosines, size);
+            build_decopy_matrix(mDeCopy, size);
+        }
+
+        LL_ALIGN_16(F32 mICosines[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+        LL_ALIGN_16(F32 mDequantize[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+        S32 mDeCopy[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
+    };
+
+    const LLPatchDecompressTables& get_patch_decompress_tables(S32 size)
+    {
+        // function local statics, so construction is thread safe
+        static const LLPatchDecompressTables sNormalTables(NORMAL_PATCH_SIZE);
+        static const LLPatchDecompressTables sLargeTables(LARGE_PATCH_SIZE);
+        return (size == NORMAL_PATCH_SIZE) ? sNormalTables : sLargeTables;
+    }
+
+    // Equivalent of idct_column() over every column: lanes run across columns.
+    template<S32 SIZE>
+    inline void idct_columns_simd(const F32 *linein, F32 *lineout, const F32 *icosines)
+    {
+        constexpr S32 QUADS = SIZE / 4;
+        const LLQuad oo_sqrt2 = _mm_set1_ps(OO_SQRT2);
+
+        for (S32 n = 0; n < SIZE; n++)
+        {
+            LLQuad total[QUADS];
+            for (S32 q = 0; q < QUADS; q++)
+            {
+                total[q] = _mm_mul_ps(oo_sqrt2, _mm_load_ps(linein + q*4));
+            }
+
+            for (S32 u = 1; u < SIZE; u++)
+            {
+                const LLQuad cosine = _mm_set1_ps(icosines[u*SIZE + n]);
+                const F32 *row = linein + u*SIZE;
+                for (S32 q = 0; q < QUADS; q++)
+                {
+                    total[q] = _mm_add_ps(total[q], _mm_mul_ps(_mm_load_ps(row + q*4), cosine));
+                }
+            }
+
+            for (S32 q = 0; q < QUADS; q++)
+            {
+                _mm_store_ps(lineout + n*SIZE + q*4, total[q]);
+            }
+        }
+    }
+
+    // Equivalent of idct_line() over every line: lanes run across output samples.
+    template<S32 SIZE>
+    inline void idct_lines_simd(const F32 *linein, F32 *lineout, const F32 *icosines)
+    {
+        constexpr S32 QUADS = SIZE / 4;
+        const LLQuad oosob = _mm_set1_ps(2.f/(F32)SIZE);
+
+        for (S32 line = 0; line < SIZE; line++)
+        {
+            const F32 *row = linein + line*SIZE;
+
+            LLQuad total[QUADS];
+            const LLQuad dc = _mm_set1_ps(OO_SQRT2*row[0]);
+            for (S32 q = 0; q < QUADS; q++)
+            {
+                total[q] = dc;
+            }
+
+            for (S32 u = 1; u < SIZE; u++)
+            {
+                const LLQuad coeff = _mm_set1_ps(row[u]);
+                const F32 *cosines = icosines + u*SIZE;
+                for (S32 q = 0; q < QUADS; q++)
+                {
+                    total[q] = _mm_add_ps(total[q], _mm_mul_ps(coeff, _mm_load_ps(cosines + q*4)));
+                }
+            }
+
+            for (S32 q = 0; q < QUADS; q++)
+            {
+                _mm_store_ps(lineout + line*SIZE + q*4, _mm_mul_ps(total[q], oosob));
+            }
+        }
+    }
+}
+
+void decompress_patch_simd(F32 *patch, const S32 *cpatch, const LLPatchHeader *ph, S32 size, S32 stride)
+{
+    // The size comes off the wire, and the tables only exist for these two
+    if (size != NORMAL_PATCH_SIZE && size != LARGE_PATCH_SIZE)
+    {
+        LL_WARNS_ONCE() << "Ignoring patch with unsupported patch size " << size << LL_ENDL;
+        return;
+    }
+
+    const LLPatchDecompressTables &tables = get_patch_decompress_tables(size);
+
+    LL_ALIGN_16(F32 block[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+    LL_ALIGN_16(F32 temp[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+
+    F32     range = ph->range;
+    S32     prequant = (ph->quant_wbits >> 4) + 2;
+    S32     quantize = 1<<prequant;
+    F32     hmin = ph->dc_offset;
+
+    F32     ooq = 1.f/(F32)quantize;
+    F32     mult = ooq*range;
+    F32     addval = mult*(F32)(1<<(prequant - 1))+hmin;
+
+    // Dequantize: un-zigzag four coefficients at a time, convert and scale.
+    const S32 *decopy_matrix = tables.mDeCopy;
+    const F32 *dq = tables.mDequantize;
+    for (S32 i = 0; i < size*size; i += 4)
+    {
+        const __m128i coeffs = _mm_set_epi32(cpatch[decopy_matrix[i + 3]],
+                                             cpatch[decopy_matrix[i + 2]],
+                                             cpatch[decopy_matrix[i + 1]],
+                                             cpatch[decopy_matrix[i]]);
+        _mm_store_ps(block + i, _mm_mul_ps(_mm_cvtepi32_ps(coeffs), _mm_load_ps(dq + i)));
+    }
+
+    if (size == NORMAL_PATCH_SIZE)
+    {
+        idct_columns_simd<NORMAL_PATCH_SIZE>(block, temp, tables.mICosines);
+        idct_lines_simd<NORMAL_PATCH_SIZE>(temp, block, tables.mICosines);
+    }
+    else
+    {
+        idct_columns_simd<LARGE_PATCH_SIZE>(block, temp, tables.mICosines);
+        idct_lines_simd<LARGE_PATCH_SIZE>(temp, block, tables.mICosines);
+    }
+
+    const LLQuad mult4 = _mm_set1_ps(mult);
+    const LLQuad addval4 = _mm_set1_ps(addval);
+    for (S32 j = 0; j < size; j++)
+    {
+        F32 *tpatch = patch + j*stride;
+        const F32 *tblock = block + j*size;
+        for (S32 i = 0; i < size; i += 4)
+        {
+            _mm_storeu_ps(tpatch + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(tblock + i), mult4), addval4));
+        }
+    }
+}
+
+void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
+{
+    decompress_patch_simd(patch, cpatch, ph, gGOPP->patch_size, gGOPP->stride);
+}
+
+
 void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph)
 {
     S32     i, j;
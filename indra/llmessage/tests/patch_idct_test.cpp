@@ -0,0 +1,140 @@
+/**
+ * @file patch_idct_test.cpp
+ * @brief Terrain patch decompression test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "llmath.h"
+#include "stringize.h"
+
+#include "../patch_dct.h"
+
+#include "../test/lltut.h"
+
+#include <algorithm>
+#include <random>
+
+namespace tut
+{
+    struct patch_idct_test
+    {
+        std::mt19937 mRandom;
+
+        patch_idct_test() : mRandom(0x5eed) {}
+
+        // Fill a quantized patch the way the encoder does: a run of nonzero
+        // coefficients followed by zeros up to the end of the patch.
+        void makePatch(S32 size, S32 *cpatch, LLPatchHeader &ph)
+        {
+            const S32 count = size*size;
+            const S32 nonzero = mRandom() % count;
+            for (S32 i = 0; i < count; i++)
+            {
+                cpatch[i] = (i < nonzero) ? (S32)(mRandom() % 4001) - 2000 : 0;
+            }
+            ph.dc_offset = (F32)(mRandom() % 100000) / 97.f - 200.f;
+            ph.range = (U16)(mRandom() % 8192);
+            ph.quant_wbits = (U8)(((mRandom() % 8) << 4) | (mRandom() % 14));
+            ph.patchids = 0;
+        }
+
+        // Returns the number of samples that differ between the two paths.
+        S32 compare(S32 size, S32 stride, S32 iterations)
+        {
+            S32 cpatch[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
+            std::vector<F32> scalar(stride*size), simd(stride*size);
+            LLPatchHeader ph;
+            LLGroupHeader gopp;
+            gopp.patch_size = (U8)size;
+            gopp.stride = (U16)stride;
+            gopp.layer_type = 0;
+
+            init_patch_decompressor(size);
+            set_group_of_patch_header(&gopp);
+
+            S32 mismatches = 0;
+            for (S32 n = 0; n < iterations; n++)
+            {
+                makePatch(size, cpatch, ph);
+                decompress_patch_scalar(scalar.data(), cpatch, &ph);
+                decompress_patch_simd(simd.data(), cpatch, &ph, size, stride);
+                for (S32 j = 0; j < size; j++)
+                {
+                    for (S32 i = 0; i < size; i++)
+                    {
+                        const F32 a = scalar[j*stride + i];
+                        const F32 b = simd[j*stride + i];
+#if defined(__arm64__) || defined(__aarch64__)
+                        // clang contracts the scalar multiply-adds into FMAs on arm64
+                        if (fabsf(a - b) > 1e-3f * llmax(1.f, fabsf(a)))
+#else
+                        if (memcmp(&a, &b, sizeof(F32)))
+#endif
+                        {
+                            mismatches++;
+                        }
+                    }
+                }
+            }
+            return mismatches;
+        }
+    };
+    typedef test_group<patch_idct_test> patch_idct_test_t;
+    typedef patch_idct_test_t::object patch_idct_test_object_t;
+    tut::patch_idct_test_t tut_patch_idct_test("patch_idct");
+
+    template<> template<>
+    void patch_idct_test_object_t::test<1>()
+    {
+        set_test_name("16x16 SIMD decompression matches scalar");
+        ensure_equals("mismatched samples", compare(NORMAL_PATCH_SIZE, NORMAL_PATCH_SIZE, 500), 0);
+        // rows written into a larger surface, as LLSurface does
+        ensure_equals("mismatched samples (strided)", compare(NORMAL_PATCH_SIZE, 257, 100), 0);
+    }
+
+    template<> template<>
+    void patch_idct_test_object_t::test<2>()
+    {
+        set_test_name("32x32 SIMD decompression matches scalar");
+        ensure_equals("mismatched samples", compare(LARGE_PATCH_SIZE, LARGE_PATCH_SIZE, 200), 0);
+        ensure_equals("mismatched samples (strided)", compare(LARGE_PATCH_SIZE, 259, 50), 0);
+    }
+
+    template<> template<>
+    void patch_idct_test_object_t::test<3>()
+    {
+        set_test_name("unsupported patch sizes are left alone");
+
+        S32 cpatch[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
+        LLPatchHeader ph;
+        makePatch(NORMAL_PATCH_SIZE, cpatch, ph);
+        for (S32 size : { 0, 8, 24, 64 })
+        {
+            std::vector<F32> out(64*64, 1.f);
+            decompress_patch_simd(out.data(), cpatch, &ph, size, size);
+            ensure(STRINGIZE("size " << size << " wrote output"),
+                   std::all_of(out.begin(), out.end(), [](F32 f) { return f == 1.f; }));
+        }
+    }
+}
@@ -41,6 +41,9 @@
 #include "llmaterialid.h"
 #include "llsdutil.h"
 
+#include <algorithm> // <FS/> std::fill_n
+#include <bit>       // <FS/> std::countr_zero
+
 /**
  * exported constants
  */
@@ -1150,10 +1153,16 @@ namespace
         // Extract the default value and fill the array.
         htolememcpy(dest, source, type, size);
         source += size;
-        for (S32 idx = 1; idx < dest_count; ++idx)
+        // <FS> Bulk fill
+        //for (S32 idx = 1; idx < dest_count; ++idx)
+        //{
+        //    dest[idx] = dest[0];
+        //}
+        if (dest_count > 1)
         {
-            dest[idx] = dest[0];
+            std::fill_n(dest + 1, dest_count - 1, dest[0]);
         }
+        // </FS>
 
         while (source < source_end)
         {
@@ -1194,13 +1203,23 @@ namespace
             htolememcpy(&value, source, type, size);
             source += size;
 
-            for (S32 idx = 0; idx < dest_count; idx++)
+            // <FS> Only visit the faces whose bits are set
+            //for (S32 idx = 0; idx < dest_count; idx++)
+            //{
+            //    if (index_flags & 1ULL << idx)
+            //    {
+            //        dest[idx] = value;
+            //    }
+            //}
+            if (dest_count < 64)
             {
-                if (index_flags & 1ULL << idx)
-                {
-                    dest[idx] = value;
-                }
+                index_flags &= (1ULL << dest_count) - 1;
+            }
+            for (; index_flags; index_flags &= index_flags - 1)
+            {
+                dest[std::countr_zero(index_flags)] = value;
             }
+            // </FS>
 
         }
         return true;
@@ -1683,7 +1683,8 @@ void LLAgentCamera::updateCamera()
         // SL-315
         gAgentAvatarp->mPelvisp->setPosition(gAgentAvatarp->mPelvisp->getPosition() + diff);
 
-        gAgentAvatarp->mRoot->updateWorldMatrixChildren();
+        //gAgentAvatarp->mRoot->updateWorldMatrixChildren();
+        gAgentAvatarp->updateJointWorldMatrices(); // <FS/> Batched skeleton update
 
         for (LLVOAvatar::attachment_map_t::iterator iter = gAgentAvatarp->mAttachmentPoints.begin();
              iter != gAgentAvatarp->mAttachmentPoints.end(); )
@@ -63,64 +63,65 @@ static const struct
     U32                         mMax;
     U32                         mRate;
     bool                        mPipelined;
+    bool                        mHttp2;     // <FS/> HTTP/2 multiplexing, see FSHttp2StreamLimit
     std::string                 mKey;
     const char *                mUsage;
 } init_data[LLAppCoreHttp::AP_COUNT] =
 {
     { // AP_DEFAULT
-        8,      8,      8,      0,      false,
+        8,      8,      8,      0,      false,  false,
         "",
         "other"
     },
     // <FS:Beq> Avoid stall in texture fetch due to asset fetching. [Drake]
     { // AP_ASSET
-        12,     1,      16,     0,      true,
+        12,     1,      16,     0,      true,   false,
         "AssetFetchConcurrency",
         "asset fetch"
     },
     // </FS:Beq>
     { // AP_TEXTURE
-        8,      1,      12,     0,      true,
+        8,      1,      12,     0,      true,   true,
         "TextureFetchConcurrency",
         "texture fetch"
     },
     { // AP_MESH1
-        32,     1,      128,    0,      false,
+        32,     1,      128,    0,      false,  true,
         "MeshMaxConcurrentRequests",
         "mesh fetch"
     },
     { // AP_MESH2
-        8,      1,      32,     0,      true,
+        8,      1,      32,     0,      true,   true,
         "Mesh2MaxConcurrentRequests",
         "mesh2 fetch"
     },
     { // AP_LARGE_MESH
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  false,
         "",
         "large mesh fetch"
     },
     { // AP_UPLOADS
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  false,
         "",
         "asset upload"
     },
     { // AP_LONG_POLL
-        32,     32,     32,     0,      false,
+        32,     32,     32,     0,      false,  false,
         "",
         "long poll"
     },
     { // AP_INVENTORY
-        4,      1,      4,      0,      false,
+        4,      1,      4,      0,      false,  false,
         "",
         "inventory"
     },
     { // AP_MATERIALS
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  false,
         "RenderMaterials",
         "material manager requests"
     },
     { // AP_AGENT
-        2,      1,      32,     0,      false,
+        2,      1,      32,     0,      false,  false,
         "Agent",
         "Agent requests"
     }
@@ -428,6 +429,35 @@ void LLAppCoreHttp::refreshSettings(bool initial)
                 }
             }
 
+            // <FS> HTTP/2 multiplexing
+            // Offer HTTP/2 to the CDN classes.  Takes precedence over
+            // pipelining for these classes, and hosts that only speak
+            // HTTP/1.1 get one request per connection.
+            static const std::string http2_stream_limit("FSHttp2StreamLimit");
+            if (init_data[i].mHttp2 && gSavedSettings.controlExists(http2_stream_limit))
+            {
+                const U32 streams(gSavedSettings.getU32(http2_stream_limit));
+                if (streams)
+                {
+                    status = LLCore::HttpRequest::setStaticPolicyOption(LLCore::HttpRequest::PO_HTTP2_STREAM_LIMIT,
+                                                                        mHttpClasses[app_policy].mPolicy,
+                                                                        streams,
+                                                                        NULL);
+                    if (! status)
+                    {
+                        LL_WARNS("Init") << "Unable to set " << init_data[i].mUsage
+                                         << " HTTP/2 stream limit.  Reason:  " << status.toString()
+                                         << LL_ENDL;
+                    }
+                    else
+                    {
+                        LL_INFOS("Init") << "HTTP/2 enabled for " << init_data[i].mUsage
+                                         << " with up to " << streams << " streams per connection"
+                                         << LL_ENDL;
+                    }
+                }
+            }
+            // </FS>
         }
 
         // Init- or run-time settings.  Must use the queued request API.
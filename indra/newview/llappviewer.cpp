@@ -69,6 +69,8 @@
 #endif
 #include "lltexturestats.h"
 #include "lltrace.h"
+#include "lltracecapture.h" // <FS/> Trace capture
+#include "lltraceframebudget.h" // <FS/> Frame budget
 #include "lltracethreadrecorder.h"
 #include "llviewerwindow.h"
 #include "llviewerdisplay.h"
@@ -1567,6 +1569,71 @@ bool LLAppViewer::frame()
     return ret;
 }
 
+// <FS> Trace capture
+static LLTrace::TraceCaptureWriter sFrameStatsCapture;
+
+// Appends the frame that just ended to the capture while FSTraceCapture is
+// set, starting a new capture each time it gets set
+static void captureFrameStats()
+{
+    static LLCachedControl<bool> trace_capture(gSavedSettings, "FSTraceCapture", false);
+    LLTrace::TraceCaptureWriter& writer = sFrameStatsCapture;
+
+    if (trace_capture && !writer.isOpen())
+    {
+        if (!writer.open(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "frame_stats.lltrace")))
+        {
+            gSavedSettings.setBOOL("FSTraceCapture", false);
+            return;
+        }
+    }
+    else if (!trace_capture && writer.isOpen())
+    {
+        writer.close();
+    }
+
+    if (writer.isOpen())
+    {
+        writer.writeFrame(LLTrace::get_frame_recording().getLastRecording());
+    }
+}
+// </FS>
+
+// <FS> Frame budget
+static LLTrace::FrameBudget sFrameBudget;
+
+static void writeFrameBudgetReport()
+{
+    sFrameBudget.writeReport(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "frame_budget.json"));
+}
+
+// Closes the frame budget's frame while FSFrameBudget is set, writing the
+// report when it gets unset. The report is written on exit as well.
+static void updateFrameBudget()
+{
+    static LLCachedControl<bool> frame_budget(gSavedSettings, "FSFrameBudget", false);
+
+    if (frame_budget && !sFrameBudget.isActive())
+    {
+        // the frame that just ended had no scopes charging it
+        sFrameBudget.reset();
+        sFrameBudget.setActive(true);
+        return;
+    }
+    else if (!frame_budget && sFrameBudget.isActive())
+    {
+        sFrameBudget.setActive(false);
+        writeFrameBudgetReport();
+    }
+
+    if (sFrameBudget.isActive())
+    {
+        F64Milliseconds frame_time(LLTrace::get_frame_recording().getLastRecording().getDuration());
+        sFrameBudget.endFrame(frame_time.value());
+    }
+}
+// </FS>
+
 bool LLAppViewer::doFrame()
 {
     resumeMainloopTimeout("Main:doFrameStart");
@@ -1592,7 +1659,11 @@ bool LLAppViewer::doFrame()
         LLWorld::createInstance();
     }
 
-    LLEventPump& mainloop(LLEventPumps::instance().obtain("mainloop"));
+    // <FS> Interned strings
+    //LLEventPump& mainloop(LLEventPumps::instance().obtain("mainloop"));
+    static const LLInternedString MAINLOOP("mainloop");
+    LLEventPump& mainloop(LLEventPumps::instance().obtain(MAINLOOP));
+    // </FS>
     LLSD newFrame;
     LLTimer frameTimer; // <FS:Beq/> relocated - <FS:Ansariel> FIRE-22297: FPS limiter not working properly on Mac/Linux
     {
@@ -1640,6 +1711,8 @@ bool LLAppViewer::doFrame()
 
             LLTrace::get_frame_recording().nextPeriod();
             LLTrace::BlockTimer::logStats();
+            captureFrameStats(); // <FS/> Trace capture
+            updateFrameBudget(); // <FS/> Frame budget
         }
 
         LLTrace::get_thread_recorder()->pullFromChildren();
@@ -2492,6 +2565,14 @@ bool LLAppViewer::cleanup()
     sImageDecodeThread = NULL;
     delete mFastTimerLogThread;
     mFastTimerLogThread = NULL;
+    sFrameStatsCapture.close(); // <FS/> Trace capture
+    // <FS> Frame budget
+    if (sFrameBudget.isActive())
+    {
+        sFrameBudget.setActive(false);
+        writeFrameBudgetReport();
+    }
+    // </FS>
     delete sPurgeDiskCacheThread;
     sPurgeDiskCacheThread = NULL;
     delete mGeneralThreadPool;
@@ -6180,6 +6261,7 @@ void LLAppViewer::idle()
 
     {
         LL_RECORD_BLOCK_TIME(FTM_OBJECTLIST_UPDATE);
+        LL_RECORD_FRAME_BUDGET(OBJECT_UPDATES); // <FS/> Frame budget
 
         if (!(logoutRequestSent() && hasSavedFinalSnapshot()))
         {
@@ -6683,6 +6765,7 @@ void LLAppViewer::idleNetwork()
     if (!speed_test())
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_NETWORK("idle network"); //LL_RECORD_BLOCK_TIME(FTM_IDLE_NETWORK); // decode
+        LL_RECORD_FRAME_BUDGET(NETWORK); // <FS/> Frame budget
 
         LLTimer check_message_timer;
         //  Read all available packets from network
@@ -0,0 +1,46 @@
+/**
+ * @file llavatarcomplexity.cpp
+ * @brief Main thread time budget for avatar render complexity updates.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llavatarcomplexity.h"
+
+LLAvatarComplexityBudget::LLAvatarComplexityBudget(F64 seconds_per_frame)
+    : mSecondsPerFrame(seconds_per_frame),
+      mSpent(0.0),
+      mFrame(0)
+{
+}
+
+bool LLAvatarComplexityBudget::canSpend(U32 frame)
+{
+    if (frame != mFrame)
+    {
+        mFrame = frame;
+        mSpent = 0.0;
+    }
+    return mSecondsPerFrame <= 0.0 || mSpent < mSecondsPerFrame;
+}
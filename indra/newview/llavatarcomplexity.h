@@ -0,0 +1,65 @@
+/**
+ * @file llavatarcomplexity.h
+ * @brief Main thread time budget for avatar render complexity updates.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLAVATARCOMPLEXITY_H
+#define LL_LLAVATARCOMPLEXITY_H
+
+//-----------------------------------------------------------------------------
+// class LLAvatarComplexityBudget
+//
+// Attachment costs are read from the viewer objects, so they have to be
+// gathered on the main thread. When many avatars arrive or change outfits at
+// once that used to take several milliseconds in a single frame. The budget
+// spreads the work out: every avatar updated in a frame draws from the same
+// allowance, and an avatar that runs out leaves its remaining attachments
+// dirty for the next frame.
+//-----------------------------------------------------------------------------
+class LLAvatarComplexityBudget
+{
+public:
+    LLAvatarComplexityBudget(F64 seconds_per_frame = 0.0);
+
+    // 0 means no limit
+    void setSecondsPerFrame(F64 seconds)    { mSecondsPerFrame = seconds; }
+    F64 getSecondsPerFrame() const          { return mSecondsPerFrame; }
+
+    // May another attachment be updated in this frame? The first one of each
+    // frame always may, so every frame makes progress.
+    bool canSpend(U32 frame);
+
+    // Record the time an attachment update took
+    void spend(F64 seconds)                 { mSpent += seconds; }
+
+    // Time recorded so far in the current frame
+    F64 getSpent() const                    { return mSpent; }
+
+private:
+    F64 mSecondsPerFrame;
+    F64 mSpent;
+    U32 mFrame;
+};
+
+#endif // LL_LLAVATARCOMPLEXITY_H
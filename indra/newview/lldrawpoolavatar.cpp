@@ -59,6 +59,7 @@
 // void drawBoxOutline(const LLVector3& pos,const LLVector3& size); // llspatialpartition.cpp
 // </FS:Zi>
 #include "llnetmap.h"
+#include "lltraceframebudget.h" // <FS/> Frame budget
 
 
 static U32 sShaderLevel = 0;
@@ -674,6 +675,7 @@ void LLDrawPoolAvatar::endDeferredSkinned()
 void LLDrawPoolAvatar::renderAvatars(LLVOAvatar* single_avatar, S32 pass)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR; //LL_RECORD_BLOCK_TIME(FTM_RENDER_CHARACTERS);
+    LL_RECORD_FRAME_BUDGET(AVATARS); // <FS/> Frame budget
 
     if (pass == -1)
     {
@@ -86,7 +86,10 @@ bool LLEmote::onActivate()
     {
         // <FS:Ansariel> [Legacy Bake]
         //default_param->setWeight( default_param->getMaxWeight());
-        default_param->setWeight( default_param->getMaxWeight(), false);
+        // <FS> Parallel animation evaluation: through the character, which queues it while motions update
+        //default_param->setWeight( default_param->getMaxWeight(), false);
+        mCharacter->setVisualParamWeight( default_param, default_param->getMaxWeight(), false);
+        // </FS>
     }
 
     mParam = mCharacter->getVisualParam(mName.c_str());
@@ -94,7 +97,10 @@ bool LLEmote::onActivate()
     {
         // <FS:Ansariel> [Legacy Bake]
         //mParam->setWeight(0.f);
-        mParam->setWeight(0.f, false);
+        // <FS> Parallel animation evaluation
+        //mParam->setWeight(0.f, false);
+        mCharacter->setVisualParamWeight(mParam, 0.f, false);
+        // </FS>
         mCharacter->updateVisualParams();
     }
 
@@ -110,15 +116,18 @@ bool LLEmote::onUpdate(F32 time, U8* joint_mask)
     if( mParam )
     {
         F32 weight = mParam->getMinWeight() + mPose.getWeight() * (mParam->getMaxWeight() - mParam->getMinWeight());
-        // <FS:Ansariel> [Legacy Bake]
-        //mParam->setWeight(weight);
-        mParam->setWeight(weight, false);
-
         // <FS:ND> mCharacter being 0 might be one of the reasons for FIRE-11529
         if( !mCharacter )
             return true;
         // </FS:ND>
 
+        // <FS:Ansariel> [Legacy Bake]
+        //mParam->setWeight(weight);
+        // <FS> Parallel animation evaluation: this runs on a worker thread, the character queues the weight
+        //mParam->setWeight(weight, false);
+        mCharacter->setVisualParamWeight(mParam, weight, false);
+        // </FS>
+
         // Cross fade against the default parameter
         LLVisualParam* default_param = mCharacter->getVisualParam( "Express_Closed_Mouth" );
         if( default_param )
@@ -128,7 +137,10 @@ bool LLEmote::onUpdate(F32 time, U8* joint_mask)
 
             // <FS:Ansariel> [Legacy Bake]
             //default_param->setWeight( default_param_weight);
-            default_param->setWeight( default_param_weight, false);
+            // <FS> Parallel animation evaluation
+            //default_param->setWeight( default_param_weight, false);
+            mCharacter->setVisualParamWeight( default_param, default_param_weight, false);
+            // </FS>
         }
 
         mCharacter->updateVisualParams();
@@ -147,7 +159,10 @@ void LLEmote::onDeactivate()
     {
         // <FS:Ansariel> [Legacy Bake]
         //mParam->setWeight( mParam->getDefaultWeight());
-        mParam->setWeight( mParam->getDefaultWeight(), false);
+        // <FS> Parallel animation evaluation: after any weight still queued by onUpdate()
+        //mParam->setWeight( mParam->getDefaultWeight(), false);
+        mCharacter->setVisualParamWeight( mParam, mParam->getDefaultWeight(), false);
+        // </FS>
     }
 
     LLVisualParam* default_param = mCharacter->getVisualParam( "Express_Closed_Mouth" );
@@ -155,7 +170,10 @@ void LLEmote::onDeactivate()
     {
         // <FS:Ansariel> [Legacy Bake]
         //default_param->setWeight( default_param->getMaxWeight());
-        default_param->setWeight( default_param->getMaxWeight(), false);
+        // <FS> Parallel animation evaluation
+        //default_param->setWeight( default_param->getMaxWeight(), false);
+        mCharacter->setVisualParamWeight( default_param, default_param->getMaxWeight(), false);
+        // </FS>
     }
 
     mCharacter->updateVisualParams();
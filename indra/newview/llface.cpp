@@ -2437,7 +2437,10 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
                     const LLMeshSkinInfo* skin = vo_volume->getSkinInfo();
                     if (skin)
                     {
-                        LLSkinningUtil::updateRiggingInfo(skin, avatar, face);
+                        // <FS> Shared rigging info cache
+                        //LLSkinningUtil::updateRiggingInfo(skin, avatar, face);
+                        LLSkinningUtil::updateRiggingInfo(skin, avatar, volume, mTEOffset);
+                        // </FS>
                     }
                 }
 
@@ -2511,8 +2511,11 @@ EMeshProcessingResult LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_p
                 for (S32 i = 0; i < num_faces; ++i)
                 {
                     // NOTE: no need to lock gAgentAvatarp as the state being checked is not changed after initialization
-                    LLVolumeFace& face = volume->getVolumeFace(i);
-                    LLSkinningUtil::updateRiggingInfo(skin_info, gAgentAvatarp, face);
+                    // <FS> Shared rigging info cache
+                    //LLVolumeFace& face = volume->getVolumeFace(i);
+                    //LLSkinningUtil::updateRiggingInfo(skin_info, gAgentAvatarp, face);
+                    LLSkinningUtil::updateRiggingInfo(skin_info, gAgentAvatarp, volume, i);
+                    // </FS>
                 }
             }
 
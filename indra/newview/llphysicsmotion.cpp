@@ -259,9 +259,20 @@ void LLPhysicsMotionController::onDeactivate()
 {
 }
 
+// <FS> Parallel animation evaluation
+// onUpdate() may run on a worker thread, so the setting is first looked up
+// from onInitialize() on the main thread.
+static bool avatar_physics_enabled()
+{
+    static LLCachedControl<bool> av_physics(gSavedSettings, "AvatarPhysics");
+    return av_physics;
+}
+// </FS>
+
 LLMotion::LLMotionInitStatus LLPhysicsMotionController::onInitialize(LLCharacter *character)
 {
         mCharacter = character;
+        avatar_physics_enabled(); // <FS/> Parallel animation evaluation
 
         mMotions.clear();
 
@@ -455,8 +466,11 @@ bool LLPhysicsMotionController::onUpdate(F32 time, U8* joint_mask)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     // Skip if disabled globally.
-    static LLCachedControl<bool> av_physics(gSavedSettings, "AvatarPhysics");
-    if (!av_physics)
+    // <FS> Parallel animation evaluation
+    //static LLCachedControl<bool> av_physics(gSavedSettings, "AvatarPhysics");
+    //if (!av_physics)
+    if (!avatar_physics_enabled())
+    // </FS>
     {
             return true;
     }
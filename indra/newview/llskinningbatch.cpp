@@ -0,0 +1,208 @@
+/**
+ * @file llskinningbatch.cpp
+ * @brief Batched skinning of whole volume faces.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llskinningbatch.h"
+#include "llparallelfor.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__AVX2__)
+    // Blend the four palette matrices a vertex is rigged to. Each 256 bit
+    // register holds two rows of a matrix, so this takes half the multiplies
+    // and adds of the SSE2 version, in the same order.
+    LL_FORCE_INLINE void blendPalette(const LLMatrix4a* palette, const U8* idx, const LLVector4a& weight,
+                                      LLMatrix4a& final_mat)
+    {
+        const F32* w = weight.getF32ptr();
+        __m256 w_k = _mm256_broadcast_ss(w);
+        __m256 rows01 = _mm256_mul_ps(_mm256_loadu_ps(palette[idx[0]].mMatrix[0].getF32ptr()), w_k);
+        __m256 rows23 = _mm256_mul_ps(_mm256_loadu_ps(palette[idx[0]].mMatrix[2].getF32ptr()), w_k);
+        for (U32 k = 1; k < 4; ++k)
+        {
+            w_k = _mm256_broadcast_ss(w + k);
+            rows01 = _mm256_add_ps(rows01, _mm256_mul_ps(_mm256_loadu_ps(palette[idx[k]].mMatrix[0].getF32ptr()), w_k));
+            rows23 = _mm256_add_ps(rows23, _mm256_mul_ps(_mm256_loadu_ps(palette[idx[k]].mMatrix[2].getF32ptr()), w_k));
+        }
+        final_mat.mMatrix[0] = _mm256_castps256_ps128(rows01);
+        final_mat.mMatrix[1] = _mm256_extractf128_ps(rows01, 1);
+        final_mat.mMatrix[2] = _mm256_castps256_ps128(rows23);
+        final_mat.mMatrix[3] = _mm256_extractf128_ps(rows23, 1);
+    }
+#else
+    // Blend the four palette matrices a vertex is rigged to, adding the
+    // weighted matrices in the same order as getPerVertexSkinMatrixWithIndices().
+    LL_FORCE_INLINE void blendPalette(const LLMatrix4a* palette, const U8* idx, const LLVector4a& weight,
+                                      LLMatrix4a& final_mat)
+    {
+        const __m128 w0 = _mm_shuffle_ps(weight, weight, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 w1 = _mm_shuffle_ps(weight, weight, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 w2 = _mm_shuffle_ps(weight, weight, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 w3 = _mm_shuffle_ps(weight, weight, _MM_SHUFFLE(3, 3, 3, 3));
+        const LLMatrix4a& m0 = palette[idx[0]];
+        const LLMatrix4a& m1 = palette[idx[1]];
+        const LLMatrix4a& m2 = palette[idx[2]];
+        const LLMatrix4a& m3 = palette[idx[3]];
+
+        for (U32 r = 0; r < 4; ++r)
+        {
+            __m128 row = _mm_mul_ps(m0.mMatrix[r], w0);
+            row = _mm_add_ps(row, _mm_mul_ps(m1.mMatrix[r], w1));
+            row = _mm_add_ps(row, _mm_mul_ps(m2.mMatrix[r], w2));
+            row = _mm_add_ps(row, _mm_mul_ps(m3.mMatrix[r], w3));
+            final_mat.mMatrix[r] = row;
+        }
+    }
+#endif
+
+    template<bool NORMALS>
+    LL_FORCE_INLINE void skinOne(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                                 const U8* joint_indices, const LLVector4a* weights,
+                                 const LLVector4a* src_pos, LLVector4a* dst_pos,
+                                 const LLVector4a* src_norm, LLVector4a* dst_norm, U32 i)
+    {
+        LLMatrix4a final_mat;
+        blendPalette(palette, joint_indices + i * 4, weights[i], final_mat);
+
+        LLVector4a t;
+        bind_shape.affineTransform(src_pos[i], t);
+        final_mat.affineTransform(t, dst_pos[i]);
+
+        if (NORMALS)
+        {
+            LLVector4a n;
+            bind_shape.rotate(src_norm[i], n);
+            final_mat.rotate(n, dst_norm[i]);
+            dst_norm[i].normalize3fast();
+        }
+    }
+
+    template<bool NORMALS>
+    void skinRange(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                   const U8* joint_indices, const LLVector4a* weights,
+                   const LLVector4a* src_pos, LLVector4a* dst_pos,
+                   const LLVector4a* src_norm, LLVector4a* dst_norm,
+                   U32 begin, U32 end)
+    {
+        // Several independent vertices per iteration, so their palette loads
+        // and multiplies overlap: eight with AVX2, four with SSE2
+#if defined(__AVX2__)
+        constexpr U32 UNROLL = 8;
+#else
+        constexpr U32 UNROLL = 4;
+#endif
+        U32 i = begin;
+        for (; i + UNROLL <= end; i += UNROLL)
+        {
+            for (U32 j = 0; j < UNROLL; ++j)
+            {
+                skinOne<NORMALS>(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, src_norm, dst_norm, i + j);
+            }
+        }
+        for (; i < end; ++i)
+        {
+            skinOne<NORMALS>(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, src_norm, dst_norm, i);
+        }
+    }
+}
+
+void LLSkinningUtil::SkinWeights::decode(const LLVector4a* weights, U32 num_vertices, U32 max_joints, U64 serial)
+{
+    llassert(max_joints > 0 && max_joints <= 256);
+
+    mSerial = serial;
+    mWeights.resize(num_vertices);
+    mJointIndices.resize(num_vertices * 4);
+
+    const __m128i max_idx = _mm_set1_epi16((S16)(max_joints - 1));
+    const __m128i zero = _mm_setzero_si128();
+    for (U32 i = 0; i < num_vertices; ++i)
+    {
+        const __m128 packed = weights[i];
+        __m128i idx = _mm_cvttps_epi32(packed);
+        __m128 weight = _mm_sub_ps(packed, _mm_cvtepi32_ps(idx));
+        // indices are small, so a 16 bit min/max clamps the 32 bit values
+        idx = _mm_max_epi16(_mm_min_epi16(idx, max_idx), zero);
+
+        __m128 scale = _mm_add_ps(weight, _mm_movehl_ps(weight, weight));
+        scale = _mm_add_ss(scale, _mm_shuffle_ps(scale, scale, 1));
+        scale = _mm_shuffle_ps(scale, scale, 0);
+        mWeights[i] = _mm_div_ps(weight, scale);
+
+        S32 bytes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(idx, zero), zero));
+        memcpy(&mJointIndices[i * 4], &bytes, 4);
+    }
+}
+
+void LLSkinningUtil::SkinWeights::clear()
+{
+    mSerial = 0;
+    mWeights.clear();
+    mJointIndices.clear();
+}
+
+void LLSkinningUtil::skinVertices(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                                  const U8* joint_indices, const LLVector4a* weights,
+                                  const LLVector4a* src_pos, LLVector4a* dst_pos,
+                                  const LLVector4a* src_norm, LLVector4a* dst_norm,
+                                  U32 begin, U32 end)
+{
+    if (src_norm && dst_norm)
+    {
+        skinRange<true>(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, src_norm, dst_norm, begin, end);
+    }
+    else
+    {
+        skinRange<false>(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, nullptr, nullptr, begin, end);
+    }
+}
+
+void LLSkinningUtil::skinVerticesParallel(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                                          const U8* joint_indices, const LLVector4a* weights,
+                                          const LLVector4a* src_pos, LLVector4a* dst_pos,
+                                          const LLVector4a* src_norm, LLVector4a* dst_norm,
+                                          U32 num_vertices, const std::string& queue)
+{
+    const U32 chunks = (num_vertices + SKIN_CHUNK_VERTICES - 1) / SKIN_CHUNK_VERTICES;
+    if (chunks < 2)
+    {
+        skinVertices(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, src_norm, dst_norm, 0, num_vertices);
+        return;
+    }
+
+    LL::parallel_for(queue, chunks,
+        [&](size_t chunk)
+        {
+            const U32 begin = (U32)chunk * SKIN_CHUNK_VERTICES;
+            const U32 end = llmin(begin + SKIN_CHUNK_VERTICES, num_vertices);
+            skinVertices(bind_shape, palette, joint_indices, weights, src_pos, dst_pos, src_norm, dst_norm, begin, end);
+        });
+}
@@ -0,0 +1,95 @@
+/**
+ * @file llskinningbatch.h
+ * @brief Batched skinning of whole volume faces.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSKINNINGBATCH_H
+#define LL_LLSKINNINGBATCH_H
+
+#include "llvector4a.h"
+#include "llmatrix4a.h"
+
+#include <string>
+#include <vector>
+
+// Skinning for a whole face at a time instead of one
+// getPerVertexSkinMatrix() call per vertex. These only touch the arrays they
+// are given, so large faces can be split across the General pool and tests
+// can run them without an avatar.
+namespace LLSkinningUtil
+{
+    // Joint indices and normalized weights for every vertex of a face, decoded
+    // once from the packed <joint_index>.<weight> floats in LLVolumeFace::mWeights.
+    class SkinWeights
+    {
+    public:
+        // Same clamping and normalization as
+        // FSSkinningUtil::getPerVertexSkinMatrixSSE(). serial is the face's
+        // LLVolumeFace::mWeightsSerial, 0 for weights not from a face.
+        void decode(const LLVector4a* weights, U32 num_vertices, U32 max_joints, U64 serial = 0);
+        void clear();
+
+        // Was this decoded from the weights with this serial? Never for 0.
+        bool isDecodedFrom(U64 serial, U32 num_vertices) const
+        {
+            return serial && mSerial == serial && size() == num_vertices;
+        }
+
+        U32 size() const                        { return (U32)mWeights.size(); }
+        const LLVector4a* getWeights() const    { return mWeights.data(); }
+        const U8* getJointIndices() const       { return mJointIndices.data(); }
+
+    private:
+        U64 mSerial = 0;
+        std::vector<LLVector4a> mWeights;
+        std::vector<U8> mJointIndices;          // 4 per vertex
+    };
+
+    // Skin vertices [begin, end). Each position is moved by bind_shape, then by
+    // the palette matrices picked by joint_indices and blended with weights,
+    // as LLRiggedVolume::update() does per vertex. Normals are optional (pass
+    // null): they get the rotation part of the same two transforms, as in the
+    // rigged shaders, and are renormalized.
+    // With AVX2 enabled at compile time this runs two vertices per register
+    // and eight per iteration, otherwise four per iteration with SSE2.
+    void skinVertices(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                      const U8* joint_indices, const LLVector4a* weights,
+                      const LLVector4a* src_pos, LLVector4a* dst_pos,
+                      const LLVector4a* src_norm, LLVector4a* dst_norm,
+                      U32 begin, U32 end);
+
+    // Vertices per job when skinVerticesParallel() splits a face.
+    constexpr U32 SKIN_CHUNK_VERTICES = 4096;
+
+    // skinVertices() over [0, num_vertices). Faces of at least two chunks are
+    // split across the threads of the named work queue; smaller ones run
+    // inline, since posting would cost more than it saves.
+    void skinVerticesParallel(const LLMatrix4a& bind_shape, const LLMatrix4a* palette,
+                              const U8* joint_indices, const LLVector4a* weights,
+                              const LLVector4a* src_pos, LLVector4a* dst_pos,
+                              const LLVector4a* src_norm, LLVector4a* dst_norm,
+                              U32 num_vertices, const std::string& queue = "General");
+}
+
+#endif // LL_LLSKINNINGBATCH_H
@@ -33,6 +33,8 @@
 #include "llmeshrepository.h"
 #include "llvolume.h"
 #include "llrigginginfo.h"
+#include "llrigginginfocache.h" // <FS/> Shared rigging info cache
+#include "llvolumemgr.h" // <FS/> Shared rigging info cache
 
 #define DEBUG_SKINNING  LL_DEBUG
 
@@ -334,50 +336,98 @@ void LLSkinningUtil::updateRiggingInfo(const LLMeshSkinInfo* skin, LLVOAvatar *a
             if (vol_face.mJointRiggingInfoTab.size()==0)
             {
                 vol_face.mJointRiggingInfoTab.resize(LL_CHARACTER_MAX_ANIMATED_JOINTS);
-                LLJointRiggingInfoTab &rig_info_tab = vol_face.mJointRiggingInfoTab;
-                for (S32 i=0; i<vol_face.mNumVertices; i++)
-                {
-                    LLVector4a& pos = vol_face.mPositions[i];
-                    F32 *weights = vol_face.mWeights[i].getF32ptr();
-                    LLVector4 wght;
-                    S32 idx[4];
-                    F32 scale = 0.0f;
-                    // FIXME unpacking of weights should be pulled into a common function and optimized if possible.
-                    for (U32 k = 0; k < 4; k++)
-                    {
-                        F32 w = weights[k];
-                        idx[k] = llclamp((S32) floorf(w), (S32)0, (S32)LL_CHARACTER_MAX_ANIMATED_JOINTS-1);
-                        wght[k] = w - idx[k];
-                    }
-
-                    for (U32 k=0; k<4; ++k)
-                    {
-                        S32 joint_index = idx[k];
-                        if (wght[k] > 0.2f && num_joints > joint_index)
-                        {
-                            S32 joint_num = skin->mJointNums[joint_index];
-                            if (joint_num >= 0 && joint_num < LL_CHARACTER_MAX_ANIMATED_JOINTS)
-                            {
-                                rig_info_tab[joint_num].setIsRiggedTo(true);
-
-                                size_t bind_poses_size = skin->mBindPoseMatrix.size();
-                                const LLMatrix4a& mat = bind_poses_size > joint_index ? skin->mBindPoseMatrix[joint_index] : LLMatrix4a::identity();
-                                LLVector4a pos_joint_space;
-
-                                mat.affineTransform(pos, pos_joint_space);
-
-                                LLVector4a *extents = rig_info_tab[joint_num].getRiggedExtents();
-                                update_min_max(extents[0], extents[1], pos_joint_space);
-                            }
-                        }
-                    }
-                }
+                // <FS> Shared rigging info cache: the vertex scan moved to
+                // LLJointRiggingInfoTab::addRiggedVertices()
+                //LLJointRiggingInfoTab &rig_info_tab = vol_face.mJointRiggingInfoTab;
+                //for (S32 i=0; i<vol_face.mNumVertices; i++)
+                //{
+                //    LLVector4a& pos = vol_face.mPositions[i];
+                //    F32 *weights = vol_face.mWeights[i].getF32ptr();
+                //    LLVector4 wght;
+                //    S32 idx[4];
+                //    F32 scale = 0.0f;
+                //    // FIXME unpacking of weights should be pulled into a common function and optimized if possible.
+                //    for (U32 k = 0; k < 4; k++)
+                //    {
+                //        F32 w = weights[k];
+                //        idx[k] = llclamp((S32) floorf(w), (S32)0, (S32)LL_CHARACTER_MAX_ANIMATED_JOINTS-1);
+                //        wght[k] = w - idx[k];
+                //    }
+
+                //    for (U32 k=0; k<4; ++k)
+                //    {
+                //        S32 joint_index = idx[k];
+                //        if (wght[k] > 0.2f && num_joints > joint_index)
+                //        {
+                //            S32 joint_num = skin->mJointNums[joint_index];
+                //            if (joint_num >= 0 && joint_num < LL_CHARACTER_MAX_ANIMATED_JOINTS)
+                //            {
+                //                rig_info_tab[joint_num].setIsRiggedTo(true);
+
+                //                size_t bind_poses_size = skin->mBindPoseMatrix.size();
+                //                const LLMatrix4a& mat = bind_poses_size > joint_index ? skin->mBindPoseMatrix[joint_index] : LLMatrix4a::identity();
+                //                LLVector4a pos_joint_space;
+
+                //                mat.affineTransform(pos, pos_joint_space);
+
+                //                LLVector4a *extents = rig_info_tab[joint_num].getRiggedExtents();
+                //                update_min_max(extents[0], extents[1], pos_joint_space);
+                //            }
+                //        }
+                //    }
+                //}
+                vol_face.mJointRiggingInfoTab.addRiggedVertices(vol_face.mPositions, vol_face.mWeights, num_verts,
+                                                                skin->mJointNums.data(), num_joints,
+                                                                skin->mBindPoseMatrix.data(), (S32)skin->mBindPoseMatrix.size());
+                // </FS>
                 vol_face.mJointRiggingInfoTab.setNeedsUpdate(false);
             }
         }
     }
 }
 
+// <FS> Shared rigging info cache
+LLRiggingInfoCache& LLSkinningUtil::getRiggingInfoCache()
+{
+    static LLRiggingInfoCache cache;
+    return cache;
+}
+
+void LLSkinningUtil::updateRiggingInfo(const LLMeshSkinInfo* skin, LLVOAvatar *avatar, LLVolume* volume, S32 face)
+{
+    LLVolumeFace& vol_face = volume->getVolumeFace(face);
+    LLJointRiggingInfoTab& rig_info_tab = vol_face.mJointRiggingInfoTab;
+    if (!rig_info_tab.needsUpdate() || rig_info_tab.size() != 0 || skin->mMeshID.isNull()
+        || vol_face.mNumVertices <= 0 || !vol_face.mWeights || skin->mJointNames.empty())
+    {
+        // Nothing to compute, or nothing to key it by
+        updateRiggingInfo(skin, avatar, vol_face);
+        return;
+    }
+
+    LLRiggingInfoCache::Key key;
+    key.mMeshID = skin->mMeshID;
+    key.mSkinHash = skin->mHash;
+    key.mLOD = LLVolumeLODGroup::getVolumeDetailFromScale(volume->getDetail());
+    key.mFace = face;
+    key.mNumVertices = vol_face.mNumVertices;
+
+    LLRiggingInfoCache& cache = getRiggingInfoCache();
+    if (cache.get(key, rig_info_tab))
+    {
+        initJointNums(const_cast<LLMeshSkinInfo*>(skin), avatar);
+        rig_info_tab.setNeedsUpdate(false);
+        return;
+    }
+
+    updateRiggingInfo(skin, avatar, vol_face);
+    if (!rig_info_tab.needsUpdate())
+    {
+        cache.put(key, rig_info_tab);
+    }
+}
+// </FS>
+
 // This is used for extracting rotation from a bind shape matrix that
 // already has scales baked in
 LLQuaternion LLSkinningUtil::getUnscaledQuaternion(const LLMatrix4& mat4)
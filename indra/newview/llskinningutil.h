@@ -36,6 +36,8 @@ class LLVOAvatar;
 class LLMeshSkinInfo;
 class LLVolumeFace;
 class LLJointRiggingInfoTab;
+class LLRiggingInfoCache; // <FS/> Shared rigging info cache
+class LLVolume; // <FS/> Shared rigging info cache
 
 namespace LLSkinningUtil
 {
@@ -68,6 +70,12 @@ namespace LLSkinningUtil
 
     void initJointNums(LLMeshSkinInfo* skin, LLVOAvatar *avatar);
     void updateRiggingInfo(const LLMeshSkinInfo* skin, LLVOAvatar *avatar, LLVolumeFace& vol_face);
+    // <FS> Shared rigging info cache
+    // As above for face of volume, reusing the rigging info computed for the
+    // same mesh, LOD and face by any other volume
+    void updateRiggingInfo(const LLMeshSkinInfo* skin, LLVOAvatar *avatar, LLVolume* volume, S32 face);
+    LLRiggingInfoCache& getRiggingInfoCache();
+    // </FS>
     LLQuaternion getUnscaledQuaternion(const LLMatrix4& mat4);
 };
 
@@ -45,6 +45,8 @@
 #include "llviewerregion.h"
 #include "lldrawpoolterrain.h"
 #include "llworldmipmap.h"
+#include "llparallelfor.h" // <FS> batched patch rebuild
+#include "noise.h"
 
 extern LLPipeline gPipeline;
 extern bool gShiftFrame;
@@ -802,13 +804,15 @@ bool LLSurface::idleUpdate(F32 max_update_time)
 
     // Always call updateNormals() / updateVerticalStats()
     //  every frame to avoid artifacts
+    // <FS> Rebuild dirty patches as batched jobs on the General pool
+    rebuildDirtyPatches<PBR>();
+    // </FS>
+
     for(std::set<LLSurfacePatch *>::iterator iter = mDirtyPatchList.begin();
         iter != mDirtyPatchList.end(); )
     {
         std::set<LLSurfacePatch *>::iterator curiter = iter++;
         LLSurfacePatch *patchp = *curiter;
-        patchp->updateNormals<PBR>();
-        patchp->updateVerticalStats();
         if (max_update_time == 0.f || update_timer.getElapsedTimeF32() < max_update_time)
         {
             if (patchp->updateTexture())
@@ -829,17 +833,133 @@ bool LLSurface::idleUpdate(F32 max_update_time)
 template bool LLSurface::idleUpdate</*PBR=*/false>(F32 max_update_time);
 template bool LLSurface::idleUpdate</*PBR=*/true>(F32 max_update_time);
 
+// <FS> Rebuild dirty patches as batched jobs on the General pool
+template<bool PBR>
+void LLSurface::rebuildDirtyPatches()
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (mDirtyPatchList.empty())
+    {
+        return;
+    }
+
+    const bool water = (mType == 'w');
+    std::vector<LLSurfacePatch*> patches;
+    std::vector<bool> middle_dirty;
+    std::vector<bool> dirty;
+    patches.reserve(mDirtyPatchList.size());
+
+    // Borders first, on this thread: they read the neighbor patches and may
+    // patch up shared corner heights, which the interior pass and the stats
+    // below must see. Only the borders flagged by the dirty-region tracking
+    // in dirtyZ() are recomputed.
+    for (LLSurfacePatch* patchp : mDirtyPatchList)
+    {
+        patches.push_back(patchp);
+        middle_dirty.push_back(!water && patchp->hasInvalidMiddleNormals());
+        dirty.push_back(!water && patchp->updateBorderNormals<PBR>());
+    }
+
+    // Interiors and vertical stats only touch their own patch.
+    std::vector<LLSurfaceRebuild::VerticalStats> stats(patches.size());
+    std::vector<bool> stats_dirty(patches.size());
+    for (size_t i = 0; i < patches.size(); ++i)
+    {
+        stats_dirty[i] = patches[i]->hasDirtyZStats();
+    }
+    LL::parallel_for("General", patches.size(),
+                     [&](size_t i)
+                     {
+                         // PBR terrain uses the flat normal path, which reads neighbors
+                         if (middle_dirty[i] && !PBR)
+                         {
+                             patches[i]->updateMiddleNormals<PBR>();
+                         }
+                         if (stats_dirty[i])
+                         {
+                             stats[i] = patches[i]->computeVerticalStats();
+                         }
+                     });
+
+    for (size_t i = 0; i < patches.size(); ++i)
+    {
+        LLSurfacePatch* patchp = patches[i];
+        if (middle_dirty[i] && PBR)
+        {
+            patchp->updateMiddleNormals<PBR>();
+        }
+        if (!water)
+        {
+            patchp->finishNormals(dirty[i] || middle_dirty[i]);
+        }
+        if (stats_dirty[i])
+        {
+            patchp->setVerticalStats(stats[i]);
+        }
+    }
+
+    // Composition heights. generateHeights() writes a patch's rectangle of
+    // the composition plus one texel into its east and north neighbors, so
+    // run one wave per (x, y) parity class: patches within a wave never share
+    // a texel.
+    std::vector<LLSurfacePatch*> waves[4];
+    for (LLSurfacePatch* patchp : patches)
+    {
+        if (patchp->needsHeightsGenerated())
+        {
+            const S32 index = (S32)(patchp - mPatchList);
+            const S32 px = index % mPatchesPerEdge;
+            const S32 py = index / mPatchesPerEdge;
+            waves[(px & 1) | ((py & 1) << 1)].push_back(patchp);
+        }
+    }
+
+    if (!waves[0].empty() || !waves[1].empty() || !waves[2].empty() || !waves[3].empty())
+    {
+        // The noise tables are built on first use; do that here rather than
+        // racing to it from the pool.
+        F32 seed[2] = { 0.f, 0.f };
+        noise2(seed);
+
+        for (const std::vector<LLSurfacePatch*>& wave : waves)
+        {
+            LL::parallel_for("General", wave.size(),
+                             [&wave](size_t i)
+                             {
+                                 wave[i]->generateHeights();
+                             });
+        }
+    }
+}
+
+template void LLSurface::rebuildDirtyPatches</*PBR=*/false>();
+template void LLSurface::rebuildDirtyPatches</*PBR=*/true>();
+// </FS>
+
 void LLSurface::decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool b_large_patch)
 {
+    decoded_terrain_patch_list_t patches;
+    decodeDCTPatches(bitpack, *gopp, b_large_patch, mPatchesPerEdge, patches);
+    applyDecodedPatches(patches, gopp->patch_size);
+}
+
+// static
+void LLSurface::decodeDCTPatches(LLBitPack &bitpack, const LLGroupHeader &goph, bool b_large_patch,
+                                 S32 patches_per_edge, decoded_terrain_patch_list_t &patches)
+{
+    LL_PROFILE_ZONE_SCOPED;
 
     LLPatchHeader  ph;
     S32 j, i;
     S32 patch[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
-    LLSurfacePatch *patchp;
+    const S32 patch_size = goph.patch_size;
 
-    init_patch_decompressor(gopp->patch_size);
-    gopp->stride = mGridsPerEdge;
-    set_group_of_patch_header(gopp);
+    if (patch_size != NORMAL_PATCH_SIZE && patch_size != LARGE_PATCH_SIZE)
+    {
+        LL_WARNS() << "Received invalid terrain packet - unsupported patch size " << patch_size << LL_ENDL;
+        return;
+    }
 
     while (1)
     {
@@ -867,10 +987,10 @@ void LLSurface::decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool
         }
 // </FS:CR> Aurora Sim
 
-        if ((i >= mPatchesPerEdge) || (j >= mPatchesPerEdge))
+        if ((i >= patches_per_edge) || (j >= patches_per_edge))
         {
             LL_WARNS() << "Received invalid terrain packet - patch header patch ID incorrect!"
-                << " patches per edge " << mPatchesPerEdge
+                << " patches per edge " << patches_per_edge
                 << " i " << i
                 << " j " << j
                 << " dc_offset " << ph.dc_offset
@@ -881,11 +1001,36 @@ void LLSurface::decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool
             return;
         }
 
-        patchp = &mPatchList[j*mPatchesPerEdge + i];
+        decode_patch(bitpack, patch);
 
+        patches.emplace_back();
+        LLDecodedTerrainPatch &decoded = patches.back();
+        decoded.mX = i;
+        decoded.mY = j;
+        decoded.mHeights.resize(patch_size*patch_size);
+        decompress_patch_simd(decoded.mHeights.data(), patch, &ph, patch_size, patch_size);
+    }
+}
 
-        decode_patch(bitpack, patch);
-        decompress_patch(patchp->getDataZ(), patch, &ph);
+void LLSurface::applyDecodedPatches(const decoded_terrain_patch_list_t &patches, S32 patch_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    for (const LLDecodedTerrainPatch &decoded : patches)
+    {
+        if ((decoded.mX >= mPatchesPerEdge) || (decoded.mY >= mPatchesPerEdge))
+        {
+            // surface was recreated with a different size since the packet was decoded
+            continue;
+        }
+
+        LLSurfacePatch *patchp = &mPatchList[decoded.mY*mPatchesPerEdge + decoded.mX];
+
+        F32 *dataz = patchp->getDataZ();
+        for (S32 row = 0; row < patch_size; row++)
+        {
+            memcpy(dataz + row*mGridsPerEdge, &decoded.mHeights[row*patch_size], patch_size*sizeof(F32));
+        }
 
         // Update edges for neighbors.  Need to guarantee that this gets done before we generate vertical stats.
         patchp->updateNorthEdge();
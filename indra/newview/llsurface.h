@@ -56,6 +56,17 @@ class LLSurfacePatch;
 class LLBitPack;
 class LLGroupHeader;
 
+// Heights for one terrain patch decoded from a LayerData packet.
+class LLDecodedTerrainPatch
+{
+public:
+    S32 mX;
+    S32 mY;
+    std::vector<F32> mHeights; // patch_size * patch_size, row major
+};
+
+typedef std::vector<LLDecodedTerrainPatch> decoded_terrain_patch_list_t;
+
 class LLSurface
 {
 public:
@@ -81,6 +92,13 @@ public:
     void rebuildWater();
 // </FS:CR> Aurora Sim
     virtual void decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool b_large_patch);
+
+    // Decode every patch in a land layer packet without touching any surface, so this may be
+    // called from a worker thread. Stops at the first patch with an out of range ID.
+    static void decodeDCTPatches(LLBitPack &bitpack, const LLGroupHeader &goph, bool b_large_patch,
+                                 S32 patches_per_edge, decoded_terrain_patch_list_t &patches);
+    // Copy decoded heights into this surface and refresh the shared patch edges.
+    void applyDecodedPatches(const decoded_terrain_patch_list_t &patches, S32 patch_size);
     virtual void updatePatchVisibilities(LLAgent &agent);
 
     inline F32 getZ(const U32 k) const              { return mSurfaceZ[k]; }
@@ -114,6 +132,12 @@ public:
 
     bool containsPosition(const LLVector3 &position);
 
+    // <FS> Normals, vertical stats and composition heights for every dirty
+    // patch, with the per-patch work spread across the General thread pool.
+    template<bool PBR>
+    void rebuildDirtyPatches();
+    // </FS>
+
     void moveZ(const S32 x, const S32 y, const F32 delta);
 
     LLViewerRegion *getRegion() const               { return mRegionp; }
@@ -213,6 +237,8 @@ private:
 
 extern template bool LLSurface::idleUpdate</*PBR=*/false>(F32 max_update_time);
 extern template bool LLSurface::idleUpdate</*PBR=*/true>(F32 max_update_time);
+extern template void LLSurface::rebuildDirtyPatches</*PBR=*/false>();
+extern template void LLSurface::rebuildDirtyPatches</*PBR=*/true>();
 
 
 
@@ -622,42 +622,22 @@ void LLSurfacePatch::updateVerticalStats()
         return;
     }
 
-    U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
-    U32 grids_per_edge = mSurfacep->getGridsPerEdge();
-    F32 meters_per_grid = mSurfacep->getMetersPerGrid();
-
-    U32 i, j, k;
-    F32 z, total;
-
-    llassert(mDataZ);
-    z = *(mDataZ);
-
-    mMinZ = z;
-    mMaxZ = z;
+    setVerticalStats(computeVerticalStats());
+}
 
-    k = 0;
-    total = 0.0f;
+LLSurfaceRebuild::VerticalStats LLSurfacePatch::computeVerticalStats() const
+{
+    return LLSurfaceRebuild::calcVerticalStats(mDataZ, mSurfacep->getGridsPerPatchEdge(), mSurfacep->getGridsPerEdge());
+}
 
-    // Iterate to +1 because we need to do the edges correctly.
-    for (j=0; j<(grids_per_patch_edge+1); j++)
-    {
-        for (i=0; i<(grids_per_patch_edge+1); i++)
-        {
-            z = *(mDataZ + i + j*grids_per_edge);
+void LLSurfacePatch::setVerticalStats(const LLSurfaceRebuild::VerticalStats &stats)
+{
+    U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    F32 meters_per_grid = mSurfacep->getMetersPerGrid();
 
-            if (z < mMinZ)
-            {
-                mMinZ = z;
-            }
-            if (z > mMaxZ)
-            {
-                mMaxZ = z;
-            }
-            total += z;
-            k++;
-        }
-    }
-    mMeanZ = total / (F32) k;
+    mMinZ = stats.mMinZ;
+    mMaxZ = stats.mMaxZ;
+    mMeanZ = stats.mMeanZ;
     mCenterRegion.mV[VZ] = 0.5f * (mMinZ + mMaxZ);
 
     LLVector3 diam_vec(meters_per_grid*grids_per_patch_edge,
@@ -678,13 +658,11 @@ void LLSurfacePatch::updateVerticalStats()
 }
 
 
+// Recompute the normals along whichever borders were invalidated by this patch or
+// its neighbors changing. Returns true if anything was recomputed.
 template<bool PBR>
-void LLSurfacePatch::updateNormals()
+bool LLSurfacePatch::updateBorderNormals()
 {
-    if (mSurfacep->mType == 'w')
-    {
-        return;
-    }
     U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
     U32 grids_per_edge = mSurfacep->getGridsPerEdge();
 
@@ -873,30 +851,71 @@ void LLSurfacePatch::updateNormals()
         dirty_patch = true;
     }
 
-    // update the middle normals
-    if (mNormalsInvalid[MIDDLE])
+    return dirty_patch;
+}
+
+template bool LLSurfacePatch::updateBorderNormals</*PBR=*/false>();
+template bool LLSurfacePatch::updateBorderNormals</*PBR=*/true>();
+
+template<bool PBR>
+void LLSurfacePatch::updateMiddleNormals()
+{
+    U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    if constexpr (PBR)
     {
-        for (j=2; j < grids_per_patch_edge - 2; j++)
+        for (U32 j=2; j < grids_per_patch_edge - 2; j++)
         {
-            for (i=2; i < grids_per_patch_edge - 2; i++)
+            for (U32 i=2; i < grids_per_patch_edge - 2; i++)
             {
                 calcNormal<PBR>(i, j, 2);
             }
         }
-        dirty_patch = true;
     }
+    else
+    {
+        // Only reads samples inside this patch and only writes this patch's
+        // interior normals, so this is safe on a worker thread.
+        LLSurfaceRebuild::calcInteriorNormals(mDataZ, mDataNorm, mSurfacep->getGridsPerEdge(),
+                                              mSurfacep->getMetersPerGrid(), 2,
+                                              2, grids_per_patch_edge - 2, 2, grids_per_patch_edge - 2);
+    }
+}
 
+template void LLSurfacePatch::updateMiddleNormals</*PBR=*/false>();
+template void LLSurfacePatch::updateMiddleNormals</*PBR=*/true>();
+
+void LLSurfacePatch::finishNormals(bool dirty_patch)
+{
     if (dirty_patch)
     {
         mSurfacep->dirtySurfacePatch(this);
     }
 
-    for (i = 0; i < 9; i++)
+    for (U32 i = 0; i < 9; i++)
     {
         mNormalsInvalid[i] = false;
     }
 }
 
+template<bool PBR>
+void LLSurfacePatch::updateNormals()
+{
+    if (mSurfacep->mType == 'w')
+    {
+        return;
+    }
+
+    bool dirty_patch = updateBorderNormals<PBR>();
+
+    if (mNormalsInvalid[MIDDLE])
+    {
+        updateMiddleNormals<PBR>();
+        dirty_patch = true;
+    }
+
+    finishNormals(dirty_patch);
+}
+
 template void LLSurfacePatch::updateNormals</*PBR=*/false>();
 template void LLSurfacePatch::updateNormals</*PBR=*/true>();
 
@@ -974,35 +993,50 @@ void LLSurfacePatch::updateNorthEdge()
     }
 }
 
+bool LLSurfacePatch::needsHeightsGenerated() const
+{
+    return mSTexUpdate && !mHeightsGenerated
+        && (!getNeighborPatch(EAST) || getNeighborPatch(EAST)->getHasReceivedData())
+        && (!getNeighborPatch(WEST) || getNeighborPatch(WEST)->getHasReceivedData())
+        && (!getNeighborPatch(SOUTH) || getNeighborPatch(SOUTH)->getHasReceivedData())
+        && (!getNeighborPatch(NORTH) || getNeighborPatch(NORTH)->getHasReceivedData());
+}
+
+// Writes only this patch's rectangle of the composition (plus a one texel overlap
+// with its north and east neighbors), so LLSurface may run it for patches that
+// don't touch each other in parallel.
+bool LLSurfacePatch::generateHeights()
+{
+    F32 meters_per_grid = getSurface()->getMetersPerGrid();
+    F32 grids_per_patch_edge = (F32)getSurface()->getGridsPerPatchEdge();
+    LLVector3d origin_region = getOriginGlobal() - getSurface()->getOriginGlobal();
+
+    LLVLComposition* comp = getSurface()->getRegion()->getComposition();
+    F32 patch_size = meters_per_grid*(grids_per_patch_edge+1);
+    if (comp->generateHeights((F32)origin_region[VX], (F32)origin_region[VY],
+                              patch_size, patch_size))
+    {
+        mHeightsGenerated = true;
+    }
+    return mHeightsGenerated;
+}
+
 bool LLSurfacePatch::updateTexture()
 {
     if (mSTexUpdate)        //  Update texture as needed
     {
-        F32 meters_per_grid = getSurface()->getMetersPerGrid();
-        F32 grids_per_patch_edge = (F32)getSurface()->getGridsPerPatchEdge();
-
         if ((!getNeighborPatch(EAST) || getNeighborPatch(EAST)->getHasReceivedData())
             && (!getNeighborPatch(WEST) || getNeighborPatch(WEST)->getHasReceivedData())
             && (!getNeighborPatch(SOUTH) || getNeighborPatch(SOUTH)->getHasReceivedData())
             && (!getNeighborPatch(NORTH) || getNeighborPatch(NORTH)->getHasReceivedData()))
         {
             LLViewerRegion *regionp = getSurface()->getRegion();
-            LLVector3d origin_region = getOriginGlobal() - getSurface()->getOriginGlobal();
 
             // Have to figure out a better way to deal with these edge conditions...
             LLVLComposition* comp = regionp->getComposition();
-            if (!mHeightsGenerated)
+            if (!mHeightsGenerated && !generateHeights())
             {
-                F32 patch_size = meters_per_grid*(grids_per_patch_edge+1);
-                if (comp->generateHeights((F32)origin_region[VX], (F32)origin_region[VY],
-                                          patch_size, patch_size))
-                {
-                    mHeightsGenerated = true;
-                }
-                else
-                {
-                    return false;
-                }
+                return false;
             }
 
             if (comp->generateComposition())
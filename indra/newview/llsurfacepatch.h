@@ -30,6 +30,7 @@
 #include "v3math.h"
 #include "v3dmath.h"
 #include "llpointer.h"
+#include "llsurfacerebuild.h"
 
 class LLSurface;
 class LLVOSurfacePatch;
@@ -80,6 +81,24 @@ public:
     template<bool PBR>
     void updateNormals();
 
+    // Pieces of updateVerticalStats() and updateNormals() for LLSurface's batched
+    // rebuild. The border pass reads neighbors and may fix up shared corner heights,
+    // so it stays on the main thread; the middle normals and computeVerticalStats()
+    // only touch this patch and may run on a worker.
+    template<bool PBR>
+    bool updateBorderNormals();
+    template<bool PBR>
+    void updateMiddleNormals();
+    void finishNormals(bool dirty_patch);
+    bool hasInvalidMiddleNormals() const        { return mNormalsInvalid[MIDDLE]; }
+    bool hasDirtyZStats() const                 { return mDirtyZStats; }
+    LLSurfaceRebuild::VerticalStats computeVerticalStats() const;
+    void setVerticalStats(const LLSurfaceRebuild::VerticalStats &stats);
+
+    // Composition heights for this patch are generated once all edge neighbors have data.
+    bool needsHeightsGenerated() const;
+    bool generateHeights();
+
     void updateEastEdge();
     void updateNorthEdge();
 
@@ -195,6 +214,10 @@ protected:
 
 extern template void LLSurfacePatch::updateNormals</*PBR=*/false>();
 extern template void LLSurfacePatch::updateNormals</*PBR=*/true>();
+extern template bool LLSurfacePatch::updateBorderNormals</*PBR=*/false>();
+extern template bool LLSurfacePatch::updateBorderNormals</*PBR=*/true>();
+extern template void LLSurfacePatch::updateMiddleNormals</*PBR=*/false>();
+extern template void LLSurfacePatch::updateMiddleNormals</*PBR=*/true>();
 
 
 #endif // LL_LLSURFACEPATCH_H
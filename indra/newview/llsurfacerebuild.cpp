@@ -0,0 +1,99 @@
+/**
+ * @file llsurfacerebuild.cpp
+ * @brief Height field kernels used when rebuilding terrain surface patches.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llsurfacerebuild.h"
+
+LLSurfaceRebuild::VerticalStats LLSurfaceRebuild::calcVerticalStats(const F32 *dataz, U32 grids_per_patch_edge, U32 grids_per_edge)
+{
+    U32 i, j, k;
+    F32 z, total;
+
+    llassert(dataz);
+    z = *(dataz);
+
+    VerticalStats stats;
+    stats.mMinZ = z;
+    stats.mMaxZ = z;
+
+    k = 0;
+    total = 0.0f;
+
+    // Iterate to +1 because we need to do the edges correctly.
+    for (j=0; j<(grids_per_patch_edge+1); j++)
+    {
+        const F32 *row = dataz + j*grids_per_edge;
+        for (i=0; i<(grids_per_patch_edge+1); i++)
+        {
+            z = row[i];
+
+            if (z < stats.mMinZ)
+            {
+                stats.mMinZ = z;
+            }
+            if (z > stats.mMaxZ)
+            {
+                stats.mMaxZ = z;
+            }
+            total += z;
+            k++;
+        }
+    }
+    stats.mMeanZ = total / (F32) k;
+    return stats;
+}
+
+void LLSurfaceRebuild::calcInteriorNormals(const F32 *dataz, LLVector3 *datanorm, U32 grids_per_edge,
+                                           F32 meters_per_grid, U32 stride,
+                                           U32 x_begin, U32 x_end, U32 y_begin, U32 y_end)
+{
+    const F32 mpg = meters_per_grid * stride;
+
+    for (U32 y = y_begin; y < y_end; y++)
+    {
+        const F32 *south = dataz + (y - stride)*grids_per_edge;
+        const F32 *north = dataz + (y + stride)*grids_per_edge;
+        LLVector3 *normals = datanorm + y*grids_per_edge;
+
+        for (U32 x = x_begin; x < x_end; x++)
+        {
+            LLVector3 p00(-mpg, -mpg, south[x - stride]);
+            LLVector3 p01(-mpg, +mpg, north[x - stride]);
+            LLVector3 p10(+mpg, -mpg, south[x + stride]);
+            LLVector3 p11(+mpg, +mpg, north[x + stride]);
+
+            LLVector3 c1 = p11 - p00;
+            LLVector3 c2 = p01 - p10;
+
+            LLVector3 normal = c1;
+            normal %= c2;
+            normal.normVec();
+
+            normals[x] = normal;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file llsurfacerebuild.h
+ * @brief Height field kernels used when rebuilding terrain surface patches.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSURFACEREBUILD_H
+#define LL_LLSURFACEREBUILD_H
+
+#include "v3math.h"
+
+// The parts of LLSurfacePatch::updateVerticalStats() and updateNormals() that
+// only read heights and write per-patch results. They touch nothing but the
+// arrays they are given, so LLSurface can run them as General pool jobs and
+// tests can run them on synthetic height fields without a region.
+namespace LLSurfaceRebuild
+{
+    class VerticalStats
+    {
+    public:
+        F32 mMinZ;
+        F32 mMaxZ;
+        F32 mMeanZ;
+    };
+
+    // Min, max and mean over the (grids_per_patch_edge + 1)^2 samples at dataz,
+    // including the shared north and east edges.
+    VerticalStats calcVerticalStats(const F32 *dataz, U32 grids_per_patch_edge, U32 grids_per_edge);
+
+    // Normals for grid points [x_begin, x_end) x [y_begin, y_end) of a patch,
+    // where every sample stride away is inside the patch. Same arithmetic as
+    // LLSurfacePatch::calcNormal<false>(), so results are bit-identical.
+    void calcInteriorNormals(const F32 *dataz, LLVector3 *datanorm, U32 grids_per_edge,
+                             F32 meters_per_grid, U32 stride,
+                             U32 x_begin, U32 x_end, U32 y_begin, U32 y_end);
+}
+
+#endif // LL_LLSURFACEREBUILD_H
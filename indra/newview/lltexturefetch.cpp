@@ -1100,6 +1100,12 @@ void LLTextureFetchWorker::setDesiredDiscard(S32 discard, S32 size)
 // Locks:  Mw
 void LLTextureFetchWorker::setImagePriority(F32 priority)
 {
+    // <FS> HTTP request priorities
+    if (mHttpActive && priority != mImagePriority && LLCORE_HTTP_HANDLE_INVALID != mHttpHandle)
+    {
+        mFetcher->queueHttpPriority(mHttpHandle, priority);
+    }
+    // </FS>
     mImagePriority = priority; //should map to max virtual size, abort if zero
 }
 
@@ -1690,6 +1696,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
         }
 
         mHttpActive = true;
+        mFetcher->queueHttpPriority(mHttpHandle, mImagePriority);      // <FS/> HTTP request priorities
         mFetcher->addToHTTPQueue(mID);
         recordTextureStart(true);
         setState(WAIT_HTTP_REQ);
@@ -3273,6 +3280,9 @@ void LLTextureFetch::commonUpdate()
     // Run a cross-thread command, if any.
     cmdDoWork();
 
+    // Reorder waiting HTTP requests
+    sendHttpPriorities();       // <FS/> HTTP request priorities
+
     // Deliver all completion notifications
     LLCore::HttpStatus status = mHttpRequest->update(0);
     if (! status)
@@ -3952,6 +3962,30 @@ void LLTextureFetch::addHttpWaiter(const LLUUID & tid)
     mNetworkQueueMutex.unlock();                                        // -Mfnq
 }
 
+// <FS> HTTP request priorities
+// Threads:  T*
+void LLTextureFetch::queueHttpPriority(LLCore::HttpHandle handle, F32 priority)
+{
+    mNetworkQueueMutex.lock();                                          // +Mfnq
+    mHttpPriorityChanges.emplace_back(handle, priority);
+    mNetworkQueueMutex.unlock();                                        // -Mfnq
+}
+
+// Threads:  Ttf
+void LLTextureFetch::sendHttpPriorities()
+{
+    LLCore::HttpRequest::priority_list_t changes;
+    mNetworkQueueMutex.lock();                                          // +Mfnq
+    changes.swap(mHttpPriorityChanges);
+    mNetworkQueueMutex.unlock();                                        // -Mfnq
+
+    if (! changes.empty())
+    {
+        mHttpRequest->requestSetPriorities(std::move(changes), LLCore::HttpHandler::ptr_t());
+    }
+}
+// </FS>
+
 // Threads:  Ttf
 void LLTextureFetch::removeHttpWaiter(const LLUUID & tid)
 {
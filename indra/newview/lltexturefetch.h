@@ -232,6 +232,18 @@ public:
     // Threads:  T*
     void cancelHttpWaiters();
 
+    // <FS> HTTP request priorities
+    // Record a new priority for an issued HTTP request.  Changes
+    // go to llcorehttp in one batch per update so requests that are
+    // waiting for a connection follow their textures' priorities.
+    //
+    // Threads:  T*
+    void queueHttpPriority(LLCore::HttpHandle handle, F32 priority);
+
+    // Threads:  Ttf
+    void sendHttpPriorities();
+    // </FS>
+
     // Threads:  T*
     int getHttpWaitersCount();
     // ----------------------------------
@@ -411,6 +423,8 @@ private:
     typedef std::set<LLUUID> wait_http_res_queue_t;
     wait_http_res_queue_t               mHttpWaitResource;              // Mfnq
 
+    LLCore::HttpRequest::priority_list_t mHttpPriorityChanges;          // Mfnq <FS/> HTTP request priorities
+
     // Cumulative stats on the states/requests issued by
     // textures running through here.
     U32 mTotalCacheReadCount;                                           // Mfq
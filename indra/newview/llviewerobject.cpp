@@ -31,6 +31,7 @@
 #include "llaudioengine.h"
 #include "indra_constants.h"
 #include "llmath.h"
+#include "llendianswizzle.h" // <FS/> bulk terse update unpacking
 #include "llflexibleobject.h"
 #include "llviewercontrol.h"
 #include "lldatapacker.h"
@@ -1294,10 +1295,12 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
     // This needs to match the largest size below. See switch(length)
     U8  data[MAX_OBJECT_BINARY_DATA_SIZE];
 
-#ifdef LL_BIG_ENDIAN
-    U16 valswizzle[4];
-#endif
-    U16 *val;
+// <FS> Terse updates are dequantized in bulk below
+//#ifdef LL_BIG_ENDIAN
+//    U16 valswizzle[4];
+//#endif
+//    U16 *val;
+// </FS>
 // <FS:CR> Aurora Sim
     //const F32 size = LLWorld::getInstance()->getRegionWidthInMeters();
     const F32 size = mRegionp->getWidth();
@@ -1639,60 +1642,38 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
                     this_update_precision = 16;
                     test_pos_parent.quantize16(-0.5f*size, 1.5f*size, MIN_HEIGHT, MAX_HEIGHT);
 
-#ifdef LL_BIG_ENDIAN
-                    htolememcpy(valswizzle, &data[count], MVT_U16Vec3, 6);
-                    val = valswizzle;
-#else
-                    val = (U16 *) &data[count];
-#endif
-                    count += sizeof(U16)*3;
-                    new_pos_parent.mV[VX] = U16_to_F32(val[VX], -0.5f*size, 1.5f*size);
-                    new_pos_parent.mV[VY] = U16_to_F32(val[VY], -0.5f*size, 1.5f*size);
-                    new_pos_parent.mV[VZ] = U16_to_F32(val[VZ], MIN_HEIGHT, MAX_HEIGHT);
-
-#ifdef LL_BIG_ENDIAN
-                    htolememcpy(valswizzle, &data[count], MVT_U16Vec3, 6);
-                    val = valswizzle;
-#else
-                    val = (U16 *) &data[count];
-#endif
-                    count += sizeof(U16)*3;
-                    setVelocity(U16_to_F32(val[VX], -size, size),
-                                U16_to_F32(val[VY], -size, size),
-                                U16_to_F32(val[VZ], -size, size));
-
-#ifdef LL_BIG_ENDIAN
-                    htolememcpy(valswizzle, &data[count], MVT_U16Vec3, 6);
-                    val = valswizzle;
-#else
-                    val = (U16 *) &data[count];
-#endif
-                    count += sizeof(U16)*3;
-                    setAcceleration(U16_to_F32(val[VX], -size, size),
-                                    U16_to_F32(val[VY], -size, size),
-                                    U16_to_F32(val[VZ], -size, size));
-
-#ifdef LL_BIG_ENDIAN
-                    htolememcpy(valswizzle, &data[count], MVT_U16Quat, 8);
-                    val = valswizzle;
-#else
-                    val = (U16 *) &data[count];
-#endif
-                    count += sizeof(U16)*4;
-                    new_rot.mQ[VX] = U16_to_F32(val[VX], -1.f, 1.f);
-                    new_rot.mQ[VY] = U16_to_F32(val[VY], -1.f, 1.f);
-                    new_rot.mQ[VZ] = U16_to_F32(val[VZ], -1.f, 1.f);
-                    new_rot.mQ[VW] = U16_to_F32(val[VW], -1.f, 1.f);
-
-#ifdef LL_BIG_ENDIAN
-                    htolememcpy(valswizzle, &data[count], MVT_U16Vec3, 6);
-                    val = valswizzle;
-#else
-                    val = (U16 *) &data[count];
-#endif
-                    new_angv.set(U16_to_F32(val[VX], -size, size),
-                                        U16_to_F32(val[VY], -size, size),
-                                        U16_to_F32(val[VZ], -size, size));
+                    // <FS> Dequantize position, velocity, acceleration, rotation and
+                    // angular velocity together rather than one U16_to_F32() at a time
+                    {
+                        constexpr S32 TERSE_VALUES = 16;
+                        const F32 lower[TERSE_VALUES] = { -0.5f*size, -0.5f*size, MIN_HEIGHT,
+                                                          -size, -size, -size,
+                                                          -size, -size, -size,
+                                                          -1.f, -1.f, -1.f, -1.f,
+                                                          -size, -size, -size };
+                        const F32 upper[TERSE_VALUES] = { 1.5f*size, 1.5f*size, MAX_HEIGHT,
+                                                          size, size, size,
+                                                          size, size, size,
+                                                          1.f, 1.f, 1.f, 1.f,
+                                                          size, size, size };
+                        U16 quantized[TERSE_VALUES];
+                        F32 terse[TERSE_VALUES];
+
+                        memcpy(quantized, &data[count], sizeof(quantized)); /* Flawfinder: ignore */
+                        llendianswizzle(quantized, sizeof(U16), TERSE_VALUES);
+                        count += sizeof(quantized);
+                        U16s_to_F32s(quantized, terse, TERSE_VALUES, lower, upper);
+
+                        new_pos_parent.set(terse[0], terse[1], terse[2]);
+                        setVelocity(terse[3], terse[4], terse[5]);
+                        setAcceleration(terse[6], terse[7], terse[8]);
+                        new_rot.mQ[VX] = terse[9];
+                        new_rot.mQ[VY] = terse[10];
+                        new_rot.mQ[VZ] = terse[11];
+                        new_rot.mQ[VW] = terse[12];
+                        new_angv.set(terse[13], terse[14], terse[15]);
+                    }
+                    // </FS>
                     setAngularVelocity(new_angv);
                     break;
 
@@ -1725,7 +1706,7 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
         U8     sound_flags = 0;
         F32     cutoff = 0;
 
-        U16 val[4];
+        //U16 val[4]; // <FS/> Terse updates are dequantized in bulk below
 
         U8      state;
 
@@ -1749,33 +1730,33 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
                 }
                 test_pos_parent = getPosition();
                 dp->unpackVector3(new_pos_parent, "Pos");
-                dp->unpackU16(val[VX], "VelX");
-                dp->unpackU16(val[VY], "VelY");
-                dp->unpackU16(val[VZ], "VelZ");
-                setVelocity(U16_to_F32(val[VX], -128.f, 128.f),
-                            U16_to_F32(val[VY], -128.f, 128.f),
-                            U16_to_F32(val[VZ], -128.f, 128.f));
-                dp->unpackU16(val[VX], "AccX");
-                dp->unpackU16(val[VY], "AccY");
-                dp->unpackU16(val[VZ], "AccZ");
-                setAcceleration(U16_to_F32(val[VX], -64.f, 64.f),
-                                U16_to_F32(val[VY], -64.f, 64.f),
-                                U16_to_F32(val[VZ], -64.f, 64.f));
-
-                dp->unpackU16(val[VX], "ThetaX");
-                dp->unpackU16(val[VY], "ThetaY");
-                dp->unpackU16(val[VZ], "ThetaZ");
-                dp->unpackU16(val[VS], "ThetaS");
-                new_rot.mQ[VX] = U16_to_F32(val[VX], -1.f, 1.f);
-                new_rot.mQ[VY] = U16_to_F32(val[VY], -1.f, 1.f);
-                new_rot.mQ[VZ] = U16_to_F32(val[VZ], -1.f, 1.f);
-                new_rot.mQ[VS] = U16_to_F32(val[VS], -1.f, 1.f);
-                dp->unpackU16(val[VX], "AccX");
-                dp->unpackU16(val[VY], "AccY");
-                dp->unpackU16(val[VZ], "AccZ");
-                new_angv.set(U16_to_F32(val[VX], -64.f, 64.f),
-                                    U16_to_F32(val[VY], -64.f, 64.f),
-                                    U16_to_F32(val[VZ], -64.f, 64.f));
+                // <FS> Unpack and dequantize the velocity, acceleration, rotation and
+                // angular velocity fields together
+                {
+                    constexpr S32 TERSE_VALUES = 13;
+                    static const F32 lower[TERSE_VALUES] = { -128.f, -128.f, -128.f,
+                                                             -64.f, -64.f, -64.f,
+                                                             -1.f, -1.f, -1.f, -1.f,
+                                                             -64.f, -64.f, -64.f };
+                    static const F32 upper[TERSE_VALUES] = { 128.f, 128.f, 128.f,
+                                                             64.f, 64.f, 64.f,
+                                                             1.f, 1.f, 1.f, 1.f,
+                                                             64.f, 64.f, 64.f };
+                    U16 quantized[TERSE_VALUES] = {};
+                    F32 terse[TERSE_VALUES];
+
+                    dp->unpackU16s(quantized, TERSE_VALUES, "TerseVelAccRotOmega");
+                    U16s_to_F32s(quantized, terse, TERSE_VALUES, lower, upper);
+
+                    setVelocity(terse[0], terse[1], terse[2]);
+                    setAcceleration(terse[3], terse[4], terse[5]);
+                    new_rot.mQ[VX] = terse[6];
+                    new_rot.mQ[VY] = terse[7];
+                    new_rot.mQ[VZ] = terse[8];
+                    new_rot.mQ[VS] = terse[9];
+                    new_angv.set(terse[10], terse[11], terse[12]);
+                }
+                // </FS>
                 setAngularVelocity(new_angv);
             }
             break;
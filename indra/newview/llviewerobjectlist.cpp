@@ -92,6 +92,7 @@
 
 #include "fsareasearch.h" // <FS:Cron> Added to provide the ability to update the impact costs in area search. </FS:Cron>
 #include "llavataractions.h"
+#include "lltraceframebudget.h" // <FS/> Frame budget
 
 extern F32 gMinObjectDistance;
 extern bool gAnimateTextures;
@@ -445,6 +446,7 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
                                              bool compressed)
 {
     LL_RECORD_BLOCK_TIME(FTM_PROCESS_OBJECTS);
+    LL_RECORD_FRAME_BUDGET(OBJECT_UPDATES); // <FS/> Frame budget
 
     LLViewerObject *objectp;
     S32         num_objects;
@@ -1029,6 +1031,7 @@ void LLViewerObjectList::update(LLAgent &agent)
     if (freezeTime)
     // </FS:Ansariel> Speed up debug settings
     {
+        LLVOAvatar::prepareMotionBatch(agent, frame_time, idle_list.begin(), idle_end); // <FS/> Parallel animation evaluation
 
         for (std::vector<LLViewerObject*>::iterator iter = idle_list.begin();
             iter != idle_end; iter++)
@@ -1039,9 +1042,13 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
             }
         }
+
+        LLVOAvatar::finishMotionBatch(); // <FS/> Parallel animation evaluation
     }
     else
     {
+        LLVOAvatar::prepareMotionBatch(agent, frame_time, idle_list.begin(), idle_end); // <FS/> Parallel animation evaluation
+
         for (std::vector<LLViewerObject*>::iterator idle_iter = idle_list.begin();
             idle_iter != idle_end; idle_iter++)
         {
@@ -1050,6 +1057,8 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
         }
 
+        LLVOAvatar::finishMotionBatch(); // <FS/> Parallel animation evaluation
+
         //update flexible objects
         LLVolumeImplFlexible::updateClass();
 
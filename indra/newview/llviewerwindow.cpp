@@ -237,6 +237,7 @@
 #include "fspanellogin.h"
 
 #include "lltracerecording.h"
+#include "lltraceframebudget.h" // <FS/> Frame budget
 
 //
 // Globals
@@ -3827,6 +3828,7 @@ void append_xui_tooltip(LLView* viewp, LLToolTip::Params& params)
 void LLViewerWindow::updateUI()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    LL_RECORD_FRAME_BUDGET(UI); // <FS/> Frame budget
 
     static std::string last_handle_msg;
 
@@ -35,6 +35,8 @@
 #include "llframetimer.h"
 #include "llsurface.h"
 #include "llbitpack.h"
+#include "llworld.h"
+#include "workqueue.h"
 
 const   char    LAND_LAYER_CODE                 = 'L';
 const   char    WIND_LAYER_CODE                 = '7';
@@ -111,21 +113,21 @@ void LLVLManager::unpackData(const S32 num_packets)
     {
         LLVLData *datap = mPacketData[i];
 
+        if (LAND_LAYER_CODE == datap->mType || AURORA_LAND_LAYER_CODE == datap->mType)
+        {
+            // Patch decoding and IDCTs run on the General pool; decodeLandAsync owns datap now.
+            mPacketData[i] = nullptr;
+            decodeLandAsync(datap, AURORA_LAND_LAYER_CODE == datap->mType);
+            continue;
+        }
+
         LLBitPack bit_pack(datap->mData, datap->mSize);
         LLGroupHeader goph;
 
         decode_patch_group_header(bit_pack, &goph);
-        if (LAND_LAYER_CODE == datap->mType)
-        {
-            datap->mRegionp->getLand().decompressDCTPatch(bit_pack, &goph, false);
-        }
 // <FS:CR> Aurora Sim
-        else if (AURORA_LAND_LAYER_CODE == datap->mType)
-        {
-            datap->mRegionp->getLand().decompressDCTPatch(bit_pack, &goph, true);
-        }
-        //else if (WIND_LAYER_CODE == datap->mType)
-        else if (WIND_LAYER_CODE == datap->mType || AURORA_WIND_LAYER_CODE == datap->mType)
+        //if (WIND_LAYER_CODE == datap->mType)
+        if (WIND_LAYER_CODE == datap->mType || AURORA_WIND_LAYER_CODE == datap->mType)
 // </FS:CR> Aurora Sim
         {
             datap->mRegionp->mWind.decompress(bit_pack, &goph);
@@ -152,6 +154,106 @@ void LLVLManager::unpackData(const S32 num_packets)
 
 }
 
+// static
+LLVLManager::DecodedLand LLVLManager::decodeLand(const std::shared_ptr<LLVLData> &data, U64 region_handle,
+                                                 S32 patches_per_edge, bool b_large_patch)
+{
+    DecodedLand decoded;
+    decoded.mRegionHandle = region_handle;
+    decoded.mPatchSize = 0;
+
+    // Whatever happens, hand back a result, so that later packets don't wait on this one.
+    try
+    {
+        LLBitPack bit_pack(data->mData, data->mSize);
+        LLGroupHeader goph;
+        decode_patch_group_header(bit_pack, &goph);
+        decoded.mPatchSize = goph.patch_size;
+        LLSurface::decodeDCTPatches(bit_pack, goph, b_large_patch, patches_per_edge, decoded.mPatches);
+    }
+    catch (...)
+    {
+        LOG_UNHANDLED_EXCEPTION("decoding land patches");
+        decoded.mPatches.clear();
+    }
+    return decoded;
+}
+
+void LLVLManager::decodeLandAsync(LLVLData *datap, bool b_large_patch)
+{
+    const U32 sequence = mNextDecodeSequence++;
+    // The region may be gone by the time the reply arrives, so carry its handle rather than a pointer.
+    const U64 region_handle = datap->mRegionp->getHandle();
+    const S32 patches_per_edge = datap->mRegionp->getLand().getPatchesPerEdge();
+    std::shared_ptr<LLVLData> data(datap);
+
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (main_queue && general_queue)
+    {
+        bool posted = main_queue->postTo(
+            general_queue,
+            [data, region_handle, patches_per_edge, b_large_patch]() // Work done on general queue
+            {
+                return decodeLand(data, region_handle, patches_per_edge, b_large_patch);
+            },
+            [sequence](DecodedLand decoded) // Callback to main thread
+            {
+                gVLManager.onLandDecoded(sequence, decoded);
+            });
+        if (posted)
+        {
+            return;
+        }
+    }
+
+    // No thread pool (startup, shutdown, or tests): decode inline, still in sequence.
+    onLandDecoded(sequence, decodeLand(data, region_handle, patches_per_edge, b_large_patch));
+}
+
+void LLVLManager::onLandDecoded(U32 sequence, const DecodedLand &decoded)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    // Replies can arrive out of order from the pool; apply strictly in packet order so
+    // that a stale packet never overwrites newer heights for the same patch.
+    if (sequence < mNextApplySequence)
+    {
+        // Its packet was already skipped below; applying it now would roll patches back.
+        LL_DEBUGS() << "Land packet " << sequence << " decoded after it was skipped, dropping" << LL_ENDL;
+        return;
+    }
+    mDecodedLand[sequence] = decoded;
+
+    // Several pool threads decode at once, so results normally arrive a little out of
+    // order, but no decode takes long enough for this many later packets to overtake it.
+    // A result still missing after that was lost (its job or its reply was dropped);
+    // skip ahead to the next result we do have rather than stop updating terrain.
+    if (mDecodedLand.size() > MAX_DECODED_LAND_BACKLOG && !mDecodedLand.count(mNextApplySequence))
+    {
+        std::map<U32, DecodedLand>::iterator next = mDecodedLand.upper_bound(mNextApplySequence);
+        if (next != mDecodedLand.end())
+        {
+            LL_WARNS() << "Land packet " << mNextApplySequence << " never decoded, skipping to "
+                       << next->first << LL_ENDL;
+            mNextApplySequence = next->first;
+        }
+    }
+
+    std::map<U32, DecodedLand>::iterator iter;
+    while ((iter = mDecodedLand.find(mNextApplySequence)) != mDecodedLand.end())
+    {
+        const DecodedLand &land = iter->second;
+        LLViewerRegion *regionp = LLWorld::getInstance()->getRegionFromHandle(land.mRegionHandle);
+        if (regionp)
+        {
+            regionp->getLand().applyDecodedPatches(land.mPatches, land.mPatchSize);
+        }
+        mDecodedLand.erase(iter);
+        mNextApplySequence++;
+    }
+}
+
 void LLVLManager::resetBitCounts()
 {
     mLandBits = mWindBits = mCloudBits = (S32Bits)0;
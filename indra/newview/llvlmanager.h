@@ -30,6 +30,7 @@
 // This class manages the data coming in for viewer layers from the network.
 
 #include "stdtypes.h"
+#include "llsurface.h"
 
 class LLVLData;
 class LLViewerRegion;
@@ -53,8 +54,26 @@ public:
 
     void cleanupData(LLViewerRegion *regionp);
 protected:
+    // Land patches decoded on the General thread pool, waiting to be applied in arrival order.
+    struct DecodedLand
+    {
+        U64 mRegionHandle;
+        S32 mPatchSize;
+        decoded_terrain_patch_list_t mPatches;
+    };
+
+    static DecodedLand decodeLand(const std::shared_ptr<LLVLData> &data, U64 region_handle,
+                                  S32 patches_per_edge, bool b_large_patch);
+    // Takes ownership of datap.
+    void decodeLandAsync(LLVLData *datap, bool b_large_patch);
+    void onLandDecoded(U32 sequence, const DecodedLand &decoded);
 
     std::vector<LLVLData *> mPacketData;
+    // Decoded results held back waiting for an earlier one before that one is given up on.
+    static constexpr size_t MAX_DECODED_LAND_BACKLOG = 64;
+    std::map<U32, DecodedLand> mDecodedLand;
+    U32 mNextDecodeSequence = 0;
+    U32 mNextApplySequence = 0;
     U32Bits mLandBits;
     U32Bits mWindBits;
     U32Bits mCloudBits;
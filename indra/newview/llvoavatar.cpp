@@ -93,6 +93,7 @@
 #include "llviewerstats.h"
 #include "llviewerwearable.h"
 #include "llvoavatarself.h"
+#include "llavatarcomplexity.h" // <FS/> Avatar complexity budget
 #include "llvovolume.h"
 #include "llworld.h"
 #include "pipeline.h"
@@ -136,6 +137,7 @@
 #include "llsidepanelappearance.h"
 #include "llviewermenufile.h"
 #include "llviewernetwork.h"    // [FS:CR] isInSecondlife()
+#include "lltraceframebudget.h" // <FS/> Frame budget
 
 
 extern F32 SPEED_ADJUST_MAX;
@@ -351,6 +353,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_BODY_NOISE; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // run-time (post constructor) initialization,
     // called after parameters have been set
@@ -362,6 +365,13 @@ public:
             return STATUS_FAILURE;
         }
 
+        // <FS> Parallel animation evaluation
+        // The noise tables are built on first use; do that here on the main
+        // thread, onUpdate() may run on a worker.
+        F32 seed[2] = { 0.f, 0.f };
+        noise2(seed);
+        // </FS>
+
         mTorsoState->setUsage(LLJointState::ROT);
 
         addJointState( mTorsoState );
@@ -459,6 +469,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_BREATHE; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // run-time (post constructor) initialization,
     // called after parameters have been set
@@ -572,6 +583,7 @@ public:
 
     // called to determine when a motion should be activated/deactivated based on avatar pixel coverage
     virtual F32 getMinPixelArea() { return MIN_REQUIRED_PIXEL_AREA_PELVIS_FIX; }
+    virtual bool canUpdateConcurrently() { return true; } // <FS/> Parallel animation evaluation
 
     // run-time (post constructor) initialization,
     // called after parameters have been set
@@ -633,6 +645,8 @@ bool LLVOAvatar::sLimitNonImpostors = false; // True unless RenderAvatarMaxNonIm
 F32 LLVOAvatar::sRenderDistance = 256.f;
 S32 LLVOAvatar::sNumVisibleAvatars = 0;
 S32 LLVOAvatar::sNumLODChangesThisFrame = 0;
+bool LLVOAvatar::sMotionBatchOpen = false; // <FS/> Parallel animation evaluation
+std::vector<LLPointer<LLVOAvatar> > LLVOAvatar::sMotionBatch; // <FS/> Parallel animation evaluation
 
 // const LLUUID LLVOAvatar::sStepSoundOnLand("e8af4a28-aa83-4310-a7c4-c047e15ea0df"); - <FS:PP> Commented out for FIRE-3169: Option to change the default footsteps sound
 const LLUUID LLVOAvatar::sStepSounds[LL_MCODE_END] =
@@ -725,6 +739,7 @@ LLVOAvatar::LLVOAvatar(const LLUUID& id,
     mUpdatePeriod(1),
     mOverallAppearance(AOA_INVISIBLE),
     mVisualComplexityStale(true),
+    mComplexityUpdateUnfinished(false), // <FS/> Avatar complexity budget
     mVisuallyMuteSetting(AV_RENDER_NORMALLY),
     mMutedAVColor(LLColor4::white /* used for "uninitialize" */),
     mFirstFullyVisible(true),
@@ -800,6 +815,13 @@ LLVOAvatar::LLVOAvatar(const LLUUID& id,
 
     mInAir = false;
 
+    // <FS> Parallel animation evaluation
+    mMotionBatchState = MOTION_BATCH_NONE;
+    mPendingUpdateType = LLCharacter::NORMAL_UPDATE;
+    mPendingCharacterVisible = false;
+    mPendingWasSitGroundConstrained = false;
+    // </FS>
+
     mStepOnLand = true;
     mStepMaterial = 0;
 
@@ -3076,6 +3098,20 @@ void LLVOAvatar::dumpAnimationState()
 void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    LL_RECORD_FRAME_BUDGET(AVATARS); // <FS/> Frame budget
+
+    // <FS> Parallel animation evaluation
+    if (mMotionBatchState != MOTION_BATCH_NONE)
+    {
+        // prepareMotionBatch() has been as far as the motion update
+        bool detailed_update = resumeUpdateCharacter();
+        if (!isDead())
+        {
+            idleUpdateAfterCharacter(detailed_update);
+        }
+        return;
+    }
+    // </FS>
 
     if (LLApp::isExiting())
         return;
@@ -3220,6 +3256,23 @@ void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
     mLastRootPos = mRoot->getWorldPosition();
     bool detailed_update = updateCharacter(agent);
 
+    // <FS> Parallel animation evaluation
+    if (mMotionBatchState != MOTION_BATCH_NONE)
+    {
+        // prepareMotionBatch(): the rest waits for this avatar's turn in the idle loop
+        return;
+    }
+
+    idleUpdateAfterCharacter(detailed_update);
+}
+
+//------------------------------------------------------------------------
+// idleUpdateAfterCharacter()
+// The rest of idleUpdate(), once updateCharacter() has finished
+//------------------------------------------------------------------------
+void LLVOAvatar::idleUpdateAfterCharacter(bool detailed_update)
+{
+    // </FS>
     static LLUICachedControl<bool> visualizers_in_calls("ShowVoiceVisualizersInCalls", false);
     bool voice_enabled = (visualizers_in_calls || LLVoiceClient::getInstance()->inProximalChannel()) &&
                          LLVoiceClient::getInstance()->getVoiceEnabled(mID);
@@ -3274,9 +3327,135 @@ void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
         // (both are unacceptably costly)
         idleUpdateRenderComplexity();
     }
+    // <FS> Avatar complexity budget
+    else if (mComplexityUpdateUnfinished)
+    {
+        // Finish an update that ran out of time without waiting for our next turn
+        calculateUpdateRenderComplexity();
+    }
+    // </FS>
     idleUpdateDebugInfo();
 }
 
+// <FS> Parallel animation evaluation
+//------------------------------------------------------------------------
+// canPrepareIdleUpdate()
+// Whether prepareMotionBatch() can take this avatar's idleUpdate() as far
+// as the motion update: not if idleUpdate() would return before that.
+// Your own avatar stays serial, its motions talk to gAgent, and so do
+// avatars that follow another object (seated ones and animesh), whose
+// idleUpdate() has to see that object's this frame.
+//------------------------------------------------------------------------
+bool LLVOAvatar::canPrepareIdleUpdate()
+{
+    if (isSelf() || isControlAvatar() || isUIAvatar() || isDead() || !mIsBuilt || getParent()
+        || LLApp::isExiting())
+    {
+        return false;
+    }
+
+    static LLCachedControl<bool> friends_only(gSavedSettings, "RenderAvatarFriendsOnly", false);
+    if (friends_only() && !isBuddy())
+    {
+        return false;
+    }
+
+    static LLCachedControl<bool> disable_all_render_types(gSavedSettings, "DisableAllRenderTypes");
+    return gPipeline.hasRenderType(LLPipeline::RENDER_TYPE_AVATAR) || disable_all_render_types;
+}
+
+//------------------------------------------------------------------------
+// prepareMotionBatch()
+// Runs other avatars' idleUpdate() up to the motion update and evaluates
+// the motions that can be across the General pool.
+//------------------------------------------------------------------------
+// static
+void LLVOAvatar::prepareMotionBatch(LLAgent &agent, const F64 &time,
+                                    const std::vector<LLViewerObject*>::iterator& begin,
+                                    const std::vector<LLViewerObject*>::iterator& end)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    static LLCachedControl<bool> parallel_motions(gSavedSettings, "FSParallelAvatarMotions");
+    llassert(sMotionBatch.empty());
+    if (!parallel_motions)
+    {
+        return;
+    }
+
+    std::vector<LLCharacter*> characters;
+    sMotionBatchOpen = true;
+    for (std::vector<LLViewerObject*>::iterator iter = begin; iter != end; ++iter)
+    {
+        if (!(*iter)->isAvatar())
+        {
+            continue;
+        }
+        LLVOAvatar* avatarp = (LLVOAvatar*)*iter;
+        if (!avatarp->canPrepareIdleUpdate())
+        {
+            continue;
+        }
+        avatarp->idleUpdate(agent, time);
+        if (avatarp->mMotionBatchState != MOTION_BATCH_NONE)
+        {
+            sMotionBatch.push_back(avatarp);
+            if (avatarp->mMotionBatchState == MOTION_BATCH_EVALUATED)
+            {
+                characters.push_back(avatarp);
+            }
+        }
+    }
+    sMotionBatchOpen = false;
+
+    LLCharacter::evaluateMotionsConcurrently(characters);
+}
+
+//------------------------------------------------------------------------
+// finishMotionBatch()
+// Finishes the idle updates of batched avatars the idle loop didn't get to.
+//------------------------------------------------------------------------
+// static
+void LLVOAvatar::finishMotionBatch()
+{
+    for (LLVOAvatar* avatarp : sMotionBatch)
+    {
+        if (avatarp->mMotionBatchState != MOTION_BATCH_NONE)
+        {
+            avatarp->resumeUpdateCharacter();
+        }
+    }
+    sMotionBatch.clear();
+}
+
+//------------------------------------------------------------------------
+// resumeUpdateCharacter()
+// The rest of an updateCharacter() that prepareMotionBatch() stopped at the
+// motion update
+//------------------------------------------------------------------------
+bool LLVOAvatar::resumeUpdateCharacter()
+{
+    EMotionBatchState state = mMotionBatchState;
+    mMotionBatchState = MOTION_BATCH_NONE;
+    switch (state)
+    {
+    case MOTION_BATCH_EVALUATED:
+        // joint writes, stop requests and visual param updates
+        finishUpdateMotions();
+        break;
+    case MOTION_BATCH_SERIAL:
+        updateMotions(mPendingUpdateType);
+        break;
+    case MOTION_BATCH_HIDDEN:
+        updateMotions(LLCharacter::HIDDEN_UPDATE);
+        return false;
+    default:
+        llassert(false);
+        return false;
+    }
+    return finishUpdateCharacter(mPendingCharacterVisible, mPendingWasSitGroundConstrained);
+}
+// </FS>
+
 void LLVOAvatar::idleUpdateVoiceVisualizer(bool voice_enabled, const LLVector3 &position)
 {
     bool render_visualizer = voice_enabled;
@@ -4669,7 +4848,8 @@ void LLVOAvatar::slamPosition()
     {
         gPipeline.updateMoveNormalAsync(mDrawable);
     }
-    mRoot->updateWorldMatrixChildren();
+    //mRoot->updateWorldMatrixChildren();
+    updateJointWorldMatrices(); // <FS/> Batched skeleton update
 }
 
 bool LLVOAvatar::isVisuallyMuted()
@@ -5691,6 +5871,14 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     //--------------------------------------------------------------------
     if (!needs_update && !isSelf())
     {
+        // <FS> Parallel animation evaluation
+        if (sMotionBatchOpen)
+        {
+            // done in resumeUpdateCharacter()
+            mMotionBatchState = MOTION_BATCH_HIDDEN;
+            return false;
+        }
+        // </FS>
         updateMotions(LLCharacter::HIDDEN_UPDATE);
         return false;
     }
@@ -5749,20 +5937,63 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     mSpeed = speed;
 
     // update animations
+    // <FS> Parallel animation evaluation
+    //if (!visible && !isSelf()) // NOTE: never do a "hidden update" for self avatar as it interrupts controller processing
+    //{
+    //    updateMotions(LLCharacter::HIDDEN_UPDATE);
+    //}
+    //else if (mSpecialRenderMode == 1) // Animation Preview
+    //{
+    //    updateMotions(LLCharacter::FORCE_UPDATE);
+    //}
+    //else
+    //{
+    //    // Might be better to do HIDDEN_UPDATE if cloud
+    //    updateMotions(LLCharacter::NORMAL_UPDATE);
+    //}
+    LLCharacter::e_update_t update_type = LLCharacter::NORMAL_UPDATE;
     if (!visible && !isSelf()) // NOTE: never do a "hidden update" for self avatar as it interrupts controller processing
     {
-        updateMotions(LLCharacter::HIDDEN_UPDATE);
+        update_type = LLCharacter::HIDDEN_UPDATE;
     }
     else if (mSpecialRenderMode == 1) // Animation Preview
     {
-        updateMotions(LLCharacter::FORCE_UPDATE);
+        update_type = LLCharacter::FORCE_UPDATE;
     }
-    else
+    // else: might be better to do HIDDEN_UPDATE if cloud
+
+    // prepareMotionBatch() stops here. Motions that can be evaluated on the
+    // pool go with the batch; resumeUpdateCharacter() does the rest at this
+    // avatar's turn in the idle loop.
+    if (sMotionBatchOpen)
     {
-        // Might be better to do HIDDEN_UPDATE if cloud
-        updateMotions(LLCharacter::NORMAL_UPDATE);
+        mPendingUpdateType = update_type;
+        mPendingCharacterVisible = visible;
+        mPendingWasSitGroundConstrained = was_sit_ground_constrained;
+        if (canUpdateMotionsConcurrently(update_type))
+        {
+            beginUpdateMotions(update_type);
+            mMotionBatchState = MOTION_BATCH_EVALUATED;
+        }
+        else
+        {
+            mMotionBatchState = MOTION_BATCH_SERIAL;
+        }
+        return visible;
     }
 
+    updateMotions(update_type);
+
+    return finishUpdateCharacter(visible, was_sit_ground_constrained);
+}
+
+//-----------------------------------------------------------------------------
+// finishUpdateCharacter()
+// The rest of updateCharacter(), once the motions have been applied
+//-----------------------------------------------------------------------------
+bool LLVOAvatar::finishUpdateCharacter(bool visible, bool was_sit_ground_constrained)
+{
+    // </FS>
     // Special handling for sitting on ground.
     if (!getParent() && (isSitting() || was_sit_ground_constrained))
     {
@@ -5785,7 +6016,8 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     updateFootstepSounds();
 
     // Update child joints as needed.
-    mRoot->updateWorldMatrixChildren();
+    //mRoot->updateWorldMatrixChildren();
+    updateJointWorldMatrices(); // <FS/> Batched skeleton update
 
     if (visible)
     {
@@ -5893,7 +6125,8 @@ void LLVOAvatar::debugBodySize() const
 //------------------------------------------------------------------------
 void LLVOAvatar::postPelvisSetRecalc()
 {
-    mRoot->updateWorldMatrixChildren();
+    //mRoot->updateWorldMatrixChildren();
+    updateJointWorldMatrices(); // <FS/> Batched skeleton update
     computeBodySize();
     dirtyMesh(2);
 }
@@ -8196,6 +8429,14 @@ void LLVOAvatar::initAttachmentPoints(bool ignore_hud_joints)
 //-----------------------------------------------------------------------------
 void LLVOAvatar::updateVisualParams()
 {
+    // <FS> Parallel animation evaluation
+    // Motions evaluated off the main thread get this done in finishUpdateMotions()
+    if (deferVisualParamUpdate())
+    {
+        return;
+    }
+    // </FS>
+
     ESex avatar_sex = (getVisualParamWeight("male") > 0.5f) ? SEX_MALE : SEX_FEMALE;
     if (getSex() != avatar_sex)
     {
@@ -8223,7 +8464,8 @@ void LLVOAvatar::updateVisualParams()
     {
         computeBodySize();
         mLastSkeletonSerialNum = mSkeletonSerialNum;
-        mRoot->updateWorldMatrixChildren();
+        //mRoot->updateWorldMatrixChildren();
+        updateJointWorldMatrices(); // <FS/> Batched skeleton update
     }
 
     dirtyMesh();
@@ -9044,7 +9286,8 @@ void LLVOAvatar::sitOnObject(LLViewerObject *sit_object)
     mRoot->getXform()->setParent(&sit_object->mDrawable->mXform); // LLVOAvatar::sitOnObject
     // SL-315
     mRoot->setPosition(getPosition());
-    mRoot->updateWorldMatrixChildren();
+    //mRoot->updateWorldMatrixChildren();
+    updateJointWorldMatrices(); // <FS/> Batched skeleton update
 
     stopMotion(ANIM_AGENT_BODY_NOISE);
 
@@ -12628,7 +12871,10 @@ void LLVOAvatar::markBodyPartsComplexityDirty()
     mVisualComplexityStale = true;
 }
 
-void LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complexity)
+// <FS> Avatar complexity budget
+//void LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complexity)
+bool LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complexity)
+// </FS>
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
 
@@ -12637,6 +12883,15 @@ void LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complex
     // till next run. In such a case will need to make sure
     // mVisualComplexityStale remains true.
 
+    // <FS> Avatar complexity budget
+    // All avatars share one allowance per frame. Whatever is left over stays
+    // dirty and the caller keeps mVisualComplexityStale set.
+    static LLCachedControl<F32> update_budget_ms(gSavedSettings, "FSAvatarComplexityUpdateBudget");
+    static LLAvatarComplexityBudget budget;
+    budget.setSecondsPerFrame(update_budget_ms() / 1000.0);
+    const U32 frame = LLFrameTimer::getFrameCount();
+    // </FS>
+
     for (attachment_map_t::iterator iter = mAttachmentPoints.begin();
         iter != mAttachmentPoints.end(); ++iter)
     {
@@ -12658,7 +12913,15 @@ void LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complex
                 // Update if cache is stale or a new entry.
                 if (shouldUpdateComplexityComponent(cache))
                 {
+                    // <FS> Avatar complexity budget
+                    if (!budget.canSpend(frame))
+                    {
+                        return false;
+                    }
+                    LLTimer update_timer;
+                    // </FS>
                     calculateAttachmentComplexity(attached_object, max_attachment_complexity, cache);
+                    budget.spend(update_timer.getElapsedTimeF64()); // <FS/> Avatar complexity budget
                 }
             }
         }
@@ -12669,6 +12932,8 @@ void LLVOAvatar::performPartialComplexityUpdate(const F32 max_attachment_complex
     {
         calculateBodyPartsComplexity(mBodyPartsComplexity);
     }
+
+    return true; // <FS/> Avatar complexity budget
 }
 
 // Calculations for mVisualComplexity value
@@ -12703,7 +12968,18 @@ void LLVOAvatar::calculateUpdateRenderComplexity()
     // per 200 frames. Limiting it by time or count runs the risk of
     // already checked attachments getting stale on last_update_time,
     // thus function will keep running indefinetely.
-    performPartialComplexityUpdate(max_attachment_complexity);
+    // <FS> Avatar complexity budget
+    // Limited by time now. An attachment only goes stale by age after 30
+    // seconds, far longer than a backlog takes to clear, so the totals
+    // are still reached.
+    //performPartialComplexityUpdate(max_attachment_complexity);
+    mComplexityUpdateUnfinished = !performPartialComplexityUpdate(max_attachment_complexity);
+    if (mComplexityUpdateUnfinished)
+    {
+        // Carry on next frame, the totals are summed up once all are in
+        return;
+    }
+    // </FS>
 
     // Reset per-run counters
     mAttachmentSurfaceArea = 0.f;
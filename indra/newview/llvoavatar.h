@@ -283,6 +283,36 @@ public:
     void            updateOrientation(LLAgent &agent, F32 speed, F32 delta_time);
     void            updateTimeStep();
     void            updateRootPositionAndRotation(LLAgent &agent, F32 speed, bool was_sit_ground_constrained);
+    // <FS> Parallel animation evaluation
+    // Before LLViewerObjectList::update() runs the idle loop,
+    // prepareMotionBatch() takes other avatars' idleUpdate() as far as
+    // their motion update and evaluates the motions together. Each
+    // idleUpdate() is then finished at its usual place in the loop;
+    // finishMotionBatch() finishes any the loop didn't get to.
+    static void     prepareMotionBatch(LLAgent &agent, const F64 &time,
+                                       const std::vector<LLViewerObject*>::iterator& begin,
+                                       const std::vector<LLViewerObject*>::iterator& end);
+    static void     finishMotionBatch();
+    bool            canPrepareIdleUpdate();
+    bool            resumeUpdateCharacter();
+    bool            finishUpdateCharacter(bool visible, bool was_sit_ground_constrained);
+    void            idleUpdateAfterCharacter(bool detailed_update);
+private:
+    enum EMotionBatchState
+    {
+        MOTION_BATCH_NONE,      // not stopped at the motion update
+        MOTION_BATCH_EVALUATED, // motions evaluated with the batch, to be applied
+        MOTION_BATCH_SERIAL,    // motions to update at the usual place
+        MOTION_BATCH_HIDDEN     // hidden motion update at the usual place
+    };
+    EMotionBatchState mMotionBatchState;
+    LLCharacter::e_update_t mPendingUpdateType;
+    bool            mPendingCharacterVisible;
+    bool            mPendingWasSitGroundConstrained;
+    static bool     sMotionBatchOpen;
+    static std::vector<LLPointer<LLVOAvatar> > sMotionBatch;
+public:
+    // </FS>
 
     void            idleUpdateVoiceVisualizer(bool voice_enabled, const LLVector3 &position);
     void            idleUpdateMisc(bool detailed_update);
@@ -674,7 +704,12 @@ private:
         object_complexity_list_t& object_list);
 
     bool shouldUpdateComplexityComponent(const ComplexityComponent& component) const;
-    void performPartialComplexityUpdate(const F32 max_attachment_complexity);
+    // <FS> Avatar complexity budget
+    // Returns false if this frame's time ran out before all dirty
+    // attachments were updated.
+    //void performPartialComplexityUpdate(const F32 max_attachment_complexity);
+    bool performPartialComplexityUpdate(const F32 max_attachment_complexity);
+    // </FS>
 
     // <FS:Ansariel> Show per-item complexity in COF
     //void processComplexityCostChange(const hud_complexity_list_t &hud_complexity_list, const object_complexity_list_t &object_complexity_list);
@@ -693,6 +728,7 @@ private:
     // DEPRECATED -- obsolete avatar render cost values
     mutable U32  mVisualComplexity;
     mutable bool mVisualComplexityStale;
+    bool         mComplexityUpdateUnfinished; // <FS/> Avatar complexity budget
     U32          mReportedVisualComplexity; // from other viewers through the simulator
 
     //--------------------------------------------------------------------
@@ -4145,7 +4145,10 @@ void LLVOVolume::updateRiggingInfo()
                 for (S32 f = 0; f < volume->getNumVolumeFaces(); ++f)
                 {
                     LLVolumeFace& vol_face = volume->getVolumeFace(f);
-                    LLSkinningUtil::updateRiggingInfo(skin, avatar, vol_face);
+                    // <FS> Shared rigging info cache
+                    //LLSkinningUtil::updateRiggingInfo(skin, avatar, vol_face);
+                    LLSkinningUtil::updateRiggingInfo(skin, avatar, volume, f);
+                    // </FS>
                     if (vol_face.mJointRiggingInfoTab.size()>0)
                     {
                         mJointRiggingInfoTab.merge(vol_face.mJointRiggingInfoTab);
@@ -5289,6 +5292,11 @@ void LLRiggedVolume::update(
     LLSkinningUtil::initSkinningMatrixPalette(mat, maxJoints, skin, avatar);
     const LLMatrix4a bind_shape_matrix = skin->mBindShapeMatrix;
 
+    // <FS> Batched skinning: each face's decoded weights are checked
+    // against the source face's weights serial below
+    mSkinWeights.resize(getNumVolumeFaces());
+    // </FS>
+
     S32 rigged_vert_count = 0;
     S32 rigged_face_count = 0;
     LLVector4a box_min, box_max;
@@ -5353,21 +5361,34 @@ void LLRiggedVolume::update(
                 else
             #endif
                 {
-                    for (S32 j = 0; j < dst_face.mNumVertices; ++j)
+                    // <FS> Batched skinning: decode the weights once per face and
+                    // skin the whole face in one pass, split across the General
+                    // pool if it is big
+                    //for (S32 j = 0; j < dst_face.mNumVertices; ++j)
+                    //{
+                    //    LLMatrix4a final_mat;
+                    //    // <FS:ND> Use the SSE2 version
+                    //    // LLSkinningUtil::getPerVertexSkinMatrix(weight[j].getF32ptr(), mat, false, final_mat, max_joints);
+                    //    FSSkinningUtil::getPerVertexSkinMatrixSSE(weight[j], mat, false, final_mat, max_joints);
+                    //    // </FS:ND>
+
+                    //    LLVector4a& v = vol_face.mPositions[j];
+                    //    LLVector4a t;
+                    //    LLVector4a dst;
+                    //    bind_shape_matrix.affineTransform(v, t);
+                    //    final_mat.affineTransform(t, dst);
+                    //    pos[j] = dst;
+                    //}
+                    LLSkinningUtil::SkinWeights& skin_weights = mSkinWeights[i];
+                    if (!skin_weights.isDecodedFrom(vol_face.mWeightsSerial, dst_face.mNumVertices))
                     {
-                        LLMatrix4a final_mat;
-                        // <FS:ND> Use the SSE2 version
-                        // LLSkinningUtil::getPerVertexSkinMatrix(weight[j].getF32ptr(), mat, false, final_mat, max_joints);
-                        FSSkinningUtil::getPerVertexSkinMatrixSSE(weight[j], mat, false, final_mat, max_joints);
-                        // </FS:ND>
-
-                        LLVector4a& v = vol_face.mPositions[j];
-                        LLVector4a t;
-                        LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
-                        final_mat.affineTransform(t, dst);
-                        pos[j] = dst;
+                        skin_weights.decode(weight, dst_face.mNumVertices, max_joints, vol_face.mWeightsSerial);
                     }
+                    LLSkinningUtil::skinVerticesParallel(bind_shape_matrix, mat,
+                                                         skin_weights.getJointIndices(), skin_weights.getWeights(),
+                                                         vol_face.mPositions, pos, nullptr, nullptr,
+                                                         dst_face.mNumVertices);
+                    // </FS>
                 }
 
                 //update bounding box
@@ -34,6 +34,7 @@
 #include "lllocalbitmaps.h"
 #include "m3math.h"     // LLMatrix3
 #include "m4math.h"     // LLMatrix4
+#include "llskinningbatch.h" // <FS/> Batched skinning
 #include <unordered_map>
 #include <unordered_set>
 
@@ -78,6 +79,12 @@ public:
         bool rebuild_face_octrees = true);
 
     std::string mExtraDebugText;
+
+    // <FS> Batched skinning
+private:
+    // Decoded weights per face, kept until the source face's weights change
+    std::vector<LLSkinningUtil::SkinWeights> mSkinWeights;
+    // </FS>
 };
 
 // Base class for implementations of the volume - Primitive, Flexible Object, etc.
@@ -133,6 +133,7 @@
 #include "SMAAAreaTex.h"
 #include "SMAASearchTex.h"
 #include "llerror.h"
+#include "lltraceframebudget.h" // <FS/> Frame budget
 #ifndef LL_WINDOWS
 #define A_GCC 1
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -2297,8 +2298,38 @@ void LLPipeline::updateMove()
     }
     mRetexturedList.clear();
 
+    // <FS> Octree node pool
+    //updateMovedList(mMovedList);
+    // Drawables moving out of a group and into the next would otherwise
+    // delete and remake groups as they go: keep them until all have moved
+    const LLWorld::region_list_t& regions = LLWorld::getInstance()->getRegionList();
+    for (LLViewerRegion* region : regions)
+    {
+        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+        {
+            LLSpatialPartition* part = region->getSpatialPartition(i);
+            if (part)
+            {
+                part->mOctree->beginBatch();
+            }
+        }
+    }
+
     updateMovedList(mMovedList);
 
+    for (LLViewerRegion* region : regions)
+    {
+        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+        {
+            LLSpatialPartition* part = region->getSpatialPartition(i);
+            if (part && part->mOctree->isCollapseDeferred())
+            {
+                part->mOctree->endBatch();
+            }
+        }
+    }
+    // </FS>
+
     //balance octrees
     for (LLWorld::region_list_t::const_iterator iter = LLWorld::getInstance()->getRegionList().begin();
         iter != LLWorld::getInstance()->getRegionList().end(); ++iter)
@@ -2637,6 +2668,7 @@ bool LLPipeline::isWaterClip()
 void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_attachments)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE; //LL_RECORD_BLOCK_TIME(FTM_CULL);
+    LL_RECORD_FRAME_BUDGET(CULLING); // <FS/> Frame budget
     LL_PROFILE_GPU_ZONE("updateCull"); // should always be zero GPU time, but drop a timer to flush stuff out
 
     bool water_clip = isWaterClip();
@@ -2975,6 +3007,7 @@ void LLPipeline::clearRebuildDrawables()
 void LLPipeline::rebuildPriorityGroups()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    LL_RECORD_FRAME_BUDGET(REBUILDS); // <FS/> Frame budget
     LL_PROFILE_GPU_ZONE("rebuildPriorityGroups");
 
     LLTimer update_timer;
@@ -3004,6 +3037,7 @@ void LLPipeline::updateGeom(F32 max_dtime)
     LLPointer<LLDrawable> drawablep;
 
     LL_RECORD_BLOCK_TIME(FTM_GEO_UPDATE);
+    LL_RECORD_FRAME_BUDGET(REBUILDS); // <FS/> Frame budget
     if (gCubeSnapshot)
     {
         return;
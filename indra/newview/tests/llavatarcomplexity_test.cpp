@@ -0,0 +1,158 @@
+/**
+ * @file llavatarcomplexity_test.cpp
+ * @brief LLAvatarComplexityBudget test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+// Precompiled header
+#include "../llviewerprecompiledheaders.h"
+
+#include "../test/lltut.h"
+
+#include "../llavatarcomplexity.h"
+#include "lltimer.h"
+
+#include <random>
+
+namespace tut
+{
+    struct avatarcomplexity_test
+    {
+        // A synthetic avatar: how long each of its attachments takes to
+        // account for, and how many of them are done
+        struct Avatar
+        {
+            std::vector<F64> mCosts;
+            size_t mNext = 0;
+        };
+
+        std::mt19937 mRandom{0xa5c};
+
+        std::vector<Avatar> makeAvatars(U32 avatars, U32 attachments)
+        {
+            std::vector<Avatar> result(avatars);
+            for (Avatar& avatar : result)
+            {
+                for (U32 i = 0; i < attachments; i++)
+                {
+                    // 10 to 60 microseconds, the odd one much slower
+                    F64 cost = (10 + mRandom() % 50) * 1e-6;
+                    if (mRandom() % 50 == 0)
+                    {
+                        cost *= 10.0;
+                    }
+                    avatar.mCosts.push_back(cost);
+                }
+            }
+            return result;
+        }
+
+        static void busyWait(F64 seconds)
+        {
+            LLTimer timer;
+            while (timer.getElapsedTimeF64() < seconds)
+            {
+            }
+        }
+
+        // LLVOAvatar::performPartialComplexityUpdate() for one avatar: false
+        // if the frame's time ran out first
+        static bool update(Avatar& avatar, LLAvatarComplexityBudget& budget, U32 frame)
+        {
+            while (avatar.mNext < avatar.mCosts.size())
+            {
+                if (!budget.canSpend(frame))
+                {
+                    return false;
+                }
+                LLTimer timer;
+                busyWait(avatar.mCosts[avatar.mNext++]);
+                budget.spend(timer.getElapsedTimeF64());
+            }
+            return true;
+        }
+    };
+    typedef test_group<avatarcomplexity_test> avatarcomplexity_test_t;
+    typedef avatarcomplexity_test_t::object avatarcomplexity_test_object_t;
+    tut::avatarcomplexity_test_t tut_avatarcomplexity_test("LLAvatarComplexityBudget");
+
+    template<> template<>
+    void avatarcomplexity_test_object_t::test<1>()
+    {
+        set_test_name("allowance per frame");
+
+        LLAvatarComplexityBudget unlimited;
+        unlimited.spend(10.0);
+        ensure("no limit", unlimited.canSpend(1));
+
+        LLAvatarComplexityBudget budget(0.001);
+        ensure("first of the frame", budget.canSpend(1));
+        budget.spend(0.0006);
+        ensure("time left", budget.canSpend(1));
+        budget.spend(0.0006);
+        ensure("used up", !budget.canSpend(1));
+        ensure_approximately_equals_range("spent", (F32)budget.getSpent(), 0.0012f, 1e-6f);
+
+        ensure("next frame", budget.canSpend(2));
+        ensure_equals("spent in next frame", budget.getSpent(), 0.0);
+
+        // a single slow update still goes through at the start of a frame
+        budget.spend(0.5);
+        ensure("over budget", !budget.canSpend(2));
+        ensure("frame after", budget.canSpend(3));
+    }
+
+    template<> template<>
+    void avatarcomplexity_test_object_t::test<2>()
+    {
+        set_test_name("main thread time per frame");
+
+        // 50 avatars arrive with 30 fresh attachments each
+        const U32 AVATARS = 50;
+        const F64 BUDGET = 0.001;
+
+        std::vector<Avatar> avatars = makeAvatars(AVATARS, 30);
+        LLAvatarComplexityBudget unlimited;
+        for (Avatar& avatar : avatars)
+        {
+            ensure("unlimited", update(avatar, unlimited, 1));
+        }
+
+        avatars = makeAvatars(AVATARS, 30);
+        LLAvatarComplexityBudget budget(BUDGET);
+        F64 worst_ms = 0.0;
+        U32 finished = 0;
+        for (U32 frame = 1; finished < AVATARS; frame++)
+        {
+            ensure("frames", frame < 10000);
+            finished = 0;
+            for (Avatar& avatar : avatars)
+            {
+                finished += update(avatar, budget, frame) ? 1 : 0;
+            }
+            worst_ms = llmax(worst_ms, budget.getSpent() * 1000.0);
+        }
+        // the slowest attachment takes 600 microseconds; the rest is slack
+        // for the scheduler
+        ensure("within budget", worst_ms < BUDGET * 1000.0 + 2.0);
+    }
+}
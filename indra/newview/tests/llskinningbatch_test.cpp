@@ -0,0 +1,281 @@
+/**
+ * @file llskinningbatch_test.cpp
+ * @brief Batched face skinning test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+// Precompiled header
+#include "../llviewerprecompiledheaders.h"
+
+#include "../test/lltut.h"
+
+#include "../llskinningbatch.h"
+#include "../llskinningutil.h"
+#include "llvolume.h"
+#include "threadpool.h"
+
+#include <random>
+
+namespace tut
+{
+    struct skinningbatch_test
+    {
+        static const U32 JOINTS = 110;
+        LL::ThreadPool mPool{"SkinningBatchTest", 3};
+        std::mt19937 mRandom{0x5c1d};
+
+        std::vector<LLMatrix4a> mPalette;
+        LLMatrix4a mBindShape;
+
+        // A mesh face as the mesh repository hands it to LLRiggedVolume
+        std::vector<LLVector4a> mPositions;
+        std::vector<LLVector4a> mNormals;
+        std::vector<LLVector4a> mPackedWeights;
+
+        skinningbatch_test()
+        {
+            mPool.start();
+
+            mPalette.resize(JOINTS);
+            for (LLMatrix4a& mat : mPalette)
+            {
+                mat = randomAffine();
+            }
+            mBindShape = randomAffine();
+        }
+
+        ~skinningbatch_test()
+        {
+            mPool.close();
+        }
+
+        F32 frand(F32 lo, F32 hi)
+        {
+            return lo + (hi - lo) * (F32)(mRandom() % 100000) / 100000.f;
+        }
+
+        LLMatrix4a randomAffine()
+        {
+            LLMatrix4a mat;
+            mat.mMatrix[0].set(frand(0.5f, 1.5f), frand(-0.5f, 0.5f), frand(-0.5f, 0.5f), 0.f);
+            mat.mMatrix[1].set(frand(-0.5f, 0.5f), frand(0.5f, 1.5f), frand(-0.5f, 0.5f), 0.f);
+            mat.mMatrix[2].set(frand(-0.5f, 0.5f), frand(-0.5f, 0.5f), frand(0.5f, 1.5f), 0.f);
+            mat.mMatrix[3].set(frand(-2.f, 2.f), frand(-2.f, 2.f), frand(-2.f, 2.f), 1.f);
+            return mat;
+        }
+
+        void makeFace(U32 num_vertices)
+        {
+            mPositions.resize(num_vertices);
+            mNormals.resize(num_vertices);
+            mPackedWeights.resize(num_vertices);
+            for (U32 i = 0; i < num_vertices; i++)
+            {
+                mPositions[i].set(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f), 1.f);
+                mNormals[i].set(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(0.1f, 1.f), 0.f);
+                mNormals[i].normalize3fast();
+                // <joint_index>.<weight>, as in LLVolumeFace::mWeights
+                mPackedWeights[i].set((F32)(mRandom() % JOINTS) + frand(0.05f, 0.95f),
+                                      (F32)(mRandom() % JOINTS) + frand(0.05f, 0.95f),
+                                      (F32)(mRandom() % JOINTS) + frand(0.05f, 0.95f),
+                                      (F32)(mRandom() % JOINTS) + frand(0.05f, 0.95f));
+            }
+        }
+
+        // The per vertex path: unpack weights, blend the palette, transform.
+        void skinScalar(LLVector4a* dst_pos, LLVector4a* dst_norm)
+        {
+            LLMatrix4a src[4];
+            for (size_t i = 0; i < mPositions.size(); i++)
+            {
+                const F32* packed = mPackedWeights[i].getF32ptr();
+                U8 idx[4];
+                F32 weights[4];
+                F32 scale = 0.f;
+                for (U32 k = 0; k < 4; k++)
+                {
+                    idx[k] = (U8)llclamp((S32)floorf(packed[k]), 0, (S32)JOINTS - 1);
+                    weights[k] = packed[k] - floorf(packed[k]);
+                    scale += weights[k];
+                }
+                for (U32 k = 0; k < 4; k++)
+                {
+                    weights[k] /= scale;
+                }
+
+                LLMatrix4a final_mat;
+                LLSkinningUtil::getPerVertexSkinMatrixWithIndices(weights, idx, mPalette.data(), final_mat, src);
+
+                LLVector4a t;
+                mBindShape.affineTransform(mPositions[i], t);
+                final_mat.affineTransform(t, dst_pos[i]);
+
+                mBindShape.rotate(mNormals[i], t);
+                final_mat.rotate(t, dst_norm[i]);
+                dst_norm[i].normalize3fast();
+            }
+        }
+
+        static F32 maxDiff(const std::vector<LLVector4a>& a, const std::vector<LLVector4a>& b)
+        {
+            F32 max_diff = 0.f;
+            for (size_t i = 0; i < a.size(); i++)
+            {
+                for (U32 k = 0; k < 3; k++)
+                {
+                    max_diff = llmax(max_diff, fabsf(a[i][k] - b[i][k]) / llmax(1.f, fabsf(a[i][k])));
+                }
+            }
+            return max_diff;
+        }
+    };
+    typedef test_group<skinningbatch_test> skinningbatch_test_t;
+    typedef skinningbatch_test_t::object skinningbatch_test_object_t;
+    tut::skinningbatch_test_t tut_skinningbatch_test("LLSkinningBatch");
+
+    template<> template<>
+    void skinningbatch_test_object_t::test<1>()
+    {
+        set_test_name("weights are decoded and normalized up front");
+
+        LLVector4a packed[3];
+        packed[0].set(3.5f, 7.25f, 0.25f, 9.f);
+        packed[1].set(200.5f, 1.5f, 0.f, 0.f);     // index past the palette is clamped
+        packed[2].set(12.75f, 12.25f, 0.f, 0.f);
+
+        LLSkinningUtil::SkinWeights decoded;
+        decoded.decode(packed, 3, 20, 42);
+        ensure_equals("size", decoded.size(), 3U);
+        ensure("source", decoded.isDecodedFrom(42, 3));
+        ensure("different source", !decoded.isDecodedFrom(43, 3));
+        ensure("different size", !decoded.isDecodedFrom(42, 2));
+
+        const U8* idx = decoded.getJointIndices();
+        const U8 expected_idx[12] = { 3, 7, 0, 9,  19, 1, 0, 0,  12, 12, 0, 0 };
+        for (U32 k = 0; k < 12; k++)
+        {
+            ensure_equals("joint index", (S32)idx[k], (S32)expected_idx[k]);
+        }
+
+        const F32* w = decoded.getWeights()[0].getF32ptr();
+        ensure_approximately_equals_range("w0", w[0], 0.5f, 1e-6f);
+        ensure_approximately_equals_range("w1", w[1], 0.25f, 1e-6f);
+        ensure_approximately_equals_range("w2", w[2], 0.25f, 1e-6f);
+        ensure_approximately_equals_range("w3", w[3], 0.f, 1e-6f);
+        w = decoded.getWeights()[1].getF32ptr();
+        ensure_approximately_equals_range("w0 of clamped", w[0], 0.5f, 1e-6f);
+        w = decoded.getWeights()[2].getF32ptr();
+        ensure_approximately_equals_range("w0 shared joint", w[0], 0.75f, 1e-6f);
+        ensure_approximately_equals_range("w1 shared joint", w[1], 0.25f, 1e-6f);
+
+        decoded.clear();
+        ensure_equals("cleared", decoded.size(), 0U);
+        ensure("cleared source", !decoded.isDecodedFrom(42, 3));
+
+        decoded.decode(packed, 3, 20);
+        ensure("no source", !decoded.isDecodedFrom(0, 3));
+    }
+
+    template<> template<>
+    void skinningbatch_test_object_t::test<2>()
+    {
+        set_test_name("batched skinning matches the per vertex path");
+
+        // odd sizes leave tails for the scalar cleanup loop
+        for (U32 num_vertices : { 1u, 7u, 1001u })
+        {
+            makeFace(num_vertices);
+            std::vector<LLVector4a> scalar_pos(num_vertices), scalar_norm(num_vertices);
+            skinScalar(scalar_pos.data(), scalar_norm.data());
+
+            LLSkinningUtil::SkinWeights decoded;
+            decoded.decode(mPackedWeights.data(), num_vertices, JOINTS);
+
+            std::vector<LLVector4a> pos(num_vertices), norm(num_vertices);
+            LLSkinningUtil::skinVertices(mBindShape, mPalette.data(), decoded.getJointIndices(), decoded.getWeights(),
+                                         mPositions.data(), pos.data(), mNormals.data(), norm.data(),
+                                         0, num_vertices);
+            ensure("positions", maxDiff(scalar_pos, pos) < 1e-5f);
+            ensure("normals", maxDiff(scalar_norm, norm) < 1e-5f);
+
+            // positions only, in pieces, leaves the normals alone
+            std::vector<LLVector4a> piecewise(num_vertices);
+            LLSkinningUtil::skinVertices(mBindShape, mPalette.data(), decoded.getJointIndices(), decoded.getWeights(),
+                                         mPositions.data(), piecewise.data(), nullptr, nullptr,
+                                         0, num_vertices / 3);
+            LLSkinningUtil::skinVertices(mBindShape, mPalette.data(), decoded.getJointIndices(), decoded.getWeights(),
+                                         mPositions.data(), piecewise.data(), nullptr, nullptr,
+                                         num_vertices / 3, num_vertices);
+            ensure("piecewise positions", maxDiff(pos, piecewise) == 0.f);
+        }
+    }
+
+    template<> template<>
+    void skinningbatch_test_object_t::test<3>()
+    {
+        set_test_name("threaded skinning matches serial skinning");
+
+        const U32 num_vertices = 10 * LLSkinningUtil::SKIN_CHUNK_VERTICES + 123;
+        makeFace(num_vertices);
+        LLSkinningUtil::SkinWeights decoded;
+        decoded.decode(mPackedWeights.data(), num_vertices, JOINTS);
+
+        std::vector<LLVector4a> serial_pos(num_vertices), serial_norm(num_vertices);
+        std::vector<LLVector4a> threaded_pos(num_vertices), threaded_norm(num_vertices);
+        LLSkinningUtil::skinVertices(mBindShape, mPalette.data(), decoded.getJointIndices(), decoded.getWeights(),
+                                     mPositions.data(), serial_pos.data(), mNormals.data(), serial_norm.data(),
+                                     0, num_vertices);
+        LLSkinningUtil::skinVerticesParallel(mBindShape, mPalette.data(), decoded.getJointIndices(), decoded.getWeights(),
+                                             mPositions.data(), threaded_pos.data(), mNormals.data(), threaded_norm.data(),
+                                             num_vertices, "SkinningBatchTest");
+        ensure("positions", maxDiff(serial_pos, threaded_pos) == 0.f);
+        ensure("normals", maxDiff(serial_norm, threaded_norm) == 0.f);
+    }
+
+    template<> template<>
+    void skinningbatch_test_object_t::test<4>()
+    {
+        set_test_name("faces give their weights a new serial each time");
+
+        LLVolumeFace face;
+        ensure_equals("no weights", face.mWeightsSerial, (U64)0);
+        // copies only carry weights over for faces with vertices
+        face.resizeVertices(16);
+        face.allocateWeights(16);
+        const U64 first = face.mWeightsSerial;
+        ensure("first weights", first != 0);
+
+        // the same size again may well reuse the same block
+        face.allocateWeights(16);
+        ensure("new weights", face.mWeightsSerial != first);
+
+        LLSkinningUtil::SkinWeights decoded;
+        decoded.decode(face.mWeights, 0, JOINTS, first);
+        ensure("stale after reallocation", !decoded.isDecodedFrom(face.mWeightsSerial, 0));
+
+        LLVolumeFace copy(face);
+        ensure("copies get their own", copy.mWeightsSerial != 0 && copy.mWeightsSerial != face.mWeightsSerial);
+
+        face = LLVolumeFace();
+        ensure_equals("weights gone", face.mWeightsSerial, (U64)0);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * @file llsurfacerebuild_test.cpp
+ * @brief Terrain patch rebuild test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+// Precompiled header
+#include "../llviewerprecompiledheaders.h"
+
+#include "../test/lltut.h"
+
+#include "../llsurfacerebuild.h"
+#include "llparallelfor.h"
+#include "threadpool.h"
+
+#include <cmath>
+
+namespace tut
+{
+    struct surfacerebuild_test
+    {
+        static const U32 GRIDS_PER_PATCH_EDGE = 16;
+        LL::ThreadPool mPool{"SurfaceRebuildTest", 3};
+
+        surfacerebuild_test()
+        {
+            mPool.start();
+        }
+
+        ~surfacerebuild_test()
+        {
+            mPool.close();
+        }
+
+        // Rolling hills plus some higher frequency detail, grids_per_edge^2 samples
+        static std::vector<F32> makeHeightField(U32 grids_per_edge)
+        {
+            std::vector<F32> dataz(grids_per_edge * grids_per_edge);
+            for (U32 y = 0; y < grids_per_edge; y++)
+            {
+                for (U32 x = 0; x < grids_per_edge; x++)
+                {
+                    dataz[y*grids_per_edge + x] = 20.f
+                        + 12.f * sinf(x * 0.031f) * cosf(y * 0.027f)
+                        + 1.5f * sinf(x * 0.7f + y * 0.3f);
+                }
+            }
+            return dataz;
+        }
+
+        // Interior normals and vertical stats for every patch of a field, either
+        // one patch after another or spread across the pool.
+        static void rebuild(const std::vector<F32>& dataz, std::vector<LLVector3>& datanorm,
+                            std::vector<LLSurfaceRebuild::VerticalStats>& stats,
+                            U32 grids_per_edge, bool threaded)
+        {
+            const U32 patches_per_edge = (grids_per_edge - 1) / GRIDS_PER_PATCH_EDGE;
+            stats.resize(patches_per_edge * patches_per_edge);
+            auto patch = [&](size_t i)
+            {
+                const U32 offset = (U32)((i / patches_per_edge) * grids_per_edge + (i % patches_per_edge))
+                                   * GRIDS_PER_PATCH_EDGE;
+                LLSurfaceRebuild::calcInteriorNormals(dataz.data() + offset, datanorm.data() + offset,
+                                                      grids_per_edge, 1.f, 2,
+                                                      2, GRIDS_PER_PATCH_EDGE - 2,
+                                                      2, GRIDS_PER_PATCH_EDGE - 2);
+                stats[i] = LLSurfaceRebuild::calcVerticalStats(dataz.data() + offset,
+                                                               GRIDS_PER_PATCH_EDGE, grids_per_edge);
+            };
+
+            if (threaded)
+            {
+                LL::parallel_for("SurfaceRebuildTest", stats.size(), patch);
+            }
+            else
+            {
+                for (size_t i = 0; i < stats.size(); i++)
+                {
+                    patch(i);
+                }
+            }
+        }
+    };
+    typedef test_group<surfacerebuild_test> surfacerebuild_test_t;
+    typedef surfacerebuild_test_t::object surfacerebuild_test_object_t;
+    tut::surfacerebuild_test_t tut_surfacerebuild_test("LLSurfaceRebuild");
+
+    template<> template<>
+    void surfacerebuild_test_object_t::test<1>()
+    {
+        set_test_name("vertical stats include the shared edges");
+        const U32 grids_per_edge = 33;
+        std::vector<F32> dataz(grids_per_edge * grids_per_edge, 1.f);
+        dataz[GRIDS_PER_PATCH_EDGE * grids_per_edge + GRIDS_PER_PATCH_EDGE] = 5.f;  // north east corner
+        dataz[3 * grids_per_edge + 4] = -3.f;
+        dataz[GRIDS_PER_PATCH_EDGE + 1] = 100.f;                                   // next patch over
+
+        LLSurfaceRebuild::VerticalStats stats =
+            LLSurfaceRebuild::calcVerticalStats(dataz.data(), GRIDS_PER_PATCH_EDGE, grids_per_edge);
+        ensure_equals("min", stats.mMinZ, -3.f);
+        ensure_equals("max", stats.mMaxZ, 5.f);
+        ensure_approximately_equals_range("mean", stats.mMeanZ, (287.f + 5.f - 3.f) / 289.f, 1e-5f);
+    }
+
+    template<> template<>
+    void surfacerebuild_test_object_t::test<2>()
+    {
+        set_test_name("interior normals of a plane");
+        const U32 grids_per_edge = 17;
+        std::vector<F32> dataz(grids_per_edge * grids_per_edge);
+        std::vector<LLVector3> datanorm(grids_per_edge * grids_per_edge);
+        for (U32 y = 0; y < grids_per_edge; y++)
+        {
+            for (U32 x = 0; x < grids_per_edge; x++)
+            {
+                dataz[y*grids_per_edge + x] = 0.5f * x;
+            }
+        }
+        LLSurfaceRebuild::calcInteriorNormals(dataz.data(), datanorm.data(), grids_per_edge, 2.f, 2,
+                                              2, 14, 2, 14);
+
+        LLVector3 expected(-0.25f, 0.f, 1.f);
+        expected.normVec();
+        const LLVector3& normal = datanorm[8*grids_per_edge + 8];
+        ensure_approximately_equals_range("interior x", normal.mV[VX], expected.mV[VX], 1e-6f);
+        ensure_approximately_equals_range("interior y", normal.mV[VY], expected.mV[VY], 1e-6f);
+        ensure_approximately_equals_range("interior z", normal.mV[VZ], expected.mV[VZ], 1e-6f);
+        ensure_equals("border untouched", datanorm[1*grids_per_edge + 8], LLVector3::zero);
+    }
+
+    template<> template<>
+    void surfacerebuild_test_object_t::test<3>()
+    {
+        set_test_name("threaded rebuild matches serial rebuild");
+        for (U32 grids_per_edge : { 257u, 1025u })
+        {
+            std::vector<F32> dataz = makeHeightField(grids_per_edge);
+            std::vector<LLVector3> serial_norm(dataz.size()), threaded_norm(dataz.size());
+            std::vector<LLSurfaceRebuild::VerticalStats> serial_stats, threaded_stats;
+
+            rebuild(dataz, serial_norm, serial_stats, grids_per_edge, false);
+            rebuild(dataz, threaded_norm, threaded_stats, grids_per_edge, true);
+
+            ensure("normals", serial_norm == threaded_norm);
+            for (size_t i = 0; i < serial_stats.size(); i++)
+            {
+                ensure_equals("min", threaded_stats[i].mMinZ, serial_stats[i].mMinZ);
+                ensure_equals("max", threaded_stats[i].mMaxZ, serial_stats[i].mMaxZ);
+                ensure_equals("mean", threaded_stats[i].mMeanZ, serial_stats[i].mMeanZ);
+            }
+        }
+    }
+}
@@ -30,6 +30,9 @@
 #include "lltut.h"
 #include "linden_common.h"
 #include "lldatapacker.h"
+#include "llbitpack.h"
+#include "llmath.h"
+#include "llquantize.h"
 #include "v4color.h"
 #include "v4coloru.h"
 #include "v2math.h"
@@ -37,6 +40,8 @@
 #include "v4math.h"
 #include "llsdserialize.h"
 
+#include <random>
+
 #define TEST_FILE_NAME  "datapacker_test.txt"
 namespace tut
 {
@@ -56,14 +61,14 @@ namespace tut
         F32 f_val2 = 12344.443232f, f_unpkval2;
         F32 f_val3 = 44.4456789f, f_unpkval3;
         LLDataPackerBinaryBuffer lldp(packbuf,128);
-        lldp.packFixed( f_val1, "linden_lab", FALSE, 8, 8);
-        lldp.packFixed( f_val2, "linden_lab", FALSE, 14, 16);
-        lldp.packFixed( f_val3, "linden_lab", FALSE, 8, 23);
+        lldp.packFixed( f_val1, "linden_lab", false, 8, 8);
+        lldp.packFixed( f_val2, "linden_lab", false, 14, 16);
+        lldp.packFixed( f_val3, "linden_lab", false, 8, 23);
 
         LLDataPackerBinaryBuffer lldp1(packbuf, lldp.getCurrentSize());
-        lldp1.unpackFixed(f_unpkval1, "linden_lab", FALSE, 8, 8);
-        lldp1.unpackFixed(f_unpkval2, "linden_lab", FALSE, 14, 16);
-        lldp1.unpackFixed(f_unpkval3, "linden_lab", FALSE, 8, 23);
+        lldp1.unpackFixed(f_unpkval1, "linden_lab", false, 8, 8);
+        lldp1.unpackFixed(f_unpkval2, "linden_lab", false, 14, 16);
+        lldp1.unpackFixed(f_unpkval3, "linden_lab", false, 8, 23);
         ensure_approximately_equals("LLDataPackerBinaryBuffer::packFixed 8 failed", f_val1, f_unpkval1, 8);
         ensure_approximately_equals("LLDataPackerBinaryBuffer::packFixed 16 failed", f_val2, f_unpkval2, 16);
         ensure_approximately_equals("LLDataPackerBinaryBuffer::packFixed 23 failed", f_val3, f_unpkval3, 31);
@@ -188,8 +193,11 @@ namespace tut
     template<> template<>
     void datapacker_test_object_t::test<5>()
     {
-        U8 buf[] = "SecondLife is virtual World";
-        S32 size = sizeof(buf);
+        // assignBuffer() frees the buffer it replaces
+        const char text[] = "SecondLife is virtual World";
+        S32 size = sizeof(text);
+        U8* buf = new U8[size];
+        memcpy(buf, text, size); /* Flawfinder: ignore */
         LLDataPackerBinaryBuffer lldp(buf, size);
         U8 new_buf[] = "Its Amazing";
         size = sizeof(new_buf);
@@ -221,10 +229,10 @@ namespace tut
         char packbuf[128];
         F32 f_val = 44.44f, f_unpkval;
         LLDataPackerAsciiBuffer lldp(packbuf,128);
-        lldp.packFixed( f_val, "linden_lab", FALSE, 8, 8);
+        lldp.packFixed( f_val, "linden_lab", false, 8, 8);
 
         LLDataPackerAsciiBuffer lldp1(packbuf, lldp.getCurrentSize());
-        lldp1.unpackFixed(f_unpkval, "linden_lab", FALSE, 8, 8);
+        lldp1.unpackFixed(f_unpkval, "linden_lab", false, 8, 8);
         ensure_approximately_equals("LLDataPackerAsciiBuffer::packFixed failed", f_val, f_unpkval, 8);
     }
 
@@ -354,13 +362,13 @@ namespace tut
         }
 
         LLDataPackerAsciiFile lldp(fp,2);
-        lldp.packFixed( f_val, "linden_lab", FALSE, 8, 8);
+        lldp.packFixed( f_val, "linden_lab", false, 8, 8);
 
         fflush(fp);
         fseek(fp,0,SEEK_SET);
         LLDataPackerAsciiFile lldp1(fp,2);
 
-        lldp1.unpackFixed(f_unpkval, "linden_lab", FALSE, 8, 8);
+        lldp1.unpackFixed(f_unpkval, "linden_lab", false, 8, 8);
         fclose(fp);
 
         ensure_approximately_equals("LLDataPackerAsciiFile::packFixed failed", f_val, f_unpkval, 8);
@@ -470,12 +478,12 @@ namespace tut
 
         std::ostringstream ostr;
         LLDataPackerAsciiFile lldp(ostr,2);
-        lldp.packFixed( f_val, "linden_lab", FALSE, 8, 8);
+        lldp.packFixed( f_val, "linden_lab", false, 8, 8);
 
         std::istringstream istr(ostr.str());
         LLDataPackerAsciiFile lldp1(istr,2);
 
-        lldp1.unpackFixed(f_unpkval, "linden_lab", FALSE, 8, 8);
+        lldp1.unpackFixed(f_unpkval, "linden_lab", false, 8, 8);
 
         ensure_approximately_equals("LLDataPackerAsciiFile::packFixed (iostring) failed", f_val, f_unpkval, 8);
     }
@@ -567,4 +575,255 @@ namespace tut
         ensure_equals("LLDataPackerAsciiFile::packVector4 (iostring) failed", llvec4, unpkllvec4);
         ensure_equals("LLDataPackerAsciiFile::packUUID (iostring) failed", uuid, unpkuuid);
     }
+
+    //*********LLDataPackerBinaryBuffer bulk unpacking
+
+    template<> template<>
+    void datapacker_test_object_t::test<15>()
+    {
+        set_test_name("bulk unpack of a short buffer fails like per-field unpack");
+
+        const S32 COUNT = 13;
+        const S32 AVAILABLE = 9;
+        U8 packbuf[COUNT * 2];
+        LLDataPackerBinaryBuffer lldp(packbuf, sizeof(packbuf));
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            lldp.packU16((U16)(i * 5039 + 1), "q");
+        }
+
+        U16 bulk[COUNT] = {};
+        LLDataPackerBinaryBuffer short_bulk(packbuf, AVAILABLE * 2);
+        LLDataPacker &dp = short_bulk;
+        ensure("bulk unpack fails", !dp.unpackU16s(bulk, COUNT, "q"));
+
+        U16 scalar[COUNT] = {};
+        LLDataPackerBinaryBuffer short_scalar(packbuf, AVAILABLE * 2);
+        bool success = true;
+        for (S32 i = 0; i < COUNT && success; i++)
+        {
+            success = short_scalar.unpackU16(scalar[i], "q");
+        }
+        ensure("per-field unpack fails", !success);
+
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            ensure_equals("same values", bulk[i], scalar[i]);
+        }
+        ensure_equals("values that fit", bulk[AVAILABLE - 1], (U16)((AVAILABLE - 1) * 5039 + 1));
+        ensure_equals("same position", short_bulk.getCurrentSize(), short_scalar.getCurrentSize());
+    }
+
+    template<> template<>
+    void datapacker_test_object_t::test<16>()
+    {
+        set_test_name("bulk unpack matches per-field unpack");
+
+        const S32 COUNT = 45;
+        U8 packbuf[COUNT * (2 + 2 + 4 + 4 + UUID_BYTES)];
+        U16 u16s[COUNT];
+        S16 s16s[COUNT];
+        F32 f32s[COUNT];
+        LLColor4U colors[COUNT];
+        LLUUID uuids[COUNT];
+
+        LLDataPackerBinaryBuffer lldp(packbuf, sizeof(packbuf));
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            u16s[i] = (U16)(i * 1021);
+            lldp.packU16(u16s[i], "u16");
+        }
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            s16s[i] = (S16)(i * -731);
+            lldp.packS16(s16s[i], "s16");
+        }
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            f32s[i] = i * 3.25f - 17.f;
+            lldp.packF32(f32s[i], "f32");
+        }
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            colors[i].set((U8)i, (U8)(i * 3), (U8)(255 - i), (U8)(i * 5));
+            lldp.packColor4U(colors[i], "color");
+        }
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            uuids[i].generate();
+            lldp.packUUID(uuids[i], "uuid");
+        }
+
+        U16 unpku16s[COUNT];
+        S16 unpks16s[COUNT];
+        F32 unpkf32s[COUNT];
+        LLColor4U unpkcolors[COUNT];
+        LLUUID unpkuuids[COUNT];
+
+        // through the virtual interface, as LLViewerObject sees it
+        LLDataPackerBinaryBuffer lldp1(packbuf, lldp.getCurrentSize());
+        LLDataPacker &dp = lldp1;
+        ensure("unpackU16s", dp.unpackU16s(unpku16s, COUNT, "u16"));
+        ensure("unpackS16s", dp.unpackS16s(unpks16s, COUNT, "s16"));
+        ensure("unpackF32s", dp.unpackF32s(unpkf32s, COUNT, "f32"));
+        ensure("unpackColor4Us", dp.unpackColor4Us(unpkcolors, COUNT, "color"));
+        ensure("unpackUUIDs", dp.unpackUUIDs(unpkuuids, COUNT, "uuid"));
+        ensure("past the end", !dp.unpackU16s(unpku16s, 1, "u16"));
+
+        for (S32 i = 0; i < COUNT; i++)
+        {
+            ensure_equals("U16s", unpku16s[i], u16s[i]);
+            ensure_equals("S16s", unpks16s[i], s16s[i]);
+            ensure_equals("F32s", unpkf32s[i], f32s[i]);
+            ensure_equals("Color4Us", unpkcolors[i], colors[i]);
+            ensure_equals("UUIDs", unpkuuids[i], uuids[i]);
+        }
+    }
+
+    template<> template<>
+    void datapacker_test_object_t::test<17>()
+    {
+        set_test_name("U16s_to_F32s matches U16_to_F32");
+
+        const F32 ranges[][2] = { { -1.f, 1.f }, { -128.f, 128.f }, { -64.f, 64.f },
+                                  { -128.f, 384.f }, { 0.f, 4096.f }, { -0.001f, 10000.f } };
+        std::vector<U16> quantized(65536);
+        for (S32 i = 0; i < 65536; i++)
+        {
+            quantized[i] = (U16)i;
+        }
+        std::vector<F32> bulk(65536);
+        std::vector<F32> lower(65536), upper(65536);
+
+        for (const auto& range : ranges)
+        {
+            U16s_to_F32s(quantized.data(), bulk.data(), 65535, range[0], range[1]);
+            for (S32 i = 0; i < 65535; i++)
+            {
+                F32 scalar = U16_to_F32(quantized[i], range[0], range[1]);
+                ensure("shared range", memcmp(&scalar, &bulk[i], sizeof(F32)) == 0);
+            }
+        }
+
+        // per-value ranges, cycling through the table so every lane sees every range
+        const S32 num_ranges = LL_ARRAY_SIZE(ranges);
+        for (S32 i = 0; i < 65536; i++)
+        {
+            lower[i] = ranges[i % num_ranges][0];
+            upper[i] = ranges[i % num_ranges][1];
+        }
+        U16s_to_F32s(quantized.data(), bulk.data(), 65533, lower.data(), upper.data());
+        for (S32 i = 0; i < 65533; i++)
+        {
+            F32 scalar = U16_to_F32(quantized[i], lower[i], upper[i]);
+            ensure("per-value range", memcmp(&scalar, &bulk[i], sizeof(F32)) == 0);
+        }
+    }
+
+    // The bit-at-a-time loops LLBitPack used before it moved whole runs of bits.
+    struct reference_bitpack
+    {
+        U8 *mBuffer;
+        U32 mBufferSize = 0;
+        U8 mLoad = 0;
+        U32 mLoadSize = 0;
+
+        reference_bitpack(U8 *buffer) : mBuffer(buffer) {}
+
+        void pack(U8 data, U32 dsize)
+        {
+            while (dsize > 0)
+            {
+                if (mLoadSize == MAX_DATA_BITS)
+                {
+                    mBuffer[mBufferSize++] = mLoad;
+                    mLoadSize = 0;
+                    mLoad = 0x00;
+                }
+                mLoad <<= 1;
+                mLoad |= (data >> (MAX_DATA_BITS - 1));
+                data <<= 1;
+                mLoadSize++;
+                dsize--;
+            }
+        }
+
+        U8 unpack(U32 dsize)
+        {
+            U8 retval = 0;
+            while (dsize > 0)
+            {
+                if (mLoadSize == 0)
+                {
+                    mLoad = mBuffer[mBufferSize++];
+                    mLoadSize = MAX_DATA_BITS;
+                }
+                retval <<= 1;
+                retval |= (mLoad >> (MAX_DATA_BITS - 1));
+                mLoadSize--;
+                mLoad <<= 1;
+                dsize--;
+            }
+            return retval;
+        }
+    };
+
+    template<> template<>
+    void datapacker_test_object_t::test<18>()
+    {
+        set_test_name("LLBitPack matches bit-at-a-time packing");
+
+        std::mt19937 random(0xb17);
+        const S32 FIELDS = 4000;
+        std::vector<U32> widths(FIELDS);
+        std::vector<U32> values(FIELDS);
+        for (S32 i = 0; i < FIELDS; i++)
+        {
+            widths[i] = 1 + random() % 32;
+            values[i] = (U32)random() & (widths[i] == 32 ? 0xFFFFFFFF : ((1U << widths[i]) - 1));
+        }
+
+        std::vector<U8> packed(FIELDS * 4 + 1), expected(FIELDS * 4 + 1);
+        LLBitPack bitpack(packed.data(), (U32)packed.size());
+        reference_bitpack reference(expected.data());
+        for (S32 i = 0; i < FIELDS; i++)
+        {
+            bitpack.bitPack((U8*)&values[i], widths[i]);
+            // bitPack() takes the low bits of each byte, least significant byte first
+            U32 remaining = widths[i];
+            const U8 *bytes = (const U8*)&values[i];
+            while (remaining)
+            {
+                U32 dsize = llmin(remaining, MAX_DATA_BITS);
+                reference.pack((U8)(*bytes++ << (MAX_DATA_BITS - dsize)), dsize);
+                remaining -= dsize;
+            }
+        }
+        bitpack.flushBitPack();
+        if (reference.mLoadSize)
+        {
+            expected[reference.mBufferSize++] = (U8)(reference.mLoad << (MAX_DATA_BITS - reference.mLoadSize));
+        }
+
+        ensure_equals("packed size", bitpack.mBufferSize, reference.mBufferSize);
+        ensure("packed bytes", memcmp(packed.data(), expected.data(), reference.mBufferSize) == 0);
+
+        LLBitPack unpacker(packed.data(), (U32)packed.size());
+        reference_bitpack reference_unpacker(packed.data());
+        for (S32 i = 0; i < FIELDS; i++)
+        {
+            U32 value = 0;
+            unpacker.bitUnpack((U8*)&value, widths[i]);
+            ensure_equals("unpacked value", value, values[i]);
+
+            U32 remaining = widths[i];
+            for (U32 byte = 0; remaining; byte++)
+            {
+                U32 dsize = llmin(remaining, MAX_DATA_BITS);
+                ensure_equals("reference unpack", (U32)reference_unpacker.unpack(dsize), (values[i] >> (byte * 8)) & ((1U << dsize) - 1));
+                remaining -= dsize;
+            }
+            ensure_equals("bytes consumed", unpacker.mBufferSize, reference_unpacker.mBufferSize);
+        }
+    }
 }
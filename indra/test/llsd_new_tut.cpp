@@ -33,6 +33,8 @@
 #include "llsdtraits.h"
 #include "llstring.h"
 
+#include <cmath> // <FS/> Shared LLSD scalars
+
 using std::fpclassify;
 
 namespace tut
@@ -725,6 +727,11 @@ namespace tut
     {
         SDCleanupCheck check;
 
+        // <FS> Shared LLSD scalars
+        // The values below are ones that get an Impl of their own: see
+        // test<15> for the shared ones
+        // </FS>
+
         {
             SDAllocationCheck check("copy construct undefinded", 0);
             LLSD v;
@@ -740,27 +747,35 @@ namespace tut
 
         {
             SDAllocationCheck check("assign integer value", 1);
-            LLSD v = 45;
-            v = 33;
-            v = 0;
+            // <FS> Shared LLSD scalars
+            //LLSD v = 45;
+            //v = 33;
+            //v = 0;
+            LLSD v = 4500;
+            v = 3300;
+            v = 1000;
+            // </FS>
         }
 
         {
             SDAllocationCheck check("copy construct integer", 1);
-            LLSD v = 45;
+            //LLSD v = 45;
+            LLSD v = 4500; // <FS/> Shared LLSD scalars
             LLSD w = v;
         }
 
         {
             SDAllocationCheck check("assign integer", 1);
-            LLSD v = 45;
+            //LLSD v = 45;
+            LLSD v = 4500; // <FS/> Shared LLSD scalars
             LLSD w;
             w = v;
         }
 
         {
             SDAllocationCheck check("avoids extra clone", 2);
-            LLSD v = 45;
+            //LLSD v = 45;
+            LLSD v = 4500; // <FS/> Shared LLSD scalars
             LLSD w = v;
             w = "nice day";
         }
@@ -772,8 +787,12 @@ namespace tut
 
             LLSD m = LLSD::emptyMap();
 
-            m["one"] = 1;
-            m["two"] = 2;
+            // <FS> Shared LLSD scalars
+            //m["one"] = 1;
+            //m["two"] = 2;
+            m["one"] = 1001;
+            m["two"] = 1002;
+            // </FS>
             m["one_copy"] = m["one"];           // 3 (m, "one" and "two")
 
             m["undef_one"] = LLSD();
@@ -782,9 +801,14 @@ namespace tut
 
             {   // Ensure first_array gets freed to avoid counting it
                 LLSD first_array = LLSD::emptyArray();
-                first_array.append(1.0f);
-                first_array.append(2.0f);
-                first_array.append(3.0f);           // 7
+                // <FS> Shared LLSD scalars
+                //first_array.append(1.0f);
+                //first_array.append(2.0f);
+                //first_array.append(3.0f);           // 7
+                first_array.append(1.5f);
+                first_array.append(2.5f);
+                first_array.append(3.5f);           // 7
+                // </FS>
 
                 m["array"] = first_array;
                 m["array_clone"] = first_array;
@@ -811,6 +835,130 @@ namespace tut
         ensure("type is a string", v.isString());
     }
 
+    // <FS> Shared LLSD scalars
+    template<> template<>
+    void SDTestObject::test<15>()
+        // common scalar values share one Impl
+    {
+        SDCleanupCheck check;
+
+        {
+            SDAllocationCheck check("shared scalars", 0);
+            LLSD a = true;
+            LLSD b = false;
+            LLSD c = 0;
+            LLSD d = 255;
+            LLSD e = -1;
+            LLSD f = 0.0;
+            LLSD g = 1.0;
+            LLSD h = "";
+            LLSD i = std::string();
+            LLSD j = LLUUID::null;
+            a = 7;
+            b = c;
+            ensureTypeAndValue("shared integer", a, 7);
+            ensureTypeAndValue("shared copy", b, 0);
+        }
+
+        {
+            SDAllocationCheck check("unshared scalars", 5);
+            LLSD a = 256;
+            LLSD b = -2;
+            LLSD c = -0.0;
+            LLSD d = "x";
+            LLUUID id;
+            id.generate();
+            LLSD e = id;
+            ensure("negative zero", std::signbit(c.asReal()));
+        }
+
+        {
+            // a shared value is never changed in place
+            SDAllocationCheck check("assign over shared", 1);
+            LLSD a = 5;
+            LLSD b = 5;
+            a = 1000;
+            b = 6;
+            ensureTypeAndValue("assigned", a, 1000);
+            ensureTypeAndValue("other unaltered", b, 6);
+            LLSD c = 5;
+            ensureTypeAndValue("shared value unaltered", c, 5);
+        }
+
+        {
+            SDAllocationCheck check("shared strings and uuids", 0);
+            LLSD a = "";
+            LLSD b = a;
+            a = std::string();
+            ensureTypeAndValue("empty string", b, "");
+            LLSD c = LLUUID::null;
+            c = LLUUID();
+            ensureTypeAndValue("null uuid", c, LLUUID::null);
+        }
+
+        {
+            // values in a map are shared as well, and copy on write still
+            // works
+            // the map and the copy of it
+            SDAllocationCheck check("shared in map", 2);
+            LLSD m;
+            m["flags"] = 0;
+            m["enabled"] = true;
+            m["count"] = 1;
+            LLSD n = m;
+            n["flags"] = 2;
+            ensureTypeAndValue("original map unaltered", m["flags"], 0);
+            ensureTypeAndValue("copied map changed", n["flags"], 2);
+        }
+    }
+
+    template<> template<>
+    void SDTestObject::test<16>()
+        // allocations per message for messages like the viewer gets
+    {
+        SDCleanupCheck check;
+
+        const S32 MESSAGES = 20000;
+        LLUUID owner;
+        owner.generate();
+
+        U32 start_allocations = llsd::allocationCount();
+        S64 sum = 0;
+        for (S32 i = 0; i < MESSAGES; ++i)
+        {
+            // mostly flags, small counts, null ids and empty strings
+            LLSD message;
+            message["LocalID"] = 100000 + i;
+            message["Flags"] = 0;
+            message["State"] = i % 4;
+            message["Material"] = 3;
+            message["Enabled"] = true;
+            message["Deleted"] = false;
+            message["Owner"] = owner;
+            message["Group"] = LLUUID::null;
+            message["Name"] = "Object";
+            message["Text"] = "";
+            message["Gain"] = 1.0;
+            message["Radius"] = 0.0;
+            LLSD& scale = message["Scale"];
+            scale.append(0.5);
+            scale.append(0.5);
+            scale.append(1.0);
+
+            LLSD copy = message;
+            copy["State"] = 1;
+            sum += copy["LocalID"].asInteger() + message["State"].asInteger()
+                + message["Scale"].size();
+        }
+        U32 allocations = llsd::allocationCount() - start_allocations;
+
+        // LocalID, Owner, Name, the two 0.5 scales, the map, its copy and
+        // the scale array
+        ensure_equals("allocations per message", allocations / MESSAGES, 8U);
+        ensure("messages read", sum > 0);
+    }
+    // </FS>
+
     /* TO DO:
         conversion of undefined to UUID, Date, URI and Binary
         conversion of undefined to map and array